@@ -43,11 +43,59 @@ if(NOT GENTEST_CODEGEN_JOBS MATCHES "^[0-9]+$")
     message(FATAL_ERROR "GENTEST_CODEGEN_JOBS must be a non-negative integer or AUTO (got '${GENTEST_CODEGEN_JOBS}')")
 endif()
 
+# Additive registration slots with many wrappers compile as one large TU.  A
+# value above 1 predeclares that many registration sources per slot; codegen
+# fills only as many as the slot's estimated wrapper cost needs and leaves the
+# rest as stubs.  gentest_attach_codegen(REGISTRATION_SHARDS) overrides it.
+# The count cannot follow the codegen cost estimate automatically: the build
+# graph declares every shard source at configure time, before any slot has
+# been scanned, and each predeclared stub is still compiled.  Sharding stays
+# opt-in so small targets do not pay for empty TUs.
+if(NOT DEFINED GENTEST_CODEGEN_REGISTRATION_SHARDS)
+    set(GENTEST_CODEGEN_REGISTRATION_SHARDS "1" CACHE STRING
+        "Maximum generated registration sources per additive scan slot (1 = no sharding).")
+endif()
+if(NOT GENTEST_CODEGEN_REGISTRATION_SHARDS MATCHES "^[1-9][0-9]*$")
+    message(FATAL_ERROR
+        "GENTEST_CODEGEN_REGISTRATION_SHARDS must be a positive integer (got '${GENTEST_CODEGEN_REGISTRATION_SHARDS}')")
+endif()
+
 if(NOT DEFINED GENTEST_CODEGEN_CLANG_SCAN_DEPS)
     set(GENTEST_CODEGEN_CLANG_SCAN_DEPS "" CACHE STRING
         "Host clang-scan-deps executable override for named-module codegen (normally discovered automatically).")
 endif()
 
+if(NOT DEFINED GENTEST_CODEGEN_BMI_CACHE_DIR)
+    set(GENTEST_CODEGEN_BMI_CACHE_DIR "${CMAKE_BINARY_DIR}/.gentest_bmi_cache" CACHE PATH
+        "Content-addressed store of codegen module BMIs shared by every target (empty = per-target BMIs only).")
+endif()
+if(NOT DEFINED GENTEST_CODEGEN_BMI_CACHE_MAX_MB)
+    set(GENTEST_CODEGEN_BMI_CACHE_MAX_MB "2048" CACHE STRING
+        "Size above which the codegen BMI store evicts least recently used BMIs (0 = unbounded).")
+endif()
+if(NOT GENTEST_CODEGEN_BMI_CACHE_MAX_MB MATCHES "^[0-9]+$")
+    message(FATAL_ERROR
+        "GENTEST_CODEGEN_BMI_CACHE_MAX_MB must be a non-negative integer (got '${GENTEST_CODEGEN_BMI_CACHE_MAX_MB}')")
+endif()
+
+# With many test targets, a no-change build spends most of its codegen time
+# starting processes.  GENTEST_CODEGEN_BATCH hands every additive target's
+# codegen command to one `gentest_codegen batch` step that loads each
+# compilation database and probes the toolchain once for all of them.
+if(NOT DEFINED GENTEST_CODEGEN_BATCH)
+    set(GENTEST_CODEGEN_BATCH OFF CACHE BOOL
+        "Run codegen for all additive registration targets in one gentest_codegen process.")
+endif()
+# The batch is the only codegen process for those targets, so unlike
+# GENTEST_CODEGEN_JOBS it defaults to using every hardware thread.
+if(NOT DEFINED GENTEST_CODEGEN_BATCH_JOBS)
+    set(GENTEST_CODEGEN_BATCH_JOBS "0" CACHE STRING
+        "Worker threads for the GENTEST_CODEGEN_BATCH gentest_codegen process (0 = auto).")
+endif()
+if(NOT GENTEST_CODEGEN_BATCH_JOBS MATCHES "^[0-9]+$")
+    message(FATAL_ERROR "GENTEST_CODEGEN_BATCH_JOBS must be a non-negative integer (got '${GENTEST_CODEGEN_BATCH_JOBS}')")
+endif()
+
 if(NOT DEFINED GENTEST_CODEGEN_HOST_CLANG)
     set(GENTEST_CODEGEN_HOST_CLANG "" CACHE FILEPATH
         "Optional path to the host Clang executable used by gentest_codegen for Clang-only operations.")
@@ -206,6 +206,11 @@ function(_gentest_append_codegen_module_context_args command_var target clang_sc
     if(NOT "${GENTEST_CODEGEN_HOST_CLANG}" STREQUAL "")
         list(APPEND _gentest_command --host-clang "${GENTEST_CODEGEN_HOST_CLANG}")
     endif()
+    if(NOT "${GENTEST_CODEGEN_BMI_CACHE_DIR}" STREQUAL "")
+        list(APPEND _gentest_command
+            "--module-bmi-cache=${GENTEST_CODEGEN_BMI_CACHE_DIR}"
+            "--module-bmi-cache-max-mb=${GENTEST_CODEGEN_BMI_CACHE_MAX_MB}")
+    endif()
     list(APPEND _gentest_command
         "$<$<BOOL:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTERNAL_MODULE_SOURCE_ARGS>>:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTERNAL_MODULE_SOURCE_ARGS>>")
     set(${command_var} "${_gentest_command}" PARENT_SCOPE)
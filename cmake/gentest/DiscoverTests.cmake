@@ -49,6 +49,79 @@ function(_gentest_escape_square_brackets output bracket placeholder placeholder_
   endif()
 endfunction()
 
+# Parses `--list-json` shaped text (one case object per line) and splits it
+# like `--list` output: skipped death cases are dropped, other death-tagged
+# cases go to the death list. With a batch_field, each normal case's value of
+# that field is published as _gentest_case_key_<md5(name)> in the caller.
+function(_gentest_parse_case_json json_text source batch_field out_var out_death_var)
+  set(_lines "${json_text}")
+  _gentest_escape_square_brackets("${_lines}" "[" "__osb" open_sb _lines)
+  _gentest_escape_square_brackets("${_lines}" "]" "__csb" close_sb _lines)
+  string(REPLACE [[;]] [[\;]] _lines "${_lines}")
+  string(REPLACE "\r\n" "\n" _lines "${_lines}")
+  string(REPLACE "\n" ";" _lines "${_lines}")
+
+  set(_cases "")
+  set(_death_cases "")
+  foreach(line IN LISTS _lines)
+    string(STRIP "${line}" entry)
+    if(NOT entry MATCHES "^{")
+      continue()
+    endif()
+    string(REGEX REPLACE ",$" "" entry "${entry}")
+    if(open_sb)
+      string(REPLACE "${open_sb}" "[" entry "${entry}")
+    endif()
+    if(close_sb)
+      string(REPLACE "${close_sb}" "]" entry "${entry}")
+    endif()
+    string(REPLACE "\\;" ";" entry "${entry}")
+
+    string(JSON case_name ERROR_VARIABLE json_error GET "${entry}" name)
+    if(json_error)
+      message(FATAL_ERROR "Malformed test inventory entry in ${source}: ${json_error}\n  ${entry}")
+    endif()
+    string(JSON case_skipped GET "${entry}" skipped)
+    string(JSON tag_count LENGTH "${entry}" tags)
+    set(is_death FALSE)
+    if(tag_count GREATER 0)
+      math(EXPR last_tag "${tag_count} - 1")
+      foreach(tag_idx RANGE ${last_tag})
+        string(JSON tag GET "${entry}" tags ${tag_idx})
+        string(TOLOWER "${tag}" tag)
+        if(tag STREQUAL "death")
+          set(is_death TRUE)
+          break()
+        endif()
+      endforeach()
+    endif()
+
+    if(is_death AND case_skipped)
+      continue()
+    endif()
+    if(is_death)
+      list(APPEND _death_cases "${case_name}")
+    else()
+      list(APPEND _cases "${case_name}")
+      if(batch_field)
+        string(JSON case_key GET "${entry}" ${batch_field})
+        string(MD5 case_id_hash "${case_name}")
+        set(_gentest_case_key_${case_id_hash} "${case_key}" PARENT_SCOPE)
+      endif()
+    endif()
+  endforeach()
+  set(${out_var} "${_cases}" PARENT_SCOPE)
+  set(${out_death_var} "${_death_cases}" PARENT_SCOPE)
+endfunction()
+
+macro(_gentest_parse_inventory inventory_file batch_field out_var out_death_var)
+  if(NOT EXISTS "${inventory_file}")
+    message(FATAL_ERROR "Specified test inventory does not exist: '${inventory_file}'")
+  endif()
+  file(READ "${inventory_file}" _gentest_inventory_json)
+  _gentest_parse_case_json("${_gentest_inventory_json}" "'${inventory_file}'" "${batch_field}" ${out_var} ${out_death_var})
+endmacro()
+
 function(_gentest_wildcard_to_regex out_var pat)
   # Convert a simple wildcard (*, ?) pattern to an anchored CMake regex.
   set(_s "${pat}")
@@ -200,6 +273,10 @@ function(gentest_discover_tests_impl)
     TEST_DISCOVERY_EXTRA_ARGS
     TEST_PROPERTIES
     TEST_EXECUTOR
+    TEST_INVENTORY
+    TEST_BATCH_SIZE
+    TEST_BATCH_BY
+    TEST_DEATH_FORK_SERVER
     DEATH_EXPECT_SUBSTRING
   )
   set(multiValueArgs "")
@@ -229,39 +306,66 @@ function(gentest_discover_tests_impl)
     set(discovery_extra_args "[==[${discovery_extra_args}]==]")
   endif()
 
-  if("${arg_TEST_DISCOVERY_TIMEOUT}" STREQUAL "")
-    set(arg_TEST_DISCOVERY_TIMEOUT 5)
+  if("${arg_TEST_BATCH_SIZE}" STREQUAL "")
+    set(arg_TEST_BATCH_SIZE 0)
+  endif()
+  set(batching FALSE)
+  if(arg_TEST_BATCH_SIZE GREATER 0 OR NOT "${arg_TEST_BATCH_BY}" STREQUAL "")
+    set(batching TRUE)
+  endif()
+  # Grouping needs per-case metadata, so batched execution-based discovery
+  # reads `--list-json` instead of `--list`.
+  set(list_arg --list)
+  if(batching)
+    set(list_arg --list-json)
   endif()
 
-  cmake_language(EVAL CODE
-    "execute_process(
-      COMMAND ${launcher_args} [==[${arg_TEST_EXECUTABLE}]==] --list ${discovery_extra_args}
-      WORKING_DIRECTORY [==[${arg_TEST_WORKING_DIR}]==]
-      TIMEOUT ${arg_TEST_DISCOVERY_TIMEOUT}
-      OUTPUT_VARIABLE output
-      ERROR_VARIABLE error_output
-      RESULT_VARIABLE result
-    )"
-  )
-  if(NOT result EQUAL 0)
-    string(REPLACE "\n" "\n    " output "${output}")
-    string(REPLACE "\n" "\n    " error_output "${error_output}")
-    if(arg_TEST_EXECUTOR)
-      set(path "${arg_TEST_EXECUTOR} ${arg_TEST_EXECUTABLE}")
-    else()
-      set(path "${arg_TEST_EXECUTABLE}")
-    endif()
-    message(FATAL_ERROR
-      "Error running test executable.\n"
-      "  Path: '${path}'\n"
-      "  Working directory: '${arg_TEST_WORKING_DIR}'\n"
-      "  Result: ${result}\n"
-      "  Command: --list\n"
-      "  Stdout:\n"
-      "    ${output}\n"
-      "  Stderr:\n"
-      "    ${error_output}\n"
+  if(NOT "${arg_TEST_INVENTORY}" STREQUAL "")
+    # Codegen already wrote the case list; nothing has to run on the build
+    # host, which also covers cross-compiled targets.
+    set(normal_cases "")
+    set(death_cases "")
+    foreach(inventory IN LISTS arg_TEST_INVENTORY)
+      _gentest_parse_inventory("${inventory}" "${arg_TEST_BATCH_BY}" inventory_cases inventory_death_cases)
+      list(APPEND normal_cases ${inventory_cases})
+      list(APPEND death_cases ${inventory_death_cases})
+    endforeach()
+    string(JOIN "\n" output ${normal_cases} ${death_cases})
+  else()
+    if("${arg_TEST_DISCOVERY_TIMEOUT}" STREQUAL "")
+      set(arg_TEST_DISCOVERY_TIMEOUT 5)
+    endif()
+
+    cmake_language(EVAL CODE
+      "execute_process(
+        COMMAND ${launcher_args} [==[${arg_TEST_EXECUTABLE}]==] ${list_arg} ${discovery_extra_args}
+        WORKING_DIRECTORY [==[${arg_TEST_WORKING_DIR}]==]
+        TIMEOUT ${arg_TEST_DISCOVERY_TIMEOUT}
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE error_output
+        RESULT_VARIABLE result
+      )"
     )
+    if(NOT result EQUAL 0)
+      string(REPLACE "\n" "\n    " output "${output}")
+      string(REPLACE "\n" "\n    " error_output "${error_output}")
+      if(arg_TEST_EXECUTOR)
+        set(path "${arg_TEST_EXECUTOR} ${arg_TEST_EXECUTABLE}")
+      else()
+        set(path "${arg_TEST_EXECUTABLE}")
+      endif()
+      message(FATAL_ERROR
+        "Error running test executable.\n"
+        "  Path: '${path}'\n"
+        "  Working directory: '${arg_TEST_WORKING_DIR}'\n"
+        "  Result: ${result}\n"
+        "  Command: ${list_arg}\n"
+        "  Stdout:\n"
+        "    ${output}\n"
+        "  Stderr:\n"
+        "    ${error_output}\n"
+      )
+    endif()
   endif()
 
   set(filter_regex "")
@@ -332,12 +436,26 @@ function(gentest_discover_tests_impl)
     set(${out_death_var} "${_death_cases}" PARENT_SCOPE)
   endfunction()
 
-  _gentest_parse_meta_list("${output}" normal_cases death_cases)
+  if("${arg_TEST_INVENTORY}" STREQUAL "")
+    if(batching)
+      _gentest_parse_case_json("${output}" "'${list_arg}' output" "${arg_TEST_BATCH_BY}" normal_cases death_cases)
+    else()
+      _gentest_parse_meta_list("${output}" normal_cases death_cases)
+    endif()
+  endif()
 
   if(death_cases)
     _gentest_ensure_check_death_script(_gentest_check_death_script)
   endif()
 
+  set(batch_count 0)
+  string(REGEX REPLACE "\\.cmake$" "" batch_dir "${arg_CTEST_FILE}")
+  set(batch_dir "${batch_dir}_batches")
+  if(batching OR arg_TEST_DEATH_FORK_SERVER)
+    file(REMOVE_RECURSE "${batch_dir}")
+    file(MAKE_DIRECTORY "${batch_dir}")
+  endif()
+
   foreach(case_id IN LISTS normal_cases)
     if(filter_regex AND NOT case_id MATCHES "${filter_regex}")
       continue()
@@ -347,6 +465,49 @@ function(gentest_discover_tests_impl)
       continue()
     endif()
 
+    if(batching)
+      # Fill the open batch for this case's group; start a new one when it
+      # reaches BATCH_SIZE (0 keeps one batch per group).
+      string(MD5 case_id_hash "${case_id}")
+      if(DEFINED batched_${case_id_hash})
+        continue()
+      endif()
+      set(batched_${case_id_hash} TRUE)
+      set(batch_key "")
+      if(NOT "${arg_TEST_BATCH_BY}" STREQUAL "")
+        set(batch_key "${_gentest_case_key_${case_id_hash}}")
+      endif()
+      string(MD5 batch_key_hash "${batch_key}")
+      if(NOT DEFINED batch_open_${batch_key_hash} OR
+         (arg_TEST_BATCH_SIZE GREATER 0 AND batch_fill_${batch_key_hash} EQUAL arg_TEST_BATCH_SIZE))
+        math(EXPR batch_count "${batch_count} + 1")
+        set(batch_open_${batch_key_hash} ${batch_count})
+        set(batch_fill_${batch_key_hash} 0)
+        # Files are labelled by name only; the per-label ordinal keeps
+        # same-named files in different directories apart.
+        set(batch_label "${batch_key}")
+        if(arg_TEST_BATCH_BY STREQUAL "file")
+          get_filename_component(batch_label "${batch_key}" NAME)
+        endif()
+        string(MD5 batch_label_hash "${batch_label}")
+        if(DEFINED batch_ordinal_${batch_label_hash})
+          math(EXPR batch_ordinal_${batch_label_hash} "${batch_ordinal_${batch_label_hash}} + 1")
+        else()
+          set(batch_ordinal_${batch_label_hash} 1)
+        endif()
+        if("${batch_label}" STREQUAL "")
+          set(batch_label_${batch_count} "batch/${batch_ordinal_${batch_label_hash}}")
+        else()
+          set(batch_label_${batch_count} "batch/${batch_label}/${batch_ordinal_${batch_label_hash}}")
+        endif()
+        set(batch_cases_${batch_count} "")
+      endif()
+      set(batch_id ${batch_open_${batch_key_hash}})
+      string(APPEND batch_cases_${batch_id} "${case_id}\n")
+      math(EXPR batch_fill_${batch_key_hash} "${batch_fill_${batch_key_hash}} + 1")
+      continue()
+    endif()
+
     set(testname "${prefix}${case_id}${suffix}")
     set(guarded_testname "${open_guard}${testname}${close_guard}")
 
@@ -386,10 +547,65 @@ function(gentest_discover_tests_impl)
     endif()
   endforeach()
 
+  # Each batch runs its exact case list in one process. The runner's JUnit
+  # report keeps one <testcase> per case and is attached to the CTest entry.
+  set(batch_junit TRUE)
+  foreach(arg IN LISTS arg_TEST_EXTRA_ARGS)
+    if(arg MATCHES "^--junit(=|$)")
+      set(batch_junit FALSE)
+    endif()
+  endforeach()
+  if(batch_count GREATER 0)
+    foreach(batch_id RANGE 1 ${batch_count})
+      set(run_list_file "${batch_dir}/${batch_id}.txt")
+      set(junit_file "${batch_dir}/${batch_id}.junit.xml")
+      file(WRITE "${run_list_file}" "${batch_cases_${batch_id}}")
+
+      set(testname "${prefix}${batch_label_${batch_id}}${suffix}")
+      set(guarded_testname "${open_guard}${testname}${close_guard}")
+      set(batch_args "${arg_TEST_EXECUTABLE}" "--run-list=${run_list_file}")
+      if(batch_junit)
+        list(APPEND batch_args "--junit=${junit_file}")
+      endif()
+      string(APPEND script "add_test(${guarded_testname} ${launcher_args}")
+      foreach(arg IN LISTS batch_args)
+        if(arg MATCHES "[^-./:a-zA-Z0-9_]")
+          string(APPEND script " [==[${arg}]==]")
+        else()
+          string(APPEND script " ${arg}")
+        endif()
+      endforeach()
+      if(arg_TEST_EXTRA_ARGS)
+        list(JOIN arg_TEST_EXTRA_ARGS "]==] [==[" extra_args)
+        string(APPEND script " [==[${extra_args}]==]")
+      endif()
+      string(APPEND script ")\n")
+
+      set(batch_properties WORKING_DIRECTORY "${arg_TEST_WORKING_DIR}")
+      if(batch_junit)
+        list(APPEND batch_properties ATTACHED_FILES "${junit_file}")
+      endif()
+      _gentest_add_command(set_tests_properties
+        "${guarded_testname}"
+        PROPERTIES
+        ${batch_properties}
+        ${arg_TEST_PROPERTIES}
+      )
+
+      string(REPLACE [[;]] [[\;]] _testname_escaped "${testname}")
+      list(APPEND tests "${_testname_escaped}")
+    endforeach()
+  endif()
+
+  set(death_fork_cases "")
   foreach(case_id IN LISTS death_cases)
     if(filter_regex AND NOT case_id MATCHES "${filter_regex}")
       continue()
     endif()
+    if(arg_TEST_DEATH_FORK_SERVER)
+      string(APPEND death_fork_cases "${case_id}\n")
+      continue()
+    endif()
 
     set(testname "${prefix}${death_prefix}${case_id}${death_suffix}${suffix}")
     set(guarded_testname "${open_guard}${testname}${close_guard}")
@@ -455,6 +671,43 @@ function(gentest_discover_tests_impl)
       set(script "")
     endif()
   endforeach()
+
+  # One entry forks every death case from a single warm process; the runner
+  # applies the same checks as GentestCheckDeath.cmake to each child.
+  if(NOT death_fork_cases STREQUAL "")
+    set(run_list_file "${batch_dir}/death.txt")
+    file(WRITE "${run_list_file}" "${death_fork_cases}")
+
+    set(testname "${prefix}${death_prefix}fork-server${suffix}")
+    set(guarded_testname "${open_guard}${testname}${close_guard}")
+    set(death_fork_args "${arg_TEST_EXECUTABLE}" "--death-fork-server" "--run-list=${run_list_file}")
+    if(NOT "${arg_DEATH_EXPECT_SUBSTRING}" STREQUAL "")
+      list(APPEND death_fork_args "--death-expect-substring=${arg_DEATH_EXPECT_SUBSTRING}")
+    endif()
+    string(APPEND script "add_test(${guarded_testname} ${launcher_args}")
+    foreach(arg IN LISTS death_fork_args)
+      if(arg MATCHES "[^-./:a-zA-Z0-9_]")
+        string(APPEND script " [==[${arg}]==]")
+      else()
+        string(APPEND script " ${arg}")
+      endif()
+    endforeach()
+    if(arg_TEST_EXTRA_ARGS)
+      list(JOIN arg_TEST_EXTRA_ARGS "]==] [==[" extra_args)
+      string(APPEND script " [==[${extra_args}]==]")
+    endif()
+    string(APPEND script ")\n")
+
+    _gentest_add_command(set_tests_properties
+      "${guarded_testname}"
+      PROPERTIES
+      WORKING_DIRECTORY "${arg_TEST_WORKING_DIR}"
+      ${arg_TEST_PROPERTIES}
+    )
+
+    string(REPLACE [[;]] [[\;]] _testname_escaped "${testname}")
+    list(APPEND tests "${_testname_escaped}")
+  endif()
   _gentest_add_command(set "" ${arg_TEST_LIST} "${tests}")
 
   file(${file_write_mode} "${arg_CTEST_FILE}" "${script}")
@@ -474,6 +727,10 @@ if(CMAKE_SCRIPT_MODE_FILE)
     TEST_EXTRA_ARGS "${TEST_EXTRA_ARGS}"
     TEST_DISCOVERY_EXTRA_ARGS "${TEST_DISCOVERY_EXTRA_ARGS}"
     TEST_PROPERTIES "${TEST_PROPERTIES}"
+    TEST_INVENTORY "${TEST_INVENTORY}"
+    TEST_BATCH_SIZE "${TEST_BATCH_SIZE}"
+    TEST_BATCH_BY "${TEST_BATCH_BY}"
+    TEST_DEATH_FORK_SERVER "${TEST_DEATH_FORK_SERVER}"
     DEATH_EXPECT_SUBSTRING ${DEATH_EXPECT_SUBSTRING}
   )
 endif()
@@ -485,7 +742,7 @@ endif()
 endfunction()
 
 function(gentest_discover_tests target)
-    set(options "")
+    set(options DEATH_FORK_SERVER)
     set(one_value_args
         TEST_PREFIX
         TEST_SUFFIX
@@ -494,9 +751,11 @@ function(gentest_discover_tests target)
         TEST_LIST
         DISCOVERY_TIMEOUT
         DISCOVERY_MODE
+        BATCH_SIZE
+        BATCH_BY
         DEATH_EXPECT_SUBSTRING)
-    set(multi_value_args EXTRA_ARGS DISCOVERY_EXTRA_ARGS PROPERTIES)
-    set(_gentest_discover_keyword_args ${one_value_args} ${multi_value_args})
+    set(multi_value_args EXTRA_ARGS DISCOVERY_EXTRA_ARGS PROPERTIES INVENTORY)
+    set(_gentest_discover_keyword_args ${options} ${one_value_args} ${multi_value_args})
     set(_gentest_in_multi_value_arg FALSE)
     list(LENGTH ARGN _gentest_arg_count)
     set(_gentest_arg_idx 0)
@@ -550,11 +809,33 @@ function(gentest_discover_tests target)
     if(NOT GENTEST_DISCOVERY_TIMEOUT)
         set(GENTEST_DISCOVERY_TIMEOUT 5)
     endif()
+    if(NOT "${GENTEST_BATCH_SIZE}" STREQUAL "" AND NOT GENTEST_BATCH_SIZE MATCHES "^[1-9][0-9]*$")
+        message(FATAL_ERROR "gentest_discover_tests: BATCH_SIZE must be a positive integer, got '${GENTEST_BATCH_SIZE}'")
+    endif()
+    if(NOT "${GENTEST_BATCH_BY}" STREQUAL "" AND NOT GENTEST_BATCH_BY MATCHES "^(suite|fixture|file)$")
+        message(FATAL_ERROR "gentest_discover_tests: BATCH_BY must be one of suite, fixture or file, got '${GENTEST_BATCH_BY}'")
+    endif()
+    if(NOT GENTEST_INVENTORY)
+        get_property(_gentest_codegen_inventory TARGET ${target} PROPERTY GENTEST_INVENTORY_FILE)
+        if(_gentest_codegen_inventory)
+            set(GENTEST_INVENTORY "${_gentest_codegen_inventory}")
+        endif()
+    endif()
     if(NOT GENTEST_DISCOVERY_MODE)
-        if(NOT CMAKE_GENTEST_DISCOVER_TESTS_DISCOVERY_MODE)
-            set(CMAKE_GENTEST_DISCOVER_TESTS_DISCOVERY_MODE "POST_BUILD")
+        if(CMAKE_GENTEST_DISCOVER_TESTS_DISCOVERY_MODE)
+            set(GENTEST_DISCOVERY_MODE ${CMAKE_GENTEST_DISCOVER_TESTS_DISCOVERY_MODE})
+        else()
+            set(GENTEST_DISCOVERY_MODE "POST_BUILD")
         endif()
-        set(GENTEST_DISCOVERY_MODE ${CMAKE_GENTEST_DISCOVER_TESTS_DISCOVERY_MODE})
+    endif()
+    if(GENTEST_DEATH_FORK_SERVER AND NOT UNIX)
+        # --death-fork-server needs fork(); register one entry per death case instead.
+        set(GENTEST_DEATH_FORK_SERVER FALSE)
+    endif()
+    if(GENTEST_DISCOVERY_MODE STREQUAL "INVENTORY" AND NOT GENTEST_INVENTORY)
+        message(FATAL_ERROR
+            "gentest_discover_tests: DISCOVERY_MODE INVENTORY requires gentest_attach_codegen(${target}) "
+            "to run first, or an explicit INVENTORY <file...>")
     endif()
     get_property(_gentest_has_counter TARGET ${target} PROPERTY GENTEST_DISCOVERED_TEST_COUNTER SET)
     if(_gentest_has_counter)
@@ -605,6 +886,9 @@ function(gentest_discover_tests target)
                 -D "CTEST_FILE=${_gentest_ctest_tests_file}"
                 -D "TEST_DISCOVERY_TIMEOUT=${GENTEST_DISCOVERY_TIMEOUT}"
                 -D "TEST_DISCOVERY_EXTRA_ARGS=${GENTEST_DISCOVERY_EXTRA_ARGS}"
+                -D "TEST_BATCH_SIZE=${GENTEST_BATCH_SIZE}"
+                -D "TEST_BATCH_BY=${GENTEST_BATCH_BY}"
+                -D "TEST_DEATH_FORK_SERVER=${GENTEST_DEATH_FORK_SERVER}"
                 -D "DEATH_EXPECT_SUBSTRING=${GENTEST_DEATH_EXPECT_SUBSTRING}"
                 -P "${_gentest_add_tests_script}"
             VERBATIM
@@ -647,6 +931,67 @@ function(gentest_discover_tests target)
             "      CTEST_FILE [==[${_gentest_ctest_tests_file}]==]" "\n"
             "      TEST_DISCOVERY_TIMEOUT [==[${GENTEST_DISCOVERY_TIMEOUT}]==]" "\n"
             "      TEST_DISCOVERY_EXTRA_ARGS [==[${GENTEST_DISCOVERY_EXTRA_ARGS}]==]" "\n"
+            "      TEST_BATCH_SIZE [==[${GENTEST_BATCH_SIZE}]==]" "\n"
+            "      TEST_BATCH_BY [==[${GENTEST_BATCH_BY}]==]" "\n"
+            "      TEST_DEATH_FORK_SERVER [==[${GENTEST_DEATH_FORK_SERVER}]==]" "\n"
+            "      DEATH_EXPECT_SUBSTRING [==[${GENTEST_DEATH_EXPECT_SUBSTRING}]==]" "\n"
+            "    )" "\n"
+            "  endif()" "\n"
+            "  include(\"${_gentest_ctest_tests_file}\")" "\n"
+            "else()" "\n"
+            "  add_test(${target}_NOT_BUILT ${target}_NOT_BUILT)" "\n"
+            "endif()" "\n"
+        )
+
+        if(_gentest_is_multi_config)
+            foreach(_gentest_cfg IN LISTS CMAKE_CONFIGURATION_TYPES)
+                file(GENERATE
+                    OUTPUT "${_gentest_ctest_file_base}_include-${_gentest_cfg}.cmake"
+                    CONTENT "${_gentest_ctest_include_content}"
+                    CONDITION $<CONFIG:${_gentest_cfg}>
+                )
+            endforeach()
+            file(WRITE "${_gentest_ctest_include_file}"
+                "include(\"${_gentest_ctest_file_base}_include-\${CTEST_CONFIGURATION_TYPE}.cmake\")"
+            )
+        else()
+            file(GENERATE
+                OUTPUT "${_gentest_ctest_file_base}_include.cmake"
+                CONTENT "${_gentest_ctest_include_content}"
+            )
+            file(WRITE "${_gentest_ctest_include_file}"
+                "include(\"${_gentest_ctest_file_base}_include.cmake\")"
+            )
+        endif()
+    elseif(GENTEST_DISCOVERY_MODE STREQUAL "INVENTORY")
+        # Regenerate from the codegen inventory whenever it changes; the test
+        # binary only has to exist, it is never executed here.
+        set(_gentest_inventory_stale "")
+        foreach(_gentest_inventory_file IN LISTS GENTEST_INVENTORY)
+            string(APPEND _gentest_inventory_stale
+                "     NOT \"${_gentest_ctest_tests_file}\" IS_NEWER_THAN \"${_gentest_inventory_file}\" OR\n")
+        endforeach()
+        string(CONCAT _gentest_ctest_include_content
+            "if(EXISTS \"$<TARGET_FILE:${target}>\")" "\n"
+            "  if(NOT EXISTS \"${_gentest_ctest_tests_file}\" OR" "\n"
+            "${_gentest_inventory_stale}"
+            "     NOT \"${_gentest_ctest_tests_file}\" IS_NEWER_THAN \"\${CMAKE_CURRENT_LIST_FILE}\")\n"
+            "    include([==[${_gentest_add_tests_script}]==])" "\n"
+            "    gentest_discover_tests_impl(" "\n"
+            "      TEST_EXECUTABLE [==[$<TARGET_FILE:${target}>]==]" "\n"
+            "      TEST_EXECUTOR [==[${_gentest_test_executor}]==]" "\n"
+            "      TEST_WORKING_DIR [==[${GENTEST_WORKING_DIRECTORY}]==]" "\n"
+            "      TEST_EXTRA_ARGS [==[${GENTEST_EXTRA_ARGS}]==]" "\n"
+            "      TEST_PROPERTIES [==[${GENTEST_PROPERTIES}]==]" "\n"
+            "      TEST_PREFIX [==[${GENTEST_TEST_PREFIX}]==]" "\n"
+            "      TEST_SUFFIX [==[${GENTEST_TEST_SUFFIX}]==]" "\n"
+            "      TEST_FILTER [==[${GENTEST_TEST_FILTER}]==]" "\n"
+            "      TEST_LIST [==[${GENTEST_TEST_LIST}]==]" "\n"
+            "      CTEST_FILE [==[${_gentest_ctest_tests_file}]==]" "\n"
+            "      TEST_INVENTORY [==[${GENTEST_INVENTORY}]==]" "\n"
+            "      TEST_BATCH_SIZE [==[${GENTEST_BATCH_SIZE}]==]" "\n"
+            "      TEST_BATCH_BY [==[${GENTEST_BATCH_BY}]==]" "\n"
+            "      TEST_DEATH_FORK_SERVER [==[${GENTEST_DEATH_FORK_SERVER}]==]" "\n"
             "      DEATH_EXPECT_SUBSTRING [==[${GENTEST_DEATH_EXPECT_SUBSTRING}]==]" "\n"
             "    )" "\n"
             "  endif()" "\n"
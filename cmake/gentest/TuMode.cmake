@@ -395,9 +395,9 @@ function(_gentest_prepare_tu_mode)
 #include \"gentest/async.h\"
 #include \"gentest/detail/generated_runtime.h\"
 
-#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 3 || \\
-    !defined(GENTEST_CASE_API_HAS_OWNER) || !GENTEST_CASE_API_HAS_OWNER
-#error \"gentest_codegen output requires gentest headers with Case::owner; use matching gentest headers/runtime\"
+#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 5 || \\
+    !defined(GENTEST_CASE_API_HAS_BENCH_CACHE) || !GENTEST_CASE_API_HAS_BENCH_CACHE
+#error \"gentest_codegen output requires gentest headers with Case::bench_cache; use matching gentest headers/runtime\"
 #endif
 
 ")
@@ -462,7 +462,8 @@ endfunction()
 
 function(_gentest_prepare_header_declaration_mode)
     set(one_value_args
-        TARGET TARGET_ID OUTPUT_DIR OUT_OUTPUT_ROOT OUT_OUTPUT_DIR OUT_REGISTRATION_CPP OUT_MANIFEST OUT_COMPILE_CONTEXT_IDS)
+        TARGET TARGET_ID OUTPUT_DIR SHARDS OUT_OUTPUT_ROOT OUT_OUTPUT_DIR OUT_REGISTRATION_CPP OUT_SHARD_CPP OUT_MANIFEST
+        OUT_COMPILE_CONTEXT_IDS)
     set(multi_value_args TUS TU_SOURCE_ENTRIES)
     cmake_parse_arguments(GENTEST "" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
@@ -488,7 +489,12 @@ function(_gentest_prepare_header_declaration_mode)
     _gentest_configure_output_dir("${_gentest_output_root}" _gentest_output_dir)
 
     set(_gentest_registration_cpp "")
+    set(_gentest_shard_cpp "")
     set(_gentest_compile_context_ids "")
+    if(NOT GENTEST_SHARDS)
+        set(GENTEST_SHARDS 1)
+    endif()
+    math(EXPR _gentest_last_shard "${GENTEST_SHARDS} - 1")
     list(LENGTH GENTEST_TUS _gentest_tu_count)
     if(_gentest_tu_count EQUAL 0)
         message(FATAL_ERROR
@@ -512,6 +518,13 @@ function(_gentest_prepare_header_declaration_mode)
         endif()
         list(APPEND _gentest_registration_cpp
             "${_gentest_output_dir}/tu_${_gentest_idx_str}_${_gentest_stem}.header_registration.gentest.cpp")
+        # Extra shards are slot-major, matching --textual-registration-shard-output.
+        if(_gentest_last_shard GREATER 0)
+            foreach(_gentest_shard RANGE 1 ${_gentest_last_shard})
+                list(APPEND _gentest_shard_cpp
+                    "${_gentest_output_dir}/tu_${_gentest_idx_str}_${_gentest_stem}.header_registration.shard${_gentest_shard}.gentest.cpp")
+            endforeach()
+        endif()
         list(APPEND _gentest_compile_context_ids "${GENTEST_TARGET_ID}:${_gentest_tu}")
     endforeach()
 
@@ -521,14 +534,33 @@ function(_gentest_prepare_header_declaration_mode)
         TU_SOURCE_ENTRIES ${GENTEST_TU_SOURCE_ENTRIES}
         TUS ${GENTEST_TUS}
         WRAPPER_CPP ${_gentest_registration_cpp})
+    # Each shard compiles under its slot's source properties, like the primary
+    # registration source.
+    if(_gentest_last_shard GREATER 0)
+        foreach(_gentest_shard RANGE 1 ${_gentest_last_shard})
+            set(_gentest_slot_shard_cpp "")
+            foreach(_gentest_idx RANGE 0 ${_gentest_last_tu})
+                math(EXPR _gentest_shard_idx "${_gentest_idx} * ${_gentest_last_shard} + ${_gentest_shard} - 1")
+                list(GET _gentest_shard_cpp ${_gentest_shard_idx} _gentest_one_shard_cpp)
+                list(APPEND _gentest_slot_shard_cpp "${_gentest_one_shard_cpp}")
+            endforeach()
+            set_source_files_properties(${_gentest_slot_shard_cpp} PROPERTIES GENERATED TRUE SKIP_UNITY_BUILD_INCLUSION ON)
+            _gentest_copy_source_properties_to_wrappers(
+                NO_IMPLICIT_SOURCE_DIR
+                TU_SOURCE_ENTRIES ${GENTEST_TU_SOURCE_ENTRIES}
+                TUS ${GENTEST_TUS}
+                WRAPPER_CPP ${_gentest_slot_shard_cpp})
+        endforeach()
+    endif()
     # Header-declaration registration is intentionally textual. Imported
     # classic TUs retain the compatibility wrapper path until their pre-import
     # registration support protocol is redesigned.
-    set_source_files_properties(${_gentest_registration_cpp} PROPERTIES CXX_SCAN_FOR_MODULES OFF)
+    set_source_files_properties(${_gentest_registration_cpp} ${_gentest_shard_cpp} PROPERTIES CXX_SCAN_FOR_MODULES OFF)
 
     set(${GENTEST_OUT_OUTPUT_ROOT} "${_gentest_output_root}" PARENT_SCOPE)
     set(${GENTEST_OUT_OUTPUT_DIR} "${_gentest_output_dir}" PARENT_SCOPE)
     set(${GENTEST_OUT_REGISTRATION_CPP} "${_gentest_registration_cpp}" PARENT_SCOPE)
+    set(${GENTEST_OUT_SHARD_CPP} "${_gentest_shard_cpp}" PARENT_SCOPE)
     set(${GENTEST_OUT_MANIFEST} "${_gentest_output_dir}/${GENTEST_TARGET_ID}.artifact_manifest.json" PARENT_SCOPE)
     set(${GENTEST_OUT_COMPILE_CONTEXT_IDS} "${_gentest_compile_context_ids}" PARENT_SCOPE)
 endfunction()
@@ -624,7 +656,7 @@ function(_gentest_make_artifact_manifest_validation_args)
         INCLUDES_AUTHORED_SOURCE REPLACES_AUTHORED_SOURCE COMPDB OUT_ARGS)
     set(multi_value_args
         SOURCES SOURCE_KINDS REGISTRATION_OUTPUTS HEADERS COMPILE_CONTEXT_IDS SOURCE_REGISTRATION_OUTPUTS
-        SCAN_SLOT_KINDS)
+        SCAN_SLOT_KINDS REGISTRATION_SHARD_OUTPUTS)
     cmake_parse_arguments(GENTEST "" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
     set(_gentest_args
@@ -658,6 +690,10 @@ function(_gentest_make_artifact_manifest_validation_args)
         _gentest_append_artifact_manifest_validation_values(_gentest_args "--expected-source-registration-output"
             ${GENTEST_SOURCE_REGISTRATION_OUTPUTS})
     endif()
+    if(GENTEST_REGISTRATION_SHARD_OUTPUTS)
+        _gentest_append_artifact_manifest_validation_values(_gentest_args "--expected-registration-shard-output"
+            ${GENTEST_REGISTRATION_SHARD_OUTPUTS})
+    endif()
     set(${GENTEST_OUT_ARGS} "${_gentest_args}" PARENT_SCOPE)
 endfunction()
 
@@ -675,6 +711,125 @@ function(_gentest_add_artifact_manifest_validation_command)
         VERBATIM)
 endfunction()
 
+# GENTEST_CODEGEN_BATCH: records one target's codegen command for the single
+# `gentest_codegen batch` custom command that the top-level directory adds once
+# it finishes configuring. Sets OUT_BATCHED to FALSE when the target must keep
+# its own command because it uses a different codegen executable.
+function(_gentest_register_batched_codegen)
+    set(one_value_args TARGET TARGET_ID OUTPUT_DIR LAUNCHER OUT_BATCHED)
+    set(multi_value_args ARGS OUTPUTS DEPENDS)
+    cmake_parse_arguments(GENTEST "" "${one_value_args}" "${multi_value_args}" ${ARGN})
+
+    get_property(_gentest_batch_launcher GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_LAUNCHER)
+    if(NOT "${_gentest_batch_launcher}" STREQUAL "" AND NOT "${_gentest_batch_launcher}" STREQUAL "${GENTEST_LAUNCHER}")
+        set(${GENTEST_OUT_BATCHED} FALSE PARENT_SCOPE)
+        return()
+    endif()
+    set_property(GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_LAUNCHER "${GENTEST_LAUNCHER}")
+
+    # The arguments hold generator expressions scoped to this target, so they
+    # are evaluated into a per-target args file, one argument per line.
+    set(_gentest_args_file "${GENTEST_OUTPUT_DIR}/${GENTEST_TARGET_ID}$<$<BOOL:$<CONFIG>>:.$<CONFIG>>.codegen_args")
+    list(JOIN GENTEST_ARGS "\n" _gentest_args_content)
+    file(GENERATE OUTPUT "${_gentest_args_file}" CONTENT "${_gentest_args_content}\n" TARGET ${GENTEST_TARGET})
+
+    # The batch command lives in the top-level directory, so relative file
+    # dependencies are anchored to this directory first.
+    set(_gentest_depends "")
+    set(_gentest_file_depends "")
+    foreach(_gentest_dep IN LISTS GENTEST_DEPENDS)
+        if(NOT _gentest_dep MATCHES "\\$<" AND NOT TARGET "${_gentest_dep}" AND NOT IS_ABSOLUTE "${_gentest_dep}")
+            cmake_path(ABSOLUTE_PATH _gentest_dep BASE_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}" NORMALIZE)
+        endif()
+        list(APPEND _gentest_depends "${_gentest_dep}")
+        if(NOT TARGET "${_gentest_dep}")
+            list(APPEND _gentest_file_depends "${_gentest_dep}")
+        endif()
+    endforeach()
+
+    # The batch reruns only targets whose own inputs changed; this file lists
+    # the file dependencies the target's depfile does not record.
+    set(_gentest_depends_file "${GENTEST_OUTPUT_DIR}/${GENTEST_TARGET_ID}$<$<BOOL:$<CONFIG>>:.$<CONFIG>>.codegen_depends")
+    list(JOIN _gentest_file_depends "\n" _gentest_depends_content)
+    file(GENERATE OUTPUT "${_gentest_depends_file}" CONTENT "${_gentest_depends_content}\n" TARGET ${GENTEST_TARGET})
+
+    set_property(GLOBAL APPEND PROPERTY GENTEST_CODEGEN_BATCH_TARGET_IDS "${GENTEST_TARGET_ID}")
+    set_property(GLOBAL APPEND PROPERTY GENTEST_CODEGEN_BATCH_ARGS_FILES "${_gentest_args_file}")
+    set_property(GLOBAL APPEND PROPERTY GENTEST_CODEGEN_BATCH_DEPENDS_FILES "${_gentest_depends_file}")
+    set_property(GLOBAL APPEND PROPERTY GENTEST_CODEGEN_BATCH_OUTPUTS ${GENTEST_OUTPUTS})
+    set_property(GLOBAL APPEND PROPERTY GENTEST_CODEGEN_BATCH_DEPENDS ${_gentest_depends})
+
+    get_property(_gentest_batch_scheduled GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_SCHEDULED)
+    if(NOT _gentest_batch_scheduled)
+        set_property(GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_SCHEDULED TRUE)
+        cmake_language(DEFER DIRECTORY "${CMAKE_SOURCE_DIR}" CALL _gentest_add_batched_codegen_command)
+    endif()
+    set(${GENTEST_OUT_BATCHED} TRUE PARENT_SCOPE)
+endfunction()
+
+function(_gentest_add_batched_codegen_command)
+    get_property(_gentest_launcher GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_LAUNCHER)
+    get_property(_gentest_target_ids GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_TARGET_IDS)
+    get_property(_gentest_args_files GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_ARGS_FILES)
+    get_property(_gentest_depends_files GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_DEPENDS_FILES)
+    get_property(_gentest_outputs GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_OUTPUTS)
+    get_property(_gentest_depends GLOBAL PROPERTY GENTEST_CODEGEN_BATCH_DEPENDS)
+    list(REMOVE_DUPLICATES _gentest_depends)
+    list(LENGTH _gentest_target_ids _gentest_target_count)
+
+    set(_gentest_batch_dir "${CMAKE_BINARY_DIR}/gentest_codegen_batch")
+    # Multi-config generators run one batch per configuration, each with its
+    # own manifest, stamp and depfile.
+    set(_gentest_batch_config "$<$<BOOL:$<CONFIG>>:.$<CONFIG>>")
+    set(_gentest_manifest "${_gentest_batch_dir}/batch${_gentest_batch_config}.manifest")
+    set(_gentest_stamp "${_gentest_batch_dir}/batch${_gentest_batch_config}.stamp")
+    set(_gentest_depfile "${_gentest_batch_dir}/batch${_gentest_batch_config}.d")
+    file(MAKE_DIRECTORY "${_gentest_batch_dir}")
+    # One `<args file>;<depends file>` pair per line.
+    set(_gentest_manifest_content "")
+    foreach(_gentest_args_file _gentest_depends_file IN ZIP_LISTS _gentest_args_files _gentest_depends_files)
+        string(APPEND _gentest_manifest_content "${_gentest_args_file};${_gentest_depends_file}\n")
+    endforeach()
+    file(GENERATE OUTPUT "${_gentest_manifest}" CONTENT "${_gentest_manifest_content}")
+
+    cmake_policy(PUSH)
+    if(POLICY CMP0171)
+        cmake_policy(SET CMP0171 NEW)
+    endif()
+    # The stamp comes first: it is the target the batch depfile names.
+    set(_gentest_custom_command_args
+        OUTPUT "${_gentest_stamp}" ${_gentest_outputs}
+        COMMAND ${_gentest_launcher} batch
+            --manifest "${_gentest_manifest}"
+            --stamp "${_gentest_stamp}"
+            --depfile "${_gentest_depfile}"
+            "--jobs=${GENTEST_CODEGEN_BATCH_JOBS}"
+        COMMAND_EXPAND_LISTS
+        DEPENDS
+            ${_gentest_depends}
+            ${_gentest_args_files}
+            ${_gentest_depends_files}
+            "${_gentest_manifest}"
+        COMMENT "Running gentest_codegen for ${_gentest_target_count} target(s)"
+        VERBATIM)
+    if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles")
+        list(APPEND _gentest_custom_command_args DEPFILE "${_gentest_depfile}")
+    endif()
+    if(POLICY CMP0171)
+        list(APPEND _gentest_custom_command_args CODEGEN)
+    endif()
+    add_custom_command(${_gentest_custom_command_args})
+    cmake_policy(POP)
+
+    add_custom_target(gentest_codegen_batch DEPENDS "${_gentest_stamp}" ${_gentest_outputs})
+    foreach(_gentest_target_id IN LISTS _gentest_target_ids)
+        add_dependencies(gentest_codegen_${_gentest_target_id} gentest_codegen_batch)
+    endforeach()
+    if(TARGET gentest_codegen_all)
+        add_dependencies(gentest_codegen_all gentest_codegen_batch)
+    endif()
+endfunction()
+
 function(_gentest_attach_tu_wrapper_sources)
     set(one_value_args TARGET TARGET_ID)
     set(multi_value_args REPLACED_TUS REPLACED_SOURCE_ENTRIES WRAPPER_CPP MODULE_NAMES EXTRA_CPP CODEGEN_OUTPUTS)
@@ -972,13 +1127,25 @@ function(gentest_attach_codegen target)
     endforeach()
 
     set(options STRICT_FIXTURE QUIET_CLANG MODULE_REGISTRATION)
-    set(one_value_args OUTPUT_DIR ENTRY FILE_SET MOCK_BACKEND MOCK_AGGREGATE_MODULE_NAME MOCK_AGGREGATE_MODULE_OUTPUT)
+    set(one_value_args
+        OUTPUT_DIR ENTRY FILE_SET MOCK_BACKEND MOCK_AGGREGATE_MODULE_NAME MOCK_AGGREGATE_MODULE_OUTPUT REGISTRATION_SHARDS)
     set(multi_value_args SOURCES CLANG_ARGS DEPENDS)
     cmake_parse_arguments(GENTEST "${options}" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
     if(NOT GENTEST_ENTRY)
         set(GENTEST_ENTRY gentest::run_all_tests)
     endif()
+    if(NOT DEFINED GENTEST_REGISTRATION_SHARDS)
+        set(GENTEST_REGISTRATION_SHARDS "${GENTEST_CODEGEN_REGISTRATION_SHARDS}")
+    endif()
+    if(NOT GENTEST_REGISTRATION_SHARDS MATCHES "^[1-9][0-9]*$")
+        message(FATAL_ERROR
+            "gentest_attach_codegen(${target}): REGISTRATION_SHARDS must be a positive integer (got '${GENTEST_REGISTRATION_SHARDS}')")
+    endif()
+    if(GENTEST_MODULE_REGISTRATION AND GENTEST_REGISTRATION_SHARDS GREATER 1)
+        message(FATAL_ERROR
+            "gentest_attach_codegen(${target}): REGISTRATION_SHARDS only applies to additive header-declaration registration.")
+    endif()
 
     _gentest_make_codegen_target_id("${target}" _gentest_target_id)
     set_property(TARGET ${target} PROPERTY GENTEST_CODEGEN_TARGET_ID "${_gentest_target_id}")
@@ -1250,6 +1417,7 @@ function(gentest_attach_codegen target)
     endif()
 
     set(_gentest_wrapper_cpp "")
+    set(_gentest_registration_shard_cpp "")
     set(_gentest_wrapper_headers "")
     set(_gentest_extra_cpp "")
     set(_gentest_artifact_manifest "")
@@ -1273,11 +1441,13 @@ function(gentest_attach_codegen target)
             TARGET ${target}
             TARGET_ID ${_gentest_target_id}
             OUTPUT_DIR "${GENTEST_OUTPUT_DIR}"
+            SHARDS ${GENTEST_REGISTRATION_SHARDS}
             TUS ${_gentest_textual_scan_sources}
             TU_SOURCE_ENTRIES ${_gentest_textual_scan_source_entries}
             OUT_OUTPUT_ROOT _gentest_output_root
             OUT_OUTPUT_DIR _gentest_output_dir
             OUT_REGISTRATION_CPP _gentest_wrapper_cpp
+            OUT_SHARD_CPP _gentest_registration_shard_cpp
             OUT_MANIFEST _gentest_artifact_manifest
             OUT_COMPILE_CONTEXT_IDS _gentest_compile_context_ids)
     else()
@@ -1372,6 +1542,12 @@ function(gentest_attach_codegen target)
         endforeach()
     endif()
     set(_gentest_depfile "${_gentest_output_dir}/${_gentest_target_id}.gentest.d")
+    # Test-bearing modes also declare the case inventory that
+    # gentest_discover_tests() consumes instead of running the binary.
+    set(_gentest_inventory "")
+    if(NOT _gentest_mode STREQUAL "module_mock_provider")
+        set(_gentest_inventory "${_gentest_output_dir}/${_gentest_target_id}.inventory.json")
+    endif()
     set(_gentest_mock_registration_manifest "")
     set(_gentest_mock_registration_manifest_depfile "")
     if(_gentest_mode STREQUAL "module_registration")
@@ -1495,6 +1671,9 @@ function(gentest_attach_codegen target)
         foreach(_gentest_registration_cpp IN LISTS _gentest_wrapper_cpp)
             list(APPEND _command --textual-registration-output ${_gentest_registration_cpp})
         endforeach()
+        foreach(_gentest_shard_cpp IN LISTS _gentest_registration_shard_cpp)
+            list(APPEND _command --textual-registration-shard-output ${_gentest_shard_cpp})
+        endforeach()
         foreach(_gentest_context_id IN LISTS _gentest_compile_context_ids)
             list(APPEND _command --compile-context-id "${_gentest_context_id}")
         endforeach()
@@ -1510,6 +1689,9 @@ function(gentest_attach_codegen target)
             list(APPEND _command --module-wrapper-output ${_gentest_wrap_cpp})
         endforeach()
     endif()
+    if(_gentest_inventory)
+        list(APPEND _command --inventory-output ${_gentest_inventory})
+    endif()
     foreach(_gentest_mock_registry_domain_output IN LISTS _gentest_mock_registry_domain_outputs)
         list(APPEND _command --mock-domain-registry-output ${_gentest_mock_registry_domain_output})
     endforeach()
@@ -1610,11 +1792,14 @@ function(gentest_attach_codegen target)
         set(_gentest_codegen_outputs
             ${_gentest_wrapper_headers}
             ${_gentest_wrapper_cpp}
-            ${_gentest_artifact_manifest})
+            ${_gentest_artifact_manifest}
+            ${_gentest_inventory})
     elseif(_gentest_mode STREQUAL "header_declaration")
         set(_gentest_codegen_outputs
             ${_gentest_wrapper_cpp}
+            ${_gentest_registration_shard_cpp}
             ${_gentest_artifact_manifest}
+            ${_gentest_inventory}
             ${_gentest_mock_registry}
             ${_gentest_mock_impl}
             ${_gentest_mock_registry_domain_outputs}
@@ -1637,33 +1822,64 @@ function(gentest_attach_codegen target)
     endif()
     set(_gentest_codegen_target_depends ${_gentest_all_codegen_outputs})
     set_property(TARGET ${target} PROPERTY GENTEST_CODEGEN_OUTPUTS "${_gentest_all_codegen_outputs}")
+    # A target may be attached more than once (e.g. per TU group); keep every
+    # inventory so discovery sees all of its cases.
+    if(_gentest_inventory)
+        get_property(_gentest_inventory_files TARGET ${target} PROPERTY GENTEST_INVENTORY_FILE)
+        if(NOT _gentest_inventory IN_LIST _gentest_inventory_files)
+            set_property(TARGET ${target} APPEND PROPERTY GENTEST_INVENTORY_FILE "${_gentest_inventory}")
+        endif()
+    endif()
     set_property(TARGET ${target} PROPERTY GENTEST_CODEGEN_EXTRA_DEPENDS "")
     set(_gentest_codegen_input_dependencies ${_gentest_tus})
     if(_gentest_mode STREQUAL "header_declaration")
         set(_gentest_codegen_input_dependencies ${_gentest_textual_scan_sources})
     endif()
-    set(_gentest_custom_command_args
-        OUTPUT ${_gentest_codegen_outputs}
-        COMMAND "${CMAKE_COMMAND}" -E make_directory "${_gentest_output_dir}"
-        COMMAND ${_command}
-        COMMAND_EXPAND_LISTS
-        DEPENDS
-            ${_gentest_codegen_deps}
-            ${_gentest_codegen_tool_depends}
-            ${_gentest_codegen_input_dependencies}
-            ${_gentest_mock_registration_manifest}
-            ${GENTEST_DEPENDS}
-            "$<$<BOOL:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>"
-        COMMENT "Running gentest_codegen for target ${target}"
-        VERBATIM)
-    if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles")
-        list(APPEND _gentest_custom_command_args DEPFILE ${_gentest_depfile})
+    # Additive targets can share one batched codegen process; the other modes
+    # depend on per-target inspect and precompile steps and keep their own.
+    set(_gentest_codegen_batched FALSE)
+    if(GENTEST_CODEGEN_BATCH AND _gentest_mode STREQUAL "header_declaration")
+        list(LENGTH _command_launcher _gentest_launcher_length)
+        list(SUBLIST _command ${_gentest_launcher_length} -1 _gentest_batch_args)
+        _gentest_register_batched_codegen(
+            TARGET ${target}
+            TARGET_ID ${_gentest_target_id}
+            OUTPUT_DIR "${_gentest_output_dir}"
+            LAUNCHER "${_command_launcher}"
+            ARGS ${_gentest_batch_args}
+            OUTPUTS ${_gentest_codegen_outputs}
+            DEPENDS
+                ${_gentest_codegen_deps}
+                ${_gentest_codegen_tool_depends}
+                ${_gentest_codegen_input_dependencies}
+                ${GENTEST_DEPENDS}
+                "$<$<BOOL:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>"
+            OUT_BATCHED _gentest_codegen_batched)
     endif()
-    if(POLICY CMP0171)
-        list(APPEND _gentest_custom_command_args CODEGEN)
+    if(NOT _gentest_codegen_batched)
+        set(_gentest_custom_command_args
+            OUTPUT ${_gentest_codegen_outputs}
+            COMMAND "${CMAKE_COMMAND}" -E make_directory "${_gentest_output_dir}"
+            COMMAND ${_command}
+            COMMAND_EXPAND_LISTS
+            DEPENDS
+                ${_gentest_codegen_deps}
+                ${_gentest_codegen_tool_depends}
+                ${_gentest_codegen_input_dependencies}
+                ${_gentest_mock_registration_manifest}
+                ${GENTEST_DEPENDS}
+                "$<$<BOOL:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>:$<TARGET_PROPERTY:${target},GENTEST_CODEGEN_EXTRA_DEPENDS>>"
+            COMMENT "Running gentest_codegen for target ${target}"
+            VERBATIM)
+        if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles")
+            list(APPEND _gentest_custom_command_args DEPFILE ${_gentest_depfile})
+        endif()
+        if(POLICY CMP0171)
+            list(APPEND _gentest_custom_command_args CODEGEN)
+        endif()
+        add_custom_command(${_gentest_custom_command_args})
+        unset(_gentest_custom_command_args)
     endif()
-    add_custom_command(${_gentest_custom_command_args})
-    unset(_gentest_custom_command_args)
 
     if(_gentest_mode STREQUAL "module_registration")
         set(_gentest_manifest_validation_stamp "${_gentest_output_dir}/${_gentest_target_id}.artifact_manifest.validated")
@@ -1720,6 +1936,7 @@ function(gentest_attach_codegen target)
             COMPILE_CONTEXT_IDS ${_gentest_compile_context_ids}
             SCAN_SLOT_KINDS ${_gentest_textual_scan_slot_kinds}
             SOURCE_REGISTRATION_OUTPUTS ${_gentest_wrapper_cpp}
+            REGISTRATION_SHARD_OUTPUTS ${_gentest_registration_shard_cpp}
             OUT_ARGS _gentest_manifest_validation_args)
         _gentest_add_artifact_manifest_validation_command(
             STAMP "${_gentest_manifest_validation_stamp}"
@@ -1744,7 +1961,7 @@ function(gentest_attach_codegen target)
         _gentest_attach_header_declaration_registration_sources(
             TARGET ${target}
             TARGET_ID ${_gentest_target_id}
-            REGISTRATION_CPP ${_gentest_wrapper_cpp}
+            REGISTRATION_CPP ${_gentest_wrapper_cpp} ${_gentest_registration_shard_cpp}
             CODEGEN_OUTPUTS ${_gentest_codegen_target_depends})
     else()
         _gentest_attach_tu_wrapper_sources(
@@ -9,9 +9,12 @@
 #include <concepts>
 #include <condition_variable>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -31,6 +34,33 @@ template <typename T = void> class async_test;
 
 namespace detail {
 
+class AsyncWaiterToken;
+
+// Storage for coroutine frames, AsyncFrame records and promise/future shared
+// state. While the runner creates or resumes an async case these come from that
+// case's size-class pool, which is freed in one piece once the case's frames
+// are gone; elsewhere they fall back to operator new.
+GENTEST_RUNTIME_API auto async_pool_allocate(std::size_t size) -> void *;
+GENTEST_RUNTIME_API void async_pool_deallocate(void *ptr) noexcept;
+
+template <typename T> struct AsyncPoolAllocator {
+    using value_type = T;
+
+    AsyncPoolAllocator() noexcept = default;
+    template <typename U> AsyncPoolAllocator(const AsyncPoolAllocator<U> &) noexcept {}
+
+    [[nodiscard]] auto allocate(std::size_t n) -> T * { return static_cast<T *>(async_pool_allocate(n * sizeof(T))); }
+    void               deallocate(T *ptr, std::size_t) noexcept { async_pool_deallocate(ptr); }
+
+    template <typename U> friend constexpr auto operator==(const AsyncPoolAllocator &, const AsyncPoolAllocator<U> &) noexcept -> bool {
+        return true;
+    }
+};
+
+template <typename T, typename... Args> [[nodiscard]] auto make_pooled_shared(Args &&...args) -> std::shared_ptr<T> {
+    return std::allocate_shared<T>(AsyncPoolAllocator<T>{}, std::forward<Args>(args)...);
+}
+
 struct AsyncFrame {
     explicit AsyncFrame(std::coroutine_handle<> coroutine) noexcept : handle(coroutine) {}
 
@@ -54,19 +84,93 @@ struct AsyncFrame {
     void               cancel() noexcept { canceled.store(true, std::memory_order_release); }
     [[nodiscard]] auto is_canceled() const noexcept -> bool { return canceled.load(std::memory_order_acquire); }
 
+    // Bookkeeping owned by the scheduler that registered the frame and only
+    // touched under the lock of the scheduler shard `shard` names (opaque to
+    // everything but that scheduler). The scheduler reaches it from a
+    // coroutine handle through the allocation header of the coroutine frame
+    // (see async_pool_allocate), so post/block/make_waiter update the frame
+    // directly instead of keying side tables by coroutine address. `waiters`
+    // heads an intrusive list of the tokens made for this frame.
+    struct SchedulerLinks {
+        static constexpr std::size_t kNoOwner = std::numeric_limits<std::size_t>::max();
+
+        struct Child {
+            AsyncFrame *frame             = nullptr;
+            std::size_t parent_link_index = 0;
+        };
+
+        struct Parent {
+            AsyncFrame *frame       = nullptr;
+            std::size_t child_index = 0;
+        };
+
+        std::size_t         owner      = kNoOwner;
+        std::size_t         owner_slot = 0;
+        std::atomic<void *> shard{nullptr};
+        std::vector<Child>  children;
+        std::vector<Parent> parents;
+        AsyncWaiterToken   *waiters            = nullptr;
+        std::size_t         waiter_count       = 0;
+        std::size_t         waiters_compact_at = 0;
+        bool                blocked            = false;
+        std::uint8_t        blocked_kind       = 0;
+        std::uint64_t       blocked_sequence   = 0;
+        std::string         blocked_reason;
+        std::string         blocked_file;
+        unsigned            blocked_line = 0;
+    };
+
     std::coroutine_handle<> handle{};
     std::atomic_bool        canceled{false};
     std::atomic_bool        waiter_claimed{false};
+    SchedulerLinks          links;
 };
 
 using AsyncFramePtr = std::shared_ptr<AsyncFrame>;
 
+// Virtual time source for async timers. It never follows steady_clock; the
+// scheduler moves it forward to the next pending timer deadline once no frame
+// is ready, so sleeps and timeouts complete without waiting.
+class AsyncClock {
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    explicit AsyncClock(time_point start) noexcept : ticks_(start.time_since_epoch().count()) {}
+
+    [[nodiscard]] auto now() const noexcept -> time_point {
+        return time_point{std::chrono::steady_clock::duration{ticks_.load(std::memory_order_acquire)}};
+    }
+
+    void advance_to(time_point deadline) noexcept {
+        const auto target  = deadline.time_since_epoch().count();
+        auto       current = ticks_.load(std::memory_order_relaxed);
+        while (current < target && !ticks_.compare_exchange_weak(current, target, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+    }
+
+  private:
+    std::atomic<std::chrono::steady_clock::rep> ticks_;
+};
+
+using AsyncClockPtr = std::shared_ptr<AsyncClock>;
+
+enum class AsyncIoInterest : std::uint8_t {
+    Readable,
+    Writable,
+};
+
+// A null clock means real time.
+[[nodiscard]] inline auto async_clock_now(const AsyncClock *clock) noexcept -> std::chrono::steady_clock::time_point {
+    return clock ? clock->now() : std::chrono::steady_clock::now();
+}
+
 class AsyncScheduler {
   public:
     class Control {
       public:
         void post(std::coroutine_handle<> handle) const;
         void post(const AsyncFramePtr &frame) const;
+        void post_waiter(AsyncWaiterToken &token) const;
         void cancel_waiters(std::coroutine_handle<> handle) const noexcept;
 
       private:
@@ -76,32 +180,16 @@ class AsyncScheduler {
         AsyncScheduler    *scheduler_ = nullptr;
     };
 
-    class WaiterToken {
-      public:
-        using BeforePost = std::function<bool()>;
-
-        WaiterToken(std::weak_ptr<Control> control, std::weak_ptr<AsyncFrame> frame)
-            : control_(std::move(control)), frame_(std::move(frame)) {}
-
-        void               post();
-        void               cancel() noexcept;
-        void               set_before_post(BeforePost before_post);
-        [[nodiscard]] auto active() const noexcept -> bool;
-
-      private:
-        mutable std::mutex        mtx_;
-        std::weak_ptr<Control>    control_;
-        std::weak_ptr<AsyncFrame> frame_;
-        BeforePost                before_post_;
-        std::atomic_bool          active_{true};
-    };
-
+    using WaiterToken = AsyncWaiterToken;
     using WaiterTokenPtr = std::shared_ptr<WaiterToken>;
 
     AsyncScheduler() : control_(std::make_shared<Control>()) { control_->scheduler_ = this; }
     virtual ~AsyncScheduler() { deactivate(); }
 
+    // Handles passed to these hooks belong to gentest::async_test coroutines.
     virtual void post(std::coroutine_handle<> handle) = 0;
+    // Resumes the frame a token from make_waiter() was made for.
+    virtual void post_waiter(AsyncWaiterToken &token) { (void)token; }
     virtual void post_frame(const AsyncFramePtr &frame) {
         if (frame && frame->handle) {
             post(frame->handle);
@@ -121,24 +209,20 @@ class AsyncScheduler {
 
     virtual void yield_at(std::coroutine_handle<> handle, const std::source_location &) { post(handle); }
 
-    virtual void schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) {
-        if (deadline <= std::chrono::steady_clock::now() && token) {
-            token->post();
-            return;
-        }
-        std::abort();
-    }
+    virtual void schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token);
+
+    // Posts `token` once `fd` is ready for `interest`.
+    virtual void watch_fd(int fd, AsyncIoInterest interest, const WaiterTokenPtr &token);
 
     virtual void cancel_waiters(std::coroutine_handle<> handle) noexcept { (void)handle; }
 
+    // Clock for timers scheduled by the coroutine currently running on this
+    // thread; null selects steady_clock.
+    [[nodiscard]] virtual auto clock() const -> AsyncClockPtr { return {}; }
+
     [[nodiscard]] auto control() const noexcept -> std::shared_ptr<Control> { return control_; }
 
-    [[nodiscard]] virtual auto make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr {
-        (void)handle;
-        auto token = std::make_shared<WaiterToken>(control_, std::weak_ptr<AsyncFrame>{});
-        token->cancel();
-        return token;
-    }
+    [[nodiscard]] virtual auto make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr;
 
   protected:
     void deactivate() noexcept {
@@ -153,6 +237,72 @@ class AsyncScheduler {
     std::shared_ptr<Control> control_;
 };
 
+class AsyncWaiterToken {
+  public:
+    using BeforePost = std::function<bool()>;
+
+    // Entry of a timer queue that removes pending timers eagerly. It is
+    // unlinked once when the token posts or is canceled.
+    struct TimerLink {
+        TimerLink()                             = default;
+        TimerLink(const TimerLink &)            = delete;
+        TimerLink &operator=(const TimerLink &) = delete;
+        virtual ~TimerLink()                    = default;
+        virtual void unlink() noexcept          = 0;
+    };
+
+    // Entry in the intrusive waiter list of the frame the token resumes. Only
+    // the scheduler that made the token touches it, under the lock of the
+    // shard `shard` names, which follows the frame; `self` keeps a listed
+    // token alive until the scheduler unlists it.
+    struct FrameHook {
+        AsyncWaiterToken                 *prev  = nullptr;
+        AsyncWaiterToken                 *next  = nullptr;
+        AsyncFrame                       *frame = nullptr;
+        std::shared_ptr<AsyncWaiterToken> self;
+        std::atomic<void *>               shard{nullptr};
+    };
+
+    explicit AsyncWaiterToken(std::weak_ptr<AsyncScheduler::Control> control) : control_(std::move(control)) {}
+
+    void               post();
+    void               cancel() noexcept;
+    void               set_before_post(BeforePost before_post);
+    void               set_timer_link(std::shared_ptr<TimerLink> link);
+    [[nodiscard]] auto active() const noexcept -> bool;
+
+    FrameHook frame_hook;
+
+  private:
+    mutable std::mutex                     mtx_;
+    std::weak_ptr<AsyncScheduler::Control> control_;
+    BeforePost                             before_post_;
+    std::shared_ptr<TimerLink>             timer_link_;
+    std::atomic_bool                       active_{true};
+};
+
+inline auto AsyncScheduler::make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr {
+    (void)handle;
+    auto token = std::make_shared<WaiterToken>(control_);
+    token->cancel();
+    return token;
+}
+
+inline void AsyncScheduler::schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) {
+    if (deadline <= async_clock_now(clock().get()) && token) {
+        token->post();
+        return;
+    }
+    std::abort();
+}
+
+inline void AsyncScheduler::watch_fd(int fd, AsyncIoInterest interest, const WaiterTokenPtr &token) {
+    (void)fd;
+    (void)interest;
+    (void)token;
+    std::abort();
+}
+
 inline void AsyncScheduler::Control::post(std::coroutine_handle<> handle) const {
     std::lock_guard<std::mutex> lk(mtx_);
     if (scheduler_) {
@@ -167,6 +317,13 @@ inline void AsyncScheduler::Control::post(const AsyncFramePtr &frame) const {
     }
 }
 
+inline void AsyncScheduler::Control::post_waiter(AsyncWaiterToken &token) const {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (scheduler_) {
+        scheduler_->post_waiter(token);
+    }
+}
+
 inline void AsyncScheduler::Control::cancel_waiters(std::coroutine_handle<> handle) const noexcept {
     std::lock_guard<std::mutex> lk(mtx_);
     if (scheduler_) {
@@ -174,40 +331,48 @@ inline void AsyncScheduler::Control::cancel_waiters(std::coroutine_handle<> hand
     }
 }
 
-inline void AsyncScheduler::WaiterToken::post() {
+inline void AsyncWaiterToken::post() {
     if (!active_.exchange(false, std::memory_order_acq_rel)) {
         return;
     }
-    std::shared_ptr<Control> control;
-    AsyncFramePtr            frame;
-    BeforePost               before_post;
+    std::shared_ptr<AsyncScheduler::Control> control;
+    BeforePost                               before_post;
+    std::shared_ptr<TimerLink>               timer_link;
     {
         std::lock_guard<std::mutex> lk(mtx_);
         control = control_.lock();
-        frame   = frame_.lock();
-        frame_.reset();
         control_.reset();
         before_post = std::move(before_post_);
+        timer_link  = std::move(timer_link_);
+    }
+    if (timer_link) {
+        timer_link->unlink();
     }
     if (before_post && !before_post()) {
         return;
     }
-    if (control && frame && !frame->is_canceled()) {
-        control->post(frame);
+    if (control) {
+        control->post_waiter(*this);
     }
 }
 
-inline void AsyncScheduler::WaiterToken::cancel() noexcept {
+inline void AsyncWaiterToken::cancel() noexcept {
     if (!active_.exchange(false, std::memory_order_acq_rel)) {
         return;
     }
-    std::lock_guard<std::mutex> lk(mtx_);
-    before_post_ = {};
-    frame_.reset();
-    control_.reset();
+    std::shared_ptr<TimerLink> timer_link;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        before_post_ = {};
+        control_.reset();
+        timer_link = std::move(timer_link_);
+    }
+    if (timer_link) {
+        timer_link->unlink();
+    }
 }
 
-inline void AsyncScheduler::WaiterToken::set_before_post(BeforePost before_post) {
+inline void AsyncWaiterToken::set_before_post(BeforePost before_post) {
     if (!active_.load(std::memory_order_acquire)) {
         return;
     }
@@ -217,7 +382,17 @@ inline void AsyncScheduler::WaiterToken::set_before_post(BeforePost before_post)
     }
 }
 
-inline auto AsyncScheduler::WaiterToken::active() const noexcept -> bool { return active_.load(std::memory_order_acquire); }
+inline void AsyncWaiterToken::set_timer_link(std::shared_ptr<TimerLink> link) {
+    if (!active_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (active_.load(std::memory_order_acquire)) {
+        timer_link_ = std::move(link);
+    }
+}
+
+inline auto AsyncWaiterToken::active() const noexcept -> bool { return active_.load(std::memory_order_acquire); }
 
 GENTEST_RUNTIME_API auto current_async_scheduler() noexcept -> AsyncScheduler *;
 GENTEST_RUNTIME_API auto set_current_async_scheduler(AsyncScheduler *scheduler) noexcept -> AsyncScheduler *;
@@ -266,6 +441,14 @@ template <typename T> class promise;
 
 enum class wait_status { ready, timeout };
 
+// Current time as seen by async timers: the virtual clock for `virtual_time`
+// cases (or under --async-virtual-time), steady_clock otherwise. Compute
+// deadlines passed to sleep_until/wait_until from this value.
+[[nodiscard]] inline auto now() -> std::chrono::steady_clock::time_point {
+    auto *scheduler = detail::current_async_scheduler();
+    return scheduler ? detail::async_clock_now(scheduler->clock().get()) : std::chrono::steady_clock::now();
+}
+
 namespace wait_result_detail {
 
 [[noreturn]] inline void wait_result_timeout_value() {
@@ -399,7 +582,7 @@ class sleep_awaitable {
 
     sleep_awaitable(std::chrono::steady_clock::time_point deadline, std::source_location loc) : deadline_(deadline), loc_(loc) {}
 
-    [[nodiscard]] auto await_ready() const noexcept -> bool { return std::chrono::steady_clock::now() >= deadline_; }
+    [[nodiscard]] auto await_ready() const -> bool { return now() >= deadline_; }
 
     void await_suspend(std::coroutine_handle<> handle) {
         auto *scheduler = detail::current_async_scheduler();
@@ -412,7 +595,7 @@ class sleep_awaitable {
     void await_suspend_with_token(std::coroutine_handle<> handle, detail::AsyncScheduler &scheduler,
                                   const detail::AsyncScheduler::WaiterTokenPtr &token) {
         token_ = token;
-        if (std::chrono::steady_clock::now() >= deadline_) {
+        if (now() >= deadline_) {
             if (token_) {
                 token_->post();
             }
@@ -439,8 +622,7 @@ class sleep_awaitable {
 template <typename Rep, typename Period>
 [[nodiscard]] inline auto sleep_for(std::chrono::duration<Rep, Period> duration,
                                     const std::source_location        &loc = std::source_location::current()) -> sleep_awaitable {
-    return sleep_awaitable{std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration),
-                           loc};
+    return sleep_awaitable{now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration), loc};
 }
 
 template <typename Duration>
@@ -449,6 +631,62 @@ template <typename Duration>
     return sleep_awaitable{std::chrono::time_point_cast<std::chrono::steady_clock::duration>(deadline), loc};
 }
 
+// Suspends until a file descriptor (POSIX: socket, pipe, eventfd, ...) is
+// readable or writable, without blocking the runner thread. Hang-up and error
+// conditions also resume the waiter so the following read/write can report
+// them. Level triggered: an fd that is already ready resumes on the next poll.
+// Supported on Linux (epoll) and other POSIX systems (poll). On Windows, or
+// when the scheduler cannot open its poller, the co_await throws
+// std::system_error.
+class fd_awaitable {
+  public:
+    using gentest_async_wait_supported = void;
+
+    fd_awaitable(int fd, detail::AsyncIoInterest interest, std::source_location loc) : fd_(fd), interest_(interest), loc_(loc) {}
+
+    [[nodiscard]] constexpr auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto *scheduler = detail::current_async_scheduler();
+        if (!scheduler) {
+            std::abort();
+        }
+        await_suspend_with_token(handle, *scheduler, scheduler->make_waiter(handle));
+    }
+
+    void await_suspend_with_token(std::coroutine_handle<> handle, detail::AsyncScheduler &scheduler,
+                                  const detail::AsyncScheduler::WaiterTokenPtr &token) {
+        token_ = token;
+        scheduler.watch_fd(fd_, interest_, token_);
+        scheduler.block_at(handle,
+                           "async fd " + std::to_string(fd_) +
+                               (interest_ == detail::AsyncIoInterest::Readable ? " is not readable" : " is not writable"),
+                           loc_);
+    }
+
+    constexpr void await_resume() const noexcept {}
+
+    ~fd_awaitable() {
+        if (token_) {
+            token_->cancel();
+        }
+    }
+
+  private:
+    int                                    fd_;
+    detail::AsyncIoInterest                interest_;
+    std::source_location                   loc_;
+    detail::AsyncScheduler::WaiterTokenPtr token_;
+};
+
+[[nodiscard]] inline auto readable(int fd, const std::source_location &loc = std::source_location::current()) -> fd_awaitable {
+    return fd_awaitable{fd, detail::AsyncIoInterest::Readable, loc};
+}
+
+[[nodiscard]] inline auto writable(int fd, const std::source_location &loc = std::source_location::current()) -> fd_awaitable {
+    return fd_awaitable{fd, detail::AsyncIoInterest::Writable, loc};
+}
+
 template <typename T = std::any> class event {
     struct Slot;
 
@@ -739,12 +977,15 @@ template <typename T> class async_test final : public detail::AsyncTask {
         [[nodiscard]] constexpr auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
         [[nodiscard]] constexpr auto final_suspend() const noexcept -> detail::final_resume_awaiter { return {}; }
 
+        static auto operator new(std::size_t size) -> void * { return detail::async_pool_allocate(size); }
+        static void operator delete(void *ptr) noexcept { detail::async_pool_deallocate(ptr); }
+
         template <typename U> void return_value(U &&v) { value.emplace(std::forward<U>(v)); }
         void                       unhandled_exception() noexcept { exception = std::current_exception(); }
     };
 
     async_test() = default;
-    explicit async_test(std::coroutine_handle<promise_type> handle) : frame_(std::make_shared<detail::AsyncFrame>(handle)) {}
+    explicit async_test(std::coroutine_handle<promise_type> handle) : frame_(detail::make_pooled_shared<detail::AsyncFrame>(handle)) {}
     async_test(async_test &&other) noexcept : frame_(std::move(other.frame_)) {}
     auto operator=(async_test &&other) noexcept -> async_test & {
         if (this != &other) {
@@ -868,12 +1109,15 @@ template <> class async_test<void> final : public detail::AsyncTask {
         [[nodiscard]] constexpr auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
         [[nodiscard]] constexpr auto final_suspend() const noexcept -> detail::final_resume_awaiter { return {}; }
 
+        static auto operator new(std::size_t size) -> void * { return detail::async_pool_allocate(size); }
+        static void operator delete(void *ptr) noexcept { detail::async_pool_deallocate(ptr); }
+
         constexpr void return_void() const noexcept {}
         void           unhandled_exception() noexcept { exception = std::current_exception(); }
     };
 
     async_test() = default;
-    explicit async_test(std::coroutine_handle<promise_type> handle) : frame_(std::make_shared<detail::AsyncFrame>(handle)) {}
+    explicit async_test(std::coroutine_handle<promise_type> handle) : frame_(detail::make_pooled_shared<detail::AsyncFrame>(handle)) {}
     async_test(async_test &&other) noexcept : frame_(std::move(other.frame_)) {}
     auto operator=(async_test &&other) noexcept -> async_test & {
         if (this != &other) {
@@ -1050,7 +1294,7 @@ template <SupportedTimedAwaitable Awaitable> class timeout_awaitable {
             (void)state_->try_ready();
             return true;
         }
-        if (std::chrono::steady_clock::now() >= deadline_) {
+        if (now() >= deadline_) {
             (void)state_->try_timeout();
             return true;
         }
@@ -1063,7 +1307,7 @@ template <SupportedTimedAwaitable Awaitable> class timeout_awaitable {
             std::abort();
         }
         control_ = scheduler->control();
-        if (std::chrono::steady_clock::now() >= deadline_) {
+        if (now() >= deadline_) {
             (void)state_->try_timeout();
             scheduler->post(handle);
             return;
@@ -1080,8 +1324,9 @@ template <SupportedTimedAwaitable Awaitable> class timeout_awaitable {
         auto state         = state_;
         auto timeout_token = timeout_token_;
         auto deadline      = deadline_;
-        ready_token_->set_before_post([state, timeout_token, deadline] {
-            if (std::chrono::steady_clock::now() >= deadline) {
+        auto clock         = scheduler->clock();
+        ready_token_->set_before_post([state, timeout_token, deadline, clock] {
+            if (gentest::detail::async_clock_now(clock.get()) >= deadline) {
                 if (!state->try_timeout()) {
                     return false;
                 }
@@ -1177,8 +1422,8 @@ template <typename Awaitable, typename Rep, typename Period>
     requires timeout_detail::SupportedTimedAwaitable<std::remove_cvref_t<Awaitable>>
 [[nodiscard]] auto wait_for(Awaitable &&awaitable, std::chrono::duration<Rep, Period> duration,
                             const std::source_location &loc = std::source_location::current()) {
-    return wait_until(std::forward<Awaitable>(awaitable),
-                      std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration), loc);
+    return wait_until(std::forward<Awaitable>(awaitable), now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration),
+                      loc);
 }
 
 template <typename Awaitable, typename Rep, typename Period>
@@ -1200,6 +1445,11 @@ template <typename T> [[nodiscard]] inline auto make_async_task(async_test<T> ta
 
 GENTEST_RUNTIME_API auto run_async_task_blocking(async_test<void> task, std::string_view label, std::string &error_out) -> bool;
 
+// Makes later run_async_task_blocking() calls run their timers on a virtual
+// clock private to each call (the runner sets it for --async-virtual-time).
+// Returns the previous setting.
+GENTEST_RUNTIME_API auto set_blocking_async_virtual_time(bool enabled) noexcept -> bool;
+
 } // namespace detail
 
 struct AsyncFixtureSetup {
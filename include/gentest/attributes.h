@@ -13,7 +13,8 @@
 //   void my_benchmark();
 //   - Run via --run= / --filter= (optionally --kind=bench), list via --list-benches.
 //   - Optional flags: --bench-table, --report-format, --bench-min-epoch-time-s, --bench-epochs, --bench-warmup, --bench-max-total-time-s
-//   - Jitter runs via --run= / --filter= with --kind=jitter; use --jitter-bins to control histogram bins.
+//   - Jitter runs via --run= / --filter= with --kind=jitter; use --jitter-bins to control histogram bins
+//     and --jitter-clock=steady|tsc to pick the sample clock.
 //
 // Fixture composition for test/bench/jitter function parameters:
 //   [[using gentest : test("suite/free")]]
@@ -37,6 +38,12 @@
 // - `baseline` is only valid for `bench`/`jitter` cases.
 // - `items_per_call(N)` / `ops_per_call(N)` declare logical measured items per bench/jitter function call.
 //   `N` must be a positive non-zero decimal integer with no prefix, suffix, separator, or leading zero.
+// - `complexity(n)` names the bench parameter axis that is the input size; the
+//   report fits O(1)..O(n^3) to the per-item medians of each size series.
+// - `cache(warm|cold)` selects the bench cache state; `cache(warm, cold)` runs
+//   both and reports the cold/warm ratio. Cold epochs evict the LLC untimed.
+// - `virtual_time` runs an async test's sleeps and timeouts on a virtual clock
+//   that jumps to the next deadline; read it with gentest::async::now().
 // Additional attribute names (e.g. `slow`, `linux`) are collected as tags,
 // while attributes such as `req("BUG-123")` or `skip("reason")` attach
 // requirements or skipping instructions. All information is extracted by the
@@ -56,6 +63,8 @@
 //   [[using gentest : jitter("suite/name")]]
 //   [[using gentest : baseline]] // optional: marks a bench as baseline within the suite
 //   [[using gentest : items_per_call(1024)]] // optional: report ns/item in addition to call counts
+//   [[using gentest : geom(n, 8, 4, 5), complexity(n)]] // optional: fit time against input size n
+//   [[using gentest : cache(warm, cold)]] // optional: also measure with a cold last-level cache
 //
 // Parameter generators (global convenience):
 //   [[using gentest : range(i, 1, 2, 9)]]                 // 1,3,5,7,9 (integers)
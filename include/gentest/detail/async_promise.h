@@ -403,7 +403,7 @@ template <typename T> class future {
 
         awaitable(std::shared_ptr<detail::AsyncPromiseSharedState<T>> state, std::string reason, std::source_location loc)
             : state_(std::move(state)), reason_(std::move(reason)), loc_(loc),
-              wait_state_(std::make_shared<detail::AsyncPromiseWaitState>()) {}
+              wait_state_(detail::make_pooled_shared<detail::AsyncPromiseWaitState>()) {}
 
         awaitable(awaitable &&other) noexcept
             : state_(std::move(other.state_)), reason_(std::move(other.reason_)), loc_(other.loc_),
@@ -488,7 +488,7 @@ template <typename T> class promise {
   public:
     using value_type = T;
 
-    promise() : state_(std::make_shared<detail::AsyncPromiseSharedState<T>>()) {}
+    promise() : state_(detail::make_pooled_shared<detail::AsyncPromiseSharedState<T>>()) {}
 
     promise(promise &&other) noexcept : state_(std::exchange(other.state_, {})) {}
 
@@ -595,7 +595,7 @@ template <> class future<void> {
 
         awaitable(std::shared_ptr<detail::AsyncPromiseSharedState<void>> state, std::string reason, std::source_location loc)
             : state_(std::move(state)), reason_(std::move(reason)), loc_(loc),
-              wait_state_(std::make_shared<detail::AsyncPromiseWaitState>()) {}
+              wait_state_(detail::make_pooled_shared<detail::AsyncPromiseWaitState>()) {}
 
         awaitable(awaitable &&other) noexcept
             : state_(std::move(other.state_)), reason_(std::move(other.reason_)), loc_(other.loc_),
@@ -680,7 +680,7 @@ template <> class promise<void> {
   public:
     using value_type = void;
 
-    promise() : state_(std::make_shared<detail::AsyncPromiseSharedState<void>>()) {}
+    promise() : state_(detail::make_pooled_shared<detail::AsyncPromiseSharedState<void>>()) {}
 
     promise(promise &&other) noexcept : state_(std::exchange(other.state_, {})) {}
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <span>
+#include <string_view>
 #include <vector>
 
 namespace gentest::detail {
@@ -33,4 +35,61 @@ struct Histogram {
 SampleStats compute_sample_stats(std::span<const double> samples);
 Histogram   compute_histogram(std::span<const double> samples, int bins);
 
+// HDR-style log-linear sample accumulator. Memory is bounded by the value
+// range rather than the sample count, and every recorded value lands in a
+// bucket whose width is within 10^-significant_digits of the value. Values are
+// quantized to picoseconds; min/max/mean/stddev are tracked exactly.
+class LogLinearHistogram {
+  public:
+    LogLinearHistogram() : LogLinearHistogram(3) {}
+    explicit LogLinearHistogram(int significant_digits);
+
+    void record(double value_ns);
+
+    [[nodiscard]] std::size_t count() const { return count_; }
+    [[nodiscard]] int         significant_digits() const { return significant_digits_; }
+    [[nodiscard]] std::size_t bucket_count() const { return counts_.size(); }
+
+    // Nearest-rank percentile, p in [0, 1]; returns the bucket midpoint clamped to [min, max].
+    [[nodiscard]] double      percentile(double p) const;
+    [[nodiscard]] SampleStats stats() const;
+    [[nodiscard]] Histogram   histogram(int bins) const;
+
+  private:
+    [[nodiscard]] std::size_t index_for(std::uint64_t units) const;
+    [[nodiscard]] double      midpoint_ns(std::size_t index) const;
+
+    int                        significant_digits_        = 3;
+    int                        sub_bucket_half_magnitude_ = 0;
+    std::uint64_t              sub_bucket_mask_           = 0;
+    std::vector<std::uint64_t> counts_;
+    std::size_t                count_ = 0;
+    double                     min_   = 0.0;
+    double                     max_   = 0.0;
+    double                     mean_  = 0.0;
+    double                     m2_    = 0.0;
+};
+
+enum class ComplexityClass {
+    Constant,
+    Logarithmic,
+    Linear,
+    Linearithmic,
+    Quadratic,
+    Cubic,
+};
+
+struct ComplexityFit {
+    ComplexityClass best_fit    = ComplexityClass::Constant;
+    double          coefficient = 0.0; // time ~= coefficient * f(n)
+    double          rms_pct     = 0.0; // RMS residual relative to mean time
+    std::size_t     points      = 0;
+};
+
+// Least-squares fit of `times` against each complexity class over input sizes
+// `sizes` (n >= 1); picks the class with the lowest RMS residual. Needs at
+// least two distinct sizes, otherwise returns an O(1) fit with `points` set.
+ComplexityFit    fit_complexity(std::span<const double> sizes, std::span<const double> times);
+std::string_view complexity_class_name(ComplexityClass cls);
+
 } // namespace gentest::detail
@@ -10,9 +10,11 @@
 // These stay as macros because generated registration code checks them with
 // preprocessor conditionals before using newer Case fields.
 // NOLINTBEGIN(modernize-macro-to-enum)
-#define GENTEST_CASE_API_VERSION            3
+#define GENTEST_CASE_API_VERSION            5
 #define GENTEST_CASE_API_HAS_ITEMS_PER_CALL 1
 #define GENTEST_CASE_API_HAS_OWNER          1
+#define GENTEST_CASE_API_HAS_COMPLEXITY     1
+#define GENTEST_CASE_API_HAS_BENCH_CACHE    1
 // NOLINTEND(modernize-macro-to-enum)
 
 namespace gentest {
@@ -27,6 +29,15 @@ enum class FixtureLifetime {
     MemberGlobal,
 };
 
+// Cache state requested by a bench's `cache(...)` attribute. `Default` defers
+// to --bench-cache-mode (warm unless overridden).
+enum class BenchCache : std::uint8_t {
+    Default,
+    Warm,
+    Cold,
+    Both,
+};
+
 // Keep the public aggregate field order stable for generated/manual designated
 // initializers; the padding check is not worth the churn across that surface.
 // NOLINTNEXTLINE(clang-analyzer-optin.performance.Padding)
@@ -49,6 +60,9 @@ struct Case {
     bool                              is_async{false};
     std::uint64_t                     items_per_call{1};
     std::string_view                  owner{};
+    double                            complexity_n{0.0};
+    std::string_view                  complexity_series{}; // non-empty for complexity(n) benches
+    BenchCache                        bench_cache{BenchCache::Default};
 };
 
 } // namespace gentest
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "gentest/detail/runtime_config.h"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace gentest::detail::mocking {
+
+// One recorded mock call. `args` holds one length-prefixed chunk per argument;
+// `result` holds the encoded return value (empty for void).
+struct MockTraceRecord {
+    std::string_view method;
+    std::string_view args;
+    std::string_view result;
+};
+
+// A loaded trace. Records point into the mapped file, which stays mapped for
+// the lifetime of the trace.
+struct MockTrace;
+
+// Maps the trace at `path`. Returns nullptr and sets `error` when the file
+// cannot be read or is not a mock trace.
+GENTEST_RUNTIME_API std::shared_ptr<const MockTrace> open_mock_trace(const std::string &path, std::string &error);
+GENTEST_RUNTIME_API std::span<const MockTraceRecord> mock_trace_records(const MockTrace &trace);
+
+// Writes `records` as a trace; method names are stored once in a table.
+// Returns an empty string on success, otherwise the error.
+GENTEST_RUNTIME_API std::string write_mock_trace(const std::string &path, std::span<const MockTraceRecord> records);
+
+} // namespace gentest::detail::mocking
@@ -7,10 +7,53 @@
 
 #include <span>
 
+// Generated TUs place a pointer range over their `kCases` array in the
+// `gentest_case_runs` linker section instead of registering from a static
+// initializer. ELF linkers provide `__start_`/`__stop_` bounds for the section;
+// other targets keep calling `register_cases`. Define
+// GENTEST_NO_CASE_TABLE_SECTION to force the static-initializer path.
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__)) && !defined(GENTEST_NO_CASE_TABLE_SECTION)
+#define GENTEST_CASE_TABLE_SECTION 1
+#define GENTEST_CASE_TABLE_ENTRY   __attribute__((used, section("gentest_case_runs")))
+#endif
+
 namespace gentest::detail {
 
 // Called by generated sources to register discovered cases. Not intended for
 // direct use in normal test code.
 GENTEST_RUNTIME_API void register_cases(std::span<const Case> cases);
 
+// One generated TU's cases, already sorted by (name, file, line).
+struct CaseTableRun {
+    const Case *begin;
+    const Case *end;
+};
+
+// The `gentest_case_runs` section of one linked module (the executable or a
+// shared library). Modules are pushed onto a lock-free list; the runtime
+// merges their sorted runs on the first snapshot instead of re-sorting.
+struct CaseTableModule {
+    const CaseTableRun *begin;
+    const CaseTableRun *end;
+    CaseTableModule    *next;
+};
+
+GENTEST_RUNTIME_API void register_case_table(CaseTableModule &module);
+
+} // namespace gentest::detail
+
+#if defined(GENTEST_CASE_TABLE_SECTION)
+// Hidden visibility keeps the bounds and the registration below per module, so
+// each executable or shared library contributes its own section exactly once.
+extern "C" {
+extern const gentest::detail::CaseTableRun __start_gentest_case_runs[] __attribute__((weak, visibility("hidden")));
+extern const gentest::detail::CaseTableRun __stop_gentest_case_runs[] __attribute__((weak, visibility("hidden")));
+}
+
+namespace gentest::detail {
+__attribute__((visibility("hidden"))) inline CaseTableModule case_table_module{__start_gentest_case_runs, __stop_gentest_case_runs,
+                                                                               nullptr};
+__attribute__((visibility("hidden"))) inline const bool case_table_module_registered =
+    (register_case_table(case_table_module), true);
 } // namespace gentest::detail
+#endif
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <stop_token>
@@ -19,7 +20,7 @@
 
 namespace gentest::detail {
 
-using TestLogObserverFn        = void (*)(void *, std::size_t, const std::vector<std::string> &, std::size_t) noexcept;
+using TestLogObserverFn        = void (*)(void *, std::size_t, std::string_view, std::size_t) noexcept;
 using DefaultStdoutLogWriterFn = void (*)(void *, std::string_view) noexcept;
 
 enum class ContextState : unsigned char {
@@ -41,7 +42,6 @@ struct TestContextInfo {
     // kind: 'F' failure
     std::vector<std::string> event_lines;
     std::vector<char>        event_kinds;
-    std::vector<std::string> recent_logs;
     std::mutex               mtx;
     std::mutex               adopted_mtx;
     std::condition_variable  adopted_cv;
@@ -52,6 +52,9 @@ struct TestContextInfo {
                 ++generation;
             }
             cv.notify_one();
+            if (interrupt) {
+                interrupt();
+            }
         }
 
         void notify_all() noexcept {
@@ -60,11 +63,17 @@ struct TestContextInfo {
                 ++generation;
             }
             cv.notify_all();
+            if (interrupt) {
+                interrupt();
+            }
         }
 
         std::mutex              mtx;
         std::condition_variable cv;
         std::uint64_t           generation = 0;
+        // Also wakes a scheduler blocked in an fd poll instead of on `cv`. Set
+        // before the wake is shared; must not throw.
+        std::function<void()> interrupt;
     };
     std::vector<std::weak_ptr<AdoptedReleaseWake>> adopted_release_wakes;
     NoExceptionsFatalHookState                     noexceptions_fatal_hook;
@@ -80,7 +89,6 @@ struct TestContextInfo {
     std::atomic<bool>                   has_failures{false};
     std::atomic<std::size_t>            adopted_contexts{0};
     std::size_t                         log_count           = 0;
-    std::size_t                         recent_log_limit    = 0;
     std::atomic<bool>                   suppress_stdout_log = false;
     void                               *log_observer_state  = nullptr;
     TestLogObserverFn                   log_observer        = nullptr;
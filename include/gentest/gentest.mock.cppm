@@ -12,6 +12,9 @@ using ::gentest::expect;
 using ::gentest::make_nice;
 using ::gentest::make_strict;
 using ::gentest::mock;
+using ::gentest::mock_codec;
+using ::gentest::record_calls;
+using ::gentest::replay_calls;
 
 namespace detail {
 using ::gentest::detail::MockAccess;
@@ -41,10 +44,15 @@ using ::gentest::match::Eq;
 using ::gentest::match::Ge;
 using ::gentest::match::Gt;
 using ::gentest::match::InRange;
+using ::gentest::match::IsMatcher;
 using ::gentest::match::Le;
 using ::gentest::match::Lt;
+using ::gentest::match::Matcher;
 using ::gentest::match::Near;
 using ::gentest::match::Not;
+using ::gentest::match::operator&&;
+using ::gentest::match::operator||;
+using ::gentest::match::operator!;
 using ::gentest::match::StartsWith;
 using ::gentest::match::StrContains;
 } // namespace match
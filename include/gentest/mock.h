@@ -1,12 +1,17 @@
 #pragma once
 
+#include "gentest/detail/mock_trace.h"
 #include "gentest/format_value.h"
 #include "gentest/mock_fwd.h"
 #include "gentest/runner.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <deque>
 #include <exception>
@@ -14,7 +19,9 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -26,6 +33,44 @@
 
 namespace gentest {
 
+// Byte codec for values in recorded mock traces (see record_calls()). Specialize
+// with `static void encode(const T &, std::string &out)` and
+// `static T decode(std::string_view)`; arithmetic types, enums and std::string
+// are covered. Replayed return values need a codec; arguments without one are
+// compared by their formatted text.
+template <typename T, typename = void> struct mock_codec {};
+
+// Arithmetic values and enums are stored little-endian, so a trace replays on
+// a host of either byte order as long as the type sizes (and, for floating
+// point, the representation) match.
+template <typename T> struct mock_codec<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>> {
+    static void encode(const T &value, std::string &out) {
+        std::array<char, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), std::addressof(value), sizeof(T));
+        if constexpr (std::endian::native == std::endian::big) {
+            std::ranges::reverse(bytes);
+        }
+        out.append(bytes.data(), bytes.size());
+    }
+    static T decode(std::string_view in) {
+        T value{};
+        if (in.size() == sizeof(T)) {
+            std::array<char, sizeof(T)> bytes{};
+            std::memcpy(bytes.data(), in.data(), sizeof(T));
+            if constexpr (std::endian::native == std::endian::big) {
+                std::ranges::reverse(bytes);
+            }
+            std::memcpy(std::addressof(value), bytes.data(), sizeof(T));
+        }
+        return value;
+    }
+};
+
+template <> struct mock_codec<std::string> {
+    static void        encode(const std::string &value, std::string &out) { out += value; }
+    static std::string decode(std::string_view in) { return std::string(in); }
+};
+
 namespace detail::mocking {
 
 struct MethodIdentity {
@@ -102,14 +147,49 @@ concept HasMakeFor = requires(const P &p) {
     { p.template make<T>() } -> std::same_as<ArgPredicate<T>>;
 };
 
-template <typename T, typename P> ArgPredicate<T> to_arg_predicate(P &&p) {
-    if constexpr (HasMakeFor<T, P>) {
+template <typename T, typename P>
+concept StaticPredicateFor = requires(const P &p, const T &a) {
+    { p.test(a) } -> std::convertible_to<bool>;
+};
+
+template <typename T, typename P>
+concept DescribesFor = requires(const P &p, const T &a) {
+    { p.describe(a) } -> std::convertible_to<std::string>;
+};
+
+// Argument predicates are matcher values (test/describe members), legacy
+// factories that only provide make<T>(), or plain callables returning bool.
+template <typename T, typename P> bool predicate_test(const P &p, const T &a) {
+    if constexpr (StaticPredicateFor<T, P>) {
+        return static_cast<bool>(p.test(a));
+    } else if constexpr (HasMakeFor<T, P>) {
+        return p.template make<T>().test(a);
+    } else {
+        return static_cast<bool>(p(a));
+    }
+}
+
+template <typename T, typename P>
+std::string predicate_describe(const P &p, const T &a, std::string_view fallback = "predicate mismatch") {
+    if constexpr (same_v<P, ArgPredicate<T>>) {
+        return p.describe ? p.describe(a) : std::string(fallback);
+    } else if constexpr (DescribesFor<T, P>) {
+        return std::string(p.describe(a));
+    } else if constexpr (HasMakeFor<T, P>) {
+        return predicate_describe(p.template make<T>(), a, fallback);
+    } else {
+        return std::string(fallback);
+    }
+}
+
+// Factories that only know make<T>() are converted once when the expectation
+// is configured; everything else is stored as-is.
+template <typename T, typename P> auto store_predicate(P &&p) {
+    using D = std::decay_t<P>;
+    if constexpr (!StaticPredicateFor<T, D> && HasMakeFor<T, D>) {
         return p.template make<T>();
     } else {
-        ArgPredicate<T> out;
-        out.test     = std::function<bool(const T &)>{std::forward<P>(p)};
-        out.describe = [](const T &) { return std::string("predicate mismatch"); };
-        return out;
+        return D(std::forward<P>(p));
     }
 }
 
@@ -135,22 +215,6 @@ void report_first_tuple_arg_mismatch(const ExpectedTuple &expected, std::string_
     }
 }
 
-template <std::size_t I = 0, typename PredicateTuple, typename ActualTuple>
-bool tuple_args_match_predicates(const PredicateTuple &preds, std::string_view method_name, const ActualTuple &actual) {
-    if constexpr (I == std::tuple_size_v<std::remove_reference_t<PredicateTuple>>) {
-        return true;
-    } else {
-        const auto &ap = std::get<I>(preds);
-        const auto &a  = std::get<I>(actual);
-        if (!ap.test(a)) {
-            const std::string msg = ap.describe ? ap.describe(a) : std::string("predicate mismatch");
-            ::gentest::detail::record_failure(fmt::format("argument[{}] mismatch for {}: {}", I, method_name, msg));
-            return false;
-        }
-        return tuple_args_match_predicates<I + 1>(preds, method_name, actual);
-    }
-}
-
 template <typename Tuple, typename... A>
 bool check_args_equal(const std::optional<Tuple> &expected, std::string_view method_name, const A &...actual) {
     if (!expected)
@@ -163,13 +227,101 @@ bool check_args_equal(const std::optional<Tuple> &expected, std::string_view met
     return matched;
 }
 
-template <typename TuplePred, typename... A>
-bool check_args_by_predicates(const std::optional<TuplePred> &preds, std::string_view method_name, const A &...actual) {
-    if (!preds)
-        return true;
-    const auto actual_tuple = std::forward_as_tuple(actual...);
-    return tuple_args_match_predicates(*preds, method_name, actual_tuple);
-}
+// Type-erased callable for the matchers and actions of an expectation. Objects
+// up to kInlineSize bytes live in the expectation itself, larger ones on the
+// heap; a call is one indirect call, with no reference count to touch. Not
+// copyable or movable: emplace() replaces the target in place.
+template <typename Signature> class InlineFunction;
+
+template <typename R, typename... A> class InlineFunction<R(A...)> {
+  public:
+    static constexpr std::size_t kInlineSize = 64;
+
+    InlineFunction() = default;
+
+    InlineFunction(const InlineFunction &)            = delete;
+    InlineFunction &operator=(const InlineFunction &) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    template <typename F> void emplace(F &&fn) {
+        using Fn = std::decay_t<F>;
+        reset();
+        if constexpr (sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t)) {
+            target_  = ::new (static_cast<void *>(storage_)) Fn(std::forward<F>(fn));
+            destroy_ = [](void *target) noexcept { static_cast<Fn *>(target)->~Fn(); };
+        } else {
+            target_  = new Fn(std::forward<F>(fn));
+            destroy_ = [](void *target) noexcept { delete static_cast<Fn *>(target); };
+        }
+        call_ = [](const void *target, A... args) -> R { return (*static_cast<const Fn *>(target))(std::forward<A>(args)...); };
+    }
+
+    void reset() noexcept {
+        if (destroy_) {
+            destroy_(target_);
+        }
+        target_  = nullptr;
+        call_    = nullptr;
+        destroy_ = nullptr;
+    }
+
+    explicit operator bool() const noexcept { return call_ != nullptr; }
+
+    R operator()(A... args) const { return call_(target_, std::forward<A>(args)...); }
+
+  private:
+    alignas(std::max_align_t) std::byte storage_[kInlineSize];
+    void *target_                     = nullptr;
+    R (*call_)(const void *, A...)    = nullptr;
+    void (*destroy_)(void *) noexcept = nullptr;
+};
+
+// Argument matchers configured through where_args()/where_call(); records the
+// mismatch and returns false when a call is rejected.
+template <typename... Args> using ArgMatchers = InlineFunction<bool(std::string_view, const std::decay_t<Args> &...)>;
+
+template <typename PredicateTuple, typename... Args> struct PerArgMatchers {
+    PredicateTuple preds;
+
+    explicit PerArgMatchers(PredicateTuple p) : preds(std::move(p)) {}
+
+    bool operator()(std::string_view method_name, const std::decay_t<Args> &...actual) const {
+        return match_each(method_name, std::index_sequence_for<Args...>{}, actual...);
+    }
+
+  private:
+    template <std::size_t... I>
+    bool match_each(std::string_view method_name, std::index_sequence<I...>, const std::decay_t<Args> &...actual) const {
+        return (match_one<I>(method_name, actual) && ...);
+    }
+
+    template <std::size_t I, typename T> bool match_one(std::string_view method_name, const T &a) const {
+        const auto &p = std::get<I>(preds);
+        if (predicate_test(p, a)) {
+            return true;
+        }
+        ::gentest::detail::record_failure(fmt::format("argument[{}] mismatch for {}: {}", I, method_name, predicate_describe(p, a)));
+        return false;
+    }
+};
+
+template <typename F, typename... Args> struct CallMatcher {
+    F fn;
+
+    explicit CallMatcher(F f) : fn(std::move(f)) {}
+
+    bool operator()(std::string_view method_name, const std::decay_t<Args> &...actual) const {
+        if (fn(actual...)) {
+            return true;
+        }
+        ::gentest::detail::record_failure(fmt::format("call predicate mismatch for {}", method_name));
+        return false;
+    }
+};
+
+// Action installed by invokes()/returns()/returns_ref().
+template <typename R, typename... Args> using CallAction = InlineFunction<R(const std::decay_t<Args> &...)>;
 
 inline void verify_calls_or_fail(std::size_t expected, std::size_t observed, std::string_view method_name, bool &already_verified) {
     if (already_verified)
@@ -185,12 +337,14 @@ template <typename... Args> struct ExpectationCommon : ExpectationBase {
     std::size_t                                                    observed_calls = 0;
     bool                                                           allow_excess   = false;
     std::optional<std::tuple<std::decay_t<Args>...>>               expected_args;
-    std::optional<std::tuple<ArgPredicate<std::decay_t<Args>>...>> arg_predicates;
-    std::function<bool(const std::decay_t<Args> &...)>             call_predicate;
+    ArgMatchers<Args...>                                           arg_matchers;
+    ArgMatchers<Args...>                                           call_matcher;
     std::shared_ptr<std::atomic<bool>>                             runtime_started;
     // Configure expectations before worker threads start. Runtime dispatch and
     // verification keep queue/counter mutation in InstanceState and never hold
-    // this mutex across user predicates/actions.
+    // this mutex across user predicates/actions. Matchers and actions are
+    // called in place: the first dispatch sets `runtime_started`, and after
+    // that allow_mutation() rejects every change to them.
     mutable std::recursive_mutex state_mtx_;
 
     void verify(std::string_view method_name) override {
@@ -223,14 +377,15 @@ template <typename... Args> struct ExpectationCommon : ExpectationBase {
         std::lock_guard<std::recursive_mutex> lk(state_mtx_);
         if (!allow_mutation(method_name))
             return;
-        arg_predicates = std::tuple<ArgPredicate<std::decay_t<Args>>...>(to_arg_predicate<std::decay_t<Args>>(std::forward<P>(preds))...);
+        using Stored = std::tuple<decltype(store_predicate<std::decay_t<Args>>(std::forward<P>(preds)))...>;
+        arg_matchers.emplace(PerArgMatchers<Stored, Args...>(Stored(store_predicate<std::decay_t<Args>>(std::forward<P>(preds))...)));
     }
 
-    void set_call_predicate(std::string_view method_name, std::function<bool(const std::decay_t<Args> &...)> predicate) {
+    template <typename F> void set_call_predicate(std::string_view method_name, F predicate) {
         std::lock_guard<std::recursive_mutex> lk(state_mtx_);
         if (!allow_mutation(method_name))
             return;
-        call_predicate = std::move(predicate);
+        call_matcher.emplace(CallMatcher<F, Args...>(std::move(predicate)));
     }
 
     void set_allow_excess(std::string_view method_name, bool enabled) {
@@ -241,39 +396,36 @@ template <typename... Args> struct ExpectationCommon : ExpectationBase {
     }
 
     bool check_args(std::string_view method_name, const std::decay_t<Args> &...actual) {
-        std::lock_guard<std::recursive_mutex> lk(state_mtx_);
-        if (call_predicate) {
-            if (!call_predicate(actual...)) {
-                ::gentest::detail::record_failure(fmt::format("call predicate mismatch for {}", method_name));
-                return false;
-            }
-            return true;
+        const ArgMatchers<Args...> *matchers = nullptr;
+        {
+            std::lock_guard<std::recursive_mutex> lk(state_mtx_);
+            matchers = call_matcher ? &call_matcher : &arg_matchers;
+            if (!*matchers)
+                return check_args_equal(expected_args, method_name, actual...);
         }
-        if (arg_predicates)
-            return check_args_by_predicates(arg_predicates, method_name, actual...);
-        return check_args_equal(expected_args, method_name, actual...);
+        return (*matchers)(method_name, actual...);
     }
 };
 
 template <typename R, typename... Args> struct Expectation<R(Args...)> : ExpectationCommon<Args...> {
-    std::function<R(const std::decay_t<Args> &...)> action;
+    CallAction<R, Args...> action;
 
-    void set_action(std::string_view method_name, std::function<R(const std::decay_t<Args> &...)> next_action) {
+    template <typename F> void set_action(std::string_view method_name, F next_action) {
         std::lock_guard<std::recursive_mutex> lk(this->state_mtx_);
         if (!this->allow_mutation(method_name))
             return;
-        action = std::move(next_action);
+        action.emplace(std::move(next_action));
     }
 
     R invoke(std::string_view method_name, const std::decay_t<Args> &...args) {
-        std::function<R(const std::decay_t<Args> &...)> action_snapshot;
+        const CallAction<R, Args...> *installed_action = nullptr;
         {
             std::lock_guard<std::recursive_mutex> lk(this->state_mtx_);
-            action_snapshot = action;
+            installed_action = action ? &action : nullptr;
         }
         (void)this->check_args(method_name, args...);
-        if (action_snapshot) {
-            return action_snapshot(args...);
+        if (installed_action) {
+            return (*installed_action)(args...);
         }
         if constexpr (!std::is_void_v<R>) {
             if constexpr (std::is_reference_v<R>) {
@@ -286,28 +438,109 @@ template <typename R, typename... Args> struct Expectation<R(Args...)> : Expecta
 };
 
 template <typename... Args> struct Expectation<void(Args...)> : ExpectationCommon<Args...> {
-    std::function<void(const std::decay_t<Args> &...)> action;
+    CallAction<void, Args...> action;
 
-    void set_action(std::string_view method_name, std::function<void(const std::decay_t<Args> &...)> next_action) {
+    template <typename F> void set_action(std::string_view method_name, F next_action) {
         std::lock_guard<std::recursive_mutex> lk(this->state_mtx_);
         if (!this->allow_mutation(method_name))
             return;
-        action = std::move(next_action);
+        action.emplace(std::move(next_action));
     }
 
     void invoke(std::string_view method_name, const std::decay_t<Args> &...args) {
-        std::function<void(const std::decay_t<Args> &...)> action_snapshot;
+        const CallAction<void, Args...> *installed_action = nullptr;
         {
             std::lock_guard<std::recursive_mutex> lk(this->state_mtx_);
-            action_snapshot = action;
+            installed_action = action ? &action : nullptr;
         }
         (void)this->check_args(method_name, args...);
-        if (action_snapshot) {
-            action_snapshot(args...);
+        if (installed_action) {
+            (*installed_action)(args...);
         }
     }
 };
 
+template <typename T>
+concept HasMockCodec = requires(const T &value, std::string &out, std::string_view in) {
+    ::gentest::mock_codec<T>::encode(value, out);
+    { ::gentest::mock_codec<T>::decode(in) } -> std::same_as<T>;
+};
+
+// Object addresses differ between runs, so recorded pointer arguments (other
+// than C strings) are left unchecked on replay.
+template <typename T>
+inline constexpr bool trace_skips_arg_v =
+    !HasMockCodec<T> && std::is_pointer_v<T> && !same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>;
+
+template <typename T> std::string encode_trace_value(const T &value) {
+    std::string out;
+    if constexpr (HasMockCodec<T>) {
+        ::gentest::mock_codec<T>::encode(value, out);
+    } else if constexpr (!trace_skips_arg_v<T>) {
+        out = to_string_fallback(value);
+    }
+    return out;
+}
+
+// Arguments are stored as one chunk each: a little-endian u32 length, then the
+// encoded bytes.
+inline void append_trace_chunk(std::string &out, std::string_view chunk) {
+    const auto size = static_cast<std::uint32_t>(chunk.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((size >> shift) & 0xffu));
+    }
+    out.append(chunk);
+}
+
+inline std::vector<std::string_view> split_trace_chunks(std::string_view in) {
+    std::vector<std::string_view> chunks;
+    while (in.size() >= 4) {
+        std::uint32_t size = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            size |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        in.remove_prefix(4);
+        chunks.push_back(in.substr(0, size));
+        in.remove_prefix(std::min<std::size_t>(size, in.size()));
+    }
+    return chunks;
+}
+
+template <typename... Args> std::string encode_trace_args(const Args &...args) {
+    std::string out;
+    (append_trace_chunk(out, encode_trace_value(args)), ...);
+    return out;
+}
+
+template <typename T> std::string describe_trace_chunk(std::string_view chunk) {
+    if constexpr (HasMockCodec<T>) {
+        return to_string_fallback(::gentest::mock_codec<T>::decode(chunk));
+    } else {
+        return std::string(chunk);
+    }
+}
+
+template <typename... Args>
+void report_trace_arg_mismatch(std::string_view method_name, std::string_view recorded, std::string_view actual) {
+    using Describe = std::string (*)(std::string_view);
+    constexpr std::array<Describe, sizeof...(Args)> describe{&describe_trace_chunk<Args>...};
+    const auto                                      expected_chunks = split_trace_chunks(recorded);
+    const auto                                      actual_chunks   = split_trace_chunks(actual);
+    for (std::size_t i = 0; i < actual_chunks.size() && i < expected_chunks.size(); ++i) {
+        if (expected_chunks[i] != actual_chunks[i]) {
+            ::gentest::detail::record_failure(fmt::format("argument[{}] mismatch for {}: recorded {}, got {}", i, method_name,
+                                                          describe[i](expected_chunks[i]), describe[i](actual_chunks[i])));
+            return;
+        }
+    }
+    ::gentest::detail::record_failure(fmt::format("argument mismatch for {}: differs from the recorded call", method_name));
+}
+
+template <typename T> struct MemberClass;
+template <typename M, typename C> struct MemberClass<M C::*> {
+    using type = C;
+};
+
 class InstanceState {
   public:
     InstanceState();
@@ -336,6 +569,67 @@ class InstanceState {
                 expectation->verify(entry.method_name);
             }
         }
+        for (const auto &cursor : replay_cursors_) {
+            if (cursor.next < cursor.records.size()) {
+                ::gentest::detail::record_failure(fmt::format("expected {} more call(s) to {} from the replay trace",
+                                                              cursor.records.size() - cursor.next, cursor.method_name));
+            }
+        }
+        replay_cursors_.clear();
+        if (!record_path_.empty()) {
+            std::vector<MockTraceRecord> records;
+            records.reserve(recorded_.size());
+            for (const auto &call : recorded_) {
+                records.push_back(MockTraceRecord{.method = call.method, .args = call.args, .result = call.result});
+            }
+            const std::string error = write_mock_trace(record_path_, records);
+            if (!error.empty()) {
+                ::gentest::detail::record_failure(fmt::format("failed to write mock trace '{}': {}", record_path_, error));
+            }
+            record_path_.clear();
+        }
+    }
+
+    // Record mode: every call is forwarded to `real` (an object of the mocked
+    // type) and appended to a trace that verify_all() writes to `path`.
+    void record_to(std::string path, void *real) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (frozen_)
+            return;
+        record_path_ = std::move(path);
+        real_        = real;
+        replay_trace_.reset();
+        replay_cursors_.clear();
+        replay_index_.clear();
+        capturing_.store(true, std::memory_order_release);
+    }
+
+    // Replay mode: loads a recorded trace as one queue of expected calls per
+    // method. Methods the trace does not cover keep using expect(). Returns
+    // the load error, if any.
+    std::string replay_from(const std::string &path) {
+        std::string error;
+        auto        trace = open_mock_trace(path, error);
+        if (!trace)
+            return error;
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (frozen_)
+            return {};
+        record_path_.clear();
+        real_           = nullptr;
+        replay_records_ = mock_trace_records(*trace);
+        replay_trace_   = std::move(trace);
+        replay_cursors_.clear();
+        replay_index_.clear();
+        for (std::size_t i = 0; i < replay_records_.size(); ++i) {
+            const auto [it, inserted] = replay_index_.emplace(replay_records_[i].method, replay_cursors_.size());
+            if (inserted) {
+                replay_cursors_.push_back(ReplayCursor{.method_name = replay_records_[i].method, .records = {}, .next = 0});
+            }
+            replay_cursors_[it->second].records.push_back(i);
+        }
+        capturing_.store(true, std::memory_order_release);
+        return {};
     }
 
     template <typename MethodPtr> MethodIdentity identify(MethodPtr ptr) { return MethodIdentity::from(ptr); }
@@ -355,11 +649,31 @@ class InstanceState {
     }
 
     template <typename R, typename... Args> R dispatch(const MethodIdentity &id, std::string_view method_name, Args &&...args) {
-        return dispatch_with_fallback<R>(id, id, method_name, std::forward<Args>(args)...);
+        return dispatch_expected<R>(id, id, method_name, std::forward<Args>(args)...);
+    }
+
+    // Entry point for generated mocks. `method` is the mocked member (or
+    // static) function, used to reach the real object in record mode.
+    // `trace_key` is the method's qualified name plus its parameter list and
+    // qualifiers, so overloads keep separate record/replay queues.
+    template <typename R, typename MethodPtr, typename... Args>
+    R dispatch_with_fallback(const MethodIdentity &id, const MethodIdentity &fallback_id, MethodPtr method, std::string_view method_name,
+                             std::string_view trace_key, Args &&...args) {
+        if (capturing_.load(std::memory_order_acquire)) {
+            if (real_ != nullptr) {
+                return record_call<R>(method, trace_key, std::forward<Args>(args)...);
+            }
+            if constexpr (!std::is_reference_v<R>) {
+                if (const auto index = take_replay_record(trace_key)) {
+                    return replay_call<R>(*index, method_name, args...);
+                }
+            }
+        }
+        return dispatch_expected<R>(id, fallback_id, method_name, std::forward<Args>(args)...);
     }
 
     template <typename R, typename... Args>
-    R dispatch_with_fallback(const MethodIdentity &id, const MethodIdentity &fallback_id, std::string_view method_name, Args &&...args) {
+    R dispatch_expected(const MethodIdentity &id, const MethodIdentity &fallback_id, std::string_view method_name, Args &&...args) {
         using ExpectationT        = Expectation<R(Args...)>;
         bool          nice_mode   = false;
         bool          unexpected  = false;
@@ -424,11 +738,108 @@ class InstanceState {
         std::size_t                                  next_expectation = 0;
     };
 
+    struct RecordedCall {
+        std::string method;
+        std::string args;
+        std::string result;
+    };
+
+    struct ReplayCursor {
+        std::string_view         method_name;
+        std::vector<std::size_t> records;
+        std::size_t              next = 0;
+    };
+
+    template <typename R, typename MethodPtr, typename... Args> R call_real(MethodPtr method, Args &&...args) {
+        if constexpr (std::is_member_function_pointer_v<MethodPtr>) {
+            using Class = typename MemberClass<MethodPtr>::type;
+            auto &real  = *static_cast<Class *>(real_);
+            if constexpr (std::is_invocable_v<MethodPtr, Class &, Args &&...>) {
+                return std::invoke(method, real, std::forward<Args>(args)...);
+            } else {
+                return std::invoke(method, std::move(real), std::forward<Args>(args)...);
+            }
+        } else {
+            return std::invoke(method, std::forward<Args>(args)...);
+        }
+    }
+
+    // Arguments are encoded before the call because the real method may move
+    // from them. Reference and immovable returns are forwarded but not recorded.
+    template <typename R, typename MethodPtr, typename... Args>
+    R record_call(MethodPtr method, std::string_view trace_key, Args &&...args) {
+        if constexpr (std::is_reference_v<R> || !(std::is_void_v<R> || std::is_move_constructible_v<R>)) {
+            return call_real<R>(method, std::forward<Args>(args)...);
+        } else {
+            std::string encoded_args = encode_trace_args(static_cast<const std::decay_t<Args> &>(args)...);
+            if constexpr (std::is_void_v<R>) {
+                call_real<R>(method, std::forward<Args>(args)...);
+                append_recorded(trace_key, std::move(encoded_args), {});
+            } else {
+                R result = call_real<R>(method, std::forward<Args>(args)...);
+                append_recorded(trace_key, std::move(encoded_args), encode_trace_value<std::remove_cv_t<R>>(result));
+                return result;
+            }
+        }
+    }
+
+    void append_recorded(std::string_view trace_key, std::string args, std::string result) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        runtime_started_->store(true, std::memory_order_release);
+        frozen_ = true;
+        recorded_.push_back(RecordedCall{.method = std::string(trace_key), .args = std::move(args), .result = std::move(result)});
+    }
+
+    std::optional<std::size_t> take_replay_record(std::string_view trace_key) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        runtime_started_->store(true, std::memory_order_release);
+        frozen_       = true;
+        const auto it = replay_index_.find(trace_key);
+        if (it == replay_index_.end()) {
+            return std::nullopt;
+        }
+        auto &cursor = replay_cursors_[it->second];
+        if (cursor.next >= cursor.records.size()) {
+            return std::nullopt;
+        }
+        return cursor.records[cursor.next++];
+    }
+
+    template <typename R, typename... Args> R replay_call(std::size_t index, std::string_view method_name, const Args &...args) {
+        using Value                         = std::remove_cv_t<R>;
+        const MockTraceRecord &rec          = replay_records_[index];
+        const std::string      encoded_args = encode_trace_args(static_cast<const std::decay_t<Args> &>(args)...);
+        if (encoded_args != rec.args) {
+            report_trace_arg_mismatch<std::decay_t<Args>...>(method_name, rec.args, encoded_args);
+        }
+        if constexpr (std::is_void_v<R>) {
+            return;
+        } else if constexpr (HasMockCodec<Value>) {
+            return ::gentest::mock_codec<Value>::decode(rec.result);
+        } else {
+            ::gentest::detail::record_failure(fmt::format("cannot replay {}: no gentest::mock_codec for its return type", method_name));
+            if constexpr (std::is_default_constructible_v<R>) {
+                return R{};
+            } else {
+                std::terminate();
+            }
+        }
+    }
+
     mutable std::mutex                                                  mtx_;
     std::unordered_map<MethodIdentity, MethodEntry, MethodIdentityHash> methods_;
     std::shared_ptr<std::atomic<bool>>                                  runtime_started_ = std::make_shared<std::atomic<bool>>(false);
     bool                                                                nice_mode_       = false;
     bool                                                                frozen_          = false;
+    // Record/replay state; set before the first call like expectations.
+    std::atomic<bool>                                 capturing_{false};
+    void                                             *real_ = nullptr;
+    std::string                                       record_path_;
+    std::deque<RecordedCall>                          recorded_;
+    std::shared_ptr<const MockTrace>                  replay_trace_;
+    std::span<const MockTraceRecord>                  replay_records_;
+    std::vector<ReplayCursor>                         replay_cursors_;
+    std::unordered_map<std::string_view, std::size_t> replay_index_;
 };
 
 // Keep these out-of-class so GCC module consumers emit concrete special-member
@@ -494,8 +905,7 @@ template <typename R, typename... Args> class ExpectationHandle<R(Args...)> {
     template <typename Callable> ExpectationHandle &where_call(Callable &&call_pred) {
         require_configurable();
         if (expectation_) {
-            expectation_->set_call_predicate(method_name_,
-                                             std::function<bool(const std::decay_t<Args> &...)>(std::forward<Callable>(call_pred)));
+            expectation_->set_call_predicate(method_name_, std::decay_t<Callable>(std::forward<Callable>(call_pred)));
         }
         return *this;
     }
@@ -630,7 +1040,11 @@ template <class Mock> struct MockAccess {
         using Signature = typename mocking::MethodTraits<decltype(Method)>::Signature;
         return mocking::ExpectationHandle<Signature>{{}, std::string(method_name)};
     }
-    static void set_nice(Mock &, bool) {}
+    static void                    set_nice(Mock &, bool) {}
+    static mocking::InstanceState &state(Mock &) {
+        static mocking::InstanceState placeholder;
+        return placeholder;
+    }
 #endif
 };
 
@@ -646,6 +1060,29 @@ template <auto Method, class Mock> auto expect(Mock &instance, std::string_view
     return detail::MockAccess<std::remove_cvref_t<Mock>>::template expect_constant<Method>(instance, method_name);
 }
 
+// Forwards every call on `instance` to `real` and writes the calls (arguments
+// and return values) to a binary trace at `trace_path` when the mock is
+// verified. Load the trace with replay_calls() instead of hand-written
+// expectations.
+template <class Mock, class Real> void record_calls(Mock &instance, Real &real, std::string trace_path) {
+    using Target = typename std::remove_cvref_t<Mock>::GentestTarget;
+    static_assert(std::is_convertible_v<Real *, Target *>, "record_calls() forwards to an object of the mocked type");
+    ::gentest::detail::require_not_adopted_context("mock recording configured");
+    detail::MockAccess<std::remove_cvref_t<Mock>>::state(instance).record_to(std::move(trace_path),
+                                                                             static_cast<Target *>(std::addressof(real)));
+}
+
+// Replays a trace written by record_calls(): each recorded call becomes an
+// expectation with its arguments checked and its return value decoded through
+// mock_codec<R>. The trace is mapped and loaded in one step.
+template <class Mock> void replay_calls(Mock &instance, const std::string &trace_path) {
+    ::gentest::detail::require_not_adopted_context("mock replay configured");
+    const std::string error = detail::MockAccess<std::remove_cvref_t<Mock>>::state(instance).replay_from(trace_path);
+    if (!error.empty()) {
+        ::gentest::detail::record_failure(fmt::format("failed to load mock trace '{}': {}", trace_path, error));
+    }
+}
+
 template <class Mock> void make_nice(Mock &instance, bool v = true) {
     ::gentest::detail::require_not_adopted_context("mock mode configured");
     detail::MockAccess<std::remove_cvref_t<Mock>>::set_nice(instance, v);
@@ -666,155 +1103,130 @@ template <class Mock> void make_strict(Mock &instance) {
 // Lightweight matcher helpers for predicate-based argument matching.
 // Use with ExpectationHandle::where_args(...) or ::where(...), e.g.:
 //   expect(mock, &T::fn).where(Eq(42), Any());
+// Matchers are plain values stored inline in the expectation and compose with
+// &&, || and !, e.g. `.where(Ge(1) && Lt(10), !StrContains("tmp"))`. Only
+// test() runs per call; describe() runs once an argument is rejected.
 namespace match {
 using ::gentest::detail::mocking::ArgPredicate;
 
-struct AnyFactory {
+// Base for matcher values. Derived types provide
+//   template <typename T> bool        test(const T &) const;
+//   template <typename T> std::string describe(const T &) const;
+// and make<T>() adapts them to the type-erased ArgPredicate.
+template <typename Derived> struct Matcher {
     template <typename T> ArgPredicate<T> make() const {
         ArgPredicate<T> ap;
-        ap.test = [](const T &) noexcept { return true; };
+        ap.test     = [self = static_cast<const Derived &>(*this)](const T &a) { return self.test(a); };
+        ap.describe = [self = static_cast<const Derived &>(*this)](const T &a) { return self.describe(a); };
         return ap;
     }
 };
+
+template <typename M>
+concept IsMatcher = std::derived_from<std::remove_cvref_t<M>, Matcher<std::remove_cvref_t<M>>>;
+
+struct AnyFactory : Matcher<AnyFactory> {
+    template <typename T> bool        test(const T &) const noexcept { return true; }
+    template <typename T> std::string describe(const T &) const { return "any"; }
+};
 inline auto Any() { return AnyFactory{}; }
 
-template <typename V> struct EqFactory {
+template <typename V> struct EqFactory : Matcher<EqFactory<V>> {
     using Value = std::decay_t<V>;
-    Value                                 expected;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     exp = expected;
-        ap.test             = [exp](const T &a) { return a == exp; };
-        ap.describe         = [exp](const T &a) {
-            return fmt::format("expected == {}, got {}", ::gentest::detail::mocking::to_string_fallback(exp),
-                               ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             expected;
+    template <typename T> bool        test(const T &a) const { return a == expected; }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected == {}, got {}", ::gentest::detail::mocking::to_string_fallback(expected),
+                           ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V> inline auto Eq(V &&v) { return EqFactory<V>{std::forward<V>(v)}; }
+template <typename V> inline auto Eq(V &&v) { return EqFactory<V>{{}, std::forward<V>(v)}; }
 
-template <typename A, typename B> struct InRangeFactory {
+template <typename A, typename B> struct InRangeFactory : Matcher<InRangeFactory<A, B>> {
     using Lo = std::decay_t<A>;
     using Hi = std::decay_t<B>;
-    Lo                                    l;
-    Hi                                    h;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Lo        lo = l;
-        const Hi        hi = h;
-        ap.test            = [lo, hi](const T &a) { return (a >= lo) && (a <= hi); };
-        ap.describe        = [lo, hi](const T &a) {
-            return fmt::format("expected in [{}, {}], got {}", ::gentest::detail::mocking::to_string_fallback(lo),
-                               ::gentest::detail::mocking::to_string_fallback(hi), ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Lo                                l;
+    Hi                                h;
+    template <typename T> bool        test(const T &a) const { return (a >= l) && (a <= h); }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected in [{}, {}], got {}", ::gentest::detail::mocking::to_string_fallback(l),
+                           ::gentest::detail::mocking::to_string_fallback(h), ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
 template <typename A, typename B> inline auto InRange(A &&lo, B &&hi) {
-    return InRangeFactory<A, B>{std::forward<A>(lo), std::forward<B>(hi)};
+    return InRangeFactory<A, B>{{}, std::forward<A>(lo), std::forward<B>(hi)};
 }
 
-template <typename P> struct NotFactory {
-    P                                     inner;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ip = inner.template make<T>();
-        ArgPredicate<T> ap;
-        ap.test     = [ip](const T &a) { return !ip.test(a); };
-        ap.describe = [ip](const T &a) {
-            std::string inner_desc = ip.describe ? ip.describe(a) : std::string("predicate matched");
-            return std::string("not(") + inner_desc + ")";
-        };
-        return ap;
+template <typename P> struct NotFactory : Matcher<NotFactory<P>> {
+    P                                 inner;
+    template <typename T> bool        test(const T &a) const { return !::gentest::detail::mocking::predicate_test(inner, a); }
+    template <typename T> std::string describe(const T &a) const {
+        return std::string("not(") + ::gentest::detail::mocking::predicate_describe(inner, a, "predicate matched") + ")";
     }
 };
-template <typename P> inline auto Not(P &&p) { return NotFactory<std::decay_t<P>>{std::forward<P>(p)}; }
+template <typename P> inline auto Not(P &&p) { return NotFactory<std::decay_t<P>>{{}, std::forward<P>(p)}; }
 
-template <typename V> struct GeFactory {
+template <typename V> struct GeFactory : Matcher<GeFactory<V>> {
     using Value = std::decay_t<V>;
-    Value                                 bound;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     b = bound;
-        ap.test           = [b](const T &a) { return a >= b; };
-        ap.describe       = [b](const T &a) {
-            return fmt::format("expected >= {}, got {}", ::gentest::detail::mocking::to_string_fallback(b),
-                               ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             bound;
+    template <typename T> bool        test(const T &a) const { return a >= bound; }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected >= {}, got {}", ::gentest::detail::mocking::to_string_fallback(bound),
+                           ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V> inline auto Ge(V &&v) { return GeFactory<V>{std::forward<V>(v)}; }
+template <typename V> inline auto Ge(V &&v) { return GeFactory<V>{{}, std::forward<V>(v)}; }
 
-template <typename V> struct LeFactory {
+template <typename V> struct LeFactory : Matcher<LeFactory<V>> {
     using Value = std::decay_t<V>;
-    Value                                 bound;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     b = bound;
-        ap.test           = [b](const T &a) { return a <= b; };
-        ap.describe       = [b](const T &a) {
-            return fmt::format("expected <= {}, got {}", ::gentest::detail::mocking::to_string_fallback(b),
-                               ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             bound;
+    template <typename T> bool        test(const T &a) const { return a <= bound; }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected <= {}, got {}", ::gentest::detail::mocking::to_string_fallback(bound),
+                           ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V> inline auto Le(V &&v) { return LeFactory<V>{std::forward<V>(v)}; }
+template <typename V> inline auto Le(V &&v) { return LeFactory<V>{{}, std::forward<V>(v)}; }
 
-template <typename V> struct GtFactory {
+template <typename V> struct GtFactory : Matcher<GtFactory<V>> {
     using Value = std::decay_t<V>;
-    Value                                 bound;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     b = bound;
-        ap.test           = [b](const T &a) { return a > b; };
-        ap.describe       = [b](const T &a) {
-            return fmt::format("expected > {}, got {}", ::gentest::detail::mocking::to_string_fallback(b),
-                               ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             bound;
+    template <typename T> bool        test(const T &a) const { return a > bound; }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected > {}, got {}", ::gentest::detail::mocking::to_string_fallback(bound),
+                           ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V> inline auto Gt(V &&v) { return GtFactory<V>{std::forward<V>(v)}; }
+template <typename V> inline auto Gt(V &&v) { return GtFactory<V>{{}, std::forward<V>(v)}; }
 
-template <typename V> struct LtFactory {
+template <typename V> struct LtFactory : Matcher<LtFactory<V>> {
     using Value = std::decay_t<V>;
-    Value                                 bound;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     b = bound;
-        ap.test           = [b](const T &a) { return a < b; };
-        ap.describe       = [b](const T &a) {
-            return fmt::format("expected < {}, got {}", ::gentest::detail::mocking::to_string_fallback(b),
-                               ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             bound;
+    template <typename T> bool        test(const T &a) const { return a < bound; }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected < {}, got {}", ::gentest::detail::mocking::to_string_fallback(bound),
+                           ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V> inline auto Lt(V &&v) { return LtFactory<V>{std::forward<V>(v)}; }
+template <typename V> inline auto Lt(V &&v) { return LtFactory<V>{{}, std::forward<V>(v)}; }
 
-template <typename V, typename E> struct NearFactory {
+template <typename V, typename E> struct NearFactory : Matcher<NearFactory<V, E>> {
     using Value = std::decay_t<V>;
     using Eps   = std::decay_t<E>;
-    Value                                 expected;
-    Eps                                   eps;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const Value     exp = expected;
-        const Eps       e   = eps;
-        ap.test             = [exp, e](const T &a) {
-            using std::abs;
-            return abs(static_cast<long double>(a) - static_cast<long double>(exp)) <= static_cast<long double>(e);
-        };
-        ap.describe = [exp, e](const T &a) {
-            return fmt::format("expected near {} ± {}, got {}", ::gentest::detail::mocking::to_string_fallback(exp),
-                               ::gentest::detail::mocking::to_string_fallback(e), ::gentest::detail::mocking::to_string_fallback(a));
-        };
-        return ap;
+    Value                             expected;
+    Eps                               eps;
+    template <typename T> bool        test(const T &a) const {
+        using std::abs;
+        return abs(static_cast<long double>(a) - static_cast<long double>(expected)) <= static_cast<long double>(eps);
+    }
+    template <typename T> std::string describe(const T &a) const {
+        return fmt::format("expected near {} ± {}, got {}", ::gentest::detail::mocking::to_string_fallback(expected),
+                           ::gentest::detail::mocking::to_string_fallback(eps), ::gentest::detail::mocking::to_string_fallback(a));
     }
 };
-template <typename V, typename E> inline auto Near(V &&v, E &&eps) { return NearFactory<V, E>{std::forward<V>(v), std::forward<E>(eps)}; }
+template <typename V, typename E> inline auto Near(V &&v, E &&eps) {
+    return NearFactory<V, E>{{}, std::forward<V>(v), std::forward<E>(eps)};
+}
 
 template <typename T> inline std::optional<std::string_view> to_string_view_safe(const T &a) {
     using D = std::decay_t<T>;
@@ -827,145 +1239,115 @@ template <typename T> inline std::optional<std::string_view> to_string_view_safe
     }
 }
 
-struct StrContainsFactory {
-    std::string                           needle;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T>   ap;
-        const std::string nd = needle;
-        ap.test              = [nd](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return false;
-            return s->find(nd) != std::string_view::npos;
-        };
-        ap.describe = [nd](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return fmt::format("expected substring '{}', got <null>", nd);
-            return fmt::format("expected substring '{}', got '{}'", nd, *s);
-        };
-        return ap;
+struct StrContainsFactory : Matcher<StrContainsFactory> {
+    std::string                       needle;
+    template <typename T> bool        test(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return false;
+        return s->find(needle) != std::string_view::npos;
+    }
+    template <typename T> std::string describe(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return fmt::format("expected substring '{}', got <null>", needle);
+        return fmt::format("expected substring '{}', got '{}'", needle, *s);
     }
 };
-inline auto StrContains(std::string needle) { return StrContainsFactory{std::move(needle)}; }
+inline auto StrContains(std::string needle) { return StrContainsFactory{{}, std::move(needle)}; }
 
-struct StartsWithFactory {
-    std::string                           prefix;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T>   ap;
-        const std::string px = prefix;
-        ap.test              = [px](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return false;
-            return s->rfind(px, 0) == 0;
-        };
-        ap.describe = [px](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return fmt::format("expected prefix '{}', got <null>", px);
-            return fmt::format("expected prefix '{}', got '{}'", px, *s);
-        };
-        return ap;
+struct StartsWithFactory : Matcher<StartsWithFactory> {
+    std::string                       prefix;
+    template <typename T> bool        test(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return false;
+        return s->rfind(prefix, 0) == 0;
+    }
+    template <typename T> std::string describe(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return fmt::format("expected prefix '{}', got <null>", prefix);
+        return fmt::format("expected prefix '{}', got '{}'", prefix, *s);
     }
 };
-inline auto StartsWith(std::string prefix) { return StartsWithFactory{std::move(prefix)}; }
+inline auto StartsWith(std::string prefix) { return StartsWithFactory{{}, std::move(prefix)}; }
 
-struct EndsWithFactory {
-    std::string                           suffix;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T>   ap;
-        const std::string sx = suffix;
-        ap.test              = [sx](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return false;
-            return s->size() >= sx.size() && s->substr(s->size() - sx.size()) == sx;
-        };
-        ap.describe = [sx](const T &a) {
-            auto s = to_string_view_safe(a);
-            if (!s)
-                return fmt::format("expected suffix '{}', got <null>", sx);
-            return fmt::format("expected suffix '{}', got '{}'", sx, *s);
-        };
-        return ap;
+struct EndsWithFactory : Matcher<EndsWithFactory> {
+    std::string                       suffix;
+    template <typename T> bool        test(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return false;
+        return s->size() >= suffix.size() && s->substr(s->size() - suffix.size()) == suffix;
+    }
+    template <typename T> std::string describe(const T &a) const {
+        auto s = to_string_view_safe(a);
+        if (!s)
+            return fmt::format("expected suffix '{}', got <null>", suffix);
+        return fmt::format("expected suffix '{}', got '{}'", suffix, *s);
     }
 };
-inline auto EndsWith(std::string suffix) { return EndsWithFactory{std::move(suffix)}; }
+inline auto EndsWith(std::string suffix) { return EndsWithFactory{{}, std::move(suffix)}; }
+
+template <typename Tuple, typename T> std::string describe_each(std::string msg, const Tuple &subs, const T &a) {
+    bool first = true;
+    std::apply(
+        [&](const auto &...m) {
+            ((msg += std::exchange(first, false) ? "" : "; ", msg += ::gentest::detail::mocking::predicate_describe(m, a, "predicate")),
+             ...);
+        },
+        subs);
+    return msg;
+}
 
-template <typename... M> struct AnyOfFactory {
-    std::tuple<M...>                      subs;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const auto      subs_local = subs;
-        ap.test                    = [subs_local](const T &a) {
-            bool ok = false;
-            std::apply([&](auto const &...m) { ((ok = ok || m.template make<T>().test(a)), ...); }, subs_local);
-            return ok;
-        };
-        ap.describe = [subs_local](const T &a) {
-            std::string msg   = "expected any of: ";
-            bool        first = true;
-            std::apply(
-                [&](auto const &...m) {
-                    (([&] {
-                         auto inner = m.template make<T>();
-                         if (!first)
-                             msg += "; ";
-                         first = false;
-                         if (inner.describe)
-                             msg += inner.describe(a);
-                         else
-                             msg += "predicate";
-                     }()),
-                     ...);
-                },
-                subs_local);
-            return msg;
-        };
-        return ap;
+template <typename... M> struct AnyOfFactory : Matcher<AnyOfFactory<M...>> {
+    std::tuple<M...>                  subs;
+    template <typename T> bool        test(const T &a) const {
+        return std::apply([&](const auto &...m) { return (::gentest::detail::mocking::predicate_test(m, a) || ...); }, subs);
     }
+    template <typename T> std::string describe(const T &a) const { return describe_each("expected any of: ", subs, a); }
 };
 template <typename... M> inline auto AnyOf(M &&...m) {
-    return AnyOfFactory<std::decay_t<M>...>{std::tuple<std::decay_t<M>...>(std::forward<M>(m)...)};
+    return AnyOfFactory<std::decay_t<M>...>{{}, std::tuple<std::decay_t<M>...>(std::forward<M>(m)...)};
 }
 
-template <typename... M> struct AllOfFactory {
-    std::tuple<M...>                      subs;
-    template <typename T> ArgPredicate<T> make() const {
-        ArgPredicate<T> ap;
-        const auto      subs_local = subs;
-        ap.test                    = [subs_local](const T &a) {
-            bool ok = true;
-            std::apply([&](auto const &...m) { ((ok = ok && m.template make<T>().test(a)), ...); }, subs_local);
-            return ok;
-        };
-        ap.describe = [subs_local](const T &a) {
-            std::string msg   = "expected all of: ";
-            bool        first = true;
-            std::apply(
-                [&](auto const &...m) {
-                    (([&] {
-                         auto inner = m.template make<T>();
-                         if (!first)
-                             msg += "; ";
-                         first = false;
-                         if (inner.describe)
-                             msg += inner.describe(a);
-                         else
-                             msg += "predicate";
-                     }()),
-                     ...);
-                },
-                subs_local);
-            return msg;
-        };
-        return ap;
+template <typename... M> struct AllOfFactory : Matcher<AllOfFactory<M...>> {
+    std::tuple<M...>                  subs;
+    template <typename T> bool        test(const T &a) const {
+        return std::apply([&](const auto &...m) { return (::gentest::detail::mocking::predicate_test(m, a) && ...); }, subs);
     }
+    template <typename T> std::string describe(const T &a) const { return describe_each("expected all of: ", subs, a); }
 };
 template <typename... M> inline auto AllOf(M &&...m) {
-    return AllOfFactory<std::decay_t<M>...>{std::tuple<std::decay_t<M>...>(std::forward<M>(m)...)};
+    return AllOfFactory<std::decay_t<M>...>{{}, std::tuple<std::decay_t<M>...>(std::forward<M>(m)...)};
+}
+
+// `a && b && c` flattens into one AllOf (and `||` into one AnyOf) so the
+// mismatch text lists every operand once.
+template <template <typename...> class Group, typename M> inline constexpr bool is_group_v                        = false;
+template <template <typename...> class Group, typename... M> inline constexpr bool is_group_v<Group, Group<M...>> = true;
+
+template <template <typename...> class Group, typename M> auto group_operands(M &&m) {
+    using D = std::remove_cvref_t<M>;
+    if constexpr (is_group_v<Group, D>) {
+        return D(std::forward<M>(m)).subs;
+    } else {
+        return std::tuple<D>(std::forward<M>(m));
+    }
+}
+
+template <IsMatcher L, IsMatcher R> auto operator&&(L &&lhs, R &&rhs) {
+    auto operands = std::tuple_cat(group_operands<AllOfFactory>(std::forward<L>(lhs)), group_operands<AllOfFactory>(std::forward<R>(rhs)));
+    return std::apply([](auto &&...m) { return AllOf(std::move(m)...); }, std::move(operands));
 }
+
+template <IsMatcher L, IsMatcher R> auto operator||(L &&lhs, R &&rhs) {
+    auto operands = std::tuple_cat(group_operands<AnyOfFactory>(std::forward<L>(lhs)), group_operands<AnyOfFactory>(std::forward<R>(rhs)));
+    return std::apply([](auto &&...m) { return AnyOf(std::move(m)...); }, std::move(operands));
+}
+
+template <IsMatcher M> auto operator!(M &&m) { return Not(std::forward<M>(m)); }
 } // namespace match
 
 } // namespace gentest
@@ -10,13 +10,19 @@ import io
 import json
 import math
 import sys
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from pathlib import Path
 from typing import Any, Iterable, Sequence
 
 
 DEFAULT_METRICS = ("median_ns_per_item", "p95_ns_per_item", "stddev_ns_per_item")
 SUMMARY_TABLE_SUFFIX = ".summary"
+COMPLEXITY_TABLE_SUFFIX = ".complexity"
+# Ordered from cheapest to most expensive; a move to the right is a regression.
+COMPLEXITY_CLASSES = ("O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)", "O(n^3)")
+ENVIRONMENT_TABLE = "environment"
+# Stable host settings worth flagging between runs; load averages are transient.
+ENVIRONMENT_FIELDS = ("cpu_governor", "no_turbo", "smt_active", "aslr", "online_cpus", "pinned_cpu")
 
 
 @dataclass(frozen=True, order=True)
@@ -46,6 +52,21 @@ class MetricComparison:
     status: str
 
 
+@dataclass
+class ComplexityChange:
+    series: str
+    baseline: str
+    current: str
+    status: str
+
+
+@dataclass
+class EnvironmentDifference:
+    field: str
+    baseline: str
+    current: str
+
+
 @dataclass
 class ComparisonResult:
     comparisons: list[MetricComparison]
@@ -54,6 +75,8 @@ class ComparisonResult:
     missing_cases: list[CaseKey]
     new_cases: list[CaseKey]
     omitted_metrics: list[str]
+    complexity_changes: list[ComplexityChange] = field(default_factory=list)
+    environment_differences: list[EnvironmentDifference] = field(default_factory=list)
 
 
 def _as_float(value: Any) -> float | None:
@@ -162,6 +185,85 @@ def load_report(path: Path) -> dict[CaseKey, CaseMetrics]:
     return _load_csv_report(path, text)
 
 
+def load_complexity_fits(path: Path) -> dict[str, str]:
+    """Return the best-fit class per complexity(n) series, keyed by series name."""
+    text = path.read_text(encoding="utf-8")
+    fits: dict[str, str] = {}
+    if text.lstrip().startswith("{"):
+        payload = json.loads(text)
+        tables = payload.get("tables") if isinstance(payload, dict) else None
+        for table in tables if isinstance(tables, list) else []:
+            if not isinstance(table, dict) or not str(table.get("id", "")).endswith(COMPLEXITY_TABLE_SUFFIX):
+                continue
+            rows = table.get("rows")
+            for row in rows if isinstance(rows, list) else []:
+                if isinstance(row, dict) and "series" in row and "best_fit" in row:
+                    fits[str(row["series"])] = str(row["best_fit"])
+        return fits
+
+    grouped: dict[tuple[str, str], dict[str, str]] = {}
+    for record in csv.DictReader(io.StringIO(text)):
+        table = record.get("table") or ""
+        if not table.endswith(COMPLEXITY_TABLE_SUFFIX):
+            continue
+        grouped.setdefault((table, record.get("row") or ""), {})[record.get("field") or ""] = record.get("value") or ""
+    for fields in grouped.values():
+        if "series" in fields and "best_fit" in fields:
+            fits[fields["series"]] = fields["best_fit"]
+    return fits
+
+
+def compare_complexity(baseline: dict[str, str], current: dict[str, str]) -> list[ComplexityChange]:
+    changes: list[ComplexityChange] = []
+    for series in sorted(set(baseline) & set(current)):
+        before = baseline[series]
+        after = current[series]
+        if before == after:
+            continue
+        status = "changed"
+        if before in COMPLEXITY_CLASSES and after in COMPLEXITY_CLASSES:
+            worse = COMPLEXITY_CLASSES.index(after) > COMPLEXITY_CLASSES.index(before)
+            status = "regression" if worse else "improvement"
+        changes.append(ComplexityChange(series=series, baseline=before, current=after, status=status))
+    return changes
+
+
+def _environment_text(value: Any) -> str:
+    if value is None:
+        return "null"
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    return str(value)
+
+
+def load_environment(path: Path) -> dict[str, str]:
+    """Return the report's environment header as text values; empty for reports without one."""
+    text = path.read_text(encoding="utf-8")
+    if text.lstrip().startswith("{"):
+        payload = json.loads(text)
+        environment = payload.get("environment") if isinstance(payload, dict) else None
+        if not isinstance(environment, dict):
+            return {}
+        return {str(key): _environment_text(value) for key, value in environment.items()}
+
+    environment: dict[str, str] = {}
+    for record in csv.DictReader(io.StringIO(text)):
+        if record.get("table") != ENVIRONMENT_TABLE:
+            continue
+        value = record.get("value") or ""
+        environment[record.get("field") or ""] = "null" if record.get("type") == "null" else value
+    return environment
+
+
+def compare_environment(baseline: dict[str, str], current: dict[str, str]) -> list[EnvironmentDifference]:
+    differences: list[EnvironmentDifference] = []
+    for name in ENVIRONMENT_FIELDS:
+        if name not in baseline or name not in current or baseline[name] == current[name]:
+            continue
+        differences.append(EnvironmentDifference(field=name, baseline=baseline[name], current=current[name]))
+    return differences
+
+
 def _require_cases(label: str, path: Path, cases: dict[CaseKey, CaseMetrics]) -> None:
     if not cases:
         raise ValueError(f"{path}: {label} report contains no measured summary rows")
@@ -288,6 +390,31 @@ def _append_comparison_table(lines: list[str], title: str, rows: Iterable[Metric
     lines.append("")
 
 
+def _append_complexity_table(lines: list[str], rows: Sequence[ComplexityChange]) -> None:
+    lines.extend(["## Complexity Changes", ""])
+    if not rows:
+        lines.extend(["None.", ""])
+        return
+    lines.extend(["| Status | Series | Baseline | Current |", "|--------|--------|----------|---------|"])
+    for row in rows:
+        lines.append(
+            f"| {_markdown_text(row.status)} | {_markdown_code(row.series)} | "
+            f"{_markdown_code(row.baseline)} | {_markdown_code(row.current)} |"
+        )
+    lines.append("")
+
+
+def _append_environment_table(lines: list[str], rows: Sequence[EnvironmentDifference]) -> None:
+    lines.extend(["## Environment Differences", ""])
+    if not rows:
+        lines.extend(["None.", ""])
+        return
+    lines.extend(["| Field | Baseline | Current |", "|-------|----------|---------|"])
+    for row in rows:
+        lines.append(f"| {_markdown_code(row.field)} | {_markdown_code(row.baseline)} | {_markdown_code(row.current)} |")
+    lines.append("")
+
+
 def _append_case_table(lines: list[str], title: str, rows: Iterable[CaseKey]) -> None:
     rows = list(rows)
     lines.extend([f"## {title}", ""])
@@ -309,6 +436,7 @@ def render_markdown(
     min_regression_delta: float,
     fail_on_new: bool,
     fail_on_missing: bool,
+    fail_on_environment_mismatch: bool = False,
 ) -> str:
     stable_count = sum(1 for comparison in result.comparisons if comparison.status == "stable")
     lines = [
@@ -332,17 +460,23 @@ def render_markdown(
         f"| New benchmarks | {len(result.new_cases)} |",
         f"| Missing benchmarks | {len(result.missing_cases)} |",
         f"| Omitted metric values | {len(result.omitted_metrics)} |",
+        f"| Complexity class changes | {len(result.complexity_changes)} |",
+        f"| Environment differences | {len(result.environment_differences)} |",
         "",
     ]
     if fail_on_new:
         lines.extend(["Policy: new benchmarks are failures.", ""])
     if fail_on_missing:
         lines.extend(["Policy: missing benchmarks are failures.", ""])
+    if fail_on_environment_mismatch:
+        lines.extend(["Policy: environment differences are failures.", ""])
 
     _append_comparison_table(lines, "Regressions", result.regressions)
     _append_comparison_table(lines, "Improvements", result.improvements)
     _append_case_table(lines, "New Benchmarks", result.new_cases)
     _append_case_table(lines, "Missing Benchmarks", result.missing_cases)
+    _append_complexity_table(lines, result.complexity_changes)
+    _append_environment_table(lines, result.environment_differences)
 
     if result.omitted_metrics:
         lines.extend(["## Omitted Metrics", ""])
@@ -377,6 +511,11 @@ def parse_args(argv: Sequence[str]) -> argparse.Namespace:
     )
     parser.add_argument("--fail-on-new", action="store_true", help="Treat benchmarks present only in the current report as failures.")
     parser.add_argument("--fail-on-missing", action="store_true", help="Treat benchmarks missing from the current report as failures.")
+    parser.add_argument(
+        "--fail-on-environment-mismatch",
+        action="store_true",
+        help="Fail when the reports' environment headers differ in governor, turbo, SMT, ASLR, CPU count or pinning.",
+    )
     parser.add_argument("--markdown-out", type=Path, help="Write the Markdown summary to this path instead of stdout.")
     args = parser.parse_args(argv)
 
@@ -402,6 +541,8 @@ def main(argv: Sequence[str] | None = None) -> int:
             args.fail_regression_pct,
             args.min_regression_delta,
         )
+        result.complexity_changes = compare_complexity(load_complexity_fits(args.baseline), load_complexity_fits(args.current))
+        result.environment_differences = compare_environment(load_environment(args.baseline), load_environment(args.current))
         markdown = render_markdown(
             args.baseline,
             args.current,
@@ -411,6 +552,7 @@ def main(argv: Sequence[str] | None = None) -> int:
             args.min_regression_delta,
             args.fail_on_new,
             args.fail_on_missing,
+            args.fail_on_environment_mismatch,
         )
         if args.markdown_out:
             args.markdown_out.parent.mkdir(parents=True, exist_ok=True)
@@ -419,8 +561,10 @@ def main(argv: Sequence[str] | None = None) -> int:
             sys.stdout.write(markdown)
 
         failed = bool(result.regressions)
+        failed = failed or any(change.status == "regression" for change in result.complexity_changes)
         failed = failed or (args.fail_on_new and bool(result.new_cases))
         failed = failed or (args.fail_on_missing and bool(result.missing_cases))
+        failed = failed or (args.fail_on_environment_mismatch and bool(result.environment_differences))
         return 1 if failed else 0
     except (OSError, ValueError, json.JSONDecodeError, csv.Error) as exc:
         print(f"error: {exc}", file=sys.stderr)
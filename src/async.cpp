@@ -6,6 +6,7 @@
 #include "runner_context_scope.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <fmt/format.h>
@@ -15,6 +16,7 @@ namespace gentest::detail {
 namespace {
 
 thread_local AsyncScheduler *g_current_async_scheduler = nullptr;
+std::atomic<bool>             g_blocking_virtual_time{false};
 
 enum class BlockingAsyncStatus {
     Completed,
@@ -24,7 +26,11 @@ enum class BlockingAsyncStatus {
 class BlockingAsyncScheduler final : public AsyncScheduler {
   public:
     explicit BlockingAsyncScheduler(std::shared_ptr<TestContextInfo> ctx) : ctx_(std::move(ctx)) {
-        adopted_release_wake_ = std::make_shared<TestContextInfo::AdoptedReleaseWake>();
+        if (g_blocking_virtual_time.load(std::memory_order_acquire)) {
+            virtual_clock_ = std::make_shared<AsyncClock>(std::chrono::steady_clock::now());
+        }
+        adopted_release_wake_            = std::make_shared<TestContextInfo::AdoptedReleaseWake>();
+        adopted_release_wake_->interrupt = core_.io_interrupter();
         register_adopted_release_wake(ctx_, adopted_release_wake_);
         core_.set_wake_callback([this] { adopted_release_wake_->notify_one(); });
     }
@@ -32,6 +38,8 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
 
     void post(std::coroutine_handle<> handle) override { core_.post(handle); }
 
+    void post_waiter(AsyncWaiterToken &token) override { (void)core_.post_waiter(token); }
+
     void post_frame(const AsyncFramePtr &frame) override { core_.post(frame); }
 
     [[nodiscard]] auto make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr override {
@@ -39,9 +47,17 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
     }
 
     void schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) override {
+        if (virtual_clock_) {
+            core_.schedule_virtual_timer(deadline, token);
+            return;
+        }
         core_.schedule_timer(deadline, token);
     }
 
+    [[nodiscard]] auto clock() const -> AsyncClockPtr override { return virtual_clock_; }
+
+    void watch_fd(int fd, AsyncIoInterest interest, const WaiterTokenPtr &token) override { core_.watch_fd(fd, interest, token); }
+
     void cancel_waiters(std::coroutine_handle<> handle) noexcept override { core_.cancel_waiters(handle); }
 
     void block(std::coroutine_handle<> handle, std::string reason) override { core_.block(handle, std::move(reason)); }
@@ -59,6 +75,7 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
         while (true) {
             while (true) {
                 core_.post_due_timers();
+                (void)core_.post_ready_io();
                 auto frame = core_.pop_ready();
                 if (!frame || !frame->handle) {
                     break;
@@ -89,7 +106,15 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
                 return BlockingAsyncStatus::Completed;
             }
 
-            if ((!ctx_ || ctx_->adopted_contexts.load(std::memory_order_acquire) == 0) && !core_.has_pending_timers()) {
+            // Same rule as the batch scheduler: the virtual clock only jumps
+            // once no adopted work or ready I/O could still beat the deadline.
+            if (virtual_clock_ && !has_unfinished_adopted_work() &&
+                (core_.post_ready_io() || core_.advance_virtual_time(*virtual_clock_))) {
+                continue;
+            }
+
+            if ((!ctx_ || ctx_->adopted_contexts.load(std::memory_order_acquire) == 0) && !core_.has_pending_timers() &&
+                !core_.has_io_watches()) {
                 break;
             }
 
@@ -117,7 +142,8 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
   private:
     void wait_for_ready_or_adopted_release() {
         const auto no_pending_wait_locked = [&] {
-            return (!ctx_ || ctx_->adopted_contexts.load(std::memory_order_acquire) == 0) && !core_.next_timer_deadline();
+            return (!ctx_ || ctx_->adopted_contexts.load(std::memory_order_acquire) == 0) && !core_.next_timer_deadline() &&
+                   !core_.has_io_watches();
         };
         const auto ready_or_done_waiting_locked = [&] { return core_.has_ready() || no_pending_wait_locked(); };
 
@@ -127,7 +153,12 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
         if (ready_or_done_waiting_locked()) {
             return;
         }
-        wake_deadline            = core_.next_timer_deadline();
+        wake_deadline = core_.next_timer_deadline();
+        if (core_.has_io_watches()) {
+            wake_lk.unlock();
+            (void)core_.wait_io(wake_deadline);
+            return;
+        }
         const auto wake_observed = [&] { return adopted_release_wake_->generation != wake_generation; };
         if (wake_deadline) {
             (void)adopted_release_wake_->cv.wait_until(wake_lk, *wake_deadline, wake_observed);
@@ -136,11 +167,17 @@ class BlockingAsyncScheduler final : public AsyncScheduler {
         }
     }
 
+    [[nodiscard]] auto has_unfinished_adopted_work() const -> bool {
+        return ctx_ && ctx_->adopted_contexts.load(std::memory_order_acquire) != 0;
+    }
+
     void cancel_all_waiters() { core_.cancel_all(); }
 
     std::shared_ptr<TestContextInfo>                     ctx_;
     std::shared_ptr<TestContextInfo::AdoptedReleaseWake> adopted_release_wake_;
     gentest::runner::AsyncSchedulerCore                  core_;
+    // Private to this run; set when --async-virtual-time is active.
+    AsyncClockPtr virtual_clock_;
 };
 
 auto make_context(std::string_view label) -> std::shared_ptr<TestContextInfo> {
@@ -179,6 +216,10 @@ auto set_current_async_scheduler(AsyncScheduler *scheduler) noexcept -> AsyncSch
     return previous;
 }
 
+auto set_blocking_async_virtual_time(bool enabled) noexcept -> bool {
+    return g_blocking_virtual_time.exchange(enabled, std::memory_order_acq_rel);
+}
+
 auto run_async_task_blocking(async_test<void> task, std::string_view label, std::string &error_out) -> bool {
     error_out.clear();
     auto ctx = make_context(label);
@@ -0,0 +1,146 @@
+#include "async_frame_pool.h"
+
+#include "gentest/async.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace gentest::runner {
+namespace {
+
+constexpr std::size_t kMinBlockShift = 6; // 64-byte smallest class
+constexpr std::size_t kChunkBytes    = 16 * 1024;
+constexpr std::size_t kOversize      = static_cast<std::size_t>(-1);
+
+thread_local AsyncFramePool *g_current_frame_pool = nullptr;
+
+// Precedes every block handed out by async_pool_allocate, pooled or not, so
+// deallocation needs neither the size nor the allocating thread's pool.
+struct alignas(std::max_align_t) BlockHeader {
+    AsyncFramePool                            *pool       = nullptr;
+    std::size_t                                size_class = kOversize;
+    std::atomic<gentest::detail::AsyncFrame *> frame{nullptr};
+};
+
+constexpr auto block_size(std::size_t size_class) -> std::size_t { return std::size_t{1} << (kMinBlockShift + size_class); }
+
+constexpr auto size_class_for(std::size_t bytes) -> std::size_t {
+    if (bytes <= block_size(0)) {
+        return 0;
+    }
+    return static_cast<std::size_t>(std::bit_width(bytes - 1)) - kMinBlockShift;
+}
+
+} // namespace
+
+auto AsyncFramePool::create() -> Ptr { return Ptr(new AsyncFramePool()); }
+
+auto AsyncFramePool::stats() const -> Stats {
+    return Stats{
+        .allocations = allocations_.load(std::memory_order_relaxed),
+        .oversize    = oversize_.load(std::memory_order_relaxed),
+        .peak_bytes  = peak_bytes_.load(std::memory_order_relaxed),
+        .chunks      = chunk_count_.load(std::memory_order_relaxed),
+    };
+}
+
+auto AsyncFramePool::allocate(std::size_t size) -> void * {
+    const std::size_t total      = size + sizeof(BlockHeader);
+    const std::size_t size_class = size_class_for(total);
+    AsyncFramePool   *pool       = g_current_frame_pool;
+
+    void *block = nullptr;
+    if (pool && size_class < kClassCount) {
+        block = pool->allocate_block(size_class);
+    } else {
+        if (pool) {
+            pool->note_oversize();
+        }
+        block = ::operator new(total);
+    }
+    auto *header = ::new (block) BlockHeader{
+        .pool       = size_class < kClassCount ? pool : nullptr,
+        .size_class = size_class < kClassCount ? size_class : kOversize,
+        .frame      = nullptr,
+    };
+    return header + 1;
+}
+
+void AsyncFramePool::set_frame_record(void *ptr, gentest::detail::AsyncFrame *frame) noexcept {
+    (static_cast<BlockHeader *>(ptr) - 1)->frame.store(frame, std::memory_order_release);
+}
+
+auto AsyncFramePool::frame_record(void *ptr) noexcept -> gentest::detail::AsyncFrame * {
+    return (static_cast<BlockHeader *>(ptr) - 1)->frame.load(std::memory_order_acquire);
+}
+
+void AsyncFramePool::deallocate(void *ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto *header = static_cast<BlockHeader *>(ptr) - 1;
+    if (!header->pool) {
+        ::operator delete(static_cast<void *>(header));
+        return;
+    }
+    header->pool->deallocate_block(header, header->size_class);
+}
+
+auto AsyncFramePool::allocate_block(std::size_t size_class) -> void * {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    auto &head = free_[size_class];
+    if (!head) {
+        head = returned_[size_class].exchange(nullptr, std::memory_order_acquire);
+    }
+    if (!head) {
+        const std::size_t bytes = block_size(size_class);
+        const std::size_t count = std::max<std::size_t>(kChunkBytes / bytes, 4);
+        chunks_.push_back(std::make_unique<std::byte[]>(bytes * count));
+        chunk_count_.fetch_add(1, std::memory_order_relaxed);
+        std::byte *base = chunks_.back().get();
+        for (std::size_t i = count; i-- > 0;) {
+            head = ::new (static_cast<void *>(base + i * bytes)) FreeBlock{head};
+        }
+    }
+    FreeBlock *block = head;
+    head             = block->next;
+    const std::size_t live = live_bytes_.fetch_add(block_size(size_class), std::memory_order_relaxed) + block_size(size_class);
+    if (live > peak_bytes_.load(std::memory_order_relaxed)) {
+        peak_bytes_.store(live, std::memory_order_relaxed);
+    }
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+void AsyncFramePool::deallocate_block(void *block, std::size_t size_class) noexcept {
+    auto &returned = returned_[size_class];
+    auto *freed    = ::new (block) FreeBlock{returned.load(std::memory_order_relaxed)};
+    while (!returned.compare_exchange_weak(freed->next, freed, std::memory_order_release, std::memory_order_relaxed)) {
+        // A failed exchange reloaded the current head into freed->next.
+    }
+    live_bytes_.fetch_sub(block_size(size_class), std::memory_order_relaxed);
+    release();
+}
+
+void AsyncFramePool::note_oversize() noexcept { oversize_.fetch_add(1, std::memory_order_relaxed); }
+
+void AsyncFramePool::release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+AsyncFramePoolScope::AsyncFramePoolScope(AsyncFramePool *pool) noexcept : previous_(g_current_frame_pool) { g_current_frame_pool = pool; }
+
+AsyncFramePoolScope::~AsyncFramePoolScope() { g_current_frame_pool = previous_; }
+
+} // namespace gentest::runner
+
+namespace gentest::detail {
+
+auto async_pool_allocate(std::size_t size) -> void * { return gentest::runner::AsyncFramePool::allocate(size); }
+
+void async_pool_deallocate(void *ptr) noexcept { gentest::runner::AsyncFramePool::deallocate(ptr); }
+
+} // namespace gentest::detail
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gentest::detail {
+struct AsyncFrame;
+} // namespace gentest::detail
+
+namespace gentest::runner {
+
+// Size-class pool serving gentest::detail::async_pool_allocate for one async
+// case. Freed blocks go back to per-class free lists; the chunks themselves are
+// released together once the owner retires the pool and the last block has
+// been returned, so a case's frames never pay for individual frees.
+//
+// The pool takes no lock. Only the thread currently resuming the case allocates
+// from it (the scheduler never runs one case on two workers at once), so the
+// allocation-side lists are unsynchronized. Frees may come from any thread and
+// are pushed onto a per-class atomic stack that the allocating side takes over
+// in one exchange once its own list runs dry.
+class AsyncFramePool {
+  public:
+    struct Stats {
+        std::uint64_t allocations = 0; // served from a size class
+        std::uint64_t oversize    = 0; // larger than the biggest class, served by operator new
+        std::size_t   peak_bytes  = 0; // pooled bytes in use at once, headers included
+        std::size_t   chunks      = 0;
+    };
+
+    struct Retire {
+        void operator()(AsyncFramePool *pool) const noexcept { pool->release(); }
+    };
+
+    using Ptr = std::unique_ptr<AsyncFramePool, Retire>;
+
+    [[nodiscard]] static auto create() -> Ptr;
+
+    AsyncFramePool(const AsyncFramePool &)            = delete;
+    AsyncFramePool &operator=(const AsyncFramePool &) = delete;
+
+    [[nodiscard]] auto stats() const -> Stats;
+
+    // Backends of async_pool_allocate/async_pool_deallocate. Allocation uses
+    // the pool installed on this thread by AsyncFramePoolScope, if any.
+    [[nodiscard]] static auto allocate(std::size_t size) -> void *;
+    static void               deallocate(void *ptr) noexcept;
+
+    // Scheduler record of the coroutine frame stored at `ptr`, an address
+    // returned by allocate(). Coroutine frames of gentest::async_test come from
+    // allocate(), so a type-erased handle reaches its AsyncFrame through the
+    // block header instead of a lookup table. Null until a scheduler sets it.
+    static void               set_frame_record(void *ptr, gentest::detail::AsyncFrame *frame) noexcept;
+    [[nodiscard]] static auto frame_record(void *ptr) noexcept -> gentest::detail::AsyncFrame *;
+
+  private:
+    static constexpr std::size_t kClassCount = 7; // 64 B .. 4 KiB
+
+    struct FreeBlock {
+        FreeBlock *next = nullptr;
+    };
+
+    AsyncFramePool()  = default;
+    ~AsyncFramePool() = default;
+
+    [[nodiscard]] auto allocate_block(std::size_t size_class) -> void *;
+    void               deallocate_block(void *block, std::size_t size_class) noexcept;
+    void               note_oversize() noexcept;
+    void               release() noexcept;
+
+    // Allocation side: touched only by the thread resuming the case.
+    std::array<FreeBlock *, kClassCount>              free_{};
+    std::vector<std::unique_ptr<std::byte[]>>         chunks_;
+    // Blocks freed by any thread, waiting to be taken over by free_.
+    std::array<std::atomic<FreeBlock *>, kClassCount> returned_{};
+    std::atomic<std::size_t>                          live_bytes_{0};
+    std::atomic<std::uint64_t>                        allocations_{0};
+    std::atomic<std::uint64_t>                        oversize_{0};
+    std::atomic<std::size_t>                          peak_bytes_{0};
+    std::atomic<std::size_t>                          chunk_count_{0};
+    // One reference for the owner plus one per outstanding block.
+    std::atomic<std::size_t> refs_{1};
+};
+
+// Routes pooled allocations made on this thread to `pool` (null restores the
+// operator new fallback) for the lifetime of the scope.
+class AsyncFramePoolScope {
+  public:
+    explicit AsyncFramePoolScope(AsyncFramePool *pool) noexcept;
+    AsyncFramePoolScope(const AsyncFramePoolScope &)            = delete;
+    AsyncFramePoolScope &operator=(const AsyncFramePoolScope &) = delete;
+    ~AsyncFramePoolScope();
+
+  private:
+    AsyncFramePool *previous_ = nullptr;
+};
+
+} // namespace gentest::runner
@@ -0,0 +1,316 @@
+#include "async_io_poller.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#if defined(__linux__)
+#define GENTEST_ASYNC_IO_EPOLL 1
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define GENTEST_ASYNC_IO_POLL 1
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace gentest::runner {
+namespace {
+
+[[maybe_unused]] auto timeout_ms(std::optional<AsyncIoPoller::time_point> deadline) -> int {
+    if (!deadline) {
+        return -1;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (*deadline <= now) {
+        return 0;
+    }
+    // Round up so a wait never returns just before a timer deadline.
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(*deadline - now).count();
+    return static_cast<int>(std::min<decltype(ms)>(ms, 60 * 60 * 1000));
+}
+
+} // namespace
+
+// The self-wake fd. Shared with interrupter() callbacks, which may outlive the
+// poller; `pending` collapses repeated notifications into one write per wait.
+// drain() reads the fd empty before clearing `pending`: a notify() racing the
+// drain either finds `pending` still set, and the waiter that is draining is
+// already awake, or writes again after the clear and wakes the next wait.
+struct AsyncIoPoller::Wakeup {
+    std::atomic<int>  write_fd{-1};
+    int               read_fd = -1;
+    std::atomic<bool> pending{false};
+
+    Wakeup() = default;
+
+    Wakeup(const Wakeup &)            = delete;
+    Wakeup &operator=(const Wakeup &) = delete;
+
+    ~Wakeup() {
+#if defined(GENTEST_ASYNC_IO_EPOLL) || defined(GENTEST_ASYNC_IO_POLL)
+        const int write_end = write_fd.load(std::memory_order_acquire);
+        if (write_end >= 0 && write_end != read_fd) {
+            ::close(write_end);
+        }
+        if (read_fd >= 0) {
+            ::close(read_fd);
+        }
+#endif
+    }
+
+    void notify() noexcept {
+#if defined(GENTEST_ASYNC_IO_EPOLL) || defined(GENTEST_ASYNC_IO_POLL)
+        const int fd = write_fd.load(std::memory_order_acquire);
+        if (fd < 0 || pending.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+#if defined(GENTEST_ASYNC_IO_EPOLL)
+        const std::uint64_t one = 1;
+        (void)!::write(fd, &one, sizeof(one));
+#else
+        const char byte = 0;
+        (void)!::write(fd, &byte, 1);
+#endif
+#endif
+    }
+
+    void drain() noexcept {
+#if defined(GENTEST_ASYNC_IO_EPOLL) || defined(GENTEST_ASYNC_IO_POLL)
+        std::array<char, 64> buf{};
+        while (::read(read_fd, buf.data(), buf.size()) > 0) {
+        }
+        pending.store(false, std::memory_order_release);
+#endif
+    }
+};
+
+AsyncIoPoller::AsyncIoPoller() : wakeup_(std::make_shared<Wakeup>()) {}
+
+AsyncIoPoller::~AsyncIoPoller() {
+#if defined(GENTEST_ASYNC_IO_EPOLL)
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+#endif
+}
+
+auto AsyncIoPoller::interrupter() const -> std::function<void()> {
+    return [wakeup = wakeup_]() noexcept { wakeup->notify(); };
+}
+
+auto AsyncIoPoller::open_locked() -> bool {
+    if (wakeup_->write_fd.load(std::memory_order_relaxed) >= 0) {
+        return true;
+    }
+    if (open_error_ != 0) {
+        return false;
+    }
+#if defined(GENTEST_ASYNC_IO_EPOLL)
+    const int event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd < 0) {
+        open_error_ = errno;
+        return false;
+    }
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events  = EPOLLIN;
+    ev.data.fd = event_fd;
+    if (epoll_fd_ < 0 || ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd, &ev) != 0) {
+        open_error_ = errno;
+        ::close(event_fd);
+        return false;
+    }
+    wakeup_->read_fd = event_fd;
+    wakeup_->write_fd.store(event_fd, std::memory_order_release);
+    return true;
+#elif defined(GENTEST_ASYNC_IO_POLL)
+    std::array<int, 2> ends{-1, -1};
+    if (::pipe(ends.data()) != 0) {
+        open_error_ = errno;
+        return false;
+    }
+    for (const int end : ends) {
+        (void)::fcntl(end, F_SETFL, ::fcntl(end, F_GETFL) | O_NONBLOCK);
+        (void)::fcntl(end, F_SETFD, FD_CLOEXEC);
+    }
+    wakeup_->read_fd = ends[0];
+    wakeup_->write_fd.store(ends[1], std::memory_order_release);
+    return true;
+#else
+    open_error_ = static_cast<int>(std::errc::function_not_supported);
+    return false;
+#endif
+}
+
+void AsyncIoPoller::watch(int fd, Interest interest, const WaiterTokenPtr &token) {
+    if (!token) {
+        return;
+    }
+    bool interrupt = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!open_locked()) {
+            throw std::system_error(open_error_, std::generic_category(), "gentest: cannot watch async fd " + std::to_string(fd));
+        }
+        fds_[fd].watches.push_back(Watch{.interest = interest, .token = token});
+        watch_count_.fetch_add(1, std::memory_order_release);
+        // A wait already in progress does not know about this fd yet.
+        interrupt = waiting_;
+    }
+    if (interrupt) {
+        wakeup_->notify();
+    }
+}
+
+auto AsyncIoPoller::has_watches() const noexcept -> bool { return watch_count_.load(std::memory_order_acquire) != 0; }
+
+void AsyncIoPoller::forget_locked(std::size_t count) noexcept { watch_count_.fetch_sub(count, std::memory_order_release); }
+
+// Drops canceled waiters and brings the epoll registrations in line with the
+// remaining ones. An fd that epoll refuses (closed, or a regular file that is
+// always ready) resumes its waiters so the caller's own I/O reports it.
+void AsyncIoPoller::sync_locked(std::vector<WaiterTokenPtr> &ready) {
+    for (auto it = fds_.begin(); it != fds_.end();) {
+        auto &[fd, state] = *it;
+        forget_locked(std::erase_if(state.watches, [](const Watch &watch) { return !watch.token->active(); }));
+#if defined(GENTEST_ASYNC_IO_EPOLL)
+        std::uint32_t wanted = 0;
+        for (const auto &watch : state.watches) {
+            wanted |= watch.interest == Interest::Readable ? EPOLLIN | EPOLLRDHUP : EPOLLOUT;
+        }
+        if (wanted != state.registered) {
+            epoll_event ev{};
+            ev.events  = wanted;
+            ev.data.fd = fd;
+            int rc     = 0;
+            if (wanted == 0) {
+                rc = ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, &ev);
+            } else if (state.registered == 0) {
+                rc = ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+                if (rc != 0 && errno == EEXIST) {
+                    rc = ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+                }
+            } else {
+                rc = ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+                // Closing an fd drops its registration; the number may have
+                // been reused since.
+                if (rc != 0 && errno == ENOENT) {
+                    rc = ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+                }
+            }
+            state.registered = wanted;
+            if (rc != 0 && wanted != 0) {
+                state.registered = 0;
+                for (auto &watch : state.watches) {
+                    ready.push_back(std::move(watch.token));
+                }
+                forget_locked(state.watches.size());
+                state.watches.clear();
+            }
+        }
+#endif
+        if (state.watches.empty() && state.registered == 0) {
+            it = fds_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AsyncIoPoller::take_ready_locked(int fd, bool readable, bool writable, std::vector<WaiterTokenPtr> &ready) {
+    const auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+        return;
+    }
+    auto &watches = it->second.watches;
+    auto  kept    = watches.begin();
+    for (auto &watch : watches) {
+        if (watch.interest == Interest::Readable ? readable : writable) {
+            if (watch.token->active()) {
+                ready.push_back(std::move(watch.token));
+            }
+        } else {
+            *kept++ = std::move(watch);
+        }
+    }
+    forget_locked(static_cast<std::size_t>(watches.end() - kept));
+    watches.erase(kept, watches.end());
+}
+
+auto AsyncIoPoller::wait(std::optional<time_point> deadline) -> std::vector<WaiterTokenPtr> {
+    std::vector<WaiterTokenPtr> ready;
+#if defined(GENTEST_ASYNC_IO_EPOLL)
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!open_locked()) {
+            return ready;
+        }
+        sync_locked(ready);
+        if (!has_watches()) {
+            return ready;
+        }
+        waiting_ = true;
+    }
+    std::array<epoll_event, 64> events{};
+    const int n = ::epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), ready.empty() ? timeout_ms(deadline) : 0);
+    std::lock_guard<std::mutex> lk(mtx_);
+    waiting_ = false;
+    for (int i = 0; i < n; ++i) {
+        const auto &ev = events[static_cast<std::size_t>(i)];
+        if (ev.data.fd == wakeup_->read_fd) {
+            wakeup_->drain();
+            continue;
+        }
+        const bool failed = (ev.events & (EPOLLERR | EPOLLHUP)) != 0;
+        take_ready_locked(ev.data.fd, failed || (ev.events & (EPOLLIN | EPOLLRDHUP)) != 0, failed || (ev.events & EPOLLOUT) != 0, ready);
+    }
+#elif defined(GENTEST_ASYNC_IO_POLL)
+    std::vector<pollfd> polled;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!open_locked()) {
+            return ready;
+        }
+        sync_locked(ready);
+        if (!has_watches()) {
+            return ready;
+        }
+        waiting_ = true;
+        polled.push_back(pollfd{.fd = wakeup_->read_fd, .events = POLLIN, .revents = 0});
+        for (const auto &[fd, state] : fds_) {
+            short events = 0;
+            for (const auto &watch : state.watches) {
+                events |= watch.interest == Interest::Readable ? POLLIN : POLLOUT;
+            }
+            polled.push_back(pollfd{.fd = fd, .events = events, .revents = 0});
+        }
+    }
+    const int n = ::poll(polled.data(), static_cast<nfds_t>(polled.size()), ready.empty() ? timeout_ms(deadline) : 0);
+    std::lock_guard<std::mutex> lk(mtx_);
+    waiting_ = false;
+    if (n > 0) {
+        if (polled.front().revents != 0) {
+            wakeup_->drain();
+        }
+        for (std::size_t i = 1; i < polled.size(); ++i) {
+            const short revents = polled[i].revents;
+            const bool  failed  = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+            if (revents != 0) {
+                take_ready_locked(polled[i].fd, failed || (revents & POLLIN) != 0, failed || (revents & POLLOUT) != 0, ready);
+            }
+        }
+    }
+#else
+    (void)deadline;
+#endif
+    return ready;
+}
+
+} // namespace gentest::runner
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "gentest/async.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace gentest::runner {
+
+// fd readiness behind gentest::async::readable/writable. Watches are level
+// triggered and one-shot: once an fd is ready, every waiter registered for that
+// direction is returned and forgotten. Linux waits in epoll, other POSIX
+// systems in poll(); an eventfd (or pipe) lets other threads interrupt a wait.
+// Nothing is opened until the first watch. When that fails, or the platform
+// has no backend (Windows), watch() throws std::system_error.
+class AsyncIoPoller {
+  public:
+    using time_point     = std::chrono::steady_clock::time_point;
+    using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
+    using Interest       = gentest::detail::AsyncIoInterest;
+
+    AsyncIoPoller();
+    ~AsyncIoPoller();
+
+    AsyncIoPoller(const AsyncIoPoller &)            = delete;
+    AsyncIoPoller &operator=(const AsyncIoPoller &) = delete;
+
+    void watch(int fd, Interest interest, const WaiterTokenPtr &token);
+
+    // True while some watch is registered. A canceled waiter still counts until
+    // the next wait() drops it.
+    [[nodiscard]] auto has_watches() const noexcept -> bool;
+
+    // Blocks until a watched fd is ready, the interrupter runs, or `deadline`
+    // passes (nullopt waits indefinitely; a past deadline only polls), then
+    // returns the waiters to post. Returns at once when no watch is left after
+    // dropping canceled ones. Only one thread may wait at a time.
+    [[nodiscard]] auto wait(std::optional<time_point> deadline) -> std::vector<WaiterTokenPtr>;
+
+    // Wakes a blocked wait() from any thread; the callback stays safe to call
+    // after the poller is destroyed.
+    [[nodiscard]] auto interrupter() const -> std::function<void()>;
+
+  private:
+    struct Wakeup;
+
+    struct Watch {
+        Interest       interest = Interest::Readable;
+        WaiterTokenPtr token;
+    };
+
+    struct FdState {
+        std::vector<Watch> watches;
+        std::uint32_t      registered = 0; // events currently registered with epoll
+    };
+
+    [[nodiscard]] auto open_locked() -> bool;
+    void               sync_locked(std::vector<WaiterTokenPtr> &ready);
+    void               take_ready_locked(int fd, bool readable, bool writable, std::vector<WaiterTokenPtr> &ready);
+    void               forget_locked(std::size_t count) noexcept;
+
+    std::mutex                       mtx_;
+    std::unordered_map<int, FdState> fds_;
+    std::atomic<std::size_t>         watch_count_{0}; // watches held in fds_, written under mtx_
+    std::shared_ptr<Wakeup>          wakeup_;
+    int                              epoll_fd_   = -1;
+    int                              open_error_ = 0;     // errno of a failed open; it is not retried
+    bool                             waiting_    = false; // between a wait()'s snapshot and its wake-up
+};
+
+} // namespace gentest::runner
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "async_frame_pool.h"
+#include "async_io_poller.h"
+#include "async_slab.h"
 #include "async_timer_queue.h"
 #include "gentest/async.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <coroutine>
 #include <cstddef>
@@ -11,11 +15,11 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <source_location>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,12 +38,46 @@ class AsyncSchedulerCore {
     };
 
     using FramePtr       = gentest::detail::AsyncFramePtr;
+    using WaiterToken    = gentest::detail::AsyncWaiterToken;
     using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
     using WakeCallback   = std::function<void()>;
 
     static constexpr std::size_t kInvalidOwner = std::numeric_limits<std::size_t>::max();
 
-    explicit AsyncSchedulerCore(WakeCallback wake = {}) : wake_(std::move(wake)) {}
+    struct ReadyFrame {
+        FramePtr    frame;
+        std::size_t owner = kInvalidOwner;
+
+        explicit operator bool() const noexcept { return static_cast<bool>(frame); }
+    };
+
+    // Ready frames are kept in one lane per worker. `lanes` is fixed for the
+    // core's lifetime; a single lane reproduces the original FIFO order.
+    // `timers` selects the queue behind both the real and virtual timers.
+    explicit AsyncSchedulerCore(WakeCallback wake = {}, std::size_t lanes = 1,
+                                gentest::detail::AsyncTimerQueueKind timers = gentest::detail::AsyncTimerQueueKind::Heap)
+        : wake_(std::move(wake)), timers_(timers), virtual_timers_(timers) {
+        lanes_.resize(std::max<std::size_t>(lanes, 1));
+        for (auto &lane : lanes_) {
+            lane = std::make_unique<ReadyLane>();
+        }
+    }
+
+    AsyncSchedulerCore(const AsyncSchedulerCore &)            = delete;
+    AsyncSchedulerCore &operator=(const AsyncSchedulerCore &) = delete;
+
+    // Frames and tokens may outlive the core: unlisted tokens stop keeping
+    // themselves alive and frame headers stop pointing here.
+    ~AsyncSchedulerCore() {
+        std::vector<WaiterTokenPtr> tokens;
+        for (const auto &shard : shards_) {
+            for (const auto &frame : shard->frames) {
+                unlist_waiters_locked(*frame, tokens);
+                AsyncFramePool::set_frame_record(frame->address(), nullptr);
+                frame->links.shard.store(nullptr, std::memory_order_release);
+            }
+        }
+    }
 
     void set_wake_callback(WakeCallback wake) { wake_ = std::move(wake); }
 
@@ -47,54 +85,92 @@ class AsyncSchedulerCore {
         if (!frame || !frame->handle) {
             return;
         }
-        std::lock_guard<std::mutex> lk(mtx_);
-        frames_[frame->address()] = frame;
-        owners_[frame->address()] = owner;
+        std::vector<FramePtr> released;
+        (void)adopt_frame(shard_for(owner), frame, nullptr, released);
     }
 
     [[nodiscard]] auto owner_for(std::coroutine_handle<> handle) const -> std::size_t {
-        std::lock_guard<std::mutex> lk(mtx_);
-        return owner_for_locked(handle.address());
+        const auto locked = lock_handle(handle.address());
+        return locked.frame ? locked.frame->links.owner : kInvalidOwner;
     }
 
     [[nodiscard]] auto owner_for(const FramePtr &frame) const -> std::size_t {
         if (!frame) {
             return kInvalidOwner;
         }
-        std::lock_guard<std::mutex> lk(mtx_);
-        return owner_for_locked(frame->address());
+        const auto lk = lock_shard(frame->links.shard);
+        return lk ? frame->links.owner : kInvalidOwner;
     }
 
     [[nodiscard]] auto make_waiter(std::coroutine_handle<> handle, const std::shared_ptr<gentest::detail::AsyncScheduler::Control> &control)
         -> WaiterTokenPtr {
-        FramePtr frame;
-        {
-            std::lock_guard<std::mutex> lk(mtx_);
-            frame = frame_for_locked(handle.address());
-        }
-
-        auto token = std::make_shared<gentest::detail::AsyncScheduler::WaiterToken>(control, frame);
+        auto                        token = std::allocate_shared<WaiterToken>(TokenAllocator{token_slab_}, control);
+        std::vector<WaiterTokenPtr> released;
+        const auto                  locked = lock_handle(handle.address());
+        auto                       *frame  = locked.frame;
         if (!frame || frame->is_canceled()) {
             token->cancel();
             return token;
         }
 
-        std::lock_guard<std::mutex> lk(mtx_);
-        if (owner_for_locked(frame->address()) == kInvalidOwner) {
-            token->cancel();
-            return token;
+        auto &links = frame->links;
+        // Canceled waiters stay listed until the list doubles; then they are
+        // dropped, so a frame that awaits in a loop keeps a bounded list.
+        if (links.waiter_count >= links.waiters_compact_at) {
+            for (auto *waiter = links.waiters; waiter != nullptr;) {
+                auto *next = waiter->frame_hook.next;
+                if (!waiter->active()) {
+                    released.push_back(unlist_waiter_locked(*waiter));
+                }
+                waiter = next;
+            }
+            links.waiters_compact_at = std::max<std::size_t>(kMinWaiterCompaction, links.waiter_count * 2);
         }
-        waiter_tokens_[frame->address()].push_back(token);
+        list_waiter_locked(*frame, token);
         return token;
     }
 
+    // A fired token leaves its frame's waiter list and queues the frame unless
+    // it was canceled or finished meanwhile. Returns whether it was queued.
+    auto post_waiter(WaiterToken &token) -> bool {
+        WaiterTokenPtr listed;
+        std::size_t    owner = kInvalidOwner;
+        FramePtr       frame;
+        {
+            const auto lk = lock_shard(token.frame_hook.shard);
+            if (!lk) {
+                return false;
+            }
+            auto *raw = token.frame_hook.frame;
+            listed    = unlist_waiter_locked(token);
+            owner  = prepare_post_locked(*raw);
+            if (owner == kInvalidOwner) {
+                return false;
+            }
+            frame = frame_ptr_locked(*raw);
+        }
+        push_ready(ReadyFrame{.frame = std::move(frame), .owner = owner});
+        notify_wake(true);
+        return true;
+    }
+
     void post(std::coroutine_handle<> handle) {
-        FramePtr frame;
+        std::size_t owner = kInvalidOwner;
+        FramePtr    frame;
         {
-            std::lock_guard<std::mutex> lk(mtx_);
-            frame = frame_for_locked(handle.address());
+            const auto locked = lock_handle(handle.address());
+            auto      *raw    = locked.frame;
+            if (!raw) {
+                return;
+            }
+            owner = prepare_post_locked(*raw);
+            if (owner == kInvalidOwner) {
+                return;
+            }
+            frame = frame_ptr_locked(*raw);
         }
-        post(std::move(frame));
+        push_ready(ReadyFrame{.frame = std::move(frame), .owner = owner});
+        notify_wake(true);
     }
 
     void post(FramePtr frame) {
@@ -102,23 +178,19 @@ class AsyncSchedulerCore {
             return;
         }
 
-        bool should_wake = false;
+        std::size_t owner = kInvalidOwner;
         {
-            std::lock_guard<std::mutex> lk(mtx_);
-            const auto                  address = frame->address();
-            if (owner_for_locked(address) == kInvalidOwner) {
-                blocked_.erase(address);
+            const auto lk = lock_shard(frame->links.shard);
+            if (!lk) {
                 return;
             }
-            if (frame->is_canceled() || frame->done()) {
-                blocked_.erase(address);
+            owner = prepare_post_locked(*frame);
+            if (owner == kInvalidOwner) {
                 return;
             }
-            blocked_.erase(address);
-            ready_.push_back(std::move(frame));
-            should_wake = true;
         }
-        notify_wake(should_wake);
+        push_ready(ReadyFrame{.frame = std::move(frame), .owner = owner});
+        notify_wake(true);
     }
 
     void block(std::coroutine_handle<> handle, std::string reason, const std::source_location &loc = {}) {
@@ -129,17 +201,11 @@ class AsyncSchedulerCore {
         if (!handle) {
             return;
         }
-        std::lock_guard<std::mutex> lk(mtx_);
-        const auto                  owner = owner_for_locked(handle.address());
-        if (owner == kInvalidOwner) {
+        const auto locked = lock_handle(handle.address());
+        if (!locked.frame) {
             return;
         }
-        blocked_[handle.address()] = BlockedHandle{.owner    = owner,
-                                                   .kind     = kind,
-                                                   .sequence = ++suspend_sequence_,
-                                                   .reason   = reason.empty() ? std::string("async test cannot resume") : std::move(reason),
-                                                   .file     = loc.file_name() == nullptr ? std::string{} : std::string(loc.file_name()),
-                                                   .line     = loc.line()};
+        mark_blocked_locked(*locked.frame, kind, reason.empty() ? std::string("async test cannot resume") : std::move(reason), loc);
     }
 
     void yield(std::coroutine_handle<> handle, const std::source_location &loc) {
@@ -147,58 +213,48 @@ class AsyncSchedulerCore {
             return;
         }
 
-        bool should_wake = false;
+        FramePtr    frame;
+        std::size_t owner = kInvalidOwner;
         {
-            std::lock_guard<std::mutex> lk(mtx_);
-            auto                        frame = frame_for_locked(handle.address());
-            const auto                  owner = owner_for_locked(handle.address());
-            if (!frame || owner == kInvalidOwner || frame->is_canceled() || frame->done()) {
+            const auto locked = lock_handle(handle.address());
+            auto      *raw    = locked.frame;
+            if (!raw || raw->is_canceled() || raw->done()) {
                 return;
             }
-            blocked_[handle.address()] = BlockedHandle{.owner    = owner,
-                                                       .kind     = SuspendKind::Yielded,
-                                                       .sequence = ++suspend_sequence_,
-                                                       .reason   = "yielded cooperatively",
-                                                       .file = loc.file_name() == nullptr ? std::string{} : std::string(loc.file_name()),
-                                                       .line = loc.line()};
-            ready_.push_back(std::move(frame));
-            should_wake = true;
+            owner = raw->links.owner;
+            frame = frame_ptr_locked(*raw);
+            mark_blocked_locked(*raw, SuspendKind::Yielded, "yielded cooperatively", loc);
         }
-        notify_wake(should_wake);
+        push_ready(ReadyFrame{.frame = std::move(frame), .owner = owner});
+        notify_wake(true);
     }
 
     void attach_child(const FramePtr &child, std::coroutine_handle<> parent) {
         if (!child || !child->handle || !parent) {
             return;
         }
-        std::lock_guard<std::mutex> lk(mtx_);
-        const auto                  parent_owner = owner_for_locked(parent.address());
-        if (parent_owner == kInvalidOwner) {
-            return;
+        std::vector<FramePtr> released;
+        for (;;) {
+            auto *parent_frame = AsyncFramePool::frame_record(parent.address());
+            auto *shard        = parent_frame ? shard_of(parent_frame->links.shard.load(std::memory_order_acquire)) : nullptr;
+            if (!shard || adopt_frame(*shard, child, parent_frame, released)) {
+                return;
+            }
         }
-        frames_[child->address()] = child;
-        owners_[child->address()] = parent_owner;
-        auto &children            = children_[parent.address()];
-        auto &parents             = parents_[child->address()];
-        children.push_back(ChildReference{
-            .child             = child->address(),
-            .parent_link_index = parents.size(),
-        });
-        parents.push_back(ParentReference{
-            .parent      = parent.address(),
-            .child_index = children.size() - 1,
-        });
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters) - Mirrors the public scheduler hook.
     void attach_child(std::coroutine_handle<> child, std::coroutine_handle<> parent) {
-        if (!child) {
+        if (!child || !parent) {
             return;
         }
         FramePtr child_frame;
         {
-            std::lock_guard<std::mutex> lk(mtx_);
-            child_frame = frame_for_locked(child.address());
+            const auto locked = lock_handle(child.address());
+            if (!locked.frame) {
+                return;
+            }
+            child_frame = frame_ptr_locked(*locked.frame);
         }
         attach_child(child_frame, parent);
     }
@@ -208,7 +264,7 @@ class AsyncSchedulerCore {
             return;
         }
         {
-            std::lock_guard<std::mutex> lk(mtx_);
+            std::lock_guard<std::mutex> lk(timers_mtx_);
             timers_.push(deadline, token);
         }
         notify_wake(true);
@@ -217,7 +273,7 @@ class AsyncSchedulerCore {
     void post_due_timers() {
         std::vector<WaiterTokenPtr> due;
         {
-            std::lock_guard<std::mutex> lk(mtx_);
+            std::lock_guard<std::mutex> lk(timers_mtx_);
             due = timers_.pop_due(std::chrono::steady_clock::now());
         }
         for (auto &token : due) {
@@ -225,72 +281,188 @@ class AsyncSchedulerCore {
         }
     }
 
+    // Virtual timers never fire on their own; advance_virtual_time() moves the
+    // clock to the earliest deadline and posts every waiter due at that instant.
+    void schedule_virtual_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) {
+        std::lock_guard<std::mutex> lk(timers_mtx_);
+        virtual_timers_.push(deadline, token);
+    }
+
+    [[nodiscard]] auto advance_virtual_time(gentest::detail::AsyncClock &clock) -> bool {
+        std::vector<WaiterTokenPtr> due;
+        {
+            std::lock_guard<std::mutex> lk(timers_mtx_);
+            const auto                  deadline = virtual_timers_.next_deadline();
+            if (!deadline) {
+                return false;
+            }
+            clock.advance_to(*deadline);
+            due = virtual_timers_.pop_due(clock.now());
+        }
+        for (auto &token : due) {
+            token->post();
+        }
+        return true;
+    }
+
     [[nodiscard]] auto next_timer_deadline() -> std::optional<std::chrono::steady_clock::time_point> {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<std::mutex> lk(timers_mtx_);
         return timers_.next_deadline();
     }
 
     [[nodiscard]] auto has_pending_timers() -> bool {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<std::mutex> lk(timers_mtx_);
         return timers_.has_pending();
     }
 
+    // fd watches live in their own poller and never take a shard lock, so a wait can
+    // block in the kernel while other threads post frames.
+    void watch_fd(int fd, gentest::detail::AsyncIoInterest interest, const WaiterTokenPtr &token) { io_.watch(fd, interest, token); }
+
+    [[nodiscard]] auto has_io_watches() -> bool { return io_.has_watches(); }
+
+    // Waits for a watched fd until `deadline` (nullopt: no limit) and posts the
+    // waiters of every ready fd. Returns whether any was posted.
+    auto wait_io(std::optional<std::chrono::steady_clock::time_point> deadline) -> bool {
+        auto ready = io_.wait(deadline);
+        for (auto &token : ready) {
+            token->post();
+        }
+        return !ready.empty();
+    }
+
+    // Non-blocking wait_io().
+    auto post_ready_io() -> bool { return io_.has_watches() && wait_io(std::chrono::steady_clock::time_point{}); }
+
+    // Wakes a wait_io() in progress; see AsyncIoPoller::interrupter().
+    [[nodiscard]] auto io_interrupter() const -> std::function<void()> { return io_.interrupter(); }
+
     [[nodiscard]] auto ready_size() const -> std::size_t {
-        std::lock_guard<std::mutex> lk(mtx_);
-        return ready_.size();
+        std::size_t size = 0;
+        for (const auto &lane : lanes_) {
+            std::lock_guard<std::mutex> lk(lane->mtx);
+            size += lane->frames.size();
+        }
+        return size;
     }
 
     [[nodiscard]] auto has_ready() const -> bool {
-        std::lock_guard<std::mutex> lk(mtx_);
-        return !ready_.empty();
+        return std::ranges::any_of(lanes_, [](const std::unique_ptr<ReadyLane> &lane) {
+            std::lock_guard<std::mutex> lk(lane->mtx);
+            return !lane->frames.empty();
+        });
     }
 
+    [[nodiscard]] auto lane_count() const noexcept -> std::size_t { return lanes_.size(); }
+
+    // Single-threaded pop used outside worker phases: takes the oldest frame of
+    // the first non-empty lane and ignores owner claims.
     [[nodiscard]] auto pop_ready() -> FramePtr {
-        std::lock_guard<std::mutex> lk(mtx_);
-        while (!ready_.empty()) {
-            auto frame = std::move(ready_.front());
-            ready_.pop_front();
-            if (frame && !frame->is_canceled()) {
-                return frame;
+        for (auto &lane : lanes_) {
+            std::lock_guard<std::mutex> lk(lane->mtx);
+            while (!lane->frames.empty()) {
+                auto ready = std::move(lane->frames.front());
+                lane->frames.pop_front();
+                if (ready.frame && !ready.frame->is_canceled()) {
+                    return std::move(ready.frame);
+                }
+            }
+        }
+        return {};
+    }
+
+    // Worker pop: the oldest frame in `lane` whose owner is not running on
+    // another worker, else the oldest such frame stolen from another lane.
+    // The returned owner stays claimed (and affined to `lane`) until
+    // `release_owner`, so one case never runs on two workers at once.
+    [[nodiscard]] auto pop_ready_for(std::size_t lane) -> ReadyFrame {
+        for (std::size_t offset = 0; offset < lanes_.size(); ++offset) {
+            const std::size_t           victim = (lane + offset) % lanes_.size();
+            auto                       &queue  = *lanes_[victim];
+            std::lock_guard<std::mutex> lk(queue.mtx);
+            for (auto it = queue.frames.begin(); it != queue.frames.end();) {
+                if (!it->frame || it->frame->is_canceled()) {
+                    it = queue.frames.erase(it);
+                    continue;
+                }
+                if (try_claim_owner(it->owner, lane)) {
+                    auto ready = std::move(*it);
+                    queue.frames.erase(it);
+                    return ready;
+                }
+                ++it;
             }
         }
         return {};
     }
 
+    void release_owner(std::size_t owner) {
+        std::lock_guard<std::mutex> lk(claims_mtx_);
+        if (owner < claims_.size()) {
+            claims_[owner].running = false;
+        }
+    }
+
     void clear_suspend_state(const FramePtr &frame) {
         if (!frame) {
             return;
         }
-        std::lock_guard<std::mutex> lk(mtx_);
-        blocked_.erase(frame->address());
+        if (const auto lk = lock_shard(frame->links.shard)) {
+            frame->links.blocked = false;
+        }
     }
 
     void cancel_owner(std::size_t owner) {
-        cancel_matching([&](std::size_t frame_owner) { return frame_owner == owner; });
+        std::vector<WaiterTokenPtr> tokens;
+        std::vector<FramePtr>       released;
+        if (auto *shard = find_shard(owner)) {
+            std::lock_guard<std::mutex> lk(shard->mtx);
+            cancel_shard_locked(*shard, tokens, released);
+        }
+        cancel_tokens(tokens);
     }
 
     void cancel_waiters(std::coroutine_handle<> handle) {
         if (!handle) {
             return;
         }
-        cancel_address(handle.address());
+        std::vector<WaiterTokenPtr> tokens;
+        std::vector<FramePtr>       released;
+        {
+            const auto locked = lock_handle(handle.address());
+            if (locked.frame) {
+                cancel_frame_locked(*locked.frame, tokens, released);
+            }
+        }
+        cancel_tokens(tokens);
     }
 
     void cancel_all() {
-        cancel_matching([](std::size_t) { return true; });
+        std::vector<WaiterTokenPtr> tokens;
+        std::vector<FramePtr>       released;
+        for (auto *shard : shard_snapshot()) {
+            std::lock_guard<std::mutex> lk(shard->mtx);
+            cancel_shard_locked(*shard, tokens, released);
+        }
+        cancel_tokens(tokens);
     }
 
     [[nodiscard]] auto suspended_state_for(std::size_t owner) const -> SuspendedState {
-        SuspendedState              result{.reason = "waiting to resume"};
-        std::lock_guard<std::mutex> lk(mtx_);
-        for (const auto &[_, blocked] : blocked_) {
-            if (blocked.owner == owner && !blocked.reason.empty() && blocked.sequence >= result.sequence) {
+        SuspendedState result{.reason = "waiting to resume"};
+        auto          *shard = find_shard(owner);
+        if (!shard) {
+            return result;
+        }
+        std::lock_guard<std::mutex> lk(shard->mtx);
+        for (const auto &frame : shard->frames) {
+            const auto &links = frame->links;
+            if (links.blocked && !links.blocked_reason.empty() && links.blocked_sequence >= result.sequence) {
                 result = SuspendedState{
-                    .kind     = blocked.kind,
-                    .reason   = blocked.reason,
-                    .file     = blocked.file,
-                    .line     = blocked.line,
-                    .sequence = blocked.sequence,
+                    .kind     = static_cast<SuspendKind>(links.blocked_kind),
+                    .reason   = links.blocked_reason,
+                    .file     = links.blocked_file,
+                    .line     = links.blocked_line,
+                    .sequence = links.blocked_sequence,
                 };
             }
         }
@@ -298,120 +470,322 @@ class AsyncSchedulerCore {
     }
 
     [[nodiscard]] auto first_blocked_reason() const -> std::string {
-        std::lock_guard<std::mutex> lk(mtx_);
-        if (blocked_.empty()) {
-            return {};
+        for (auto *shard : shard_snapshot()) {
+            std::lock_guard<std::mutex> lk(shard->mtx);
+            for (const auto &frame : shard->frames) {
+                if (frame->links.blocked) {
+                    return frame->links.blocked_reason;
+                }
+            }
         }
-        return blocked_.begin()->second.reason;
+        return {};
     }
 
   private:
-    struct ChildReference {
-        void       *child             = nullptr;
-        std::size_t parent_link_index = 0;
+    using Frame          = gentest::detail::AsyncFrame;
+    using TokenAllocator = gentest::detail::AsyncSlabAllocator<WaiterToken>;
+
+    static constexpr std::size_t kMinWaiterCompaction = 8;
+
+    struct ReadyLane {
+        mutable std::mutex     mtx;
+        std::deque<ReadyFrame> frames;
     };
 
-    struct ParentReference {
-        void       *parent      = nullptr;
-        std::size_t child_index = 0;
+    struct OwnerClaim {
+        std::size_t lane    = 0;
+        bool        affined = false;
+        bool        running = false;
     };
 
-    struct BlockedHandle {
-        std::size_t   owner    = 0;
-        SuspendKind   kind     = SuspendKind::Suspended;
-        std::uint64_t sequence = 0;
-        std::string   reason;
-        std::string   file;
-        unsigned      line = 0;
+    // Frames are sharded by owner: a shard's mutex guards its frame list and
+    // the scheduler links of those frames, so post/block/make_waiter for
+    // different cases never contend. Parent/child links stay inside a shard; a
+    // frame that moves to another owner takes the frames below it along.
+    // Shards live as long as the core, so a pointer read from a frame or token
+    // can be locked and then rechecked.
+    struct Shard {
+        const AsyncSchedulerCore *core  = nullptr;
+        std::size_t               owner = kInvalidOwner;
+        std::mutex                mtx;
+        std::vector<FramePtr>     frames;
     };
 
-    [[nodiscard]] auto owner_for_locked(void *address) const -> std::size_t {
-        const auto it = owners_.find(address);
-        if (it == owners_.end()) {
-            return kInvalidOwner;
+    struct LockedFrame {
+        Frame                       *frame = nullptr;
+        std::unique_lock<std::mutex> lock;
+    };
+
+    [[nodiscard]] auto shard_for(std::size_t owner) -> Shard & {
+        std::lock_guard<std::mutex> lk(shards_mtx_);
+        while (owner >= shards_.size()) {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->core  = this;
+            shards_.back()->owner = shards_.size() - 1;
+        }
+        return *shards_[owner];
+    }
+
+    [[nodiscard]] auto find_shard(std::size_t owner) const -> Shard * {
+        std::lock_guard<std::mutex> lk(shards_mtx_);
+        return owner < shards_.size() ? shards_[owner].get() : nullptr;
+    }
+
+    [[nodiscard]] auto shard_snapshot() const -> std::vector<Shard *> {
+        std::lock_guard<std::mutex> lk(shards_mtx_);
+        std::vector<Shard *>        shards;
+        shards.reserve(shards_.size());
+        for (const auto &shard : shards_) {
+            shards.push_back(shard.get());
         }
-        return it->second;
+        return shards;
     }
 
-    [[nodiscard]] auto frame_for_locked(void *address) const -> FramePtr {
-        const auto it = frames_.find(address);
-        if (it == frames_.end()) {
+    [[nodiscard]] auto shard_of(void *pointer) const noexcept -> Shard * {
+        auto *shard = static_cast<Shard *>(pointer);
+        return shard && shard->core == this ? shard : nullptr;
+    }
+
+    // Locks the shard named by a frame's or a token's shard pointer. The lock
+    // owns nothing when the pointer is empty or names another core.
+    [[nodiscard]] auto lock_shard(const std::atomic<void *> &pointer) const -> std::unique_lock<std::mutex> {
+        while (auto *shard = shard_of(pointer.load(std::memory_order_acquire))) {
+            std::unique_lock<std::mutex> lk(shard->mtx);
+            if (pointer.load(std::memory_order_relaxed) == shard) {
+                return lk;
+            }
+        }
+        return {};
+    }
+
+    // Scheduler hooks receive type-erased handles of gentest::async_test
+    // coroutines. Their frames come from async_pool_allocate, whose header
+    // points back at the AsyncFrame while the frame is linked to a scheduler.
+    [[nodiscard]] auto lock_handle(void *address) const -> LockedFrame {
+        auto *frame = address ? AsyncFramePool::frame_record(address) : nullptr;
+        if (!frame) {
             return {};
         }
-        return it->second;
+        auto lk = lock_shard(frame->links.shard);
+        if (!lk) {
+            return {};
+        }
+        return LockedFrame{.frame = frame, .lock = std::move(lk)};
     }
 
-    template <typename Pred> void cancel_matching(Pred pred) {
-        std::vector<WaiterTokenPtr> tokens;
-        {
-            std::lock_guard<std::mutex> lk(mtx_);
-            std::vector<void *>         addresses;
-            for (const auto &[address, owner] : owners_) {
-                if (pred(owner)) {
-                    addresses.push_back(address);
+    [[nodiscard]] static auto locked_shard(const Frame &frame) -> Shard & {
+        return *static_cast<Shard *>(frame.links.shard.load(std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] static auto frame_ptr_locked(const Frame &frame) -> const FramePtr & {
+        return locked_shard(frame).frames[frame.links.owner_slot];
+    }
+
+    // Links `frame` to `to` and, when `parent` is set, under `parent`. A frame
+    // held by another shard moves over with both shards locked. Returns false
+    // when `parent` left `to` meanwhile and the caller must look it up again.
+    [[nodiscard]] auto adopt_frame(Shard &to, const FramePtr &frame, Frame *parent, std::vector<FramePtr> &released) -> bool {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lk(to.mtx);
+                if (parent && parent->links.shard.load(std::memory_order_relaxed) != &to) {
+                    return false;
+                }
+                void *unlinked = nullptr;
+                if (frame->links.shard.compare_exchange_strong(unlinked, &to, std::memory_order_acq_rel)) {
+                    push_frame_locked(to, frame);
+                    AsyncFramePool::set_frame_record(frame->address(), frame.get());
                 }
+                if (frame->links.shard.load(std::memory_order_relaxed) == &to) {
+                    if (parent) {
+                        link_child_locked(*parent, *frame);
+                    }
+                    return true;
+                }
+            }
+
+            auto *current = frame->links.shard.load(std::memory_order_acquire);
+            auto *from    = shard_of(current);
+            if (current && !from) {
+                return true;
+            }
+            if (!from || from == &to) {
+                continue;
+            }
+            std::scoped_lock lk(from->mtx, to.mtx);
+            if (parent && parent->links.shard.load(std::memory_order_relaxed) != &to) {
+                return false;
+            }
+            if (frame->links.shard.load(std::memory_order_relaxed) != from) {
+                continue;
             }
-            for (auto *address : addresses) {
-                cancel_address_locked(address, tokens);
+            move_frame_locked(*frame, to, released);
+            if (parent) {
+                link_child_locked(*parent, *frame);
             }
+            return true;
         }
-        cancel_tokens(tokens);
     }
 
-    void cancel_address(void *address) {
-        std::vector<WaiterTokenPtr> tokens;
-        {
-            std::lock_guard<std::mutex> lk(mtx_);
-            cancel_address_locked(address, tokens);
+    static void push_frame_locked(Shard &shard, const FramePtr &frame) {
+        frame->links.owner      = shard.owner;
+        frame->links.owner_slot = shard.frames.size();
+        shard.frames.push_back(frame);
+    }
+
+    // Swap-removes the frame from its shard. The last reference may be the one
+    // moved into `released`, which the caller drops after unlocking so
+    // coroutine destructors never run under a shard lock.
+    static void pop_frame_locked(Frame &frame, std::vector<FramePtr> &released) {
+        auto             &frames = locked_shard(frame).frames;
+        const std::size_t slot   = frame.links.owner_slot;
+        released.push_back(std::move(frames[slot]));
+        if (slot + 1 != frames.size()) {
+            frames[slot]                   = std::move(frames.back());
+            frames[slot]->links.owner_slot = slot;
         }
-        cancel_tokens(tokens);
+        frames.pop_back();
+        frame.links.owner = kInvalidOwner;
+    }
+
+    static void unlink_frame_locked(Frame &frame, std::vector<FramePtr> &released) {
+        pop_frame_locked(frame, released);
+        AsyncFramePool::set_frame_record(frame.address(), nullptr);
+        frame.links.shard.store(nullptr, std::memory_order_release);
     }
 
-    void cancel_address_locked(void *address, std::vector<WaiterTokenPtr> &tokens) {
-        if (auto frame = frame_for_locked(address)) {
-            frame->cancel();
+    // Moves `frame` and the frames below it from their shard to `to`, both
+    // locked. Links to parents left behind are dropped. The allocation record
+    // stays set, so a lookup racing the move waits on the old shard, sees the
+    // new pointer and retries.
+    void move_frame_locked(Frame &frame, Shard &to, std::vector<FramePtr> &released) {
+        auto *from = &locked_shard(frame);
+        auto  kept = frame_ptr_locked(frame);
+        remove_child_references_locked(frame);
+        pop_frame_locked(frame, released);
+        push_frame_locked(to, kept);
+        frame.links.shard.store(&to, std::memory_order_release);
+        for (auto *waiter = frame.links.waiters; waiter != nullptr; waiter = waiter->frame_hook.next) {
+            waiter->frame_hook.shard.store(&to, std::memory_order_release);
         }
 
-        if (const auto child_it = children_.find(address); child_it != children_.end()) {
-            auto children = std::move(child_it->second);
-            children_.erase(child_it);
-            for (const auto &child : children) {
-                cancel_address_locked(child.child, tokens);
+        auto children = std::move(frame.links.children);
+        frame.links.children.clear();
+        for (const auto &child : children) {
+            if (&locked_shard(*child.frame) == from) {
+                move_frame_locked(*child.frame, to, released);
             }
+            link_child_locked(frame, *child.frame);
         }
-        remove_child_references_locked(address);
+    }
 
-        const auto waiter_it = waiter_tokens_.find(address);
-        if (waiter_it != waiter_tokens_.end()) {
-            for (auto &weak_waiter : waiter_it->second) {
-                if (auto waiter = weak_waiter.lock()) {
-                    tokens.push_back(std::move(waiter));
-                }
-            }
-            waiter_tokens_.erase(waiter_it);
+    static void link_child_locked(Frame &parent, Frame &child) {
+        auto &children = parent.links.children;
+        auto &parents  = child.links.parents;
+        children.push_back(Frame::SchedulerLinks::Child{
+            .frame             = &child,
+            .parent_link_index = parents.size(),
+        });
+        parents.push_back(Frame::SchedulerLinks::Parent{
+            .frame       = &parent,
+            .child_index = children.size() - 1,
+        });
+    }
+
+    static void list_waiter_locked(Frame &frame, const WaiterTokenPtr &token) {
+        auto &links = frame.links;
+        auto &hook  = token->frame_hook;
+        hook.prev   = nullptr;
+        hook.next   = links.waiters;
+        hook.frame  = &frame;
+        hook.self   = token;
+        hook.shard.store(links.shard.load(std::memory_order_relaxed), std::memory_order_release);
+        if (links.waiters) {
+            links.waiters->frame_hook.prev = token.get();
+        }
+        links.waiters = token.get();
+        ++links.waiter_count;
+    }
+
+    // Returns the list's reference to `token` for the caller to drop once it
+    // no longer holds the lock.
+    [[nodiscard]] static auto unlist_waiter_locked(WaiterToken &token) -> WaiterTokenPtr {
+        auto &hook  = token.frame_hook;
+        auto &links = hook.frame->links;
+        (hook.prev ? hook.prev->frame_hook.next : links.waiters) = hook.next;
+        if (hook.next) {
+            hook.next->frame_hook.prev = hook.prev;
+        }
+        --links.waiter_count;
+        hook.prev  = nullptr;
+        hook.next  = nullptr;
+        hook.frame = nullptr;
+        hook.shard.store(nullptr, std::memory_order_release);
+        return std::move(hook.self);
+    }
+
+    static void unlist_waiters_locked(Frame &frame, std::vector<WaiterTokenPtr> &tokens) {
+        while (frame.links.waiters) {
+            tokens.push_back(unlist_waiter_locked(*frame.links.waiters));
+        }
+        frame.links.waiters_compact_at = 0;
+    }
+
+    // Returns the owner to queue the frame under, or kInvalidOwner when it must
+    // not run again.
+    [[nodiscard]] static auto prepare_post_locked(Frame &frame) -> std::size_t {
+        frame.links.blocked = false;
+        if (frame.is_canceled() || frame.done()) {
+            return kInvalidOwner;
         }
+        return frame.links.owner;
+    }
+
+    void mark_blocked_locked(Frame &frame, SuspendKind kind, std::string reason, const std::source_location &loc) {
+        auto &links            = frame.links;
+        links.blocked          = true;
+        links.blocked_kind     = static_cast<std::uint8_t>(kind);
+        links.blocked_sequence = suspend_sequence_.fetch_add(1, std::memory_order_relaxed) + 1;
+        links.blocked_reason   = std::move(reason);
+        links.blocked_file     = loc.file_name() == nullptr ? std::string{} : std::string(loc.file_name());
+        links.blocked_line     = loc.line();
+    }
 
-        blocked_.erase(address);
-        owners_.erase(address);
-        frames_.erase(address);
-        std::erase_if(ready_, [address](const FramePtr &frame) { return !frame || frame->address() == address; });
+    void cancel_shard_locked(Shard &shard, std::vector<WaiterTokenPtr> &tokens, std::vector<FramePtr> &released) {
+        while (!shard.frames.empty()) {
+            cancel_frame_locked(*shard.frames.back(), tokens, released);
+        }
     }
 
-    void remove_child_references_locked(void *address) {
-        const auto parent_it = parents_.find(address);
-        if (parent_it == parents_.end()) {
+    void cancel_frame_locked(Frame &frame, std::vector<WaiterTokenPtr> &tokens, std::vector<FramePtr> &released) {
+        if (frame.links.owner == kInvalidOwner) {
             return;
         }
+        frame.cancel();
+
+        auto children = std::move(frame.links.children);
+        frame.links.children.clear();
+        for (const auto &child : children) {
+            cancel_frame_locked(*child.frame, tokens, released);
+        }
+        remove_child_references_locked(frame);
 
-        auto parents = std::move(parent_it->second);
-        parents_.erase(parent_it);
+        unlist_waiters_locked(frame, tokens);
+        frame.links.blocked = false;
+
+        for (auto &lane : lanes_) {
+            std::lock_guard<std::mutex> lane_lk(lane->mtx);
+            std::erase_if(lane->frames, [&frame](const ReadyFrame &ready) { return !ready.frame || ready.frame.get() == &frame; });
+        }
+        unlink_frame_locked(frame, released);
+    }
+
+    void remove_child_references_locked(Frame &frame) {
+        auto parents = std::move(frame.links.parents);
+        frame.links.parents.clear();
         for (const auto &parent : parents) {
-            const auto children_it = children_.find(parent.parent);
-            if (children_it == children_.end()) {
-                continue;
-            }
-            auto &children = children_it->second;
-            if (parent.child_index >= children.size() || children[parent.child_index].child != address) {
+            auto &children = parent.frame->links.children;
+            if (parent.child_index >= children.size() || children[parent.child_index].frame != &frame) {
                 continue;
             }
 
@@ -419,18 +793,42 @@ class AsyncSchedulerCore {
             if (parent.child_index != last_index) {
                 const auto moved_child       = children[last_index];
                 children[parent.child_index] = moved_child;
-                if (const auto moved_parent_it = parents_.find(moved_child.child);
-                    moved_parent_it != parents_.end() && moved_child.parent_link_index < moved_parent_it->second.size()) {
-                    moved_parent_it->second[moved_child.parent_link_index].child_index = parent.child_index;
+                auto &moved_parents          = moved_child.frame->links.parents;
+                if (moved_child.parent_link_index < moved_parents.size()) {
+                    moved_parents[moved_child.parent_link_index].child_index = parent.child_index;
                 }
             }
             children.pop_back();
-            if (children.empty()) {
-                children_.erase(children_it);
-            }
         }
     }
 
+    [[nodiscard]] auto lane_for_owner(std::size_t owner) -> std::size_t {
+        std::lock_guard<std::mutex> lk(claims_mtx_);
+        if (owner < claims_.size() && claims_[owner].affined) {
+            return claims_[owner].lane;
+        }
+        return owner % lanes_.size();
+    }
+
+    [[nodiscard]] auto try_claim_owner(std::size_t owner, std::size_t lane) -> bool {
+        std::lock_guard<std::mutex> lk(claims_mtx_);
+        if (owner >= claims_.size()) {
+            claims_.resize(owner + 1);
+        }
+        auto &claim = claims_[owner];
+        if (claim.running) {
+            return false;
+        }
+        claim = OwnerClaim{.lane = lane, .affined = true, .running = true};
+        return true;
+    }
+
+    void push_ready(ReadyFrame ready) {
+        auto                       &lane = *lanes_[lane_for_owner(ready.owner)];
+        std::lock_guard<std::mutex> lk(lane.mtx);
+        lane.frames.push_back(std::move(ready));
+    }
+
     static void cancel_tokens(std::vector<WaiterTokenPtr> &tokens) {
         for (auto &token : tokens) {
             token->cancel();
@@ -443,17 +841,22 @@ class AsyncSchedulerCore {
         }
     }
 
-    WakeCallback                                                                         wake_;
-    mutable std::mutex                                                                   mtx_;
-    std::deque<FramePtr>                                                                 ready_;
-    std::unordered_map<void *, FramePtr>                                                 frames_;
-    std::unordered_map<void *, std::size_t>                                              owners_;
-    std::unordered_map<void *, std::vector<ChildReference>>                              children_;
-    std::unordered_map<void *, std::vector<ParentReference>>                             parents_;
-    std::unordered_map<void *, BlockedHandle>                                            blocked_;
-    std::unordered_map<void *, std::vector<std::weak_ptr<WaiterTokenPtr::element_type>>> waiter_tokens_;
-    gentest::detail::AsyncTimerQueue                                                     timers_;
-    std::uint64_t                                                                        suspend_sequence_ = 0;
+    WakeCallback wake_;
+    // Lock order: a shard's mtx (two shards only together, through
+    // std::scoped_lock), then a lane's mtx, then claims_mtx_. shards_mtx_ and
+    // timers_mtx_ are taken alone; a timer wheel's own lock is taken under
+    // timers_mtx_ or alone, by a token unlinking its timer.
+    mutable std::mutex                          shards_mtx_;
+    std::vector<std::unique_ptr<Shard>>         shards_;
+    std::vector<std::unique_ptr<ReadyLane>>     lanes_;
+    std::mutex                                  claims_mtx_;
+    std::vector<OwnerClaim>                     claims_;
+    std::shared_ptr<gentest::detail::AsyncSlab> token_slab_ = std::make_shared<gentest::detail::AsyncSlab>();
+    std::mutex                                  timers_mtx_;
+    gentest::detail::AsyncTimerQueue            timers_;
+    gentest::detail::AsyncTimerQueue            virtual_timers_;
+    std::atomic<std::uint64_t>                  suspend_sequence_{0};
+    AsyncIoPoller                               io_;
 };
 
 } // namespace gentest::runner
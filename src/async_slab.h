@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace gentest::detail {
+
+// Free-list pool of equally sized blocks. The block size is fixed by the first
+// allocation, which suits allocate_shared of one type (the control block and
+// object share a single allocation); other sizes fall through to operator new.
+// The slab stays alive while any allocator copy references it, so objects may
+// outlive the scheduler that created them.
+class AsyncSlab {
+  public:
+    AsyncSlab() = default;
+
+    AsyncSlab(const AsyncSlab &)            = delete;
+    AsyncSlab &operator=(const AsyncSlab &) = delete;
+
+    [[nodiscard]] auto allocate(std::size_t bytes) -> void * {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (block_size_ == 0) {
+            block_size_ = round_up(bytes);
+        }
+        if (bytes > block_size_) {
+            return ::operator new(bytes);
+        }
+        if (!free_) {
+            grow();
+        }
+        auto *block = free_;
+        free_       = block->next;
+        return block;
+    }
+
+    void deallocate(void *ptr, std::size_t bytes) noexcept {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (bytes > block_size_) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto *block = static_cast<FreeBlock *>(ptr);
+        block->next = free_;
+        free_       = block;
+    }
+
+  private:
+    struct FreeBlock {
+        FreeBlock *next = nullptr;
+    };
+
+    static constexpr std::size_t kBlocksPerChunk = 64;
+
+    static constexpr auto round_up(std::size_t bytes) -> std::size_t {
+        constexpr std::size_t align = alignof(std::max_align_t);
+        return bytes < sizeof(FreeBlock) ? align : (bytes + align - 1) / align * align;
+    }
+
+    void grow() {
+        chunks_.push_back(std::make_unique<std::byte[]>(block_size_ * kBlocksPerChunk));
+        std::byte *base = chunks_.back().get();
+        for (std::size_t i = kBlocksPerChunk; i-- > 0;) {
+            auto *block = ::new (static_cast<void *>(base + i * block_size_)) FreeBlock{free_};
+            free_       = block;
+        }
+    }
+
+    std::mutex                                mtx_;
+    std::size_t                               block_size_ = 0;
+    FreeBlock                                *free_       = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+};
+
+template <typename T> class AsyncSlabAllocator {
+  public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "AsyncSlab blocks are only max_align_t aligned");
+
+    explicit AsyncSlabAllocator(std::shared_ptr<AsyncSlab> slab) noexcept : slab_(std::move(slab)) {}
+
+    template <typename U> AsyncSlabAllocator(const AsyncSlabAllocator<U> &other) noexcept : slab_(other.slab()) {}
+
+    [[nodiscard]] auto allocate(std::size_t n) -> T * { return static_cast<T *>(slab_->allocate(n * sizeof(T))); }
+    void               deallocate(T *ptr, std::size_t n) noexcept { slab_->deallocate(ptr, n * sizeof(T)); }
+
+    [[nodiscard]] auto slab() const noexcept -> const std::shared_ptr<AsyncSlab> & { return slab_; }
+
+    template <typename U> friend auto operator==(const AsyncSlabAllocator &lhs, const AsyncSlabAllocator<U> &rhs) noexcept -> bool {
+        return lhs.slab_ == rhs.slab();
+    }
+
+  private:
+    std::shared_ptr<AsyncSlab> slab_;
+};
+
+} // namespace gentest::detail
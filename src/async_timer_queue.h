@@ -1,16 +1,31 @@
 #pragma once
 
+#include "async_slab.h"
 #include "gentest/async.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
+#include <variant>
 #include <vector>
 
 namespace gentest::detail {
 
-class AsyncTimerQueue {
+enum class AsyncTimerQueueKind {
+    Heap,
+    Wheel,
+};
+
+// Binary heap ordered by deadline. Canceled tokens stay queued until they reach
+// the top, so a burst of armed-then-canceled timeouts costs O(log n) each way.
+class AsyncTimerHeap {
   public:
     using time_point     = std::chrono::steady_clock::time_point;
     using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
@@ -81,4 +96,380 @@ class AsyncTimerQueue {
     std::uint64_t                                                        next_sequence_ = 0;
 };
 
+// Hashed hierarchical timing wheel. Deadlines are bucketed into ~1 ms ticks;
+// level L has 64 slots of 64^L ticks each, and a timer sits on the lowest level
+// whose span still separates it from the current tick. Insert and cancel are
+// O(1): every queued timer is linked into its slot's list and registered on its
+// token, so a post or cancel unlinks it immediately instead of leaving it for
+// pop_due to skip. Advancing re-slots only the timers whose slot the clock has
+// reached, so each timer is touched at most once per level. Due timers are
+// returned in (deadline, push order), matching AsyncTimerHeap.
+class AsyncTimerWheel {
+  public:
+    using time_point     = std::chrono::steady_clock::time_point;
+    using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
+
+    AsyncTimerWheel() = default;
+
+    AsyncTimerWheel(const AsyncTimerWheel &)            = delete;
+    AsyncTimerWheel &operator=(const AsyncTimerWheel &) = delete;
+
+    ~AsyncTimerWheel() { clear(); }
+
+    void push(time_point deadline, const WaiterTokenPtr &token) {
+        if (!token) {
+            return;
+        }
+        auto node      = std::allocate_shared<Node>(AsyncSlabAllocator<Node>{slab_});
+        node->wheel    = state_;
+        node->token    = token;
+        node->deadline = deadline;
+        node->tick     = tick_of(deadline);
+        {
+            std::lock_guard<std::mutex> lk(state_->mtx);
+            node->sequence = state_->next_sequence++;
+            node->self     = node;
+            state_->insert(node.get());
+        }
+        token->set_timer_link(std::move(node));
+    }
+
+    [[nodiscard]] auto pop_due(time_point now) -> std::vector<WaiterTokenPtr> {
+        std::vector<WaiterTokenPtr>        due;
+        std::vector<std::shared_ptr<Node>> released;
+        {
+            std::lock_guard<std::mutex> lk(state_->mtx);
+            State                      &state = *state_;
+            state.advance(tick_of(now));
+            const std::size_t slot = state.current & kSlotMask;
+            if ((state.occupied[0] & (std::uint64_t{1} << slot)) == 0) {
+                return due;
+            }
+            std::vector<Node *> fired;
+            for (Node *node = state.slots[0][slot]; node; node = node->next) {
+                if (node->deadline <= now || !node->token->active()) {
+                    fired.push_back(node);
+                }
+            }
+            std::ranges::sort(fired, [](const Node *lhs, const Node *rhs) {
+                if (lhs->deadline != rhs->deadline) {
+                    return lhs->deadline < rhs->deadline;
+                }
+                return lhs->sequence < rhs->sequence;
+            });
+            released.reserve(fired.size());
+            due.reserve(fired.size());
+            for (Node *node : fired) {
+                state.remove(node);
+                if (node->token->active()) {
+                    due.push_back(std::move(node->token));
+                }
+                node->token.reset();
+                released.push_back(std::move(node->self));
+            }
+        }
+        return due;
+    }
+
+    [[nodiscard]] auto next_deadline() -> std::optional<time_point> {
+        std::vector<std::shared_ptr<Node>> released;
+        std::lock_guard<std::mutex>        lk(state_->mtx);
+        const Node                        *earliest = state_->earliest(released);
+        if (!earliest) {
+            return std::nullopt;
+        }
+        return earliest->deadline;
+    }
+
+    [[nodiscard]] auto has_pending() -> bool { return next_deadline().has_value(); }
+
+    void clear() {
+        std::vector<std::shared_ptr<Node>> released;
+        std::vector<WaiterTokenPtr>        tokens;
+        std::lock_guard<std::mutex>        lk(state_->mtx);
+        state_->drain(released, tokens);
+    }
+
+  private:
+    static constexpr std::size_t   kTickShift = 20; // 2^20 ns, about 1 ms
+    static constexpr std::size_t   kSlotBits  = 6;
+    static constexpr std::size_t   kSlots     = std::size_t{1} << kSlotBits;
+    static constexpr std::size_t   kSlotMask  = kSlots - 1;
+    static constexpr std::size_t   kLevels    = 4; // 2^24 ticks, about 4.9 hours; later timers overflow
+    static constexpr std::uint8_t  kOverflow  = kLevels;
+    static constexpr std::uint64_t kAllSlots  = ~std::uint64_t{0};
+
+    struct State;
+
+    struct Node final : AsyncWaiterToken::TimerLink {
+        std::weak_ptr<State> wheel;
+        Node                *prev = nullptr;
+        Node                *next = nullptr;
+        // Set while linked; the token's link keeps the node alive afterwards.
+        std::shared_ptr<Node> self;
+        WaiterTokenPtr        token;
+        time_point            deadline;
+        std::uint64_t         sequence = 0;
+        std::uint64_t         tick     = 0;
+        std::uint8_t          level    = 0;
+        std::uint8_t          slot     = 0;
+
+        void unlink() noexcept override {
+            auto state = wheel.lock();
+            if (!state) {
+                return;
+            }
+            std::shared_ptr<Node> keep;
+            WaiterTokenPtr        token_ref;
+            {
+                std::lock_guard<std::mutex> lk(state->mtx);
+                if (!self) {
+                    return;
+                }
+                state->remove(this);
+                token_ref = std::move(token);
+                keep      = std::move(self);
+            }
+        }
+    };
+
+    // Shared with the nodes so a token that outlives the wheel can still try
+    // to unlink itself; the mutex also covers calls that race with the owner.
+    struct State {
+        std::mutex                                      mtx;
+        std::array<std::array<Node *, kSlots>, kLevels> slots{};
+        std::array<std::uint64_t, kLevels>              occupied{};
+        Node                                           *overflow      = nullptr;
+        const Node                                     *overflow_min  = nullptr; // earliest overflow timer, null once unknown
+        const Node                                     *cached_next   = nullptr;
+        std::uint64_t                                   current       = 0;
+        std::uint64_t                                   next_sequence = 0;
+        std::vector<Node *>                             moved;
+
+        [[nodiscard]] static auto before(const Node *lhs, const Node *rhs) noexcept -> bool {
+            return lhs->deadline < rhs->deadline || (lhs->deadline == rhs->deadline && lhs->sequence < rhs->sequence);
+        }
+
+        [[nodiscard]] auto head_for(const Node *node) -> Node *& {
+            return node->level == kOverflow ? overflow : slots[node->level][node->slot];
+        }
+
+        void insert(Node *node) {
+            const std::uint64_t diff = node->tick > current ? node->tick ^ current : 0;
+            const std::size_t   level = diff == 0 ? 0 : static_cast<std::size_t>(std::bit_width(diff) - 1) / kSlotBits;
+            if (level >= kLevels) {
+                node->level = kOverflow;
+                node->slot  = 0;
+                if (!overflow) {
+                    overflow_min = node;
+                } else if (overflow_min && before(node, overflow_min)) {
+                    overflow_min = node;
+                }
+            } else {
+                const std::uint64_t tick = diff == 0 ? current : node->tick;
+                node->level              = static_cast<std::uint8_t>(level);
+                node->slot               = static_cast<std::uint8_t>((tick >> (level * kSlotBits)) & kSlotMask);
+                occupied[level] |= std::uint64_t{1} << node->slot;
+            }
+            Node *&head = head_for(node);
+            node->prev  = nullptr;
+            node->next  = head;
+            if (head) {
+                head->prev = node;
+            }
+            head = node;
+            if (cached_next && node->deadline < cached_next->deadline) {
+                cached_next = node;
+            }
+        }
+
+        void remove(Node *node) noexcept {
+            if (node->prev) {
+                node->prev->next = node->next;
+            } else {
+                head_for(node) = node->next;
+            }
+            if (node->next) {
+                node->next->prev = node->prev;
+            }
+            if (node->level != kOverflow && !slots[node->level][node->slot]) {
+                occupied[node->level] &= ~(std::uint64_t{1} << node->slot);
+            }
+            node->prev = nullptr;
+            node->next = nullptr;
+            if (cached_next == node) {
+                cached_next = nullptr;
+            }
+            if (overflow_min == node) {
+                overflow_min = nullptr;
+            }
+        }
+
+        void take_slot(std::size_t level, std::size_t slot) {
+            for (Node *node = slots[level][slot]; node;) {
+                Node *next = node->next;
+                moved.push_back(node);
+                node = next;
+            }
+            slots[level][slot] = nullptr;
+        }
+
+        // Moves the wheel to `target`. A slot needs re-slotting once the clock
+        // has reached it: on each level that is the run of slots between the
+        // old and new position, or the whole level when a higher level turned
+        // over. Level-0 timers for past ticks collect in the current slot.
+        void advance(std::uint64_t target) {
+            if (target <= current) {
+                return;
+            }
+            moved.clear();
+            for (std::size_t level = 0; level < kLevels; ++level) {
+                const std::size_t shift = level * kSlotBits;
+                std::uint64_t     range = kAllSlots;
+                if ((target >> (shift + kSlotBits)) == (current >> (shift + kSlotBits))) {
+                    const std::size_t lo = (current >> shift) & kSlotMask;
+                    const std::size_t hi = (target >> shift) & kSlotMask;
+                    range = (hi == kSlotMask ? kAllSlots : (std::uint64_t{1} << (hi + 1)) - 1) & ~((std::uint64_t{1} << lo) - 1);
+                }
+                std::uint64_t hit = occupied[level] & range;
+                occupied[level] &= ~range;
+                while (hit != 0) {
+                    take_slot(level, static_cast<std::size_t>(std::countr_zero(hit)));
+                    hit &= hit - 1;
+                }
+            }
+            if ((target >> (kLevels * kSlotBits)) != (current >> (kLevels * kSlotBits))) {
+                for (Node *node = overflow; node;) {
+                    Node *next = node->next;
+                    moved.push_back(node);
+                    node = next;
+                }
+                overflow     = nullptr;
+                overflow_min = nullptr;
+            }
+            current = target;
+            for (Node *node : moved) {
+                insert(node);
+            }
+            moved.clear();
+        }
+
+        // Earliest live timer. All timers on a level expire after every timer on
+        // the levels below it, and slots on a level are ordered by index from
+        // the current position, so only the first non-empty slot is scanned.
+        // The overflow list is scanned only when its cached minimum was removed
+        // or spent. Timers whose token was already spent are dropped along the
+        // way.
+        [[nodiscard]] auto earliest(std::vector<std::shared_ptr<Node>> &released) -> const Node * {
+            if (cached_next && cached_next->token->active()) {
+                return cached_next;
+            }
+            cached_next = nullptr;
+            for (std::size_t level = 0; level <= kLevels && !cached_next; ++level) {
+                while (!cached_next) {
+                    Node *head = nullptr;
+                    if (level == kLevels) {
+                        if (overflow_min && overflow_min->token->active()) {
+                            cached_next = overflow_min;
+                            break;
+                        }
+                        head = overflow;
+                    } else if (occupied[level] != 0) {
+                        head = slots[level][static_cast<std::size_t>(std::countr_zero(occupied[level]))];
+                    }
+                    if (!head) {
+                        break;
+                    }
+                    const Node *best = nullptr;
+                    for (Node *node = head; node;) {
+                        Node *next = node->next;
+                        if (!node->token->active()) {
+                            remove(node);
+                            node->token.reset();
+                            released.push_back(std::move(node->self));
+                        } else if (!best || before(node, best)) {
+                            best = node;
+                        }
+                        node = next;
+                    }
+                    cached_next = best;
+                    if (level == kLevels) {
+                        overflow_min = best;
+                    }
+                }
+            }
+            return cached_next;
+        }
+
+        void drain(std::vector<std::shared_ptr<Node>> &released, std::vector<WaiterTokenPtr> &tokens) {
+            auto take = [&](Node *head) {
+                for (Node *node = head; node;) {
+                    Node *next = node->next;
+                    node->prev = nullptr;
+                    node->next = nullptr;
+                    tokens.push_back(std::move(node->token));
+                    released.push_back(std::move(node->self));
+                    node = next;
+                }
+            };
+            for (auto &level : slots) {
+                for (Node *&head : level) {
+                    take(head);
+                    head = nullptr;
+                }
+            }
+            take(overflow);
+            overflow     = nullptr;
+            overflow_min = nullptr;
+            occupied     = {};
+            cached_next  = nullptr;
+        }
+    };
+
+    [[nodiscard]] static auto tick_of(time_point deadline) noexcept -> std::uint64_t {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        return ns <= 0 ? 0 : static_cast<std::uint64_t>(ns) >> kTickShift;
+    }
+
+    std::shared_ptr<State>     state_ = std::make_shared<State>();
+    std::shared_ptr<AsyncSlab> slab_  = std::make_shared<AsyncSlab>();
+};
+
+// Timer queue used by AsyncSchedulerCore; the implementation is chosen once per
+// scheduler (--async-timer-queue).
+class AsyncTimerQueue {
+  public:
+    using time_point     = std::chrono::steady_clock::time_point;
+    using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
+
+    explicit AsyncTimerQueue(AsyncTimerQueueKind kind = AsyncTimerQueueKind::Heap) {
+        if (kind == AsyncTimerQueueKind::Wheel) {
+            queue_.emplace<AsyncTimerWheel>();
+        }
+    }
+
+    void push(time_point deadline, const WaiterTokenPtr &token) {
+        std::visit([&](auto &queue) { queue.push(deadline, token); }, queue_);
+    }
+
+    [[nodiscard]] auto pop_due(time_point now) -> std::vector<WaiterTokenPtr> {
+        return std::visit([&](auto &queue) { return queue.pop_due(now); }, queue_);
+    }
+
+    [[nodiscard]] auto next_deadline() -> std::optional<time_point> {
+        return std::visit([](auto &queue) { return queue.next_deadline(); }, queue_);
+    }
+
+    [[nodiscard]] auto has_pending() -> bool {
+        return std::visit([](auto &queue) { return queue.has_pending(); }, queue_);
+    }
+
+    void clear() {
+        std::visit([](auto &queue) { queue.clear(); }, queue_);
+    }
+
+  private:
+    std::variant<AsyncTimerHeap, AsyncTimerWheel> queue_;
+};
+
 } // namespace gentest::detail
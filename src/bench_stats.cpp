@@ -1,7 +1,9 @@
 #include "gentest/detail/bench_stats.h"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <limits>
 
 namespace gentest::detail {
 namespace {
@@ -40,6 +42,65 @@ double stddev_of(const std::vector<double> &v, double mean) {
     }
     return std::sqrt(sum / static_cast<double>(v.size()));
 }
+
+struct LinearBins {
+    double min_v = 0.0;
+    double max_v = 0.0;
+    int    bins  = 1;
+    double width = 0.0;
+
+    LinearBins(double lo, double hi, int requested)
+        : min_v(lo), max_v(hi), bins((lo == hi) ? 1 : ((requested > 0) ? requested : 1)),
+          width((bins == 1) ? 0.0 : (hi - lo) / static_cast<double>(bins)) {}
+
+    [[nodiscard]] std::size_t index_of(double v) const {
+        int idx = 0;
+        if (bins > 1) {
+            const double offset = (v - min_v) / width;
+            idx                 = static_cast<int>(offset);
+            if (idx < 0)
+                idx = 0;
+            if (idx >= bins)
+                idx = bins - 1;
+        }
+        return static_cast<std::size_t>(idx);
+    }
+
+    [[nodiscard]] Histogram finish(const std::vector<std::size_t> &counts, std::size_t total_count) const {
+        Histogram   hist{};
+        const auto  total      = static_cast<double>(total_count);
+        std::size_t cumulative = 0;
+        hist.bins.reserve(static_cast<std::size_t>(bins));
+        for (int i = 0; i < bins; ++i) {
+            const double      lo    = (bins == 1) ? min_v : (min_v + width * static_cast<double>(i));
+            const double      hi    = (bins == 1) ? max_v : ((i == bins - 1) ? max_v : (min_v + width * static_cast<double>(i + 1)));
+            const std::size_t count = counts[static_cast<std::size_t>(i)];
+            cumulative += count;
+            const double pct     = (total > 0.0) ? (static_cast<double>(count) / total * 100.0) : 0.0;
+            const double cum_pct = (total > 0.0) ? (static_cast<double>(cumulative) / total * 100.0) : 0.0;
+            hist.bins.push_back(HistogramBin{
+                .lo                 = lo,
+                .hi                 = hi,
+                .count              = count,
+                .percent            = pct,
+                .cumulative_percent = cum_pct,
+                .inclusive_hi       = (i == bins - 1),
+            });
+        }
+        return hist;
+    }
+};
+
+constexpr double kUnitsPerNs = 1000.0; // picosecond quantization
+
+std::uint64_t units_from_ns(double value_ns) {
+    if (!(value_ns > 0.0))
+        return 0;
+    const double units = value_ns * kUnitsPerNs + 0.5;
+    if (units >= static_cast<double>(std::numeric_limits<std::uint64_t>::max()))
+        return std::numeric_limits<std::uint64_t>::max();
+    return static_cast<std::uint64_t>(units);
+}
 } // namespace
 
 SampleStats compute_sample_stats(std::span<const double> samples) {
@@ -61,52 +122,195 @@ SampleStats compute_sample_stats(std::span<const double> samples) {
 }
 
 Histogram compute_histogram(std::span<const double> samples, int bins) {
-    Histogram hist{};
     if (samples.empty())
-        return hist;
-
-    const int    safe_bins = (bins > 0) ? bins : 1;
-    const auto   min_it    = std::ranges::min_element(samples);
-    const auto   max_it    = std::ranges::max_element(samples);
-    const double min_v     = *min_it;
-    const double max_v     = *max_it;
-    const int    hist_bins = (min_v == max_v) ? 1 : safe_bins;
-    const double width     = (hist_bins == 1) ? 0.0 : (max_v - min_v) / static_cast<double>(hist_bins);
+        return Histogram{};
 
-    std::vector<std::size_t> counts(static_cast<std::size_t>(hist_bins), 0);
+    const auto               min_it = std::ranges::min_element(samples);
+    const auto               max_it = std::ranges::max_element(samples);
+    const LinearBins         layout(*min_it, *max_it, bins);
+    std::vector<std::size_t> counts(static_cast<std::size_t>(layout.bins), 0);
     for (double v : samples) {
-        int idx = 0;
-        if (hist_bins > 1) {
-            const double offset = (v - min_v) / width;
-            idx                 = static_cast<int>(offset);
-            if (idx < 0)
-                idx = 0;
-            if (idx >= hist_bins)
-                idx = hist_bins - 1;
+        counts[layout.index_of(v)]++;
+    }
+    return layout.finish(counts, samples.size());
+}
+
+LogLinearHistogram::LogLinearHistogram(int significant_digits) : significant_digits_(std::clamp(significant_digits, 1, 5)) {
+    // Sub-buckets per power of two must resolve 1 part in 10^digits across the
+    // whole octave, so size them to the next power of two >= 2 * 10^digits.
+    std::uint64_t largest_single_unit = 2;
+    for (int i = 0; i < significant_digits_; ++i)
+        largest_single_unit *= 10;
+    const int sub_bucket_magnitude = static_cast<int>(std::bit_width(largest_single_unit - 1));
+    sub_bucket_half_magnitude_     = sub_bucket_magnitude - 1;
+    sub_bucket_mask_               = (std::uint64_t{1} << sub_bucket_magnitude) - 1;
+}
+
+std::size_t LogLinearHistogram::index_for(std::uint64_t units) const {
+    const int           bucket      = static_cast<int>(std::bit_width(units | sub_bucket_mask_)) - 1 - sub_bucket_half_magnitude_;
+    const std::uint64_t sub_bucket  = units >> bucket;
+    const std::uint64_t half_count  = std::uint64_t{1} << sub_bucket_half_magnitude_;
+    const std::uint64_t bucket_base = static_cast<std::uint64_t>(bucket + 1) << sub_bucket_half_magnitude_;
+    return static_cast<std::size_t>(bucket_base + sub_bucket - half_count);
+}
+
+double LogLinearHistogram::midpoint_ns(std::size_t index) const {
+    const std::uint64_t half_count = std::uint64_t{1} << sub_bucket_half_magnitude_;
+    int                 bucket     = static_cast<int>(index >> sub_bucket_half_magnitude_) - 1;
+    std::uint64_t       sub_bucket = (index & (half_count - 1)) + half_count;
+    if (bucket < 0) {
+        bucket = 0;
+        sub_bucket -= half_count;
+    }
+    const double lowest = std::ldexp(static_cast<double>(sub_bucket), bucket);
+    const double width  = std::ldexp(1.0, bucket);
+    return (lowest + (width - 1.0) / 2.0) / kUnitsPerNs;
+}
+
+void LogLinearHistogram::record(double value_ns) {
+    const std::size_t index = index_for(units_from_ns(value_ns));
+    if (index >= counts_.size())
+        counts_.resize(index + 1, 0);
+    ++counts_[index];
+
+    ++count_;
+    if (count_ == 1) {
+        min_ = value_ns;
+        max_ = value_ns;
+    } else {
+        min_ = std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+    const double delta = value_ns - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value_ns - mean_);
+}
+
+double LogLinearHistogram::percentile(double p) const {
+    if (count_ == 0)
+        return 0.0;
+    if (p <= 0.0)
+        return min_;
+    if (p >= 1.0)
+        return max_;
+    const auto    rank       = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(count_))));
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        cumulative += counts_[i];
+        if (cumulative >= rank)
+            return std::clamp(midpoint_ns(i), min_, max_);
+    }
+    return max_;
+}
+
+SampleStats LogLinearHistogram::stats() const {
+    SampleStats stats{};
+    stats.count = count_;
+    if (count_ == 0)
+        return stats;
+    stats.min    = min_;
+    stats.max    = max_;
+    stats.mean   = mean_;
+    stats.stddev = (count_ < 2) ? 0.0 : std::sqrt(m2_ / static_cast<double>(count_));
+    stats.median = percentile(0.5);
+    stats.p05    = percentile(0.05);
+    stats.p95    = percentile(0.95);
+    return stats;
+}
+
+Histogram LogLinearHistogram::histogram(int bins) const {
+    if (count_ == 0)
+        return Histogram{};
+
+    const LinearBins         layout(min_, max_, bins);
+    std::vector<std::size_t> counts(static_cast<std::size_t>(layout.bins), 0);
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] == 0)
+            continue;
+        counts[layout.index_of(std::clamp(midpoint_ns(i), min_, max_))] += static_cast<std::size_t>(counts_[i]);
+    }
+    return layout.finish(counts, count_);
+}
+
+namespace {
+double complexity_basis(ComplexityClass cls, double n) {
+    switch (cls) {
+    case ComplexityClass::Constant: return 1.0;
+    case ComplexityClass::Logarithmic: return std::log2(n);
+    case ComplexityClass::Linear: return n;
+    case ComplexityClass::Linearithmic: return n * std::log2(n);
+    case ComplexityClass::Quadratic: return n * n;
+    case ComplexityClass::Cubic: return n * n * n;
+    }
+    return 1.0;
+}
+} // namespace
+
+ComplexityFit fit_complexity(std::span<const double> sizes, std::span<const double> times) {
+    constexpr ComplexityClass kClasses[] = {
+        ComplexityClass::Constant,     ComplexityClass::Logarithmic, ComplexityClass::Linear,
+        ComplexityClass::Linearithmic, ComplexityClass::Quadratic,   ComplexityClass::Cubic,
+    };
+
+    ComplexityFit fit{};
+    fit.points = std::min(sizes.size(), times.size());
+    if (fit.points == 0)
+        return fit;
+
+    const auto   pairs     = fit.points;
+    double       mean_time = 0.0;
+    const double first     = sizes.front();
+    bool         distinct  = false;
+    for (std::size_t i = 0; i < pairs; ++i) {
+        mean_time += times[i];
+        distinct = distinct || sizes[i] != first;
+    }
+    mean_time /= static_cast<double>(pairs);
+    fit.coefficient = mean_time;
+    if (!distinct)
+        return fit;
+
+    // Sizes below 1 would make log-based bases zero or negative; clamp so every
+    // class stays a non-decreasing function of n.
+    double best_rms = std::numeric_limits<double>::infinity();
+    for (const ComplexityClass cls : kClasses) {
+        double sum_tf = 0.0;
+        double sum_ff = 0.0;
+        for (std::size_t i = 0; i < pairs; ++i) {
+            const double f = complexity_basis(cls, std::max(sizes[i], 1.0));
+            sum_tf += times[i] * f;
+            sum_ff += f * f;
+        }
+        if (sum_ff <= 0.0)
+            continue;
+        const double coefficient = sum_tf / sum_ff;
+        double       sum_sq      = 0.0;
+        for (std::size_t i = 0; i < pairs; ++i) {
+            const double residual = times[i] - coefficient * complexity_basis(cls, std::max(sizes[i], 1.0));
+            sum_sq += residual * residual;
+        }
+        const double rms = std::sqrt(sum_sq / static_cast<double>(pairs));
+        // Strict comparison keeps the simpler class on ties.
+        if (rms < best_rms) {
+            best_rms        = rms;
+            fit.best_fit    = cls;
+            fit.coefficient = coefficient;
         }
-        counts[static_cast<std::size_t>(idx)]++;
     }
+    fit.rms_pct = (mean_time > 0.0) ? (best_rms / mean_time) * 100.0 : 0.0;
+    return fit;
+}
 
-    const auto  total      = static_cast<double>(samples.size());
-    std::size_t cumulative = 0;
-    hist.bins.reserve(static_cast<std::size_t>(hist_bins));
-    for (int i = 0; i < hist_bins; ++i) {
-        const double      lo    = (hist_bins == 1) ? min_v : (min_v + width * static_cast<double>(i));
-        const double      hi    = (hist_bins == 1) ? max_v : ((i == hist_bins - 1) ? max_v : (min_v + width * static_cast<double>(i + 1)));
-        const std::size_t count = counts[static_cast<std::size_t>(i)];
-        cumulative += count;
-        const double pct     = (total > 0.0) ? (static_cast<double>(count) / total * 100.0) : 0.0;
-        const double cum_pct = (total > 0.0) ? (static_cast<double>(cumulative) / total * 100.0) : 0.0;
-        hist.bins.push_back(HistogramBin{
-            .lo                 = lo,
-            .hi                 = hi,
-            .count              = count,
-            .percent            = pct,
-            .cumulative_percent = cum_pct,
-            .inclusive_hi       = (i == hist_bins - 1),
-        });
+std::string_view complexity_class_name(ComplexityClass cls) {
+    switch (cls) {
+    case ComplexityClass::Constant: return "O(1)";
+    case ComplexityClass::Logarithmic: return "O(log n)";
+    case ComplexityClass::Linear: return "O(n)";
+    case ComplexityClass::Linearithmic: return "O(n log n)";
+    case ComplexityClass::Quadratic: return "O(n^2)";
+    case ComplexityClass::Cubic: return "O(n^3)";
     }
-    return hist;
+    return "O(1)";
 }
 
 } // namespace gentest::detail
@@ -91,7 +91,6 @@ void log(std::string_view message) {
         buffer.owner = ctx.get();
     }
 
-    std::vector<std::string>  recent_logs;
     std::size_t               log_count      = 0;
     void                     *observer_state = nullptr;
     detail::TestLogObserverFn observer       = nullptr;
@@ -100,22 +99,13 @@ void log(std::string_view message) {
     {
         std::lock_guard<std::mutex> lk(ctx->mtx);
         ++ctx->log_count;
-        log_count = ctx->log_count;
-        if (ctx->recent_log_limit != 0) {
-            ctx->recent_logs.emplace_back(message);
-            while (ctx->recent_logs.size() > ctx->recent_log_limit) {
-                ctx->recent_logs.erase(ctx->recent_logs.begin());
-            }
-        } else {
-            ctx->recent_logs.clear();
-        }
-        recent_logs    = ctx->recent_logs;
+        log_count      = ctx->log_count;
         observer_state = ctx->log_observer_state;
         observer       = ctx->log_observer;
         observer_id    = ctx->log_observer_id;
     }
     if (observer) {
-        observer(observer_state, observer_id, recent_logs, log_count);
+        observer(observer_state, observer_id, message, log_count);
     }
     detail::dispatch_log_to_sinks(message);
 }
@@ -0,0 +1,214 @@
+#include "gentest/detail/mock_trace.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GENTEST_MOCK_TRACE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Layout (integers are little-endian u32; method names are trace keys, i.e.
+// the qualified name plus parameter list, so overloads stay distinct):
+//   "GTMOCKT2" method_count record_count
+//   method_count x { len bytes }
+//   record_count x { method_index args_len args result_len result }
+namespace gentest::detail::mocking {
+namespace {
+
+constexpr std::array<char, 8> kMagic{'G', 'T', 'M', 'O', 'C', 'K', 'T', '2'};
+// Smallest encodings: an empty method name is its length prefix, a call
+// record with empty args and result is its three u32 fields.
+constexpr std::size_t kMinMethodBytes = 4;
+constexpr std::size_t kMinRecordBytes = 12;
+
+void put_u32(std::string &out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xffu));
+    }
+}
+
+void put_bytes(std::string &out, std::string_view bytes) {
+    put_u32(out, static_cast<std::uint32_t>(bytes.size()));
+    out.append(bytes);
+}
+
+struct Cursor {
+    std::string_view rest;
+
+    auto u32() -> std::optional<std::uint32_t> {
+        if (rest.size() < 4) {
+            return std::nullopt;
+        }
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(rest[static_cast<std::size_t>(i)])) << (8 * i);
+        }
+        rest.remove_prefix(4);
+        return value;
+    }
+
+    auto bytes() -> std::optional<std::string_view> {
+        const auto len = u32();
+        if (!len || rest.size() < *len) {
+            return std::nullopt;
+        }
+        const std::string_view out = rest.substr(0, *len);
+        rest.remove_prefix(*len);
+        return out;
+    }
+};
+
+} // namespace
+
+struct MockTrace {
+    const char                  *data   = nullptr;
+    std::size_t                  size   = 0;
+    bool                         mapped = false;
+    std::string                  owned;
+    std::vector<MockTraceRecord> records;
+
+    MockTrace() = default;
+
+    MockTrace(const MockTrace &)            = delete;
+    MockTrace &operator=(const MockTrace &) = delete;
+
+    ~MockTrace() {
+#if defined(GENTEST_MOCK_TRACE_MMAP)
+        if (mapped) {
+            ::munmap(const_cast<char *>(data), size);
+        }
+#endif
+    }
+
+    auto load(const std::string &path, std::string &error) -> bool {
+#if defined(GENTEST_MOCK_TRACE_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            struct stat st{};
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void *addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr != MAP_FAILED) {
+                    data   = static_cast<const char *>(addr);
+                    size   = static_cast<std::size_t>(st.st_size);
+                    mapped = true;
+                }
+            }
+            ::close(fd);
+        }
+#endif
+        if (!mapped) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                error = "cannot open file";
+                return false;
+            }
+            owned.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            data = owned.data();
+            size = owned.size();
+        }
+        return parse(error);
+    }
+
+    auto parse(std::string &error) -> bool {
+        Cursor cur{std::string_view(data, size)};
+        if (cur.rest.size() < kMagic.size() || std::memcmp(cur.rest.data(), kMagic.data(), kMagic.size()) != 0) {
+            error = "not a gentest mock trace";
+            return false;
+        }
+        cur.rest.remove_prefix(kMagic.size());
+        const auto method_count = cur.u32();
+        const auto record_count = cur.u32();
+        if (!method_count || !record_count) {
+            error = "truncated header";
+            return false;
+        }
+        // The counts come from the file; check them against the bytes left
+        // before reserving so a corrupt header cannot request a huge buffer.
+        if (*method_count > cur.rest.size() / kMinMethodBytes) {
+            error = "truncated method table";
+            return false;
+        }
+        std::vector<std::string_view> methods;
+        methods.reserve(*method_count);
+        for (std::uint32_t i = 0; i < *method_count; ++i) {
+            const auto name = cur.bytes();
+            if (!name) {
+                error = "truncated method table";
+                return false;
+            }
+            methods.push_back(*name);
+        }
+        if (*record_count > cur.rest.size() / kMinRecordBytes) {
+            error = "truncated or corrupt call record";
+            return false;
+        }
+        records.reserve(*record_count);
+        for (std::uint32_t i = 0; i < *record_count; ++i) {
+            const auto method = cur.u32();
+            const auto args   = method ? cur.bytes() : std::nullopt;
+            const auto result = args ? cur.bytes() : std::nullopt;
+            if (!result || *method >= methods.size()) {
+                error = "truncated or corrupt call record";
+                return false;
+            }
+            records.push_back(MockTraceRecord{.method = methods[*method], .args = *args, .result = *result});
+        }
+        return true;
+    }
+};
+
+auto open_mock_trace(const std::string &path, std::string &error) -> std::shared_ptr<const MockTrace> {
+    auto trace = std::make_shared<MockTrace>();
+    if (!trace->load(path, error)) {
+        return nullptr;
+    }
+    return trace;
+}
+
+auto mock_trace_records(const MockTrace &trace) -> std::span<const MockTraceRecord> { return trace.records; }
+
+auto write_mock_trace(const std::string &path, std::span<const MockTraceRecord> records) -> std::string {
+    std::vector<std::string_view>                       methods;
+    std::unordered_map<std::string_view, std::uint32_t> method_index;
+    std::string                                         body;
+    for (const auto &record : records) {
+        const auto [it, inserted] = method_index.emplace(record.method, static_cast<std::uint32_t>(methods.size()));
+        if (inserted) {
+            methods.push_back(record.method);
+        }
+        put_u32(body, it->second);
+        put_bytes(body, record.args);
+        put_bytes(body, record.result);
+    }
+
+    std::string out(kMagic.data(), kMagic.size());
+    put_u32(out, static_cast<std::uint32_t>(methods.size()));
+    put_u32(out, static_cast<std::uint32_t>(records.size()));
+    for (const auto method : methods) {
+        put_bytes(out, method);
+    }
+    out += body;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return "cannot open file for writing";
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        return "write failed";
+    }
+    return {};
+}
+
+} // namespace gentest::detail::mocking
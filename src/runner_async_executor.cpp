@@ -8,6 +8,7 @@
 #include "runner_context_scope.h"
 #include "runner_fixture_runtime.h"
 #include "runner_reporting.h"
+#include "runner_tag_utils.h"
 
 #include <atomic>
 #include <chrono>
@@ -123,11 +124,10 @@ void write_async_log_through_renderer(void *state, std::string_view message) noe
     }
 }
 
-void observe_async_case_logs(void *state, std::size_t case_id, const std::vector<std::string> &recent_logs,
-                             std::size_t log_count) noexcept {
+void observe_async_case_logs(void *state, std::size_t case_id, std::string_view message, std::size_t log_count) noexcept {
     auto *renderer = static_cast<AsyncStatusRenderer *>(state);
     if (renderer) {
-        renderer->update_logs(case_id, recent_logs, log_count);
+        renderer->append_log(case_id, message, log_count);
     }
 }
 
@@ -162,7 +162,8 @@ bool run_tests_async_batch(TestRunContext &state, std::span<const gentest::Case>
                            bool fail_fast, TestCounters &counters) {
     std::vector<AsyncCaseRun> async_runs;
     AsyncStatusRenderer       renderer(std::cout, AsyncStatusRenderer::terminal_mode(state.color_output), state.color_output, {},
-                                       state.async_log_tail);
+                                       state.async_log_tail, {},
+                                       state.async_live_diff ? AsyncStatusRenderer::Refresh::Diff : AsyncStatusRenderer::Refresh::Redraw);
     gentest::detail::DefaultStdoutLogWriterScope log_writer_scope(renderer.enabled() ? &renderer : nullptr,
                                                                   &write_async_log_through_renderer);
     TestRunContext                               final_state = state;
@@ -184,6 +185,24 @@ bool run_tests_async_batch(TestRunContext &state, std::span<const gentest::Case>
         }
     };
 
+    // Dropping the task and the pool's owner reference frees the case's frame
+    // pool in one piece as soon as no other holder keeps a block alive.
+    const auto release_run_frames = [&](std::size_t run_index) {
+        auto &run = async_runs[run_index];
+        if (state.async_alloc_stats && run.frame_pool) {
+            const auto stats = run.frame_pool->stats();
+            const auto line  = fmt::format("[ ALLOC ] {} :: {} pooled, {} oversize, peak {} bytes in {} chunk(s)",
+                                           cases[run.case_index].name, stats.allocations, stats.oversize, stats.peak_bytes, stats.chunks);
+            if (renderer.enabled()) {
+                renderer.result_line(line);
+            } else {
+                fmt::print("{}\n", line);
+            }
+        }
+        run.task.reset();
+        run.frame_pool.reset();
+    };
+
     const auto finalize_run = [&](std::size_t run_index) {
         auto &run = async_runs[run_index];
         if (run.finalized) {
@@ -192,9 +211,12 @@ bool run_tests_async_batch(TestRunContext &state, std::span<const gentest::Case>
         run.finalized = true;
         ++counters.total;
         record_invoke_result(run_index, finish_async_run(run));
+        release_run_frames(run_index);
     };
 
-    BatchAsyncScheduler scheduler(async_runs, renderer.enabled() ? &renderer : nullptr);
+    BatchAsyncScheduler scheduler(async_runs, renderer.enabled() ? &renderer : nullptr, fail_fast ? 1 : state.async_workers,
+                                  state.async_timer_wheel ? gentest::detail::AsyncTimerQueueKind::Wheel
+                                                          : gentest::detail::AsyncTimerQueueKind::Heap);
 
     const auto has_adopted_work = [](const AsyncCaseRun &run) {
         return run.ctxinfo && run.ctxinfo->adopted_contexts.load(std::memory_order_acquire) != 0;
@@ -314,6 +336,7 @@ bool run_tests_async_batch(TestRunContext &state, std::span<const gentest::Case>
         if (state.acc) {
             gentest::runner::record_case_result(*state.acc, cases[run.case_index], std::move(rr), state.record_results);
         }
+        release_run_frames(run_index);
     };
 
     const auto finalize_completed_runs = [&] {
@@ -465,10 +488,10 @@ bool run_tests_async_batch(TestRunContext &state, std::span<const gentest::Case>
             const auto run_index = async_runs.size();
             schedule_async_case(async_runs, test, i, ctx);
             renderer.add_case(run_index, test.name);
-            auto &run = async_runs[run_index];
+            auto &run        = async_runs[run_index];
+            run.virtual_time = state.async_virtual_time || has_tag_ci(test, "virtual_time");
             if (renderer.enabled() && run.ctxinfo) {
                 std::lock_guard<std::mutex> lk(run.ctxinfo->mtx);
-                run.ctxinfo->recent_log_limit = state.async_log_tail;
                 run.ctxinfo->suppress_stdout_log.store(true, std::memory_order_release);
                 run.ctxinfo->log_observer_state = &renderer;
                 run.ctxinfo->log_observer       = &observe_async_case_logs;
@@ -9,6 +9,7 @@
 #include <filesystem>
 #include <fmt/format.h>
 #include <iterator>
+#include <limits>
 #include <ranges>
 #include <string_view>
 #include <utility>
@@ -18,6 +19,35 @@ namespace {
 
 constexpr std::string_view kAsyncCannotResumeMessage = "cannot resume async test";
 
+// Run index of the frame this thread is resuming; selects the timer clock.
+thread_local std::size_t g_resuming_owner = AsyncSchedulerCore::kInvalidOwner;
+
+class ResumingOwnerScope {
+  public:
+    explicit ResumingOwnerScope(std::size_t owner) noexcept : previous_(std::exchange(g_resuming_owner, owner)) {}
+    ResumingOwnerScope(const ResumingOwnerScope &)            = delete;
+    ResumingOwnerScope &operator=(const ResumingOwnerScope &) = delete;
+    ~ResumingOwnerScope() { g_resuming_owner = previous_; }
+
+  private:
+    std::size_t previous_;
+};
+
+// Set while a thread runs a worker phase. Cases that finish there are handed
+// back to the runner thread instead of being finalized on the worker.
+thread_local bool g_pool_phase = false;
+
+class PoolPhaseScope {
+  public:
+    PoolPhaseScope() noexcept : previous_(std::exchange(g_pool_phase, true)) {}
+    PoolPhaseScope(const PoolPhaseScope &)            = delete;
+    PoolPhaseScope &operator=(const PoolPhaseScope &) = delete;
+    ~PoolPhaseScope() { g_pool_phase = previous_; }
+
+  private:
+    bool previous_;
+};
+
 auto suspend_location_text(std::string_view file, unsigned line) -> std::string {
     if (file.empty() || line == 0) {
         return {};
@@ -39,14 +69,43 @@ auto suspend_location_text(std::string_view file, unsigned line) -> std::string
 
 } // namespace
 
-BatchAsyncScheduler::BatchAsyncScheduler(std::vector<AsyncCaseRun> &runs, AsyncStatusRenderer *renderer)
+BatchAsyncScheduler::BatchAsyncScheduler(std::vector<AsyncCaseRun> &runs, AsyncStatusRenderer *renderer, std::size_t workers,
+                                         gentest::detail::AsyncTimerQueueKind timers)
     : runs_(runs), renderer_(renderer), adopted_release_wake_(std::make_shared<gentest::detail::TestContextInfo::AdoptedReleaseWake>()),
-      core_([this] { adopted_release_wake_->notify_one(); }) {}
+      core_(
+          [this] {
+              adopted_release_wake_->notify_one();
+              if (!workers_.empty()) {
+                  notify_pool_work();
+              }
+          },
+          workers, timers),
+      virtual_clock_(std::make_shared<gentest::detail::AsyncClock>(std::chrono::steady_clock::now())) {
+    adopted_release_wake_->interrupt = core_.io_interrupter();
+    if (core_.lane_count() > 1) {
+        workers_.reserve(core_.lane_count() - 1);
+        for (std::size_t lane = 1; lane < core_.lane_count(); ++lane) {
+            workers_.emplace_back([this, lane] { worker_main(lane); });
+        }
+    }
+}
 
-BatchAsyncScheduler::~BatchAsyncScheduler() { deactivate(); }
+BatchAsyncScheduler::~BatchAsyncScheduler() {
+    {
+        std::lock_guard<std::mutex> lk(pool_mtx_);
+        stopping_ = true;
+    }
+    pool_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    deactivate();
+}
 
 void BatchAsyncScheduler::post(std::coroutine_handle<> handle) { core_.post(handle); }
 
+void BatchAsyncScheduler::post_waiter(gentest::detail::AsyncWaiterToken &token) { (void)core_.post_waiter(token); }
+
 void BatchAsyncScheduler::post_frame(const gentest::detail::AsyncFramePtr &frame) { core_.post(frame); }
 
 void BatchAsyncScheduler::block(std::coroutine_handle<> handle, std::string reason) { core_.block(handle, std::move(reason)); }
@@ -66,11 +125,27 @@ void BatchAsyncScheduler::attach_child_frame(const gentest::detail::AsyncFramePt
 auto BatchAsyncScheduler::make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr { return core_.make_waiter(handle, control()); }
 
 void BatchAsyncScheduler::schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) {
+    if (clock()) {
+        core_.schedule_virtual_timer(deadline, token);
+        return;
+    }
     core_.schedule_timer(deadline, token);
 }
 
+void BatchAsyncScheduler::watch_fd(int fd, gentest::detail::AsyncIoInterest interest, const WaiterTokenPtr &token) {
+    core_.watch_fd(fd, interest, token);
+}
+
 void BatchAsyncScheduler::cancel_waiters(std::coroutine_handle<> handle) noexcept { core_.cancel_waiters(handle); }
 
+auto BatchAsyncScheduler::clock() const -> gentest::detail::AsyncClockPtr {
+    const auto owner = g_resuming_owner;
+    if (owner < runs_.size() && runs_[owner].virtual_time) {
+        return virtual_clock_;
+    }
+    return {};
+}
+
 void BatchAsyncScheduler::add_top_level(std::size_t run_index, gentest::detail::AsyncTask &task) {
     register_adopted_release_wake_for(run_index);
     task.set_scheduler(this);
@@ -85,6 +160,11 @@ auto BatchAsyncScheduler::run_one_ready() -> bool {
 }
 
 void BatchAsyncScheduler::run_ready() {
+    if (!workers_.empty()) {
+        core_.post_due_timers();
+        run_phase(core_.ready_size());
+        return;
+    }
     gentest::detail::AsyncSchedulerScope scheduler_scope(this);
     core_.post_due_timers();
     for (std::size_t remaining = core_.ready_size(); remaining != 0; --remaining) {
@@ -186,48 +266,153 @@ void BatchAsyncScheduler::complete(std::size_t owner) {
 
 auto BatchAsyncScheduler::resume_one_ready() -> bool {
     while (auto frame = core_.pop_ready()) {
-        if (!frame || !frame->handle) {
-            continue;
+        if (resume_frame(frame, core_.owner_for(frame))) {
+            return true;
         }
-        const auto owner = core_.owner_for(frame);
-        if (owner >= runs_.size()) {
-            continue;
+    }
+    return false;
+}
+
+auto BatchAsyncScheduler::resume_frame(const gentest::detail::AsyncFramePtr &frame, std::size_t owner) -> bool {
+    if (!frame || !frame->handle || owner >= runs_.size() || frame->is_canceled() || frame->done()) {
+        return false;
+    }
+    auto &run = runs_[owner];
+    if (run.finalized) {
+        return false;
+    }
+    {
+        gentest::runner::detail::CurrentTestContextScope current_scope(run.ctxinfo);
+        ResumingOwnerScope                               owner_scope(owner);
+        AsyncFramePoolScope                              pool_scope(run.frame_pool.get());
+        if (renderer_) {
+            renderer_->mark_running(owner);
         }
-        if (frame->is_canceled() || frame->done()) {
-            continue;
+        core_.clear_suspend_state(frame);
+        try {
+            frame->handle.resume();
+        } catch (const std::exception &e) {
+            run.exception = InvokeException::StdException;
+            run.message   = fmt::format("std::exception: {}", e.what());
+        } catch (...) {
+            run.exception = InvokeException::Unknown;
+            run.message   = "unknown exception";
         }
-        auto &run = runs_[owner];
-        if (run.finalized) {
-            continue;
+    }
+
+    if (run_is_complete(owner)) {
+        if (g_pool_phase) {
+            // Cancel the case's remaining frames now so no other worker picks
+            // them up; finalization waits for the runner thread.
+            core_.cancel_owner(owner);
+            std::lock_guard<std::mutex> lk(pool_mtx_);
+            phase_completions_.push_back(owner);
+        } else {
+            complete(owner);
+        }
+    } else if (renderer_ && run.exception == InvokeException::None) {
+        const auto suspended = core_.suspended_state_for(owner);
+        if (suspended.kind == AsyncSchedulerCore::SuspendKind::Yielded) {
+            renderer_->mark_yielded(owner, suspended.reason, suspended.file, suspended.line);
+        } else {
+            renderer_->mark_suspended(owner, suspended.reason, suspended.file, suspended.line);
         }
+    }
+    return true;
+}
+
+void BatchAsyncScheduler::notify_pool_work() {
+    {
+        std::lock_guard<std::mutex> lk(pool_mtx_);
+        ++work_epoch_;
+    }
+    pool_cv_.notify_all();
+}
+
+void BatchAsyncScheduler::worker_main(std::size_t lane) {
+    std::uint64_t seen_generation = 0;
+    while (true) {
         {
-            gentest::runner::detail::CurrentTestContextScope current_scope(run.ctxinfo);
-            if (renderer_) {
-                renderer_->mark_running(owner);
-            }
-            core_.clear_suspend_state(frame);
-            try {
-                frame->handle.resume();
-            } catch (const std::exception &e) {
-                run.exception = InvokeException::StdException;
-                run.message   = fmt::format("std::exception: {}", e.what());
-            } catch (...) {
-                run.exception = InvokeException::Unknown;
-                run.message   = "unknown exception";
+            std::unique_lock<std::mutex> lk(pool_mtx_);
+            pool_cv_.wait(lk, [&] { return stopping_ || phase_generation_ != seen_generation; });
+            if (stopping_) {
+                return;
             }
+            seen_generation = phase_generation_;
+        }
+        work_phase(lane);
+        {
+            std::lock_guard<std::mutex> lk(pool_mtx_);
+            --active_workers_;
         }
+        pool_cv_.notify_all();
+    }
+}
 
-        if (run_is_complete(owner)) {
-            complete(owner);
-        } else if (renderer_ && run.exception == InvokeException::None) {
-            const auto suspended = core_.suspended_state_for(owner);
-            if (suspended.kind == AsyncSchedulerCore::SuspendKind::Yielded) {
-                renderer_->mark_yielded(owner, suspended.reason, suspended.file, suspended.line);
-            } else {
-                renderer_->mark_suspended(owner, suspended.reason, suspended.file, suspended.line);
-            }
+void BatchAsyncScheduler::run_phase(std::size_t budget) {
+    if (budget == 0) {
+        return;
+    }
+    phase_budget_.store(budget, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(pool_mtx_);
+        active_workers_ = workers_.size();
+        ++phase_generation_;
+    }
+    pool_cv_.notify_all();
+    work_phase(0);
+    std::vector<std::size_t> completions;
+    {
+        std::unique_lock<std::mutex> lk(pool_mtx_);
+        pool_cv_.wait(lk, [&] { return active_workers_ == 0; });
+        completions.swap(phase_completions_);
+    }
+    for (const std::size_t owner : completions) {
+        complete(owner);
+    }
+}
+
+// Runs ready frames until the phase budget is spent or every lane is empty with
+// no frame in flight. A worker that only finds frames of cases running
+// elsewhere waits for the next post or completion instead of spinning.
+void BatchAsyncScheduler::work_phase(std::size_t lane) {
+    gentest::detail::AsyncSchedulerScope scheduler_scope(this);
+    PoolPhaseScope                       phase_scope;
+    while (true) {
+        std::uint64_t epoch = 0;
+        {
+            std::lock_guard<std::mutex> lk(pool_mtx_);
+            epoch = work_epoch_;
+        }
+        core_.post_due_timers();
+        busy_workers_.fetch_add(1, std::memory_order_acq_rel);
+        const bool budgeted = take_phase_budget();
+        auto       ready    = budgeted ? core_.pop_ready_for(lane) : AsyncSchedulerCore::ReadyFrame{};
+        if (ready) {
+            (void)resume_frame(ready.frame, ready.owner);
+            core_.release_owner(ready.owner);
+            busy_workers_.fetch_sub(1, std::memory_order_acq_rel);
+            notify_pool_work();
+            continue;
+        }
+        if (budgeted) {
+            phase_budget_.fetch_add(1, std::memory_order_relaxed);
+        }
+        const bool others_busy = busy_workers_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        if (phase_budget_.load(std::memory_order_relaxed) == 0 || (!others_busy && !core_.has_ready())) {
+            return;
+        }
+        std::unique_lock<std::mutex> lk(pool_mtx_);
+        pool_cv_.wait(lk, [&] { return work_epoch_ != epoch; });
+    }
+}
+
+auto BatchAsyncScheduler::take_phase_budget() -> bool {
+    std::size_t budget = phase_budget_.load(std::memory_order_relaxed);
+    while (budget != 0) {
+        if (phase_budget_.compare_exchange_weak(budget, budget - 1, std::memory_order_relaxed)) {
+            return true;
         }
-        return true;
     }
     return false;
 }
@@ -246,7 +431,8 @@ auto BatchAsyncScheduler::has_unfinished_adopted_work() const -> bool {
 
 void BatchAsyncScheduler::wait_for_ready_or_adopted_release(const StopCallback &should_stop) {
     const auto stop_or_progress_locked = [&] {
-        return core_.has_ready() || (!has_unfinished_adopted_work() && !core_.next_timer_deadline()) || (should_stop && should_stop());
+        return core_.has_ready() || (!has_unfinished_adopted_work() && !core_.next_timer_deadline() && !core_.has_io_watches()) ||
+               (should_stop && should_stop());
     };
 
     while (true) {
@@ -263,6 +449,13 @@ void BatchAsyncScheduler::wait_for_ready_or_adopted_release(const StopCallback &
                 wake_deadline = renderer_deadline;
             }
         }
+        // With fds to watch, block in the poller instead; notify_one() on the
+        // wake also interrupts it.
+        if (core_.has_io_watches()) {
+            wake_lk.unlock();
+            (void)core_.wait_io(wake_deadline);
+            break;
+        }
         const auto wake_observed = [&] { return adopted_release_wake_->generation != wake_generation; };
         if (wake_deadline) {
             (void)adopted_release_wake_->cv.wait_until(wake_lk, *wake_deadline, wake_observed);
@@ -280,6 +473,10 @@ void BatchAsyncScheduler::wait_for_ready_or_adopted_release(const StopCallback &
 auto BatchAsyncScheduler::drain_ready_and_adopted_work(const StopCallback &should_stop, const ProgressCallback &after_progress) -> bool {
     do {
         core_.post_due_timers();
+        (void)core_.post_ready_io();
+        if (!workers_.empty() && !should_stop) {
+            run_phase(std::numeric_limits<std::size_t>::max());
+        }
         while (has_ready()) {
             if (should_stop && should_stop()) {
                 return true;
@@ -300,7 +497,13 @@ auto BatchAsyncScheduler::drain_ready_and_adopted_work(const StopCallback &shoul
         if (should_stop && should_stop()) {
             return true;
         }
-        if (!has_unfinished_adopted_work() && !core_.has_pending_timers()) {
+        // Virtual time jumps only once no frame is ready, no adopted worker
+        // thread is outstanding and no watched fd is ready, so a worker's
+        // completion or pending I/O still beats a virtual timeout.
+        if (!has_unfinished_adopted_work() && (core_.post_ready_io() || core_.advance_virtual_time(*virtual_clock_))) {
+            continue;
+        }
+        if (!has_unfinished_adopted_work() && !core_.has_pending_timers() && !core_.has_io_watches()) {
             return false;
         }
         wait_for_ready_or_adopted_release(should_stop);
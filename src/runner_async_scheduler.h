@@ -5,13 +5,18 @@
 #include "runner_async_state.h"
 #include "runner_async_status_renderer.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <coroutine>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <source_location>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -22,10 +27,15 @@ class BatchAsyncScheduler final : public gentest::detail::AsyncScheduler {
     using StopCallback     = std::function<bool()>;
     using ProgressCallback = std::function<bool()>;
 
-    BatchAsyncScheduler(std::vector<AsyncCaseRun> &runs, AsyncStatusRenderer *renderer);
+    // `workers` counts the calling thread; with more than one, ready frames of
+    // different cases are resumed concurrently on a pool of worker threads.
+    // `timers` picks the wait_for/sleep_for timer queue.
+    BatchAsyncScheduler(std::vector<AsyncCaseRun> &runs, AsyncStatusRenderer *renderer, std::size_t workers = 1,
+                        gentest::detail::AsyncTimerQueueKind timers = gentest::detail::AsyncTimerQueueKind::Heap);
     ~BatchAsyncScheduler() override;
 
     void               post(std::coroutine_handle<> handle) override;
+    void               post_waiter(gentest::detail::AsyncWaiterToken &token) override;
     void               post_frame(const gentest::detail::AsyncFramePtr &frame) override;
     void               block(std::coroutine_handle<> handle, std::string reason) override;
     void               block_at(std::coroutine_handle<> handle, std::string reason, const std::source_location &loc) override;
@@ -34,7 +44,9 @@ class BatchAsyncScheduler final : public gentest::detail::AsyncScheduler {
     void               attach_child_frame(const gentest::detail::AsyncFramePtr &child, std::coroutine_handle<> parent) override;
     [[nodiscard]] auto make_waiter(std::coroutine_handle<> handle) -> WaiterTokenPtr override;
     void               schedule_timer(std::chrono::steady_clock::time_point deadline, const WaiterTokenPtr &token) override;
+    void               watch_fd(int fd, gentest::detail::AsyncIoInterest interest, const WaiterTokenPtr &token) override;
     void               cancel_waiters(std::coroutine_handle<> handle) noexcept override;
+    [[nodiscard]] auto clock() const -> gentest::detail::AsyncClockPtr override;
 
     void               add_top_level(std::size_t run_index, gentest::detail::AsyncTask &task);
     [[nodiscard]] auto run_one_ready() -> bool;
@@ -51,6 +63,12 @@ class BatchAsyncScheduler final : public gentest::detail::AsyncScheduler {
     [[nodiscard]] bool run_is_complete(std::size_t owner) const;
     void               complete(std::size_t owner);
     [[nodiscard]] auto resume_one_ready() -> bool;
+    [[nodiscard]] auto resume_frame(const gentest::detail::AsyncFramePtr &frame, std::size_t owner) -> bool;
+    void               notify_pool_work();
+    void               worker_main(std::size_t lane);
+    void               run_phase(std::size_t budget);
+    void               work_phase(std::size_t lane);
+    [[nodiscard]] auto take_phase_budget() -> bool;
     [[nodiscard]] auto has_unfinished_adopted_work() const -> bool;
     void               wait_for_ready_or_adopted_release(const StopCallback &should_stop);
     [[nodiscard]] auto drain_ready_and_adopted_work(const StopCallback &should_stop, const ProgressCallback &after_progress) -> bool;
@@ -60,6 +78,23 @@ class BatchAsyncScheduler final : public gentest::detail::AsyncScheduler {
     std::shared_ptr<gentest::detail::TestContextInfo::AdoptedReleaseWake> adopted_release_wake_;
     std::unordered_set<gentest::detail::TestContextInfo *>                context_listener_contexts_;
     AsyncSchedulerCore                                                    core_;
+    // Shared by every virtual-time case in the batch; starts at construction.
+    gentest::detail::AsyncClockPtr virtual_clock_;
+
+    // Worker pool. Phases are fork-join: the calling thread runs lane 0 and
+    // returns once every worker is idle. Cases that finish during a phase are
+    // queued in `phase_completions_` and finalized on the calling thread after
+    // the join, so finalization stays single-threaded.
+    std::vector<std::thread>     workers_;
+    std::mutex                   pool_mtx_;
+    std::condition_variable      pool_cv_;
+    std::vector<std::size_t>     phase_completions_;
+    std::uint64_t                phase_generation_ = 0;
+    std::uint64_t                work_epoch_       = 0;
+    std::size_t                  active_workers_   = 0;
+    bool                         stopping_         = false;
+    std::atomic<std::size_t>     phase_budget_{0};
+    std::atomic<std::size_t>     busy_workers_{0};
 };
 
 } // namespace gentest::runner
@@ -102,9 +102,11 @@ void schedule_async_case(std::vector<AsyncCaseRun> &runs, const gentest::Case &t
     run.fixture_ctx = fixture_ctx;
     run.ctxinfo     = gentest::runner::detail::make_active_test_context(test.name);
     run.start       = std::chrono::steady_clock::now();
+    run.frame_pool  = AsyncFramePool::create();
 
     {
         gentest::runner::detail::CurrentTestContextScope current_scope(run.ctxinfo);
+        AsyncFramePoolScope                              pool_scope(run.frame_pool.get());
         try {
             if (test.async_fn) {
                 run.task = test.async_fn(fixture_ctx);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "async_frame_pool.h"
 #include "gentest/runner.h"
 #include "runner_case_invoker.h"
 
@@ -16,12 +17,14 @@ struct AsyncCaseRun {
     void                                             *fixture_ctx = nullptr;
     std::shared_ptr<gentest::detail::TestContextInfo> ctxinfo;
     gentest::detail::AsyncTaskPtr                     task;
+    AsyncFramePool::Ptr                               frame_pool;
     std::chrono::steady_clock::time_point             start;
     std::chrono::steady_clock::time_point             end;
     InvokeException                                   exception = InvokeException::None;
     std::string                                       message;
     bool                                              ready_to_finalize = false;
     bool                                              finalized         = false;
+    bool                                              virtual_time      = false;
 };
 
 [[nodiscard]] auto async_run_requests_xfail(const AsyncCaseRun &run) -> bool;
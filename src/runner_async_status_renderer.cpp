@@ -109,10 +109,6 @@ auto status_color(AsyncLiveStatus status) -> indicators::Color {
     return indicators::Color::white;
 }
 
-auto find_row(std::vector<AsyncLiveRowSnapshot> &rows, std::size_t id) -> std::vector<AsyncLiveRowSnapshot>::iterator {
-    return std::ranges::find_if(rows, [&](const AsyncLiveRowSnapshot &row) { return row.id == id; });
-}
-
 auto plain_status(AsyncLiveStatus status) -> std::string { return fmt::format("[ {:^9} ]", async_live_status_text(status)); }
 
 auto ansi_status_color_code(AsyncLiveStatus status) -> std::string_view {
@@ -465,8 +461,81 @@ auto format_scrolling_log_line(std::string_view message, std::size_t max_width)
     return shorten_right(sanitized_terminal_field(message), max_width);
 }
 
+// The row line followed by its recent log tail, each clipped to `line_width`.
+auto format_row_block(const AsyncLiveRowSnapshot &row, bool color_output, bool hyperlink_locations, std::size_t line_width,
+                      std::size_t log_tail_limit) -> std::vector<std::string> {
+    std::vector<std::string> block;
+    const auto               tail_size = log_tail_limit == 0 ? 0 : std::min(row.recent_logs.size(), log_tail_limit);
+    block.reserve(tail_size + 1);
+    auto line = format_row(row, color_output, hyperlink_locations, line_width);
+    trim_trailing_padding(line);
+    block.push_back(std::move(line));
+    for (std::size_t i = row.recent_logs.size() - tail_size; i < row.recent_logs.size(); ++i) {
+        auto log_line = format_log_tail_line(row.recent_logs[i], line_width);
+        trim_trailing_padding(log_line);
+        block.push_back(std::move(log_line));
+    }
+    return block;
+}
+
+// Stacks the blocks of the active rows in creation order. With a `max_rows`
+// limit the newest rows win: rows are visited from the back and stop once the
+// limit is reached, and a block that does not fit keeps its row line plus its
+// newest tail lines. `block_for(index)` is only called for rows that show.
+template <typename BlockFor>
+auto stack_row_blocks(const std::vector<AsyncLiveRowSnapshot> &rows, std::size_t max_rows, BlockFor &&block_for)
+    -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    if (max_rows == 0) {
+        for (std::size_t index = 0; index < rows.size(); ++index) {
+            if (!rows[index].final) {
+                const std::vector<std::string> &block = block_for(index);
+                lines.insert(lines.end(), block.begin(), block.end());
+            }
+        }
+        return lines;
+    }
+
+    std::size_t remaining = max_rows;
+    for (std::size_t index = rows.size(); index-- > 0 && remaining != 0;) {
+        if (rows[index].final) {
+            continue;
+        }
+        const std::vector<std::string> &block   = block_for(index);
+        const std::size_t               visible = std::min(block.size(), remaining);
+        for (std::size_t i = block.size(); i-- > block.size() - (visible - 1);) {
+            lines.push_back(block[i]);
+        }
+        lines.push_back(block.front());
+        remaining -= visible;
+    }
+    std::ranges::reverse(lines);
+    return lines;
+}
+
 } // namespace
 
+void AsyncLogRing::push(std::string_view line) {
+    if (slots_.empty()) {
+        return;
+    }
+    if (size_ < slots_.size()) {
+        slots_[(head_ + size_) % slots_.size()].assign(line);
+        ++size_;
+        return;
+    }
+    slots_[head_].assign(line);
+    head_ = (head_ + 1) % slots_.size();
+}
+
+void AsyncLogRing::assign(std::span<const std::string> lines) {
+    head_ = 0;
+    size_ = 0;
+    for (std::size_t i = lines.size() > slots_.size() ? lines.size() - slots_.size() : 0; i < lines.size(); ++i) {
+        push(lines[i]);
+    }
+}
+
 auto async_live_status_text(AsyncLiveStatus status) -> std::string_view {
     switch (status) {
     case AsyncLiveStatus::Suspended: return "SUSPENDED";
@@ -498,9 +567,10 @@ auto async_live_status_color_name(AsyncLiveStatus status) -> std::string_view {
 }
 
 AsyncStatusRenderer::AsyncStatusRenderer(std::ostream &out, Mode mode, bool color_output, AsyncTerminalSizeOverride size_override,
-                                         std::size_t log_tail_limit, MonotonicNow monotonic_now)
-    : out_(&out), mode_(mode), color_output_(color_output && mode != Mode::Disabled), width_override_(size_override.width),
-      height_override_(size_override.height), log_tail_limit_(log_tail_limit), monotonic_now_(std::move(monotonic_now)) {
+                                         std::size_t log_tail_limit, MonotonicNow monotonic_now, Refresh refresh)
+    : out_(&out), mode_(mode), refresh_(refresh), color_output_(color_output && mode != Mode::Disabled),
+      width_override_(size_override.width), height_override_(size_override.height), log_tail_limit_(log_tail_limit),
+      monotonic_now_(std::move(monotonic_now)) {
     if (!monotonic_now_) {
         monotonic_now_ = [] { return MonotonicClock::now(); };
     }
@@ -529,10 +599,13 @@ auto AsyncStatusRenderer::enabled() const noexcept -> bool { return mode_ != Mod
 
 void AsyncStatusRenderer::add_case(std::size_t id, std::string_view name) {
     std::lock_guard<std::mutex> lk(mtx_);
-    if (!enabled() || finished_ || find_row(rows_, id) != rows_.end()) {
+    if (!enabled() || finished_ || row_index_.contains(id)) {
         return;
     }
-    rows_.push_back(AsyncLiveRowSnapshot{.id = id, .name = std::string(name), .status = AsyncLiveStatus::Suspended});
+    row_index_.emplace(id, rows_.size());
+    rows_.push_back(AsyncLiveRowSnapshot{
+        .id = id, .name = std::string(name), .status = AsyncLiveStatus::Suspended, .recent_logs = AsyncLogRing(log_tail_limit_)});
+    row_blocks_.emplace_back();
     render();
 }
 
@@ -541,8 +614,8 @@ void AsyncStatusRenderer::mark_running(std::size_t id) {
     if (!enabled() || finished_) {
         return;
     }
-    auto row = find_row(rows_, id);
-    if (row == rows_.end() || row->final) {
+    auto *row = find_row(id);
+    if (row == nullptr || row->final) {
         return;
     }
     row->status = AsyncLiveStatus::Running;
@@ -551,6 +624,7 @@ void AsyncStatusRenderer::mark_running(std::size_t id) {
     row->suspend_label.clear();
     row->suspend_uri.clear();
     row->suspend_line = 0;
+    mark_dirty(*row);
     render();
 }
 
@@ -560,8 +634,8 @@ void AsyncStatusRenderer::mark_yielded(std::size_t id, std::string_view detail,
     if (!enabled() || finished_) {
         return;
     }
-    auto row = find_row(rows_, id);
-    if (row == rows_.end() || row->final) {
+    auto *row = find_row(id);
+    if (row == nullptr || row->final) {
         return;
     }
     row->status         = AsyncLiveStatus::Yielded;
@@ -571,6 +645,7 @@ void AsyncStatusRenderer::mark_yielded(std::size_t id, std::string_view detail,
     const auto location = location_parts(file, line);
     row->suspend_label  = location.label;
     row->suspend_uri    = location.uri;
+    mark_dirty(*row);
     render();
 }
 
@@ -580,8 +655,8 @@ void AsyncStatusRenderer::mark_suspended(std::size_t id, std::string_view detail
     if (!enabled() || finished_) {
         return;
     }
-    auto row = find_row(rows_, id);
-    if (row == rows_.end() || row->final) {
+    auto *row = find_row(id);
+    if (row == nullptr || row->final) {
         return;
     }
     row->status         = AsyncLiveStatus::Suspended;
@@ -591,6 +666,7 @@ void AsyncStatusRenderer::mark_suspended(std::size_t id, std::string_view detail
     const auto location = location_parts(file, line);
     row->suspend_label  = location.label;
     row->suspend_uri    = location.uri;
+    mark_dirty(*row);
     render();
 }
 
@@ -600,8 +676,8 @@ auto AsyncStatusRenderer::mark_final(std::size_t id, AsyncLiveStatus status, std
     if (!enabled() || finished_) {
         return {};
     }
-    auto row = find_row(rows_, id);
-    if (row == rows_.end()) {
+    auto *row = find_row(id);
+    if (row == nullptr) {
         return {};
     }
     row->status = status;
@@ -612,6 +688,7 @@ auto AsyncStatusRenderer::mark_final(std::size_t id, AsyncLiveStatus status, std
     row->suspend_line = 0;
     row->duration_ms  = duration_ms;
     row->final        = true;
+    row_blocks_[static_cast<std::size_t>(row - rows_.data())] = RowBlock{};
     completed_lines_.push_back(format_row(*row, color_output_, false, output_width()));
     auto line = completed_lines_.back();
     render(true);
@@ -623,12 +700,28 @@ void AsyncStatusRenderer::update_logs(std::size_t id, std::span<const std::strin
     if (!enabled() || finished_) {
         return;
     }
-    auto row = find_row(rows_, id);
-    if (row == rows_.end() || row->final) {
+    auto *row = find_row(id);
+    if (row == nullptr || row->final) {
         return;
     }
     row->log_count = log_count;
-    row->recent_logs.assign(recent_logs.begin(), recent_logs.end());
+    row->recent_logs.assign(recent_logs);
+    mark_dirty(*row);
+    render();
+}
+
+void AsyncStatusRenderer::append_log(std::size_t id, std::string_view message, std::size_t log_count) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!enabled() || finished_) {
+        return;
+    }
+    auto *row = find_row(id);
+    if (row == nullptr || row->final) {
+        return;
+    }
+    row->log_count = log_count;
+    row->recent_logs.push(message);
+    mark_dirty(*row);
     render();
 }
 
@@ -653,7 +746,7 @@ auto AsyncStatusRenderer::next_refresh_deadline() const -> std::optional<Monoton
     if (!enabled() || finished_ || mode_ != Mode::Terminal || !terminal_refresh_pending_ || !has_terminal_refresh_) {
         return std::nullopt;
     }
-    return last_terminal_refresh_ + kTerminalRefreshInterval;
+    return last_terminal_refresh_ + refresh_interval_;
 }
 
 void AsyncStatusRenderer::refresh_if_due() {
@@ -697,6 +790,15 @@ auto AsyncStatusRenderer::render_snapshot_for_test() const -> std::string {
 
 auto AsyncStatusRenderer::completed_lines_for_test() const -> const std::vector<std::string> & { return completed_lines_; }
 
+auto AsyncStatusRenderer::find_row(std::size_t id) -> AsyncLiveRowSnapshot * {
+    const auto it = row_index_.find(id);
+    return it == row_index_.end() ? nullptr : &rows_[it->second];
+}
+
+void AsyncStatusRenderer::mark_dirty(const AsyncLiveRowSnapshot &row) {
+    row_blocks_[static_cast<std::size_t>(&row - rows_.data())].dirty = true;
+}
+
 auto AsyncStatusRenderer::output_width() const -> std::size_t {
     if (width_override_ != 0) {
         return width_override_;
@@ -736,83 +838,48 @@ auto AsyncStatusRenderer::location_parts(std::string_view file, unsigned line) -
 }
 
 auto AsyncStatusRenderer::active_lines_for_render(bool hyperlink_locations) const -> std::vector<std::string> {
-    const auto ordered = ordered_rows_unlocked();
-    if (ordered.empty()) {
-        return {};
-    }
-
+    const std::size_t        width      = output_width();
+    const std::size_t        line_width = mode_ == Mode::Terminal && width > 1 ? width - 1 : width;
+    const std::size_t        max_rows   = mode_ == Mode::Terminal ? std::max<std::size_t>(terminal_rows(), 2) - 1 : 0;
+    std::vector<std::string> scratch;
+    return stack_row_blocks(rows_, max_rows, [&](std::size_t index) -> const std::vector<std::string> & {
+        scratch = format_row_block(rows_[index], color_output_, hyperlink_locations, line_width, log_tail_limit_);
+        return scratch;
+    });
+}
+
+// Like active_lines_for_render(true), but re-formats only rows that changed
+// since they were last drawn at this width.
+auto AsyncStatusRenderer::cached_active_lines() -> std::vector<std::string> {
     const std::size_t width      = output_width();
-    const std::size_t line_width = mode_ == Mode::Terminal && width > 1 ? width - 1 : width;
-    const std::size_t max_rows   = mode_ == Mode::Terminal ? std::max<std::size_t>(terminal_rows(), 2) - 1 : 0;
-
-    std::vector<std::vector<std::string>> blocks;
-    blocks.reserve(ordered.size());
-    for (const auto &row : ordered) {
-        std::vector<std::string> block;
-        const auto               tail_capacity = log_tail_limit_ == 0 ? 0 : std::min(row.recent_logs.size(), log_tail_limit_);
-        block.reserve(tail_capacity + 1);
-        auto line = format_row(row, color_output_, hyperlink_locations, line_width);
-        trim_trailing_padding(line);
-        block.push_back(std::move(line));
-        if (log_tail_limit_ != 0 && !row.recent_logs.empty()) {
-            const auto first_log = row.recent_logs.size() > log_tail_limit_ ? row.recent_logs.size() - log_tail_limit_ : 0;
-            for (std::size_t i = first_log; i < row.recent_logs.size(); ++i) {
-                auto log_line = format_log_tail_line(row.recent_logs[i], line_width);
-                trim_trailing_padding(log_line);
-                block.push_back(std::move(log_line));
-            }
-        }
-        if (mode_ == Mode::Terminal && block.size() > max_rows) {
-            std::vector<std::string> clipped;
-            clipped.reserve(max_rows);
-            clipped.push_back(std::move(block.front()));
-            const auto keep_tail = max_rows - 1;
-            if (keep_tail != 0) {
-                clipped.insert(clipped.end(), std::make_move_iterator(block.end() - static_cast<std::ptrdiff_t>(keep_tail)),
-                               std::make_move_iterator(block.end()));
-            }
-            block = std::move(clipped);
+    const std::size_t line_width = width > 1 ? width - 1 : width;
+    const std::size_t max_rows   = std::max<std::size_t>(terminal_rows(), 2) - 1;
+    return stack_row_blocks(rows_, max_rows, [&](std::size_t index) -> const std::vector<std::string> & {
+        auto &block = row_blocks_[index];
+        if (block.dirty || block.width != line_width) {
+            block.lines = format_row_block(rows_[index], color_output_, true, line_width, log_tail_limit_);
+            block.width = line_width;
+            block.dirty = false;
         }
-        blocks.push_back(std::move(block));
-    }
-
-    std::vector<std::string> lines;
-    if (mode_ != Mode::Terminal) {
-        for (auto &block : blocks) {
-            lines.insert(lines.end(), std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
-        }
-        return lines;
-    }
-
-    std::size_t remaining = max_rows;
-    for (auto block = blocks.rbegin(); block != blocks.rend() && remaining != 0; ++block) {
-        std::vector<std::string> visible_block;
-        if (block->size() <= remaining) {
-            visible_block = std::move(*block);
-        } else {
-            visible_block.reserve(remaining);
-            visible_block.push_back(std::move(block->front()));
-            const auto keep_tail = std::min(remaining - 1, block->size() - 1);
-            if (keep_tail != 0) {
-                visible_block.insert(visible_block.end(), std::make_move_iterator(block->end() - static_cast<std::ptrdiff_t>(keep_tail)),
-                                     std::make_move_iterator(block->end()));
-            }
-        }
-        remaining -= visible_block.size();
-        lines.insert(lines.begin(), std::make_move_iterator(visible_block.begin()), std::make_move_iterator(visible_block.end()));
-    }
-
-    return lines;
+        return block.lines;
+    });
 }
 
 void AsyncStatusRenderer::render(bool force_refresh) {
     if (!enabled() || mode_ != Mode::Terminal) {
         return;
     }
-    if (!force_refresh && has_terminal_refresh_ && monotonic_now_() - last_terminal_refresh_ < kTerminalRefreshInterval) {
+    if (!force_refresh && has_terminal_refresh_ && monotonic_now_() - last_terminal_refresh_ < refresh_interval_) {
         terminal_refresh_pending_ = true;
         return;
     }
+    if (refresh_ == Refresh::Diff) {
+        const auto started = monotonic_now_();
+        patch_terminal_block(cached_active_lines());
+        out_->flush();
+        finish_terminal_refresh(started);
+        return;
+    }
     redraw_terminal({}, false, true);
     terminal_refresh_pending_ = false;
 }
@@ -834,6 +901,7 @@ void AsyncStatusRenderer::erase_terminal_block() {
         *out_ << "\033[" << (visible_lines_ - 1) << "A";
     }
     visible_lines_ = 0;
+    drawn_lines_.clear();
 }
 
 void AsyncStatusRenderer::draw_terminal_block(const std::vector<std::string> &lines) {
@@ -845,6 +913,53 @@ void AsyncStatusRenderer::draw_terminal_block(const std::vector<std::string> &li
         *out_ << "\r\033[2K" << line << '\n';
     }
     visible_lines_ = lines.size();
+    if (refresh_ == Refresh::Diff) {
+        drawn_lines_ = lines;
+    }
+}
+
+// Rewrites only the lines of the live block that differ from the last drawn
+// block, moving the cursor relative to the line just below the block. A
+// shrinking block blanks its old tail; a growing one appends below.
+void AsyncStatusRenderer::patch_terminal_block(const std::vector<std::string> &lines) {
+    if (mode_ != Mode::Terminal || !out_) {
+        return;
+    }
+
+    if (lines == drawn_lines_) {
+        return;
+    }
+
+    std::size_t cursor  = drawn_lines_.size();
+    const auto  move_to = [&](std::size_t line) {
+        if (line < cursor) {
+            *out_ << "\033[" << (cursor - line) << "A";
+        } else if (line > cursor) {
+            *out_ << "\033[" << (line - cursor) << "B";
+        }
+        cursor = line;
+    };
+
+    const std::size_t kept = std::min(lines.size(), drawn_lines_.size());
+    for (std::size_t i = 0; i < kept; ++i) {
+        if (lines[i] != drawn_lines_[i]) {
+            move_to(i);
+            *out_ << "\r\033[2K" << lines[i];
+            drawn_lines_[i] = lines[i];
+        }
+    }
+    for (std::size_t i = kept; i < drawn_lines_.size(); ++i) {
+        move_to(i);
+        *out_ << "\r\033[2K";
+    }
+    move_to(kept);
+    *out_ << '\r';
+    drawn_lines_.resize(kept);
+    for (std::size_t i = kept; i < lines.size(); ++i) {
+        *out_ << "\033[2K" << lines[i] << '\n';
+        drawn_lines_.push_back(lines[i]);
+    }
+    visible_lines_ = drawn_lines_.size();
 }
 
 void AsyncStatusRenderer::redraw_terminal(std::string_view message, bool has_message, bool sanitize_message) {
@@ -852,7 +967,8 @@ void AsyncStatusRenderer::redraw_terminal(std::string_view message, bool has_mes
         return;
     }
 
-    const auto lines = active_lines_for_render(true);
+    const auto started = monotonic_now_();
+    const auto lines   = refresh_ == Refresh::Diff ? cached_active_lines() : active_lines_for_render(true);
     erase_terminal_block();
     if (has_message) {
         if (color_output_) {
@@ -866,9 +982,21 @@ void AsyncStatusRenderer::redraw_terminal(std::string_view message, bool has_mes
     }
     draw_terminal_block(lines);
     out_->flush();
+    finish_terminal_refresh(started);
+}
+
+// Diff refreshes also time themselves: the interval grows with the average
+// drawing cost so a huge live panel cannot starve the scheduler.
+void AsyncStatusRenderer::finish_terminal_refresh(MonotonicClock::time_point started) {
     last_terminal_refresh_    = monotonic_now_();
     has_terminal_refresh_     = true;
     terminal_refresh_pending_ = false;
+    if (refresh_ != Refresh::Diff) {
+        return;
+    }
+    render_cost_      = (render_cost_ * 3 + (last_terminal_refresh_ - started)) / 4;
+    refresh_interval_ = std::clamp<MonotonicClock::duration>(render_cost_ * kRenderCostBudget, kTerminalRefreshInterval,
+                                                             kMaxTerminalRefreshInterval);
 }
 
 void AsyncStatusRenderer::restore_terminal() {
@@ -26,19 +26,40 @@ enum class AsyncLiveStatus {
     XPass,
 };
 
+// The newest `capacity` log lines of a live row, oldest first. Slots are
+// reused as the ring wraps, so a chatty case stops allocating once its tail
+// buffers have grown to fit.
+class AsyncLogRing {
+  public:
+    AsyncLogRing() = default;
+    explicit AsyncLogRing(std::size_t capacity) : slots_(capacity) {}
+
+    void push(std::string_view line);
+    void assign(std::span<const std::string> lines);
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+    [[nodiscard]] auto operator[](std::size_t index) const -> const std::string & { return slots_[(head_ + index) % slots_.size()]; }
+
+  private:
+    std::vector<std::string> slots_;
+    std::size_t              head_ = 0;
+    std::size_t              size_ = 0;
+};
+
 struct AsyncLiveRowSnapshot {
-    std::size_t              id = 0;
-    std::string              name;
-    AsyncLiveStatus          status = AsyncLiveStatus::Suspended;
-    std::string              detail;
-    std::string              suspend_file;
-    std::string              suspend_label;
-    std::string              suspend_uri;
-    std::vector<std::string> recent_logs;
-    std::size_t              log_count    = 0;
-    unsigned                 suspend_line = 0;
-    long long                duration_ms  = 0;
-    bool                     final        = false;
+    std::size_t     id = 0;
+    std::string     name;
+    AsyncLiveStatus status = AsyncLiveStatus::Suspended;
+    std::string     detail;
+    std::string     suspend_file;
+    std::string     suspend_label;
+    std::string     suspend_uri;
+    AsyncLogRing    recent_logs;
+    std::size_t     log_count    = 0;
+    unsigned        suspend_line = 0;
+    long long       duration_ms  = 0;
+    bool            final        = false;
 };
 
 struct AsyncTerminalSizeOverride {
@@ -51,7 +72,11 @@ class AsyncStatusRenderer {
     using MonotonicClock = std::chrono::steady_clock;
     using MonotonicNow   = std::function<MonotonicClock::time_point()>;
 
-    inline static constexpr auto kTerminalRefreshInterval = std::chrono::milliseconds{40};
+    inline static constexpr auto kTerminalRefreshInterval    = std::chrono::milliseconds{40};
+    inline static constexpr auto kMaxTerminalRefreshInterval = std::chrono::milliseconds{500};
+    // Diff refreshes stretch their interval to keep drawing under 1/N of the
+    // wall clock.
+    inline static constexpr long long kRenderCostBudget = 20;
 
     enum class Mode {
         Disabled,
@@ -59,8 +84,16 @@ class AsyncStatusRenderer {
         Terminal,
     };
 
+    // Redraw erases and repaints the whole live block on every refresh. Diff
+    // keeps the last drawn block, rewrites only the lines that changed in place
+    // and re-formats only rows that changed since the previous refresh.
+    enum class Refresh {
+        Redraw,
+        Diff,
+    };
+
     AsyncStatusRenderer(std::ostream &out, Mode mode, bool color_output, AsyncTerminalSizeOverride size_override = {},
-                        std::size_t log_tail_limit = 5, MonotonicNow monotonic_now = {});
+                        std::size_t log_tail_limit = 5, MonotonicNow monotonic_now = {}, Refresh refresh = Refresh::Redraw);
     AsyncStatusRenderer(const AsyncStatusRenderer &)            = delete;
     AsyncStatusRenderer &operator=(const AsyncStatusRenderer &) = delete;
     ~AsyncStatusRenderer();
@@ -76,6 +109,7 @@ class AsyncStatusRenderer {
                                       unsigned line = 0); // NOLINT(bugprone-easily-swappable-parameters)
     auto               mark_final(std::size_t id, AsyncLiveStatus status, std::string_view detail, long long duration_ms) -> std::string;
     void               update_logs(std::size_t id, std::span<const std::string> recent_logs, std::size_t log_count);
+    void               append_log(std::size_t id, std::string_view message, std::size_t log_count);
     void               log(std::string_view message);
     void               result_line(std::string_view message);
     [[nodiscard]] auto next_refresh_deadline() const -> std::optional<MonotonicClock::time_point>;
@@ -87,8 +121,16 @@ class AsyncStatusRenderer {
     [[nodiscard]] auto completed_lines_for_test() const -> const std::vector<std::string> &;
 
   private:
+    // Formatted terminal lines of one row, kept between Diff refreshes.
+    struct RowBlock {
+        std::vector<std::string> lines;
+        std::size_t              width = 0;
+        bool                     dirty = true;
+    };
+
     std::ostream                     *out_             = nullptr;
     Mode                              mode_            = Mode::Disabled;
+    Refresh                           refresh_         = Refresh::Redraw;
     bool                              color_output_    = false;
     bool                              finished_        = false;
     std::size_t                       visible_lines_   = 0;
@@ -97,26 +139,36 @@ class AsyncStatusRenderer {
     std::size_t                       log_tail_limit_  = 5;
     MonotonicNow                      monotonic_now_;
     MonotonicClock::time_point        last_terminal_refresh_{};
+    MonotonicClock::duration          refresh_interval_         = kTerminalRefreshInterval;
+    MonotonicClock::duration          render_cost_{};
     bool                              has_terminal_refresh_     = false;
     bool                              terminal_refresh_pending_ = false;
     mutable std::mutex                mtx_;
     std::vector<AsyncLiveRowSnapshot> rows_;
+    std::vector<RowBlock>             row_blocks_;
+    std::vector<std::string>          drawn_lines_;
     std::vector<std::string>          completed_lines_;
     struct LocationParts {
         std::string label;
         std::string uri;
     };
     std::unordered_map<std::string, LocationParts> location_cache_;
+    std::unordered_map<std::size_t, std::size_t>   row_index_;
 
+    [[nodiscard]] auto find_row(std::size_t id) -> AsyncLiveRowSnapshot *;
+    void               mark_dirty(const AsyncLiveRowSnapshot &row);
     [[nodiscard]] auto output_width() const -> std::size_t;
     [[nodiscard]] auto terminal_rows() const -> std::size_t;
     [[nodiscard]] auto location_parts(std::string_view file, unsigned line) -> LocationParts;
     [[nodiscard]] auto ordered_rows_unlocked() const -> std::vector<AsyncLiveRowSnapshot>;
     [[nodiscard]] auto active_lines_for_render(bool hyperlink_locations) const -> std::vector<std::string>;
+    [[nodiscard]] auto cached_active_lines() -> std::vector<std::string>;
     void               render(bool force_refresh = false);
     void               erase_terminal_block();
     void               draw_terminal_block(const std::vector<std::string> &lines);
+    void               patch_terminal_block(const std::vector<std::string> &lines);
     void               redraw_terminal(std::string_view message, bool has_message, bool sanitize_message);
+    void               finish_terminal_refresh(MonotonicClock::time_point started);
     void               restore_terminal();
 };
 
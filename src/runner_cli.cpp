@@ -1,13 +1,16 @@
 #include "runner_cli.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <fmt/format.h>
+#include <fstream>
 #include <limits>
 #include <random>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #if defined(_WIN32)
 #include <io.h>
@@ -18,6 +21,31 @@
 namespace gentest::runner {
 namespace {
 
+// Upper bound for --async-workers; far above any useful pool size and small
+// enough that a typo cannot spawn thousands of threads.
+constexpr std::uint64_t kMaxAsyncWorkers = 256;
+
+// One exact case name per line; blank lines are ignored and CRLF is accepted.
+bool read_run_list(const char *path, std::vector<std::string> &out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        fmt::print(stderr, "error: cannot open --run-list file '{}'\n", path);
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            out.push_back(line);
+    }
+    if (out.empty()) {
+        fmt::print(stderr, "error: --run-list file '{}' lists no cases\n", path);
+        return false;
+    }
+    return true;
+}
+
 auto env_value(const char *name) -> std::string {
 #if defined(_WIN32) && defined(_MSC_VER)
     char  *value  = nullptr;
@@ -111,17 +139,26 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
     bool wants_list_json         = false;
     bool wants_list_death        = false;
     bool wants_list_benches      = false;
+    bool wants_death_fork_server = false;
     bool no_color_flag           = false;
     bool github_annotations_flag = false;
 
     bool seen_repeat               = false;
     bool seen_async_log_tail       = false;
+    bool seen_async_workers        = false;
+    bool seen_async_timer_queue    = false;
+    bool seen_async_live_render    = false;
     bool seen_bench_min_epoch_time = false;
     bool seen_bench_min_total_time = false;
     bool seen_bench_max_total_time = false;
     bool seen_bench_warmup         = false;
     bool seen_bench_epochs         = false;
+    bool seen_bench_cache_mode     = false;
+    bool seen_bench_pin_cpu        = false;
     bool seen_jitter_bins          = false;
+    bool seen_jitter_clock         = false;
+    bool seen_jitter_hdr_digits    = false;
+    bool seen_death_timeout        = false;
     bool seen_time_unit            = false;
     bool seen_report_format        = false;
 
@@ -254,6 +291,40 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
         return false;
     };
 
+    auto parse_jitter_clock_option = [&](std::string_view value, JitterClockMode &out_clock) -> bool {
+        if (value == "steady") {
+            out_clock = JitterClockMode::Steady;
+            return true;
+        }
+        if (value == "tsc") {
+            out_clock = JitterClockMode::Tsc;
+            return true;
+        }
+        fmt::print(stderr, "error: --jitter-clock must be one of steady,tsc; got: '{}'\n", value);
+        return false;
+    };
+
+    auto parse_bench_cache_mode_option = [&](std::string_view value, BenchCacheMode &out_mode) -> bool {
+        if (value == "auto") {
+            out_mode = BenchCacheMode::Auto;
+            return true;
+        }
+        if (value == "warm") {
+            out_mode = BenchCacheMode::Warm;
+            return true;
+        }
+        if (value == "cold") {
+            out_mode = BenchCacheMode::Cold;
+            return true;
+        }
+        if (value == "both") {
+            out_mode = BenchCacheMode::Both;
+            return true;
+        }
+        fmt::print(stderr, "error: --bench-cache-mode must be one of auto,warm,cold,both; got: '{}'\n", value);
+        return false;
+    };
+
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
     auto set_unique_string_option = [&](const char *&out_value, std::string_view opt_name, std::string_view value) -> bool {
         if (out_value) {
@@ -324,6 +395,14 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
             opt.shuffle = true;
             continue;
         }
+        if (s == "--async-virtual-time") {
+            opt.async_virtual_time = true;
+            continue;
+        }
+        if (s == "--async-alloc-stats") {
+            opt.async_alloc_stats = true;
+            continue;
+        }
         if (s == "--include-death") {
             opt.include_death = true;
             continue;
@@ -332,6 +411,14 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
             opt.bench_table = true;
             continue;
         }
+        if (s == "--shutdown") {
+            opt.shutdown_server = true;
+            continue;
+        }
+        if (s == "--death-fork-server") {
+            wants_death_fork_server = true;
+            continue;
+        }
 
         if (const OptionParseResult seed_result = parse_value_option(i, s, "--seed",
                                                                      [&](std::string_view value) {
@@ -393,6 +480,77 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
                 return false;
             continue;
         }
+        if (const OptionParseResult async_workers_result =
+                parse_value_option(i, s, "--async-workers",
+                                   [&](std::string_view value) {
+                                       if (seen_async_workers) {
+                                           fmt::print(stderr, "error: duplicate --async-workers\n");
+                                           return false;
+                                       }
+                                       std::uint64_t workers = 0;
+                                       if (!parse_u64_option("--async-workers", value, workers))
+                                           return false;
+                                       if (workers > kMaxAsyncWorkers) {
+                                           fmt::print(stderr, "error: --async-workers is out of range (max {})\n", kMaxAsyncWorkers);
+                                           return false;
+                                       }
+                                       if (workers == 0)
+                                           workers = std::max(1U, std::thread::hardware_concurrency());
+                                       opt.async_workers  = static_cast<std::size_t>(workers);
+                                       seen_async_workers = true;
+                                       return true;
+                                   });
+            async_workers_result != OptionParseResult::NoMatch) {
+            if (async_workers_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (const OptionParseResult async_timer_queue_result =
+                parse_value_option(i, s, "--async-timer-queue",
+                                   [&](std::string_view value) {
+                                       if (seen_async_timer_queue) {
+                                           fmt::print(stderr, "error: duplicate --async-timer-queue\n");
+                                           return false;
+                                       }
+                                       if (value == "heap") {
+                                           opt.async_timer_wheel = false;
+                                       } else if (value == "wheel") {
+                                           opt.async_timer_wheel = true;
+                                       } else {
+                                           fmt::print(stderr, "error: --async-timer-queue must be one of heap,wheel; got: '{}'\n", value);
+                                           return false;
+                                       }
+                                       seen_async_timer_queue = true;
+                                       return true;
+                                   });
+            async_timer_queue_result != OptionParseResult::NoMatch) {
+            if (async_timer_queue_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (const OptionParseResult async_live_render_result =
+                parse_value_option(i, s, "--async-live-render",
+                                   [&](std::string_view value) {
+                                       if (seen_async_live_render) {
+                                           fmt::print(stderr, "error: duplicate --async-live-render\n");
+                                           return false;
+                                       }
+                                       if (value == "redraw") {
+                                           opt.async_live_diff = false;
+                                       } else if (value == "diff") {
+                                           opt.async_live_diff = true;
+                                       } else {
+                                           fmt::print(stderr, "error: --async-live-render must be one of redraw,diff; got: '{}'\n", value);
+                                           return false;
+                                       }
+                                       seen_async_live_render = true;
+                                       return true;
+                                   });
+            async_live_render_result != OptionParseResult::NoMatch) {
+            if (async_live_render_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
 
         if (const OptionParseResult run_result = parse_value_option(
                 i, s, "--run", [&](std::string_view value) { return set_unique_string_option(opt.run_exact, "--run", value); });
@@ -401,6 +559,45 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
                 return false;
             continue;
         }
+        if (const OptionParseResult run_list_result =
+                parse_value_option(i, s, "--run-list",
+                                   [&](std::string_view value) {
+                                       return set_unique_string_option(opt.run_list_path, "--run-list", value);
+                                   });
+            run_list_result != OptionParseResult::NoMatch) {
+            if (run_list_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (const OptionParseResult death_expect_result =
+                parse_value_option(i, s, "--death-expect-substring",
+                                   [&](std::string_view value) {
+                                       return set_unique_string_option(opt.death_expect_substring, "--death-expect-substring", value);
+                                   });
+            death_expect_result != OptionParseResult::NoMatch) {
+            if (death_expect_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (!seen_death_timeout) {
+            if (const OptionParseResult death_timeout_result =
+                    parse_value_option(i, s, "--death-timeout",
+                                       [&](std::string_view value) {
+                                           if (!parse_u64_option("--death-timeout", value, opt.death_timeout_sec))
+                                               return false;
+                                           if (opt.death_timeout_sec == 0) {
+                                               fmt::print(stderr, "error: --death-timeout must be a positive number of seconds\n");
+                                               return false;
+                                           }
+                                           seen_death_timeout = true;
+                                           return true;
+                                       });
+                death_timeout_result != OptionParseResult::NoMatch) {
+                if (death_timeout_result == OptionParseResult::Error)
+                    return false;
+                continue;
+            }
+        }
         if (const OptionParseResult filter_result = parse_value_option(
                 i, s, "--filter", [&](std::string_view value) { return set_unique_string_option(opt.filter_pat, "--filter", value); });
             filter_result != OptionParseResult::NoMatch) {
@@ -463,6 +660,23 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
                 return false;
             continue;
         }
+        if (const OptionParseResult serve_result = parse_value_option(
+                i, s, "--serve", [&](std::string_view value) { return set_unique_string_option(opt.serve_socket, "--serve", value); });
+            serve_result != OptionParseResult::NoMatch) {
+            if (serve_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (const OptionParseResult connect_result =
+                parse_value_option(i, s, "--connect",
+                                   [&](std::string_view value) {
+                                       return set_unique_string_option(opt.connect_socket, "--connect", value);
+                                   });
+            connect_result != OptionParseResult::NoMatch) {
+            if (connect_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
 
         if (const OptionParseResult removed_run_test = parse_value_option(i, s, "--run-test",
                                                                           [&](std::string_view) {
@@ -579,6 +793,46 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
                 continue;
             }
         }
+        if (const OptionParseResult cache_mode_result =
+                parse_value_option(i, s, "--bench-cache-mode",
+                                   [&](std::string_view value) {
+                                       if (seen_bench_cache_mode) {
+                                           fmt::print(stderr, "error: duplicate --bench-cache-mode\n");
+                                           return false;
+                                       }
+                                       if (!parse_bench_cache_mode_option(value, opt.bench_cache_mode))
+                                           return false;
+                                       seen_bench_cache_mode = true;
+                                       return true;
+                                   });
+            cache_mode_result != OptionParseResult::NoMatch) {
+            if (cache_mode_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
+        if (const OptionParseResult pin_cpu_result =
+                parse_value_option(i, s, "--bench-pin-cpu",
+                                   [&](std::string_view value) {
+                                       if (seen_bench_pin_cpu) {
+                                           fmt::print(stderr, "error: duplicate --bench-pin-cpu\n");
+                                           return false;
+                                       }
+                                       std::uint64_t cpu = 0;
+                                       if (!parse_u64_option("--bench-pin-cpu", value, cpu))
+                                           return false;
+                                       if (cpu > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+                                           fmt::print(stderr, "error: --bench-pin-cpu is out of range\n");
+                                           return false;
+                                       }
+                                       opt.bench_pin_cpu  = static_cast<int>(cpu);
+                                       seen_bench_pin_cpu = true;
+                                       return true;
+                                   });
+            pin_cpu_result != OptionParseResult::NoMatch) {
+            if (pin_cpu_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
 
         if (const OptionParseResult removed_run_jitter =
                 parse_value_option(i, s, "--run-jitter",
@@ -620,6 +874,44 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
                 continue;
             }
         }
+        if (!seen_jitter_hdr_digits) {
+            if (const OptionParseResult jitter_hdr_digits_result =
+                    parse_value_option(i, s, "--jitter-hdr-digits",
+                                       [&](std::string_view value) {
+                                           std::uint64_t digits = 0;
+                                           if (!parse_u64_option("--jitter-hdr-digits", value, digits))
+                                               return false;
+                                           if (digits < 1 || digits > 5) {
+                                               fmt::print(stderr, "error: --jitter-hdr-digits must be between 1 and 5\n");
+                                               return false;
+                                           }
+                                           opt.jitter_hdr_digits  = static_cast<int>(digits);
+                                           seen_jitter_hdr_digits = true;
+                                           return true;
+                                       });
+                jitter_hdr_digits_result != OptionParseResult::NoMatch) {
+                if (jitter_hdr_digits_result == OptionParseResult::Error)
+                    return false;
+                continue;
+            }
+        }
+        if (const OptionParseResult jitter_clock_result =
+                parse_value_option(i, s, "--jitter-clock",
+                                   [&](std::string_view value) {
+                                       if (seen_jitter_clock) {
+                                           fmt::print(stderr, "error: duplicate --jitter-clock\n");
+                                           return false;
+                                       }
+                                       if (!parse_jitter_clock_option(value, opt.jitter_clock))
+                                           return false;
+                                       seen_jitter_clock = true;
+                                       return true;
+                                   });
+            jitter_clock_result != OptionParseResult::NoMatch) {
+            if (jitter_clock_result == OptionParseResult::Error)
+                return false;
+            continue;
+        }
 
         if (s.starts_with("-")) {
             fmt::print(stderr, "error: unknown option '{}'\n", s);
@@ -645,7 +937,40 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
         return false;
     }
 
-    if (wants_help)
+    if (opt.serve_socket != nullptr && opt.connect_socket != nullptr) {
+        fmt::print(stderr, "error: --serve and --connect cannot be combined\n");
+        return false;
+    }
+    if (opt.shutdown_server && opt.connect_socket == nullptr) {
+        fmt::print(stderr, "error: --shutdown requires --connect\n");
+        return false;
+    }
+    if (wants_death_fork_server && (opt.serve_socket != nullptr || opt.connect_socket != nullptr)) {
+        fmt::print(stderr, "error: --death-fork-server cannot be combined with --serve or --connect\n");
+        return false;
+    }
+    if (opt.death_expect_substring != nullptr && !wants_death_fork_server) {
+        fmt::print(stderr, "error: --death-expect-substring requires --death-fork-server\n");
+        return false;
+    }
+    if (seen_death_timeout && !wants_death_fork_server) {
+        fmt::print(stderr, "error: --death-timeout requires --death-fork-server\n");
+        return false;
+    }
+    if (opt.run_list_path != nullptr && (opt.run_exact != nullptr || opt.filter_pat != nullptr)) {
+        fmt::print(stderr, "error: --run-list cannot be combined with --run or --filter\n");
+        return false;
+    }
+    // A client forwards the path; the server reads the list itself.
+    if (opt.run_list_path != nullptr && opt.connect_socket == nullptr && !read_run_list(opt.run_list_path, opt.run_list))
+        return false;
+
+    // The client forwards help/list/run options to the server, so --connect wins.
+    if (opt.connect_socket != nullptr)
+        opt.mode = Mode::Connect;
+    else if (opt.serve_socket != nullptr)
+        opt.mode = Mode::Serve;
+    else if (wants_help)
         opt.mode = Mode::Help;
     else if (wants_list_tests)
         opt.mode = Mode::ListTests;
@@ -657,6 +982,8 @@ bool parse_cli(std::span<const char *> args, CliOptions &out_opt) {
         opt.mode = Mode::ListDeath;
     else if (wants_list_benches)
         opt.mode = Mode::ListBenches;
+    else if (wants_death_fork_server)
+        opt.mode = Mode::DeathForkServer;
     else
         opt.mode = Mode::Execute;
 
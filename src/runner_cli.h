@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <string>
+#include <vector>
 
 namespace gentest::runner {
 
@@ -14,6 +16,9 @@ enum class Mode {
     ListJson,
     ListDeath,
     ListBenches,
+    Serve,           // --serve=<socket>
+    Connect,         // --connect=<socket>
+    DeathForkServer, // --death-fork-server
 };
 
 enum class KindFilter {
@@ -35,6 +40,19 @@ enum class MeasuredReportFormat {
     Json,
 };
 
+enum class JitterClockMode {
+    Steady,
+    Tsc,
+};
+
+// `Auto` follows each bench's cache(...) attribute and defaults to warm.
+enum class BenchCacheMode {
+    Auto,
+    Warm,
+    Cold,
+    Both,
+};
+
 struct BenchConfig {
     double      min_epoch_time_s = 0.01; // 10 ms
     double      min_total_time_s = 0.0;  // per benchmark
@@ -52,11 +70,16 @@ struct CliOptions {
     bool color_output       = true;
     bool github_annotations = false;
 
-    bool        fail_fast      = false;
-    bool        shuffle        = false;
-    std::size_t repeat_n       = 1;
-    std::size_t async_log_tail = 5;
-    bool        include_death  = false;
+    bool        fail_fast          = false;
+    bool        shuffle            = false;
+    std::size_t repeat_n           = 1;
+    std::size_t async_log_tail     = 5;
+    std::size_t async_workers      = 1; // threads resuming async cases, including the runner thread
+    bool        async_virtual_time = false;
+    bool        async_alloc_stats  = false; // debug: per-case async frame pool counts
+    bool        async_timer_wheel  = false; // --async-timer-queue=wheel
+    bool        async_live_diff    = false; // --async-live-render=diff
+    bool        include_death      = false;
 
     bool          seed_provided = false;
     std::uint64_t seed_value    = 0; // exact value from --seed
@@ -67,9 +90,23 @@ struct CliOptions {
     const char *junit_path = nullptr;
     const char *allure_dir = nullptr;
 
-    bool        bench_table = false;
-    BenchConfig bench_cfg{};
-    int         jitter_bins = 10;
+    const char              *run_list_path = nullptr; // --run-list: file with one exact case name per line
+    std::vector<std::string> run_list;                // names read from run_list_path
+
+    const char *serve_socket    = nullptr; // --serve: keep shared fixtures warm and run requests from clients
+    const char *connect_socket  = nullptr; // --connect: forward the remaining options to a --serve process
+    bool        shutdown_server = false;   // --shutdown (with --connect)
+
+    const char   *death_expect_substring = nullptr; // --death-expect-substring: required in each death case's output
+    std::uint64_t death_timeout_sec      = 60;      // --death-timeout: per-child deadline under --death-fork-server
+
+    bool            bench_table       = false;
+    BenchConfig     bench_cfg{};
+    BenchCacheMode  bench_cache_mode  = BenchCacheMode::Auto;
+    int             bench_pin_cpu     = -1; // -1 leaves thread affinity unchanged
+    int             jitter_bins       = 10;
+    int             jitter_hdr_digits = 3;
+    JitterClockMode jitter_clock      = JitterClockMode::Steady;
 };
 
 bool parse_cli(std::span<const char *> args, CliOptions &out_opt);
@@ -0,0 +1,358 @@
+#include "runner_death_fork.h"
+
+#include "runner_fixture_runtime.h"
+#include "runner_orchestrator.h"
+#include "runner_selector.h"
+#include "runner_tag_utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GENTEST_RUNNER_DEATH_FORK 1
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace gentest::runner {
+
+#if defined(GENTEST_RUNNER_DEATH_FORK)
+namespace {
+
+enum class DeathOutcome {
+    Pass,
+    Fail,
+    Skip,
+};
+
+struct DeathCounters {
+    std::size_t total   = 0;
+    std::size_t passed  = 0;
+    std::size_t failed  = 0;
+    std::size_t skipped = 0;
+};
+
+bool has_line_prefix(std::string_view output, std::string_view prefix) {
+    std::size_t pos = 0;
+    while (pos <= output.size()) {
+        if (output.substr(pos).starts_with(prefix)) {
+            return true;
+        }
+        const auto next = output.find('\n', pos);
+        if (next == std::string_view::npos) {
+            break;
+        }
+        pos = next + 1;
+    }
+    return false;
+}
+
+auto describe_status(int status) -> std::string {
+    if (WIFSIGNALED(status)) {
+        return fmt::format("killed by signal {}", WTERMSIG(status));
+    }
+    return fmt::format("exited with code {}", WEXITSTATUS(status));
+}
+
+void print_death_line(const CliOptions &opt, DeathOutcome outcome, std::string_view name, std::string_view detail, long long dur_ms) {
+    std::FILE       *stream = outcome == DeathOutcome::Fail ? stderr : stdout;
+    std::string_view label  = "[ PASS ]";
+    auto             color  = fmt::color::green;
+    if (outcome == DeathOutcome::Fail) {
+        label = "[ FAIL ]";
+        color = fmt::color::red;
+    } else if (outcome == DeathOutcome::Skip) {
+        label = "[ SKIP ]";
+        color = fmt::color::yellow;
+    }
+    if (opt.color_output) {
+        fmt::print(stream, fmt::fg(color), "{}", label);
+    } else {
+        fmt::print(stream, "{}", label);
+    }
+    fmt::print(stream, " {} :: {} ({} ms)\n", name, detail, dur_ms);
+}
+
+// Reads the child's combined stdout/stderr until every writer has closed it.
+// Returns false when `deadline` passes first.
+bool drain_pipe(int fd, std::chrono::steady_clock::time_point deadline, std::string &output) {
+    std::array<char, 8192> buf{};
+    for (;;) {
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        pollfd     pfd{.fd = fd, .events = POLLIN, .revents = 0};
+        const auto wait_ms = static_cast<int>(std::min<long long>(remaining.count(), 1000));
+        const int  ready   = ::poll(&pfd, 1, wait_ms);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0) {
+            return true;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        const auto n = ::read(fd, buf.data(), buf.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return true;
+        }
+        output.append(buf.data(), static_cast<std::size_t>(n));
+    }
+}
+
+enum class ChildWait {
+    Exited,
+    TimedOut,
+    Error,
+};
+
+// Reaps `pid`, polling until `deadline`.
+auto wait_child(pid_t pid, std::chrono::steady_clock::time_point deadline, int &status) -> ChildWait {
+    for (;;) {
+        const pid_t done = ::waitpid(pid, &status, WNOHANG);
+        if (done == pid) {
+            return ChildWait::Exited;
+        }
+        if (done < 0 && errno != EINTR) {
+            return ChildWait::Error;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return ChildWait::TimedOut;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+// Same verdict as the per-case CTest harness (GentestCheckDeath.cmake).
+auto judge_death_case(int status, std::string_view output, const CliOptions &opt, std::string &detail) -> DeathOutcome {
+    if (has_line_prefix(output, "[ SKIP ]")) {
+        detail = "skipped by the case";
+        return DeathOutcome::Skip;
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        detail = "expected the process to abort or exit non-zero, but it exited with code 0";
+        return DeathOutcome::Fail;
+    }
+    if (has_line_prefix(output, "[ FAIL ]")) {
+        detail = fmt::format("{} after reporting a normal test failure", describe_status(status));
+        return DeathOutcome::Fail;
+    }
+    if (opt.death_expect_substring != nullptr && output.find(opt.death_expect_substring) == std::string_view::npos) {
+        detail = fmt::format("{} without the expected output '{}'", describe_status(status), opt.death_expect_substring);
+        return DeathOutcome::Fail;
+    }
+    detail = describe_status(status);
+    return DeathOutcome::Pass;
+}
+
+// Runs in the forked child: the case's output goes to `write_fd`, and the exit
+// skips static destructors and the parent's shared fixture teardown.
+[[noreturn]] void run_death_child(std::span<const gentest::Case> cases, const CliOptions &opt, const gentest::Case &test, int write_fd,
+                                  detail::WarmSharedFixtures &warm) {
+    (void)::dup2(write_fd, STDOUT_FILENO);
+    (void)::dup2(write_fd, STDERR_FILENO);
+    ::close(write_fd);
+
+    CliOptions child{};
+    child.mode          = Mode::Execute;
+    child.kind          = opt.kind;
+    child.include_death = true;
+    child.color_output  = false; // keep the `[ FAIL ]`/`[ SKIP ]` markers plain for the parent
+    child.run_list.emplace_back(test.name);
+    const int code = run_from_options(cases, child, &warm);
+    std::fflush(stdout);
+    std::fflush(stderr);
+    ::_exit(code);
+}
+
+auto run_one_death_case(std::span<const gentest::Case> cases, const CliOptions &opt, const gentest::Case &test,
+                        detail::WarmSharedFixtures &warm, std::string &output, std::string &detail) -> DeathOutcome {
+    std::array<int, 2> fds{-1, -1};
+    if (::pipe(fds.data()) != 0) {
+        detail = fmt::format("pipe failed: {}", std::strerror(errno));
+        return DeathOutcome::Fail;
+    }
+    std::fflush(stdout);
+    std::fflush(stderr);
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        detail = fmt::format("fork failed: {}", std::strerror(errno));
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return DeathOutcome::Fail;
+    }
+    if (pid == 0) {
+        ::close(fds[0]);
+        run_death_child(cases, opt, test, fds[1], warm);
+    }
+    ::close(fds[1]);
+    // A child that hangs instead of dying would otherwise stall every case after it.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(opt.death_timeout_sec);
+    const bool drained  = drain_pipe(fds[0], deadline, output);
+    ::close(fds[0]);
+
+    int        status = 0;
+    const auto waited = drained ? wait_child(pid, deadline, status) : ChildWait::TimedOut;
+    if (waited == ChildWait::Error) {
+        detail = fmt::format("waitpid failed: {}", std::strerror(errno));
+        return DeathOutcome::Fail;
+    }
+    if (waited == ChildWait::TimedOut) {
+        (void)::kill(pid, SIGKILL);
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        detail = fmt::format("timed out after {} s and was killed", opt.death_timeout_sec);
+        return DeathOutcome::Fail;
+    }
+    return judge_death_case(status, output, opt, detail);
+}
+
+void print_indented(std::string_view output) {
+    while (!output.empty()) {
+        const auto             end  = output.find('\n');
+        const std::string_view line = output.substr(0, end);
+        if (line.empty()) {
+            fmt::print(stderr, "\n");
+        } else {
+            fmt::print(stderr, "    {}\n", line);
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        output.remove_prefix(end + 1);
+    }
+}
+
+bool release_fixtures(detail::WarmSharedFixtures &warm) {
+    std::vector<std::string> errors;
+    if (warm.release(errors)) {
+        return true;
+    }
+    if (errors.empty()) {
+        errors.emplace_back("shared fixture teardown failed");
+    }
+    for (const auto &message : errors) {
+        fmt::print(stderr, "gentest: death-fork-server: {}\n", message);
+    }
+    return false;
+}
+
+} // namespace
+
+int run_death_fork_server(std::span<const gentest::Case> cases, const CliOptions &opt) {
+    CliOptions selection_opt    = opt;
+    selection_opt.mode          = Mode::Execute;
+    selection_opt.include_death = true;
+
+    DeathCounters counters;
+
+    // Listed names this build does not have are skipped, like the per-case
+    // harness does for death tests compiled out of a configuration.
+    std::vector<std::string> missing;
+    if (!opt.run_list.empty()) {
+        selection_opt.run_list.clear();
+        for (const auto &name : opt.run_list) {
+            const bool present = std::ranges::any_of(cases, [&](const gentest::Case &c) { return c.name == name; });
+            (present ? selection_opt.run_list : missing).push_back(name);
+        }
+    }
+    for (const auto &name : missing) {
+        ++counters.total;
+        ++counters.skipped;
+        print_death_line(opt, DeathOutcome::Skip, name, "not present in this build configuration", 0);
+    }
+
+    std::vector<std::size_t> death_idxs;
+    if (opt.run_list.empty() || !selection_opt.run_list.empty()) {
+        const auto selection = select_cases(cases, selection_opt);
+        if (selection.status != SelectionStatus::Ok) {
+            // Reports the selection error without running anything.
+            return run_from_options(cases, selection_opt);
+        }
+        for (auto idx : selection.idxs) {
+            if (has_tag_ci(cases[idx], "death")) {
+                death_idxs.push_back(idx);
+            }
+        }
+    }
+    if (death_idxs.empty() && counters.total == 0) {
+        fmt::print("Executed 0 death test(s).\n");
+        return 0;
+    }
+
+    detail::WarmSharedFixtures warm;
+    std::vector<std::string>   setup_errors;
+    if (!death_idxs.empty() && !warm.ensure_setup(setup_errors)) {
+        for (const auto &message : setup_errors) {
+            fmt::print(stderr, "gentest: death-fork-server: {}\n", message);
+        }
+        (void)release_fixtures(warm);
+        return 1;
+    }
+
+    std::vector<std::string_view> failed_names;
+    for (auto idx : death_idxs) {
+        const auto &test = cases[idx];
+        ++counters.total;
+        if (test.should_skip) {
+            ++counters.skipped;
+            print_death_line(opt, DeathOutcome::Skip, test.name, test.skip_reason.empty() ? "skipped" : test.skip_reason, 0);
+            continue;
+        }
+        std::string output;
+        std::string detail;
+        const auto  start   = std::chrono::steady_clock::now();
+        const auto  outcome = run_one_death_case(cases, opt, test, warm, output, detail);
+        const auto  dur_ms  = std::llround(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        print_death_line(opt, outcome, test.name, detail, dur_ms);
+        switch (outcome) {
+        case DeathOutcome::Pass: ++counters.passed; break;
+        case DeathOutcome::Skip: ++counters.skipped; break;
+        case DeathOutcome::Fail:
+            ++counters.failed;
+            failed_names.push_back(test.name);
+            print_indented(output);
+            break;
+        }
+    }
+
+    const bool teardown_ok = !warm.live || release_fixtures(warm);
+
+    fmt::print("Summary: passed {}/{}; failed {}; skipped {}.\n", counters.passed, counters.total, counters.failed, counters.skipped);
+    if (!failed_names.empty()) {
+        fmt::print("Failed death tests:\n");
+        for (auto name : failed_names) {
+            fmt::print("  {}\n", name);
+        }
+    }
+    return counters.failed == 0 && teardown_ok ? 0 : 1;
+}
+
+#else
+
+int run_death_fork_server(std::span<const gentest::Case>, const CliOptions &) {
+    fmt::print(stderr, "error: --death-fork-server requires fork(), which this platform build does not support\n");
+    return 1;
+}
+
+#endif
+
+} // namespace gentest::runner
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "gentest/runner.h"
+#include "runner_cli.h"
+
+#include <span>
+
+namespace gentest::runner {
+
+// `--death-fork-server`: sets shared fixtures up once, then forks one child per
+// selected death case. Each child runs its case against the warm fixtures with
+// stdout/stderr piped back; the parent applies the death-test checks (non-zero
+// exit or signal, no `[ FAIL ]`, `--death-expect-substring`) and reports every
+// case in a single run.
+int run_death_fork_server(std::span<const gentest::Case> cases, const CliOptions &opt);
+
+} // namespace gentest::runner
@@ -649,4 +649,18 @@ bool teardown_shared_fixture_runtime(std::vector<std::string> &errors, SharedFix
     return teardown_ok;
 }
 
+bool WarmSharedFixtures::ensure_setup(std::vector<std::string> &errors) {
+    if (live) {
+        errors.clear();
+        return true;
+    }
+    live = setup_shared_fixture_runtime(errors, session);
+    return live;
+}
+
+bool WarmSharedFixtures::release(std::vector<std::string> &errors) {
+    live = false;
+    return teardown_shared_fixture_runtime(errors, session);
+}
+
 } // namespace gentest::runner::detail
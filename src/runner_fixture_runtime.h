@@ -24,4 +24,15 @@ struct SharedFixtureRuntimeSession {
 bool setup_shared_fixture_runtime(std::vector<std::string> &errors, SharedFixtureRuntimeSession &session);
 bool teardown_shared_fixture_runtime(std::vector<std::string> &errors, SharedFixtureRuntimeSession &session);
 
+// Shared fixtures kept alive across runs by `--serve`. `ensure_setup()` only
+// sets fixtures up when none are live; `release()` tears them down and is used
+// on shutdown and after a run whose setup failed, so the next run retries.
+struct WarmSharedFixtures {
+    SharedFixtureRuntimeSession session{};
+    bool                        live = false;
+
+    bool ensure_setup(std::vector<std::string> &errors);
+    bool release(std::vector<std::string> &errors);
+};
+
 } // namespace gentest::runner::detail
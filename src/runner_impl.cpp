@@ -2,18 +2,31 @@
 #include "gentest/detail/registry_runtime.h"
 #include "gentest/runner.h"
 #include "runner_cli.h"
+#include "runner_death_fork.h"
 #include "runner_orchestrator.h"
+#include "runner_serve.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <span>
 #include <vector>
 
 namespace {
+// Immutable sorted view handed to a run. `cases` points into `storage` or, when
+// a single generated table is all there is, straight at that table.
+struct CaseSnapshot {
+    std::vector<gentest::Case>     storage;
+    std::span<const gentest::Case> cases;
+};
+
 struct CaseRegistry {
-    std::vector<gentest::Case> cases;
-    bool                       sorted = false;
-    std::mutex                 mtx;
+    std::vector<gentest::Case>          cases; // register_cases() additions
+    bool                                sorted = false;
+    std::shared_ptr<const CaseSnapshot> snapshot;
+    std::size_t                         snapshot_generation = 0;
+    std::mutex                          mtx;
 };
 
 auto case_registry() -> CaseRegistry & {
@@ -21,34 +34,121 @@ auto case_registry() -> CaseRegistry & {
     return reg;
 }
 
-void sort_cases(std::vector<gentest::Case> &cases) {
-    std::ranges::sort(cases, [](const gentest::Case &lhs, const gentest::Case &rhs) {
-        if (lhs.name != rhs.name)
-            return lhs.name < rhs.name;
-        if (lhs.file != rhs.file)
-            return lhs.file < rhs.file;
-        return lhs.line < rhs.line;
-    });
+// Modules with a `gentest_case_runs` section; pushed during static init (or
+// dlopen) without locking. The generation invalidates cached snapshots.
+std::atomic<gentest::detail::CaseTableModule *> g_case_tables{nullptr};
+std::atomic<std::size_t>                        g_case_table_generation{0};
+
+bool case_less(const gentest::Case &lhs, const gentest::Case &rhs) {
+    if (lhs.name != rhs.name)
+        return lhs.name < rhs.name;
+    if (lhs.file != rhs.file)
+        return lhs.file < rhs.file;
+    return lhs.line < rhs.line;
 }
 
-auto sorted_case_copy(std::span<const gentest::Case> cases) -> std::vector<gentest::Case> {
-    std::vector<gentest::Case> sorted(cases.begin(), cases.end());
-    sort_cases(sorted);
-    return sorted;
+void sort_cases(std::vector<gentest::Case> &cases) { std::ranges::sort(cases, case_less); }
+
+// k-way merge of runs that are each sorted already; ties keep run order.
+auto merge_sorted_runs(const std::vector<std::span<const gentest::Case>> &runs) -> std::vector<gentest::Case> {
+    std::size_t total = 0;
+    for (const auto &run : runs)
+        total += run.size();
+    std::vector<gentest::Case> merged;
+    merged.reserve(total);
+
+    std::vector<std::size_t> pos(runs.size(), 0);
+    std::vector<std::size_t> heap;
+    heap.reserve(runs.size());
+    const auto later = [&](std::size_t lhs, std::size_t rhs) {
+        const auto &a = runs[lhs][pos[lhs]];
+        const auto &b = runs[rhs][pos[rhs]];
+        if (case_less(b, a))
+            return true;
+        return !case_less(a, b) && rhs < lhs;
+    };
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        if (!runs[i].empty())
+            heap.push_back(i);
+    }
+    std::ranges::make_heap(heap, later);
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, later);
+        const std::size_t run = heap.back();
+        merged.push_back(runs[run][pos[run]]);
+        if (++pos[run] == runs[run].size())
+            heap.pop_back();
+        else
+            std::ranges::push_heap(heap, later);
+    }
+    return merged;
 }
 
-auto snapshot_cases() -> std::vector<gentest::Case> {
+auto build_snapshot(CaseRegistry &reg) -> std::shared_ptr<const CaseSnapshot> {
+    std::vector<std::span<const gentest::Case>> runs;
+    // Runs are emitted sorted by codegen, but a table from an older or
+    // mismatched generator must not break the merge; sort a copy instead.
+    std::vector<std::vector<gentest::Case>> resorted;
+    for (auto *module = g_case_tables.load(std::memory_order_acquire); module != nullptr; module = module->next) {
+        for (const auto *run = module->begin; run != module->end; ++run) {
+            if (run->begin == run->end)
+                continue;
+            const std::span<const gentest::Case> cases(run->begin, run->end);
+            if (std::ranges::is_sorted(cases, case_less)) {
+                runs.push_back(cases);
+                continue;
+            }
+            auto &copy = resorted.emplace_back(cases.begin(), cases.end());
+            sort_cases(copy);
+            runs.emplace_back(copy);
+        }
+    }
+    auto snapshot = std::make_shared<CaseSnapshot>();
+    if (reg.cases.empty() && runs.size() == 1) {
+        if (resorted.empty()) {
+            snapshot->cases = runs.front();
+        } else {
+            snapshot->storage = std::move(resorted.front());
+            snapshot->cases   = snapshot->storage;
+        }
+        return snapshot;
+    }
+    if (!reg.cases.empty()) {
+        if (!reg.sorted) {
+            sort_cases(reg.cases);
+            reg.sorted = true;
+        }
+        runs.emplace_back(reg.cases);
+    }
+    snapshot->storage = merge_sorted_runs(runs);
+    snapshot->cases   = snapshot->storage;
+    return snapshot;
+}
+
+auto case_snapshot() -> std::shared_ptr<const CaseSnapshot> {
     auto                       &reg = case_registry();
     std::lock_guard<std::mutex> lk(reg.mtx);
-    if (!reg.sorted) {
-        sort_cases(reg.cases);
-        reg.sorted = true;
+    const std::size_t           generation = g_case_table_generation.load(std::memory_order_acquire);
+    if (!reg.snapshot || reg.snapshot_generation != generation) {
+        reg.snapshot            = build_snapshot(reg);
+        reg.snapshot_generation = generation;
     }
-    return reg.cases;
+    return reg.snapshot;
 }
 
-auto run_sorted_cases(std::span<const gentest::Case> cases, const gentest::runner::CliOptions &options) -> int {
-    return gentest::runner::run_from_options(cases, options);
+auto snapshot_cases() -> std::vector<gentest::Case> {
+    const auto snapshot = case_snapshot();
+    return {snapshot->cases.begin(), snapshot->cases.end()};
+}
+
+auto run_sorted_cases(std::span<const gentest::Case> cases, const gentest::runner::CliOptions &options, std::span<const char *> args)
+    -> int {
+    switch (options.mode) {
+    case gentest::runner::Mode::Serve: return gentest::runner::serve_cases(cases, options);
+    case gentest::runner::Mode::Connect: return gentest::runner::run_connected(options, args);
+    case gentest::runner::Mode::DeathForkServer: return gentest::runner::run_death_fork_server(cases, options);
+    default: return gentest::runner::run_from_options(cases, options);
+    }
 }
 } // namespace
 
@@ -58,6 +158,14 @@ void register_cases(std::span<const Case> cases) {
     std::lock_guard<std::mutex> lk(reg.mtx);
     reg.cases.insert(reg.cases.end(), cases.begin(), cases.end());
     reg.sorted = false;
+    reg.snapshot.reset();
+}
+
+void register_case_table(CaseTableModule &module) {
+    module.next = g_case_tables.load(std::memory_order_relaxed);
+    while (!g_case_tables.compare_exchange_weak(module.next, &module, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    g_case_table_generation.fetch_add(1, std::memory_order_release);
 }
 
 auto snapshot_registered_cases() -> std::vector<Case> { return snapshot_cases(); }
@@ -71,8 +179,11 @@ auto run_cases(std::span<const Case> cases, std::span<const char *> args) -> int
     if (!gentest::runner::parse_cli(args, opt))
         return 1;
 
-    const auto sorted_cases = sorted_case_copy(cases);
-    return run_sorted_cases(sorted_cases, opt);
+    if (std::ranges::is_sorted(cases, case_less))
+        return run_sorted_cases(cases, opt, args);
+    std::vector<Case> sorted(cases.begin(), cases.end());
+    sort_cases(sorted);
+    return run_sorted_cases(sorted, opt, args);
 }
 
 auto run_all_tests(std::span<const char *> args) -> int {
@@ -80,8 +191,9 @@ auto run_all_tests(std::span<const char *> args) -> int {
     if (!gentest::runner::parse_cli(args, opt))
         return 1;
 
-    const auto cases = gentest::detail::snapshot_registered_cases();
-    return run_sorted_cases(cases, opt);
+    // Holding the snapshot keeps the run insulated from later registrations.
+    const auto snapshot = case_snapshot();
+    return run_sorted_cases(snapshot->cases, opt, args);
 }
 
 auto run_all_tests(int argc, char **argv) -> int {
@@ -0,0 +1,104 @@
+#include "runner_measured_cache.h"
+
+#include "gentest/bench_util.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace gentest::runner {
+namespace {
+
+constexpr std::size_t kCacheLineBytes     = 64;
+constexpr std::size_t kFallbackBufferSize = std::size_t{64} << 20;
+constexpr std::size_t kMinBufferSize      = std::size_t{8} << 20;
+constexpr std::size_t kMaxBufferSize      = std::size_t{256} << 20;
+
+// Parses sysfs cache sizes such as "48K", "2048K" or "32M".
+std::size_t parse_sysfs_size(const std::string &text) {
+    std::size_t value = 0;
+    std::size_t pos   = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + static_cast<std::size_t>(text[pos] - '0');
+        ++pos;
+    }
+    if (pos < text.size()) {
+        switch (text[pos]) {
+        case 'K': return value << 10;
+        case 'M': return value << 20;
+        case 'G': return value << 30;
+        default: break;
+        }
+    }
+    return value;
+}
+
+std::size_t sysfs_last_level_cache_bytes() {
+    int         best_level = 0;
+    std::size_t best_size  = 0;
+    for (int index = 0; index < 16; ++index) {
+        const std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        std::ifstream     level_file(base + "level");
+        std::ifstream     size_file(base + "size");
+        int               level = 0;
+        std::string       size_text;
+        if (!(level_file >> level) || !(size_file >> size_text)) {
+            break;
+        }
+        const std::size_t size = parse_sysfs_size(size_text);
+        if (level > best_level || (level == best_level && size > best_size)) {
+            best_level = level;
+            best_size  = size;
+        }
+    }
+    return best_size;
+}
+
+} // namespace
+
+std::size_t detect_last_level_cache_bytes() {
+    if (const std::size_t sysfs = sysfs_last_level_cache_bytes(); sysfs != 0) {
+        return sysfs;
+    }
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    if (const long l3 = ::sysconf(_SC_LEVEL3_CACHE_SIZE); l3 > 0) {
+        return static_cast<std::size_t>(l3);
+    }
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    if (const long l2 = ::sysconf(_SC_LEVEL2_CACHE_SIZE); l2 > 0) {
+        return static_cast<std::size_t>(l2);
+    }
+#endif
+    return 0;
+}
+
+// 1.5x the LLC leaves no room for earlier lines under LRU-like replacement;
+// the cap keeps very large shared LLCs from making every eviction a long pause.
+CacheEvictor::CacheEvictor() {
+    const std::size_t llc = detect_last_level_cache_bytes();
+    size_                 = llc == 0 ? kFallbackBufferSize : std::clamp(llc + llc / 2, kMinBufferSize, kMaxBufferSize);
+    buffer_               = std::make_unique<unsigned char[]>(size_);
+}
+
+void CacheEvictor::evict() noexcept {
+    unsigned char *data = buffer_.get();
+    for (std::size_t offset = 0; offset < size_; offset += kCacheLineBytes) {
+        data[offset] = static_cast<unsigned char>(data[offset] + 1);
+    }
+    gentest::doNotOptimizeAway(data);
+    gentest::clobberMemory();
+}
+
+CacheEvictor &shared_cache_evictor() {
+    static CacheEvictor evictor;
+    return evictor;
+}
+
+} // namespace gentest::runner
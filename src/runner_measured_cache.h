@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gentest::runner {
+
+// Size of the largest CPU cache level reported by the OS, in bytes; 0 when
+// unknown.
+std::size_t detect_last_level_cache_bytes();
+
+// Evicts data caches and TLB entries by streaming read-modify-write passes
+// over a buffer larger than the last-level cache. Cold benches call `evict()`
+// between measured epochs, outside the timed region.
+class CacheEvictor {
+  public:
+    CacheEvictor();
+
+    void                      evict() noexcept;
+    [[nodiscard]] std::size_t buffer_bytes() const { return size_; }
+
+  private:
+    std::unique_ptr<unsigned char[]> buffer_;
+    std::size_t                      size_ = 0;
+};
+
+// Process-wide evictor; the buffer is allocated on first use.
+CacheEvictor &shared_cache_evictor();
+
+} // namespace gentest::runner
@@ -0,0 +1,151 @@
+#include "runner_measured_clock.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <utility>
+
+#if GENTEST_MEASURED_HAS_TSC_CLOCK
+#include <cpuid.h>
+#endif
+
+namespace gentest::runner {
+namespace {
+
+constexpr double kSteadyNsPerTick =
+    static_cast<double>(std::chrono::steady_clock::period::num) * 1e9 / static_cast<double>(std::chrono::steady_clock::period::den);
+
+template <typename TickClock> double estimate_tick_resolution_ns(double ns_per_tick) {
+    constexpr std::size_t kProbes    = 256;
+    constexpr std::size_t kSpinLimit = 1U << 20;
+    std::uint64_t         best_ticks = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t probe = 0; probe < kProbes; ++probe) {
+        const std::uint64_t first = TickClock::start();
+        std::uint64_t       next  = first;
+        for (std::size_t spin = 0; spin < kSpinLimit && next == first; ++spin) {
+            next = TickClock::start();
+        }
+        if (next > first) {
+            best_ticks = std::min(best_ticks, next - first);
+        }
+    }
+    if (best_ticks == std::numeric_limits<std::uint64_t>::max()) {
+        return 0.0;
+    }
+    return static_cast<double>(best_ticks) * ns_per_tick;
+}
+
+#if GENTEST_MEASURED_HAS_TSC_CLOCK
+bool cpu_supports_invariant_tsc(std::string &reason) {
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (__get_cpuid(0x80000000U, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007U) {
+        reason = "CPUID leaf 0x80000007 is unavailable";
+        return false;
+    }
+    if (__get_cpuid(0x80000001U, &eax, &ebx, &ecx, &edx) == 0 || (edx & (1U << 27)) == 0) {
+        reason = "CPU does not support rdtscp";
+        return false;
+    }
+    if (__get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx) == 0 || (edx & (1U << 8)) == 0) {
+        reason = "CPU does not report an invariant TSC";
+        return false;
+    }
+    return true;
+}
+
+// Measures TSC ticks against steady_clock over a few short windows and takes
+// the median rate; rejects the TSC when the windows disagree by more than 1%.
+bool calibrate_tsc_ns_per_tick(double &ns_per_tick, std::string &reason) {
+    using clock                          = std::chrono::steady_clock;
+    constexpr std::size_t       kRounds  = 5;
+    constexpr auto              kWindow  = std::chrono::milliseconds(2);
+    constexpr double            kMaxSkew = 0.01;
+    std::array<double, kRounds> rates{};
+    for (auto &rate : rates) {
+        const auto          wall_start = clock::now();
+        const std::uint64_t tsc_start  = TscTickClock::start();
+        auto                wall_end   = wall_start;
+        while (wall_end - wall_start < kWindow) {
+            wall_end = clock::now();
+        }
+        const std::uint64_t tsc_end = TscTickClock::stop();
+        if (tsc_end <= tsc_start) {
+            reason = "TSC did not advance during calibration";
+            return false;
+        }
+        const double wall_ns = std::chrono::duration<double, std::nano>(wall_end - wall_start).count();
+        rate                 = wall_ns / static_cast<double>(tsc_end - tsc_start);
+    }
+    std::ranges::sort(rates);
+    const double median = rates[kRounds / 2];
+    if (!std::isfinite(median) || median <= 0.0) {
+        reason = "TSC calibration produced an invalid tick rate";
+        return false;
+    }
+    if ((rates.back() - rates.front()) / median > kMaxSkew) {
+        reason = fmt::format("TSC calibration is unstable ({:.3f}..{:.3f} ns/tick)", rates.front(), rates.back());
+        return false;
+    }
+    ns_per_tick = median;
+    return true;
+}
+#endif
+
+JitterClockCalibration make_steady_calibration(JitterClockMode requested, std::string fallback_reason) {
+    JitterClockCalibration calibration{};
+    calibration.requested       = requested;
+    calibration.active          = JitterClockMode::Steady;
+    calibration.ns_per_tick     = kSteadyNsPerTick;
+    calibration.resolution_ns   = estimate_tick_resolution_ns<SteadyTickClock>(kSteadyNsPerTick);
+    calibration.fallback_reason = std::move(fallback_reason);
+    return calibration;
+}
+
+JitterClockCalibration make_tsc_calibration() {
+#if GENTEST_MEASURED_HAS_TSC_CLOCK
+    std::string reason;
+    double      ns_per_tick = 0.0;
+    if (!cpu_supports_invariant_tsc(reason) || !calibrate_tsc_ns_per_tick(ns_per_tick, reason)) {
+        return make_steady_calibration(JitterClockMode::Tsc, std::move(reason));
+    }
+    JitterClockCalibration calibration{};
+    calibration.requested     = JitterClockMode::Tsc;
+    calibration.active        = JitterClockMode::Tsc;
+    calibration.ns_per_tick   = ns_per_tick;
+    calibration.resolution_ns = estimate_tick_resolution_ns<TscTickClock>(ns_per_tick);
+    return calibration;
+#else
+    return make_steady_calibration(JitterClockMode::Tsc, "TSC clock is only supported on x86-64 Linux");
+#endif
+}
+
+} // namespace
+
+const JitterClockCalibration &resolve_jitter_clock(JitterClockMode requested) {
+    if (requested == JitterClockMode::Tsc) {
+        static const JitterClockCalibration tsc = make_tsc_calibration();
+        return tsc;
+    }
+    static const JitterClockCalibration steady = make_steady_calibration(JitterClockMode::Steady, {});
+    return steady;
+}
+
+std::string_view jitter_clock_name(JitterClockMode mode) {
+    switch (mode) {
+    case JitterClockMode::Steady: return "steady";
+    case JitterClockMode::Tsc: return "tsc";
+    }
+    return "steady";
+}
+
+} // namespace gentest::runner
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "runner_cli.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define GENTEST_MEASURED_HAS_TSC_CLOCK 1
+#include <x86intrin.h>
+#else
+#define GENTEST_MEASURED_HAS_TSC_CLOCK 0
+#endif
+
+namespace gentest::runner {
+
+// Raw tick sources used by jitter per-call sampling. `start()` and `stop()`
+// return ticks in the source's native unit; convert with
+// JitterClockCalibration::ns_per_tick.
+struct SteadyTickClock {
+    static std::uint64_t start() noexcept { return read(); }
+    static std::uint64_t stop() noexcept { return read(); }
+
+  private:
+    static std::uint64_t read() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+};
+
+#if GENTEST_MEASURED_HAS_TSC_CLOCK
+// lfence before rdtsc keeps earlier loads from drifting into the timed region;
+// rdtscp + lfence keeps the body from drifting past the stop read.
+struct TscTickClock {
+    static std::uint64_t start() noexcept {
+        _mm_lfence();
+        const std::uint64_t ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+    }
+    static std::uint64_t stop() noexcept {
+        unsigned int        aux   = 0;
+        const std::uint64_t ticks = __rdtscp(&aux);
+        _mm_lfence();
+        return ticks;
+    }
+};
+#endif
+
+struct JitterClockCalibration {
+    JitterClockMode requested     = JitterClockMode::Steady;
+    JitterClockMode active        = JitterClockMode::Steady;
+    double          ns_per_tick   = 1.0;
+    double          resolution_ns = 0.0;
+    std::string     fallback_reason;
+};
+
+// Resolves and calibrates the requested clock once per process. A TSC request
+// falls back to steady_clock (with `fallback_reason` set) when the CPU lacks an
+// invariant TSC/rdtscp or calibration against steady_clock is unstable.
+const JitterClockCalibration &resolve_jitter_clock(JitterClockMode requested);
+
+std::string_view jitter_clock_name(JitterClockMode mode);
+
+} // namespace gentest::runner
@@ -0,0 +1,204 @@
+#include "runner_measured_environment.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace gentest::runner {
+namespace {
+
+// A 1-minute load above this many runnable tasks per online CPU means other
+// work is likely competing with the measured thread.
+constexpr double kBusyLoadPerCpu = 0.5;
+
+std::optional<std::string> read_first_token(const std::string &path) {
+    std::ifstream in(path);
+    std::string   token;
+    if (!(in >> token)) {
+        return std::nullopt;
+    }
+    return token;
+}
+
+std::optional<int> read_int(const std::string &path) {
+    std::ifstream in(path);
+    int           value = 0;
+    if (!(in >> value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+unsigned configured_cpu_count() {
+#if defined(_SC_NPROCESSORS_CONF)
+    const long count = sysconf(_SC_NPROCESSORS_CONF);
+    return count > 0 ? static_cast<unsigned>(count) : 0U;
+#else
+    return 0;
+#endif
+}
+
+unsigned online_cpu_count() {
+#if defined(_SC_NPROCESSORS_ONLN)
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? static_cast<unsigned>(count) : 0U;
+#else
+    return 0;
+#endif
+}
+
+// Offline CPUs have no cpufreq directory and are skipped.
+std::optional<std::string> probe_cpu_governor() {
+    std::vector<std::string> governors;
+    const unsigned           cpus = configured_cpu_count();
+    for (unsigned cpu = 0; cpu < cpus; ++cpu) {
+        auto governor = read_first_token(fmt::format("/sys/devices/system/cpu/cpu{}/cpufreq/scaling_governor", cpu));
+        if (governor && std::ranges::find(governors, *governor) == governors.end()) {
+            governors.push_back(std::move(*governor));
+        }
+    }
+    if (governors.empty()) {
+        return std::nullopt;
+    }
+    if (governors.size() == 1) {
+        return governors.front();
+    }
+    std::ranges::sort(governors);
+    std::string joined = governors.front();
+    for (std::size_t i = 1; i < governors.size(); ++i) {
+        joined += ',';
+        joined += governors[i];
+    }
+    return fmt::format("mixed({})", joined);
+}
+
+// intel_pstate exposes no_turbo directly; acpi-cpufreq and amd-pstate expose
+// the inverse as cpufreq/boost.
+std::optional<bool> probe_no_turbo() {
+    if (const auto no_turbo = read_int("/sys/devices/system/cpu/intel_pstate/no_turbo")) {
+        return *no_turbo != 0;
+    }
+    if (const auto boost = read_int("/sys/devices/system/cpu/cpufreq/boost")) {
+        return *boost == 0;
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> probe_smt_active() {
+    if (const auto active = read_int("/sys/devices/system/cpu/smt/active")) {
+        return *active != 0;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+BenchEnvironment probe_bench_environment(std::optional<int> pinned_cpu) {
+    BenchEnvironment env{};
+    env.cpu_governor = probe_cpu_governor();
+    env.no_turbo     = probe_no_turbo();
+    env.smt_active   = probe_smt_active();
+    env.aslr         = read_int("/proc/sys/kernel/randomize_va_space");
+    env.online_cpus  = online_cpu_count();
+    env.pinned_cpu   = pinned_cpu;
+#if defined(__unix__) || defined(__APPLE__)
+    double loads[3] = {};
+    if (getloadavg(loads, 3) == 3) {
+        env.loadavg_1m  = loads[0];
+        env.loadavg_5m  = loads[1];
+        env.loadavg_15m = loads[2];
+    }
+#endif
+    if (pinned_cpu) {
+        env.pinned_cpu_siblings =
+            read_first_token(fmt::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", *pinned_cpu)).value_or("");
+    }
+    return env;
+}
+
+std::vector<std::string> bench_environment_warnings(const BenchEnvironment &env) {
+    std::vector<std::string> warnings;
+    if (env.cpu_governor && *env.cpu_governor != "performance") {
+        warnings.push_back(fmt::format("CPU frequency governor is '{}'; 'performance' gives steadier timings", *env.cpu_governor));
+    }
+    if (env.no_turbo && !*env.no_turbo) {
+        warnings.push_back("CPU turbo boost is enabled; clock speed varies with temperature and load");
+    }
+    if (env.loadavg_1m && env.online_cpus != 0 && *env.loadavg_1m > kBusyLoadPerCpu * static_cast<double>(env.online_cpus)) {
+        warnings.push_back(fmt::format("1-minute load average is {:.2f} on {} online CPUs; other work competes with the benchmark",
+                                       *env.loadavg_1m, env.online_cpus));
+    }
+    if (env.pinned_cpu && env.pinned_cpu_siblings.find_first_of(",-") != std::string::npos) {
+        warnings.push_back(fmt::format("pinned CPU {} shares a core with SMT siblings {}", *env.pinned_cpu, env.pinned_cpu_siblings));
+    }
+    return warnings;
+}
+
+ScopedCpuPin::~ScopedCpuPin() {
+#if defined(__linux__)
+    if (!cpu_) {
+        return;
+    }
+    cpu_set_t restore;
+    CPU_ZERO(&restore);
+    for (const int saved : saved_cpus_) {
+        CPU_SET(saved, &restore);
+    }
+    (void)sched_setaffinity(0, sizeof(restore), &restore);
+#endif
+}
+
+bool ScopedCpuPin::pin(int cpu, std::string &error) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        error = fmt::format("CPU index must be below {}", CPU_SETSIZE);
+        return false;
+    }
+    cpu_set_t previous;
+    CPU_ZERO(&previous);
+    if (sched_getaffinity(0, sizeof(previous), &previous) != 0) {
+        error = fmt::format("sched_getaffinity failed: {}", std::strerror(errno));
+        return false;
+    }
+    if (!CPU_ISSET(cpu, &previous)) {
+        error = fmt::format("CPU {} is not in the allowed CPU set of this process", cpu);
+        return false;
+    }
+    cpu_set_t target;
+    CPU_ZERO(&target);
+    CPU_SET(cpu, &target);
+    if (sched_setaffinity(0, sizeof(target), &target) != 0) {
+        error = fmt::format("sched_setaffinity failed: {}", std::strerror(errno));
+        return false;
+    }
+    saved_cpus_.clear();
+    for (int saved = 0; saved < CPU_SETSIZE; ++saved) {
+        if (CPU_ISSET(saved, &previous)) {
+            saved_cpus_.push_back(saved);
+        }
+    }
+    cpu_ = cpu;
+    return true;
+#else
+    (void)cpu;
+    error = "CPU pinning is only supported on Linux";
+    return false;
+#endif
+}
+
+} // namespace gentest::runner
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gentest::runner {
+
+// Host state that commonly skews measured results, probed once before the
+// first bench/jitter case runs. Values the host does not expose (non-Linux,
+// missing sysfs entries, containers) stay empty and are reported as null.
+struct BenchEnvironment {
+    std::optional<std::string> cpu_governor; // shared scaling_governor, or "mixed(a,b)"
+    std::optional<bool>        no_turbo;
+    std::optional<bool>        smt_active;
+    std::optional<double>      loadavg_1m;
+    std::optional<double>      loadavg_5m;
+    std::optional<double>      loadavg_15m;
+    std::optional<int>         aslr; // kernel.randomize_va_space: 0 off, 1 stack/mmap, 2 full
+    unsigned                   online_cpus = 0;
+    std::optional<int>         pinned_cpu;
+    std::string                pinned_cpu_siblings; // thread_siblings_list of the pinned CPU
+};
+
+BenchEnvironment probe_bench_environment(std::optional<int> pinned_cpu);
+
+// Human-readable findings for table/markdown runs; empty when nothing looks
+// off or nothing could be read. ASLR is on by default on Linux, so it is only
+// recorded in machine-readable reports and never warned about.
+std::vector<std::string> bench_environment_warnings(const BenchEnvironment &env);
+
+// Restricts the calling thread to one CPU and restores the previous affinity
+// on destruction. Threads spawned while the pin is held inherit it, which
+// covers worker threads started by bench bodies.
+class ScopedCpuPin {
+  public:
+    ScopedCpuPin() = default;
+    ~ScopedCpuPin();
+    ScopedCpuPin(const ScopedCpuPin &)            = delete;
+    ScopedCpuPin &operator=(const ScopedCpuPin &) = delete;
+
+    bool                             pin(int cpu, std::string &error);
+    [[nodiscard]] std::optional<int> cpu() const { return cpu_; }
+
+  private:
+    std::optional<int> cpu_;
+    std::vector<int>   saved_cpus_;
+};
+
+} // namespace gentest::runner
@@ -4,6 +4,8 @@
 #include "runner_case_invoker.h"
 #include "runner_context_scope.h"
 #include "runner_fixture_runtime.h"
+#include "runner_measured_cache.h"
+#include "runner_measured_clock.h"
 #include "runner_measured_format.h"
 #include "runner_measured_report.h"
 
@@ -16,6 +18,7 @@
 #include <fmt/format.h>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -52,6 +55,24 @@ struct OverheadEstimate {
     std::size_t samples   = 0;
 };
 
+struct JitterSampling {
+    int  hdr_digits       = 3;
+    bool keep_raw_samples = false;
+};
+
+// Samples always feed the bounded log-linear histogram; the raw vector is only
+// filled when a consumer (the Allure samples attachment) needs every value.
+struct JitterSampleSink {
+    gentest::detail::LogLinearHistogram &histogram;
+    std::vector<double>                 *raw_samples = nullptr;
+
+    void record(double ns) {
+        histogram.record(ns);
+        if (raw_samples != nullptr)
+            raw_samples->push_back(ns);
+    }
+};
+
 struct CalibratedEpoch {
     std::size_t iterations = 1;
     std::size_t completed  = 0;
@@ -239,18 +260,18 @@ double run_warmup_epochs(const gentest::Case &c, void *ctx, std::size_t iters, s
 }
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-double run_jitter_epoch_calls(const gentest::Case &c, void *ctx, std::size_t iters, std::size_t &iterations_done, bool &had_assert_fail,
-                              std::vector<double> &samples_ns, MeasurementCaseFailure &failure) {
-    using clock     = std::chrono::steady_clock;
+template <typename TickClock>
+double run_jitter_epoch_calls(const gentest::Case &c, void *ctx, std::size_t iters, double ns_per_tick, std::size_t &iterations_done,
+                              bool &had_assert_fail, JitterSampleSink &samples, MeasurementCaseFailure &failure) {
     iterations_done = 0;
     return run_call_phase_with_context(
         c, "skip requested during jitter call phase",
         [&] {
             for (std::size_t i = 0; i < iters; ++i) {
-                auto start = clock::now();
+                const std::uint64_t start = TickClock::start();
                 c.fn(ctx);
-                auto end = clock::now();
-                samples_ns.push_back(ns_from_s(std::chrono::duration<double>(end - start).count()));
+                const std::uint64_t end = TickClock::stop();
+                samples.record(static_cast<double>(end - start) * ns_per_tick);
                 iterations_done = i + 1;
             }
         },
@@ -258,29 +279,28 @@ double run_jitter_epoch_calls(const gentest::Case &c, void *ctx, std::size_t ite
 }
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
+template <typename TickClock>
 double run_jitter_batch_epoch_calls(const gentest::Case &c, void *ctx, std::size_t batch_iters, std::size_t batch_samples,
-                                    std::size_t &iterations_done, bool &had_assert_fail, std::vector<double> &samples_ns,
+                                    double ns_per_tick, std::size_t &iterations_done, bool &had_assert_fail, JitterSampleSink &samples,
                                     MeasurementCaseFailure &failure) {
-    using clock             = std::chrono::steady_clock;
-    iterations_done         = 0;
-    std::size_t local_done  = 0;
-    auto        batch_start = clock::now();
-    bool        in_batch    = false;
+    iterations_done           = 0;
+    std::size_t   local_done  = 0;
+    std::uint64_t batch_start = 0;
+    bool          in_batch    = false;
     return run_call_phase_with_context(
         c, "skip requested during jitter call phase",
         [&] {
             for (std::size_t sample = 0; sample < batch_samples; ++sample) {
-                batch_start = clock::now();
+                batch_start = TickClock::start();
                 local_done  = 0;
                 in_batch    = true;
                 for (std::size_t i = 0; i < batch_iters; ++i) {
                     c.fn(ctx);
                     ++local_done;
                 }
-                auto end = clock::now();
+                const std::uint64_t end = TickClock::stop();
                 if (local_done != 0) {
-                    samples_ns.push_back(ns_from_s(std::chrono::duration<double>(end - batch_start).count()) /
-                                         static_cast<double>(local_done));
+                    samples.record(static_cast<double>(end - batch_start) * ns_per_tick / static_cast<double>(local_done));
                     iterations_done += local_done;
                 }
                 in_batch = false;
@@ -288,8 +308,8 @@ double run_jitter_batch_epoch_calls(const gentest::Case &c, void *ctx, std::size
         },
         [&] {
             if (in_batch && local_done != 0) {
-                auto end = clock::now();
-                samples_ns.push_back(ns_from_s(std::chrono::duration<double>(end - batch_start).count()) / static_cast<double>(local_done));
+                const std::uint64_t end = TickClock::stop();
+                samples.record(static_cast<double>(end - batch_start) * ns_per_tick / static_cast<double>(local_done));
                 iterations_done += local_done;
             }
         },
@@ -297,8 +317,7 @@ double run_jitter_batch_epoch_calls(const gentest::Case &c, void *ctx, std::size
 }
 // NOLINTEND(bugprone-easily-swappable-parameters)
 
-OverheadEstimate estimate_timer_overhead_per_iter(std::size_t sample_count) {
-    using clock = std::chrono::steady_clock;
+template <typename TickClock> OverheadEstimate estimate_timer_overhead_per_iter(std::size_t sample_count, double ns_per_tick) {
     OverheadEstimate est{};
     if (sample_count == 0)
         return est;
@@ -306,13 +325,13 @@ OverheadEstimate estimate_timer_overhead_per_iter(std::size_t sample_count) {
     std::vector<double>   samples;
     samples.reserve(sample_count);
     for (std::size_t i = 0; i < sample_count; ++i) {
-        auto start = clock::now();
+        const std::uint64_t start = TickClock::start();
         for (std::size_t r = 0; r < repeat; ++r) {
-            (void)clock::now();
-            (void)clock::now();
+            (void)TickClock::start();
+            (void)TickClock::stop();
         }
-        auto         end = clock::now();
-        const double ns  = ns_from_s(std::chrono::duration<double>(end - start).count()) / static_cast<double>(repeat);
+        const std::uint64_t end = TickClock::stop();
+        const double        ns  = static_cast<double>(end - start) * ns_per_tick / static_cast<double>(repeat);
         samples.push_back(ns);
     }
     est.mean_ns   = mean_of(samples);
@@ -321,8 +340,8 @@ OverheadEstimate estimate_timer_overhead_per_iter(std::size_t sample_count) {
     return est;
 }
 
-OverheadEstimate estimate_timer_overhead_batch(std::size_t sample_count, std::size_t batch_iters) {
-    using clock = std::chrono::steady_clock;
+template <typename TickClock>
+OverheadEstimate estimate_timer_overhead_batch(std::size_t sample_count, std::size_t batch_iters, double ns_per_tick) {
     OverheadEstimate est{};
     if (sample_count == 0 || batch_iters == 0)
         return est;
@@ -330,12 +349,12 @@ OverheadEstimate estimate_timer_overhead_batch(std::size_t sample_count, std::si
     samples.reserve(sample_count);
     volatile std::size_t sink = 0;
     for (std::size_t i = 0; i < sample_count; ++i) {
-        auto start = clock::now();
+        const std::uint64_t start = TickClock::start();
         for (std::size_t j = 0; j < batch_iters; ++j) {
             sink += j;
         }
-        auto         end = clock::now();
-        const double ns  = ns_from_s(std::chrono::duration<double>(end - start).count()) / static_cast<double>(batch_iters);
+        const std::uint64_t end = TickClock::stop();
+        const double        ns  = static_cast<double>(end - start) * ns_per_tick / static_cast<double>(batch_iters);
         samples.push_back(ns);
     }
     (void)sink;
@@ -404,19 +423,40 @@ bool run_measurement_phase(const gentest::Case &c, void *ctx, gentest::detail::B
 }
 // NOLINTEND(bugprone-easily-swappable-parameters)
 
-BenchResult run_bench(const gentest::Case &c, void *ctx, const BenchConfig &cfg, MeasurementCaseFailure &failure) {
+BenchCacheMode resolve_bench_cache_mode(const gentest::Case &c, BenchCacheMode requested) {
+    if (requested != BenchCacheMode::Auto) {
+        return requested;
+    }
+    switch (c.bench_cache) {
+    case gentest::BenchCache::Cold: return BenchCacheMode::Cold;
+    case gentest::BenchCache::Both: return BenchCacheMode::Both;
+    case gentest::BenchCache::Default:
+    case gentest::BenchCache::Warm: break;
+    }
+    return BenchCacheMode::Warm;
+}
+
+// Cold runs skip calibration: an epoch is a single call so that every timed
+// call starts from evicted caches, with the eviction itself outside the timer.
+BenchResult run_bench(const gentest::Case &c, void *ctx, const BenchConfig &cfg, bool cold_cache, MeasurementCaseFailure &failure) {
     BenchResult br{};
-    auto        calibration = calibrate_epoch_iterations(c, ctx, cfg, failure);
+    auto        calibration = cold_cache ? CalibratedEpoch{} : calibrate_epoch_iterations(c, ctx, cfg, failure);
     auto        iters       = calibration.iterations;
     auto        done        = calibration.completed;
     auto        had_assert  = calibration.had_assert;
     const auto  calib_s     = calibration.elapsed_s;
     br.calibration_time_s   = calib_s;
-    br.calibration_iters    = iters;
+    br.calibration_iters    = cold_cache ? 0 : iters;
+    br.cold_cache           = cold_cache;
     if (!had_assert) {
         br.warmup_time_s = run_warmup_epochs(c, ctx, iters, cfg.warmup_epochs, done, had_assert, failure);
     }
 
+    CacheEvictor *evictor = cold_cache ? &shared_cache_evictor() : nullptr;
+    if (evictor != nullptr) {
+        br.evict_buffer_bytes = evictor->buffer_bytes();
+    }
+
     std::vector<double> epoch_ns;
     if (!had_assert) {
         auto        start_all  = std::chrono::steady_clock::now();
@@ -424,6 +464,12 @@ BenchResult run_bench(const gentest::Case &c, void *ctx, const BenchConfig &cfg,
         for (;;) {
             if (epochs_run >= cfg.measure_epochs && br.total_time_s >= cfg.min_total_time_s)
                 break;
+            if (evictor != nullptr) {
+                const auto evict_start = std::chrono::steady_clock::now();
+                evictor->evict();
+                br.eviction_time_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - evict_start).count();
+                ++br.evictions;
+            }
             double s = run_epoch_calls(c, ctx, iters, done, had_assert, failure);
             if (had_assert) {
                 br.total_time_s += s;
@@ -452,11 +498,13 @@ BenchResult run_bench(const gentest::Case &c, void *ctx, const BenchConfig &cfg,
         br.p05_ns          = percentile_sorted(sorted, 0.05);
         br.p95_ns          = percentile_sorted(sorted, 0.95);
     }
-    br.wall_time_s = br.warmup_time_s + br.total_time_s + br.calibration_time_s;
+    br.wall_time_s = br.warmup_time_s + br.total_time_s + br.calibration_time_s + br.eviction_time_s;
     return br;
 }
 
-JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cfg, MeasurementCaseFailure &failure) {
+template <typename TickClock>
+JitterResult run_jitter_with_clock(const gentest::Case &c, void *ctx, const BenchConfig &cfg, const JitterClockCalibration &clock,
+                                   const JitterSampling &sampling, MeasurementCaseFailure &failure) {
     JitterResult jr{};
     auto         calibration = calibrate_epoch_iterations(c, ctx, cfg, failure);
     std::size_t  iters       = calibration.iterations;
@@ -464,16 +512,28 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
     std::size_t  done        = calibration.completed;
     std::size_t  epoch_count = 0;
     const double calib_s     = calibration.elapsed_s;
+    const double ns_per_tick = clock.ns_per_tick;
     jr.calibration_time_s    = calib_s;
     jr.calibration_iters     = iters;
+    jr.clock                 = clock.active;
+    jr.clock_requested       = clock.requested;
+    jr.clock_resolution_ns   = clock.resolution_ns;
+    jr.sample_histogram      = gentest::detail::LogLinearHistogram(sampling.hdr_digits);
+    JitterSampleSink samples{
+        .histogram   = jr.sample_histogram,
+        .raw_samples = sampling.keep_raw_samples ? &jr.samples_ns : nullptr,
+    };
 
-    const std::size_t      calib_iters        = done ? done : iters;
-    const double           real_ns_per_iter   = (calib_iters > 0) ? (ns_from_s(calib_s) / static_cast<double>(calib_iters)) : 0.0;
-    constexpr std::size_t  kOverheadSamples   = 256;
-    const OverheadEstimate per_iter_overhead  = estimate_timer_overhead_per_iter(kOverheadSamples);
-    constexpr double       kOverheadThreshold = 10.0;
-    const bool             use_batch          = (real_ns_per_iter > 0.0) && (per_iter_overhead.mean_ns > 0.0) &&
-                                                (real_ns_per_iter < per_iter_overhead.mean_ns * kOverheadThreshold);
+    const std::size_t      calib_iters       = done ? done : iters;
+    const double           real_ns_per_iter  = (calib_iters > 0) ? (ns_from_s(calib_s) / static_cast<double>(calib_iters)) : 0.0;
+    constexpr std::size_t  kOverheadSamples  = 256;
+    const OverheadEstimate per_iter_overhead = estimate_timer_overhead_per_iter<TickClock>(kOverheadSamples, ns_per_tick);
+    // Serialized TSC reads cost a few stable cycles, so per-call samples stay
+    // meaningful much closer to the read overhead than steady_clock samples do.
+    const double kOverheadThreshold = (clock.active == JitterClockMode::Tsc) ? 2.0 : 10.0;
+    const bool   use_batch          = (real_ns_per_iter > 0.0) && (per_iter_overhead.mean_ns > 0.0) &&
+                                      (real_ns_per_iter < per_iter_overhead.mean_ns * kOverheadThreshold);
+    jr.clock_overhead_ns = per_iter_overhead.mean_ns;
 
     std::size_t      batch_samples = 1;
     std::size_t      batch_iters   = 1;
@@ -483,7 +543,7 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
         if (batch_samples == 0)
             batch_samples = 1;
         batch_iters   = std::max<std::size_t>(1, iters / batch_samples);
-        overhead      = estimate_timer_overhead_batch(kOverheadSamples, batch_iters);
+        overhead      = estimate_timer_overhead_batch<TickClock>(kOverheadSamples, batch_iters, ns_per_tick);
         jr.batch_mode = true;
     }
     jr.overhead_mean_ns = overhead.mean_ns;
@@ -499,9 +559,10 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
                 break;
             double s = 0.0;
             if (use_batch) {
-                s = run_jitter_batch_epoch_calls(c, ctx, batch_iters, batch_samples, done, had_assert, jr.samples_ns, failure);
+                s = run_jitter_batch_epoch_calls<TickClock>(c, ctx, batch_iters, batch_samples, ns_per_tick, done, had_assert, samples,
+                                                            failure);
             } else {
-                s = run_jitter_epoch_calls(c, ctx, iters, done, had_assert, jr.samples_ns, failure);
+                s = run_jitter_epoch_calls<TickClock>(c, ctx, iters, ns_per_tick, done, had_assert, samples, failure);
             }
             if (had_assert) {
                 jr.total_time_s += s;
@@ -518,8 +579,8 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
     }
     jr.epochs          = epoch_count;
     jr.iters_per_epoch = use_batch ? (batch_iters * batch_samples) : iters;
-    if (!jr.samples_ns.empty()) {
-        const auto stats = gentest::detail::compute_sample_stats(jr.samples_ns);
+    if (jr.sample_histogram.count() != 0) {
+        const auto stats = jr.sample_histogram.stats();
         jr.min_ns        = stats.min;
         jr.max_ns        = stats.max;
         jr.median_ns     = stats.median;
@@ -527,6 +588,9 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
         jr.stddev_ns     = stats.stddev;
         jr.p05_ns        = stats.p05;
         jr.p95_ns        = stats.p95;
+        jr.p99_ns        = jr.sample_histogram.percentile(0.99);
+        jr.p999_ns       = jr.sample_histogram.percentile(0.999);
+        jr.p9999_ns      = jr.sample_histogram.percentile(0.9999);
     }
     if (jr.median_ns > 0.0) {
         jr.overhead_ratio_pct = (jr.overhead_mean_ns / jr.median_ns) * 100.0;
@@ -535,6 +599,16 @@ JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cf
     return jr;
 }
 
+JitterResult run_jitter(const gentest::Case &c, void *ctx, const BenchConfig &cfg, const JitterClockCalibration &clock,
+                        const JitterSampling &sampling, MeasurementCaseFailure &failure) {
+#if GENTEST_MEASURED_HAS_TSC_CLOCK
+    if (clock.active == JitterClockMode::Tsc) {
+        return run_jitter_with_clock<TscTickClock>(c, ctx, cfg, clock, sampling, failure);
+    }
+#endif
+    return run_jitter_with_clock<SteadyTickClock>(c, ctx, cfg, clock, sampling, failure);
+}
+
 template <typename Result, typename CallFn>
 bool run_measured_case(const gentest::Case &c, CallFn &&run_call, Result &out_result, MeasurementCaseFailure &out_failure) {
     using clock = std::chrono::steady_clock;
@@ -795,17 +869,25 @@ TimedRunStatus run_selected_benches(std::span<const gentest::Case> kCases, std::
     std::vector<BenchReportRow> local_rows;
     auto                       &rows = report_rows == nullptr ? local_rows : *report_rows;
     rows.reserve(rows.size() + idxs.size());
-    const bool           machine_report  = is_machine_measured_report(opt.measured_report_format);
-    const TimedRunStatus measured_status = run_measured_cases<BenchResult>(
+    const bool                 machine_report = is_machine_measured_report(opt.measured_report_format);
+    std::optional<BenchResult> pending_cold;
+    const TimedRunStatus       measured_status = run_measured_cases<BenchResult>(
         kCases, idxs, "benchmark", fail_fast, machine_report,
         [&](const gentest::Case &measured, void *measured_ctx, MeasurementCaseFailure &failure) {
-            return run_bench(measured, measured_ctx, opt.bench_cfg, failure);
+            pending_cold.reset();
+            const BenchCacheMode mode = resolve_bench_cache_mode(measured, opt.bench_cache_mode);
+            BenchResult          br   = run_bench(measured, measured_ctx, opt.bench_cfg, mode == BenchCacheMode::Cold, failure);
+            if (mode == BenchCacheMode::Both && !gentest::detail::has_bench_error()) {
+                pending_cold = run_bench(measured, measured_ctx, opt.bench_cfg, true, failure);
+            }
+            return br;
         },
         [&](const gentest::Case &measured, BenchResult &&br) {
             on_success(measured, br);
             rows.push_back(BenchReportRow{
                 .c      = &measured,
                 .result = br,
+                .cold   = std::exchange(pending_cold, std::nullopt),
             });
         },
         on_failure);
@@ -826,15 +908,24 @@ TimedRunStatus run_selected_jitters(std::span<const gentest::Case> kCases, std::
     std::vector<JitterReportRow> local_rows;
     auto                        &rows = report_rows == nullptr ? local_rows : *report_rows;
     rows.reserve(rows.size() + idxs.size());
-    const bool           machine_report  = is_machine_measured_report(opt.measured_report_format);
+    const bool                    machine_report = is_machine_measured_report(opt.measured_report_format);
+    const JitterClockCalibration &clock          = resolve_jitter_clock(opt.jitter_clock);
+    if (!clock.fallback_reason.empty()) {
+        fmt::print(stderr, "note: --jitter-clock={} unavailable ({}); using {}\n", jitter_clock_name(clock.requested),
+                   clock.fallback_reason, jitter_clock_name(clock.active));
+    }
+    const JitterSampling sampling{
+        .hdr_digits       = opt.jitter_hdr_digits,
+        .keep_raw_samples = opt.allure_dir != nullptr,
+    };
     const TimedRunStatus measured_status = run_measured_cases<JitterResult>(
         kCases, idxs, "jitter", fail_fast, machine_report,
         [&](const gentest::Case &measured, void *measured_ctx, MeasurementCaseFailure &failure) {
-            return run_jitter(measured, measured_ctx, opt.bench_cfg, failure);
+            return run_jitter(measured, measured_ctx, opt.bench_cfg, clock, sampling, failure);
         },
         [&](const gentest::Case &measured, JitterResult &&jr) {
             jr.histogram_bins = opt.jitter_bins;
-            jr.histogram      = gentest::detail::compute_histogram(jr.samples_ns, opt.jitter_bins);
+            jr.histogram      = jr.sample_histogram.histogram(opt.jitter_bins);
             on_success(measured, jr);
             rows.push_back(JitterReportRow{
                 .c      = &measured,
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -28,36 +29,54 @@ struct BenchResult {
     double      wall_time_s        = 0;
     double      calibration_time_s = 0;
     std::size_t calibration_iters  = 0;
+    // Cold runs time one call per epoch and evict caches before each epoch;
+    // eviction time is excluded from total_time_s but included in wall_time_s.
+    bool        cold_cache         = false;
+    std::size_t evictions          = 0;
+    double      eviction_time_s    = 0;
+    std::size_t evict_buffer_bytes = 0;
 };
 
 struct JitterResult {
-    std::size_t                epochs             = 0;
-    std::size_t                iters_per_epoch    = 0;
-    std::size_t                total_iters        = 0;
-    bool                       batch_mode         = false;
-    double                     min_ns             = 0;
-    double                     max_ns             = 0;
-    double                     median_ns          = 0;
-    double                     mean_ns            = 0;
-    double                     stddev_ns          = 0;
-    double                     p05_ns             = 0;
-    double                     p95_ns             = 0;
-    double                     overhead_mean_ns   = 0;
-    double                     overhead_sd_ns     = 0;
-    double                     overhead_ratio_pct = 0;
-    double                     total_time_s       = 0;
-    double                     warmup_time_s      = 0;
-    double                     wall_time_s        = 0;
-    double                     calibration_time_s = 0;
-    std::size_t                calibration_iters  = 0;
-    int                        histogram_bins     = 0;
+    std::size_t                epochs              = 0;
+    std::size_t                iters_per_epoch     = 0;
+    std::size_t                total_iters         = 0;
+    bool                       batch_mode          = false;
+    double                     min_ns              = 0;
+    double                     max_ns              = 0;
+    double                     median_ns           = 0;
+    double                     mean_ns             = 0;
+    double                     stddev_ns           = 0;
+    double                     p05_ns              = 0;
+    double                     p95_ns              = 0;
+    double                     p99_ns              = 0;
+    double                     p999_ns             = 0;
+    double                     p9999_ns            = 0;
+    double                     overhead_mean_ns    = 0;
+    double                     overhead_sd_ns      = 0;
+    double                     overhead_ratio_pct  = 0;
+    double                     total_time_s        = 0;
+    double                     warmup_time_s       = 0;
+    double                     wall_time_s         = 0;
+    double                     calibration_time_s  = 0;
+    std::size_t                calibration_iters   = 0;
+    JitterClockMode            clock               = JitterClockMode::Steady;
+    JitterClockMode            clock_requested     = JitterClockMode::Steady;
+    double                     clock_overhead_ns   = 0;
+    double                     clock_resolution_ns = 0;
+    int                        histogram_bins      = 0;
     gentest::detail::Histogram histogram;
-    std::vector<double>        samples_ns;
+    // Every sample is accumulated here; `samples_ns` is only filled when raw
+    // values are needed (Allure sample attachments).
+    gentest::detail::LogLinearHistogram sample_histogram;
+    std::vector<double>                 samples_ns;
 };
 
 struct BenchReportRow {
     const gentest::Case *c = nullptr;
     BenchResult          result{};
+    // Set when both cache states were measured; `result` then holds the warm run.
+    std::optional<BenchResult> cold{};
 };
 
 struct JitterReportRow {
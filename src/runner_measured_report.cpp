@@ -1,6 +1,7 @@
 #include "runner_measured_report.h"
 
 #include "gentest/detail/bench_stats.h"
+#include "runner_measured_clock.h"
 #include "runner_measured_format.h"
 
 #include <algorithm>
@@ -11,6 +12,7 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tabulate/table.hpp>
@@ -60,6 +62,8 @@ double total_items(const BenchResult &result, const gentest::Case &c) {
     return static_cast<double>(result.total_iters) * static_cast<double>(case_items_per_call(c));
 }
 
+std::string_view bench_cache_name(const BenchResult &result) { return result.cold_cache ? "cold" : "warm"; }
+
 double total_items(const JitterResult &result, const gentest::Case &c) {
     return static_cast<double>(result.total_iters) * static_cast<double>(case_items_per_call(c));
 }
@@ -103,6 +107,34 @@ MachineField machine_optional_pct(std::string key, bool present, double value) {
 
 MachineRow machine_row(std::initializer_list<MachineField> fields) { return MachineRow{.fields = std::vector<MachineField>(fields)}; }
 
+template <typename T> MachineField machine_optional(std::string key, const std::optional<T> &value) {
+    if (!value) {
+        return machine_null(std::move(key));
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+        return machine_bool(std::move(key), *value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return machine_string(std::move(key), *value);
+    } else {
+        return machine_number(std::move(key), static_cast<double>(*value));
+    }
+}
+
+MachineRow environment_machine_row(const BenchEnvironment &env) {
+    return machine_row({
+        machine_optional("cpu_governor", env.cpu_governor),
+        machine_optional("no_turbo", env.no_turbo),
+        machine_optional("smt_active", env.smt_active),
+        machine_optional("loadavg_1m", env.loadavg_1m),
+        machine_optional("loadavg_5m", env.loadavg_5m),
+        machine_optional("loadavg_15m", env.loadavg_15m),
+        machine_optional("aslr", env.aslr),
+        env.online_cpus != 0 ? machine_count("online_cpus", env.online_cpus) : machine_null("online_cpus"),
+        machine_optional("pinned_cpu", env.pinned_cpu),
+        env.pinned_cpu ? machine_string("pinned_cpu_siblings", env.pinned_cpu_siblings) : machine_null("pinned_cpu_siblings"),
+    });
+}
+
 std::string time_header(std::string_view label, std::string_view denominator, TimeUnitMode mode) {
     if (mode == TimeUnitMode::Ns) {
         return fmt::format("{} (ns/{})", label, denominator);
@@ -254,8 +286,13 @@ void print_csv_record(std::initializer_list<std::string_view> cells) {
     std::cout << "\n";
 }
 
-void print_csv_report(std::span<const ReportTable> tables, std::span<const MeasuredReportIssue> issues) {
+void print_csv_report(std::span<const ReportTable> tables, std::span<const MeasuredReportIssue> issues, const MachineRow *environment) {
     print_csv_record({"report", "table", "row", "field", "type", "value"});
+    if (environment != nullptr) {
+        for (const auto &field : environment->fields) {
+            print_csv_record({"measured", "environment", "0", field.key, machine_kind_name(field.kind), field.value});
+        }
+    }
     for (const auto &table : tables) {
         const auto  table_id = table.id.empty() ? table.title : table.id;
         const auto  report   = table.report.empty() ? std::string_view("measured") : std::string_view(table.report);
@@ -289,8 +326,27 @@ void print_json_field_value(const MachineField &field) {
     }
 }
 
-void print_json_report(std::string_view report_name, std::span<const ReportTable> tables, std::span<const MeasuredReportIssue> issues) {
-    std::cout << R"({"report":")" << escape_json_string(report_name) << R"(","tables":[)";
+void print_json_object(const MachineRow &row) {
+    std::cout << '{';
+    for (std::size_t field_idx = 0; field_idx < row.fields.size(); ++field_idx) {
+        if (field_idx != 0) {
+            std::cout << ',';
+        }
+        const auto &field = row.fields[field_idx];
+        std::cout << '"' << escape_json_string(field.key) << R"(":)";
+        print_json_field_value(field);
+    }
+    std::cout << '}';
+}
+
+void print_json_report(std::string_view report_name, std::span<const ReportTable> tables, std::span<const MeasuredReportIssue> issues,
+                       const MachineRow *environment) {
+    std::cout << R"({"report":")" << escape_json_string(report_name) << '"';
+    if (environment != nullptr) {
+        std::cout << R"(,"environment":)";
+        print_json_object(*environment);
+    }
+    std::cout << R"(,"tables":[)";
     for (std::size_t table_idx = 0; table_idx < tables.size(); ++table_idx) {
         const auto &table = tables[table_idx];
         if (table_idx != 0) {
@@ -304,17 +360,7 @@ void print_json_report(std::string_view report_name, std::span<const ReportTable
             if (row_idx != 0) {
                 std::cout << ',';
             }
-            std::cout << '{';
-            const auto &row = table.machine_rows[row_idx];
-            for (std::size_t field_idx = 0; field_idx < row.fields.size(); ++field_idx) {
-                if (field_idx != 0) {
-                    std::cout << ',';
-                }
-                const auto &field = row.fields[field_idx];
-                std::cout << '"' << escape_json_string(field.key) << R"(":)";
-                print_json_field_value(field);
-            }
-            std::cout << '}';
+            print_json_object(table.machine_rows[row_idx]);
         }
         std::cout << "]}";
     }
@@ -332,12 +378,12 @@ void print_json_report(std::string_view report_name, std::span<const ReportTable
 }
 
 void print_report(std::string_view report_name, std::span<const ReportTable> tables, MeasuredReportFormat format,
-                  std::span<const MeasuredReportIssue> issues = {}) {
+                  std::span<const MeasuredReportIssue> issues = {}, const MachineRow *environment = nullptr) {
     switch (format) {
     case MeasuredReportFormat::Table: print_table_report(tables); break;
     case MeasuredReportFormat::Markdown: print_markdown_report(tables); break;
-    case MeasuredReportFormat::Csv: print_csv_report(tables, issues); break;
-    case MeasuredReportFormat::Json: print_json_report(report_name, tables, issues); break;
+    case MeasuredReportFormat::Csv: print_csv_report(tables, issues, environment); break;
+    case MeasuredReportFormat::Json: print_json_report(report_name, tables, issues, environment); break;
     }
 }
 
@@ -502,13 +548,14 @@ std::string make_jitter_histogram_svg(const gentest::Case &c, std::span<const ge
         first_lo, last_hi, height - 6.0, bins.size(), max_count);
 }
 
-std::string make_samples_json(std::span<const double> samples_ns) {
+std::string make_samples_json(std::span<const double> samples_ns, std::size_t sample_count) {
     constexpr std::size_t kMaxStoredSamples = 2048;
 
+    const std::size_t  total_count  = std::max(sample_count, samples_ns.size());
     const std::size_t  stored_count = std::min(samples_ns.size(), kMaxStoredSamples);
     fmt::memory_buffer out;
-    fmt::format_to(std::back_inserter(out), R"({{"sample_count":{},"stored_count":{},"truncated":{},"samples_ns":[)", samples_ns.size(),
-                   stored_count, (samples_ns.size() > stored_count) ? "true" : "false");
+    fmt::format_to(std::back_inserter(out), R"({{"sample_count":{},"stored_count":{},"truncated":{},"samples_ns":[)", total_count,
+                   stored_count, (total_count > stored_count) ? "true" : "false");
     if (stored_count == 0) {
         out.push_back(']');
         out.push_back('}');
@@ -533,7 +580,8 @@ const gentest::detail::Histogram &select_jitter_histogram(const JitterResult &re
     if (result.histogram_bins == bins) {
         return result.histogram;
     }
-    fallback_histogram = gentest::detail::compute_histogram(result.samples_ns, bins);
+    fallback_histogram = result.samples_ns.empty() ? result.sample_histogram.histogram(bins)
+                                                   : gentest::detail::compute_histogram(result.samples_ns, bins);
     return fallback_histogram;
 }
 
@@ -592,6 +640,9 @@ std::vector<ReportAttachment> make_bench_allure_attachments(const gentest::Case
     append_tsv_metric(metrics, "wall_time_s", result.wall_time_s);
     append_tsv_metric(metrics, "calibration_time_s", result.calibration_time_s);
     append_tsv_metric(metrics, "calibration_iters", result.calibration_iters);
+    append_tsv_metric(metrics, "cache", bench_cache_name(result));
+    append_tsv_metric(metrics, "evictions", result.evictions);
+    append_tsv_metric(metrics, "eviction_time_s", result.eviction_time_s);
     const double calls_per_sec =
         (result.total_time_s > 0.0 && result.total_iters != 0) ? (static_cast<double>(result.total_iters) / result.total_time_s) : 0.0;
     append_tsv_metric(metrics, "calls_per_sec", calls_per_sec);
@@ -624,7 +675,7 @@ std::vector<ReportAttachment> make_jitter_allure_attachments(const gentest::Case
     append_tsv_metric(metrics, "items_per_call", case_items_per_call(c));
     append_tsv_metric(metrics, "batch_mode", result.batch_mode ? "true" : "false");
     append_tsv_metric(metrics, "epochs", result.epochs);
-    append_tsv_metric(metrics, "samples", result.samples_ns.size());
+    append_tsv_metric(metrics, "samples", result.sample_histogram.count());
     append_tsv_metric(metrics, "iters_per_epoch", result.iters_per_epoch);
     append_tsv_metric(metrics, "total_iters", result.total_iters);
     append_tsv_metric(metrics, "total_items", total_items(result, c));
@@ -649,9 +700,20 @@ std::vector<ReportAttachment> make_jitter_allure_attachments(const gentest::Case
     append_tsv_metric(metrics, "p95_ns_per_op", result.p95_ns);
     append_tsv_metric(metrics, "p95_ns_per_call", result.p95_ns);
     append_tsv_metric(metrics, "p95_ns_per_item", per_item_ns(result.p95_ns, c));
+    append_tsv_metric(metrics, "p99_ns_per_call", result.p99_ns);
+    append_tsv_metric(metrics, "p99_ns_per_item", per_item_ns(result.p99_ns, c));
+    append_tsv_metric(metrics, "p999_ns_per_call", result.p999_ns);
+    append_tsv_metric(metrics, "p999_ns_per_item", per_item_ns(result.p999_ns, c));
+    append_tsv_metric(metrics, "p9999_ns_per_call", result.p9999_ns);
+    append_tsv_metric(metrics, "p9999_ns_per_item", per_item_ns(result.p9999_ns, c));
+    append_tsv_metric(metrics, "hdr_significant_digits", result.sample_histogram.significant_digits());
     append_tsv_metric(metrics, "overhead_mean_ns_per_iter", result.overhead_mean_ns);
     append_tsv_metric(metrics, "overhead_sd_ns_per_iter", result.overhead_sd_ns);
     append_tsv_metric(metrics, "overhead_ratio_pct", result.overhead_ratio_pct);
+    append_tsv_metric(metrics, "clock", jitter_clock_name(result.clock));
+    append_tsv_metric(metrics, "clock_requested", jitter_clock_name(result.clock_requested));
+    append_tsv_metric(metrics, "clock_overhead_ns", result.clock_overhead_ns);
+    append_tsv_metric(metrics, "clock_resolution_ns", result.clock_resolution_ns);
     append_tsv_metric(metrics, "total_time_s", result.total_time_s);
     append_tsv_metric(metrics, "warmup_time_s", result.warmup_time_s);
     append_tsv_metric(metrics, "wall_time_s", result.wall_time_s);
@@ -691,12 +753,116 @@ std::vector<ReportAttachment> make_jitter_allure_attachments(const gentest::Case
         .name           = "samples",
         .mime_type      = "application/json",
         .file_extension = ".json",
-        .contents       = make_samples_json(result.samples_ns),
+        .contents       = make_samples_json(result.samples_ns, result.sample_histogram.count()),
     });
 
     return attachments;
 }
 
+// Warm and cold results side by side for benches measured in both cache states.
+static ReportTable build_bench_cache_table(std::span<const BenchReportRow> rows, const CliOptions &opt) {
+    ReportTable table{
+        .title  = "Bench cache",
+        .id     = "bench.cache",
+        .report = "bench",
+        .headers =
+            {
+                "Benchmark",
+                time_header("Warm median", "item", opt.time_unit_mode),
+                time_header("Cold median", "item", opt.time_unit_mode),
+                "Cold/warm",
+                time_header("Cold P95", "item", opt.time_unit_mode),
+                "Evictions",
+                "Evict buffer",
+            },
+        .right_align = {false, true, true, true, true, true, true},
+    };
+    for (const auto &row : rows) {
+        if (!row.c || !row.cold)
+            continue;
+        const double warm_ns  = per_item_ns(row.result.median_ns, *row.c);
+        const double cold_ns  = per_item_ns(row.cold->median_ns, *row.c);
+        const bool   has_warm = warm_ns > 0.0;
+        const double ratio    = has_warm ? cold_ns / warm_ns : 0.0;
+        table.rows.push_back({
+            std::string(row.c->name),
+            format_report_time_ns(warm_ns, opt.time_unit_mode),
+            format_report_time_ns(cold_ns, opt.time_unit_mode),
+            has_warm ? fmt::format("{:.2f}x", ratio) : std::string("-"),
+            format_report_time_ns(per_item_ns(row.cold->p95_ns, *row.c), opt.time_unit_mode),
+            fmt::format("{}", row.cold->evictions),
+            fmt::format("{} MiB", row.cold->evict_buffer_bytes >> 20),
+        });
+        table.machine_rows.push_back(machine_row({
+            machine_string("benchmark", row.c->name),
+            machine_string("suite", row.c->suite),
+            machine_number("warm_median_ns_per_item", warm_ns),
+            machine_number("cold_median_ns_per_item", cold_ns),
+            has_warm ? machine_number("cold_warm_ratio", ratio) : machine_null("cold_warm_ratio"),
+            machine_number("cold_p95_ns_per_item", per_item_ns(row.cold->p95_ns, *row.c)),
+            machine_count("cold_samples", row.cold->epochs),
+            machine_count("evictions", row.cold->evictions),
+            machine_number("eviction_time_s", row.cold->eviction_time_s),
+            machine_count("evict_buffer_bytes", row.cold->evict_buffer_bytes),
+        }));
+    }
+    return table;
+}
+
+// Groups complexity(n) benches by series (the case name with the size argument
+// replaced by its parameter name) and fits per-item medians against n.
+static ReportTable build_bench_complexity_table(std::span<const BenchReportRow> rows, const CliOptions &opt) {
+    struct SeriesPoints {
+        std::string_view    suite;
+        std::vector<double> sizes;
+        std::vector<double> times_ns;
+    };
+    std::map<std::string, SeriesPoints, std::less<>> series;
+    for (const auto &row : rows) {
+        if (!row.c || row.c->complexity_series.empty())
+            continue;
+        auto &points = series[std::string(row.c->complexity_series)];
+        points.suite = row.c->suite;
+        points.sizes.push_back(row.c->complexity_n);
+        points.times_ns.push_back(per_item_ns(row.result.median_ns, *row.c));
+    }
+
+    ReportTable table{
+        .title  = "Bench complexity",
+        .id     = "bench.complexity",
+        .report = "bench",
+        .headers =
+            {
+                "Series",
+                "Points",
+                "Best fit",
+                time_header("Coefficient", "item", opt.time_unit_mode),
+                "RMS %",
+            },
+        .right_align = {false, true, false, true, true},
+    };
+    for (const auto &[name, points] : series) {
+        const auto fit      = gentest::detail::fit_complexity(points.sizes, points.times_ns);
+        const auto best_fit = gentest::detail::complexity_class_name(fit.best_fit);
+        table.rows.push_back({
+            name,
+            fmt::format("{}", fit.points),
+            std::string(best_fit),
+            format_report_time_ns(fit.coefficient, opt.time_unit_mode),
+            fmt::format("{:.2f}", fit.rms_pct),
+        });
+        table.machine_rows.push_back(machine_row({
+            machine_string("series", name),
+            machine_string("suite", points.suite),
+            machine_count("points", fit.points),
+            machine_string("best_fit", best_fit),
+            machine_number("coefficient_ns_per_item", fit.coefficient),
+            machine_number("rms_pct", fit.rms_pct),
+        }));
+    }
+    return table;
+}
+
 static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchReportRow> rows, const CliOptions &opt) {
     std::map<std::string, double> baseline_ns;
     for (const auto &row : rows) {
@@ -724,6 +890,7 @@ static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchR
                 "Samples",
                 "Iters/epoch",
                 "Items/call",
+                "Cache",
                 time_header("Median", "item", opt.time_unit_mode),
                 time_header("Mean", "item", opt.time_unit_mode),
                 time_header("P05", "item", opt.time_unit_mode),
@@ -732,7 +899,7 @@ static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchR
                 time_header_s("Total", opt.time_unit_mode),
                 "Baseline Δ%",
             },
-        .right_align = {false, true, true, true, true, true, true, true, true, true, true},
+        .right_align = {false, true, true, true, false, true, true, true, true, true, true, true},
     };
 
     for (const auto &row : rows) {
@@ -750,6 +917,7 @@ static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchR
             fmt::format("{}", row.result.epochs),
             fmt::format("{}", row.result.iters_per_epoch),
             fmt::format("{}", case_items_per_call(*row.c)),
+            std::string(bench_cache_name(row.result)),
             format_report_time_ns(median_item_ns, opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.mean_ns, *row.c), opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.p05_ns, *row.c), opt.time_unit_mode),
@@ -765,6 +933,7 @@ static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchR
             machine_count("samples", row.result.epochs),
             machine_count("iters_per_epoch", row.result.iters_per_epoch),
             machine_count("items_per_call", case_items_per_call(*row.c)),
+            machine_string("cache", bench_cache_name(row.result)),
             machine_number("median_ns_per_item", median_item_ns),
             machine_number("mean_ns_per_item", per_item_ns(row.result.mean_ns, *row.c)),
             machine_number("p05_ns_per_item", per_item_ns(row.result.p05_ns, *row.c)),
@@ -848,6 +1017,12 @@ static std::vector<ReportTable> build_bench_report_tables(std::span<const BenchR
     std::vector<ReportTable> tables;
     tables.push_back(std::move(summary));
     tables.push_back(std::move(debug));
+    if (auto cache = build_bench_cache_table(rows, opt); !cache.rows.empty()) {
+        tables.push_back(std::move(cache));
+    }
+    if (auto complexity = build_bench_complexity_table(rows, opt); !complexity.rows.empty()) {
+        tables.push_back(std::move(complexity));
+    }
     return tables;
 }
 
@@ -880,13 +1055,14 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
                 time_header("StdDev", "item", opt.time_unit_mode),
                 time_header("P05", "item", opt.time_unit_mode),
                 time_header("P95", "item", opt.time_unit_mode),
+                time_header("P99", "item", opt.time_unit_mode),
                 time_header("Min", "item", opt.time_unit_mode),
                 time_header("Max", "item", opt.time_unit_mode),
                 time_header_s("Total", opt.time_unit_mode),
                 "Baseline Δ%",
                 "Baseline SD Δ%",
             },
-        .right_align = {false, true, true, true, true, true, true, true, true, true, true, true, true},
+        .right_align = {false, true, true, true, true, true, true, true, true, true, true, true, true, true},
     };
 
     for (const auto &row : rows) {
@@ -907,13 +1083,14 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
         const std::string baseline_sd_cell       = has_baseline_sd ? fmt::format("{:+.2f}%", baseline_sd_delta_pct) : std::string("-");
         summary.rows.push_back({
             std::string(row.c->name),
-            fmt::format("{}", row.result.samples_ns.size()),
+            fmt::format("{}", row.result.sample_histogram.count()),
             fmt::format("{}", case_items_per_call(*row.c)),
             format_report_time_ns(median_item_ns, opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.mean_ns, *row.c), opt.time_unit_mode),
             format_report_time_ns(sd_item_ns, opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.p05_ns, *row.c), opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.p95_ns, *row.c), opt.time_unit_mode),
+            format_report_time_ns(per_item_ns(row.result.p99_ns, *row.c), opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.min_ns, *row.c), opt.time_unit_mode),
             format_report_time_ns(per_item_ns(row.result.max_ns, *row.c), opt.time_unit_mode),
             format_report_time_s(row.result.wall_time_s, opt.time_unit_mode),
@@ -924,13 +1101,16 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
             machine_string("benchmark", row.c->name),
             machine_string("suite", row.c->suite),
             machine_bool("is_baseline", row.c->is_baseline),
-            machine_count("samples", row.result.samples_ns.size()),
+            machine_count("samples", row.result.sample_histogram.count()),
             machine_count("items_per_call", case_items_per_call(*row.c)),
             machine_number("median_ns_per_item", median_item_ns),
             machine_number("mean_ns_per_item", per_item_ns(row.result.mean_ns, *row.c)),
             machine_number("stddev_ns_per_item", sd_item_ns),
             machine_number("p05_ns_per_item", per_item_ns(row.result.p05_ns, *row.c)),
             machine_number("p95_ns_per_item", per_item_ns(row.result.p95_ns, *row.c)),
+            machine_number("p99_ns_per_item", per_item_ns(row.result.p99_ns, *row.c)),
+            machine_number("p999_ns_per_item", per_item_ns(row.result.p999_ns, *row.c)),
+            machine_number("p9999_ns_per_item", per_item_ns(row.result.p9999_ns, *row.c)),
             machine_number("min_ns_per_item", per_item_ns(row.result.min_ns, *row.c)),
             machine_number("max_ns_per_item", per_item_ns(row.result.max_ns, *row.c)),
             machine_number("wall_time_s", row.result.wall_time_s),
@@ -948,6 +1128,8 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
             {
                 "Benchmark",
                 "Mode",
+                "Clock",
+                time_header("Clock res", "tick", opt.time_unit_mode),
                 "Samples",
                 "Iters/epoch",
                 "Items/call",
@@ -959,13 +1141,17 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
                 time_header_s("Max total", opt.time_unit_mode),
                 time_header_s("Wall", opt.time_unit_mode),
             },
-        .right_align = {false, false, true, true, true, true, true, true, true, true, true, true},
+        .right_align = {false, false, false, true, true, true, true, true, true, true, true, true, true, true},
     };
 
     for (const auto &row : rows) {
         if (!row.c)
             continue;
-        const std::string mode = row.result.batch_mode ? "batch" : "per-call";
+        const std::string mode  = row.result.batch_mode ? "batch" : "per-call";
+        const std::string clock = std::string(jitter_clock_name(row.result.clock));
+        const std::string clock_res =
+            (row.result.clock_resolution_ns > 0.0) ? format_report_time_ns(row.result.clock_resolution_ns, opt.time_unit_mode)
+                                                   : std::string("-");
         const std::string overhead_cell =
             (row.result.overhead_mean_ns > 0.0)
                 ? fmt::format("{} +/- {}", format_report_time_ns(row.result.overhead_mean_ns, opt.time_unit_mode),
@@ -976,7 +1162,9 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
         debug.rows.push_back({
             std::string(row.c->name),
             mode,
-            fmt::format("{}", row.result.samples_ns.size()),
+            clock,
+            clock_res,
+            fmt::format("{}", row.result.sample_histogram.count()),
             fmt::format("{}", row.result.iters_per_epoch),
             fmt::format("{}", case_items_per_call(*row.c)),
             overhead_cell,
@@ -992,7 +1180,12 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
             machine_string("suite", row.c->suite),
             machine_string("mode", mode),
             machine_bool("batch_mode", row.result.batch_mode),
-            machine_count("samples", row.result.samples_ns.size()),
+            machine_string("clock", clock),
+            machine_string("clock_requested", jitter_clock_name(row.result.clock_requested)),
+            machine_number("clock_overhead_ns", row.result.clock_overhead_ns),
+            machine_number("clock_resolution_ns", row.result.clock_resolution_ns),
+            machine_count("hdr_significant_digits", row.result.sample_histogram.significant_digits()),
+            machine_count("samples", row.result.sample_histogram.count()),
             machine_count("iters_per_epoch", row.result.iters_per_epoch),
             machine_count("items_per_call", case_items_per_call(*row.c)),
             machine_number("overhead_mean_ns_per_call", row.result.overhead_mean_ns),
@@ -1046,7 +1239,7 @@ static std::vector<ReportTable> build_jitter_report_tables(std::span<const Jitte
             .right_align = {true, false, true, true, true},
         };
 
-        const auto  total_samples    = static_cast<double>(row.result.samples_ns.size());
+        const auto  total_samples    = static_cast<double>(row.result.sample_histogram.count());
         std::size_t cumulative_count = 0;
         for (std::size_t i = 0; i < scaled_bins.size(); ++i) {
             const auto &bin = scaled_bins[i];
@@ -1098,7 +1291,8 @@ void print_jitter_report(std::span<const JitterReportRow> rows, const CliOptions
 }
 
 void print_measured_report(std::span<const BenchReportRow> bench_rows, std::span<const JitterReportRow> jitter_rows, const CliOptions &opt,
-                           std::span<const MeasuredReportIssue> issues, bool include_bench_report, bool include_jitter_report) {
+                           std::span<const MeasuredReportIssue> issues, bool include_bench_report, bool include_jitter_report,
+                           const BenchEnvironment *environment) {
     include_bench_report  = include_bench_report || !bench_rows.empty();
     include_jitter_report = include_jitter_report || !jitter_rows.empty();
 
@@ -1118,7 +1312,11 @@ void print_measured_report(std::span<const BenchReportRow> bench_rows, std::span
     } else if (!include_bench_report && include_jitter_report) {
         report_name = "jitter";
     }
-    print_report(report_name, tables, opt.measured_report_format, issues);
+    std::optional<MachineRow> environment_row;
+    if (environment != nullptr) {
+        environment_row = environment_machine_row(*environment);
+    }
+    print_report(report_name, tables, opt.measured_report_format, issues, environment_row ? &*environment_row : nullptr);
 }
 
 } // namespace gentest::runner
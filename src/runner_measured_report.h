@@ -2,6 +2,7 @@
 
 #include "gentest/runner.h"
 #include "runner_cli.h"
+#include "runner_measured_environment.h"
 #include "runner_measured_executor.h"
 #include "runner_result_model.h"
 
@@ -22,7 +23,7 @@ void print_bench_report(std::span<const BenchReportRow> rows, const CliOptions &
 void print_jitter_report(std::span<const JitterReportRow> rows, const CliOptions &opt);
 void print_measured_report(std::span<const BenchReportRow> bench_rows, std::span<const JitterReportRow> jitter_rows, const CliOptions &opt,
                            std::span<const MeasuredReportIssue> issues = {}, bool include_bench_report = false,
-                           bool include_jitter_report = false);
+                           bool include_jitter_report = false, const BenchEnvironment *environment = nullptr);
 std::vector<ReportAttachment> make_bench_allure_attachments(const gentest::Case &c, const BenchResult &result);
 std::vector<ReportAttachment> make_jitter_allure_attachments(const gentest::Case &c, const JitterResult &result, int bins);
 
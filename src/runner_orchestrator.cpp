@@ -1,5 +1,6 @@
 #include "runner_orchestrator.h"
 
+#include "gentest/async.h"
 #include "runner_fixture_runtime.h"
 #include "runner_measured_executor.h"
 #include "runner_measured_report.h"
@@ -13,6 +14,7 @@
 #include <cstdio>
 #include <fmt/format.h>
 #include <map>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -25,29 +27,53 @@ using Outcome         = gentest::runner::Outcome;
 using RunResult       = gentest::runner::RunResult;
 using SelectionStatus = gentest::runner::SelectionStatus;
 
+// Owns the shared fixture lifetime of one run, or borrows warm fixtures from
+// `--serve`, in which case teardown only happens when setup failed.
 struct SharedFixtureRunGuard {
     gentest::runner::detail::SharedFixtureRuntimeSession session{};
+    gentest::runner::detail::WarmSharedFixtures         *warm        = nullptr;
     bool                                                 setup_ok    = true;
     bool                                                 teardown_ok = true;
     bool                                                 finalized   = false;
     std::vector<std::string>                             setup_errors;
     std::vector<std::string>                             teardown_errors;
 
-    SharedFixtureRunGuard() { setup_ok = gentest::runner::detail::setup_shared_fixture_runtime(setup_errors, session); }
+    explicit SharedFixtureRunGuard(gentest::runner::detail::WarmSharedFixtures *warm_fixtures) : warm(warm_fixtures) {
+        setup_ok = warm ? warm->ensure_setup(setup_errors) : gentest::runner::detail::setup_shared_fixture_runtime(setup_errors, session);
+    }
 
     void finalize() {
         if (!finalized) {
-            teardown_ok = gentest::runner::detail::teardown_shared_fixture_runtime(teardown_errors, session);
-            finalized   = true;
+            if (!warm) {
+                teardown_ok = gentest::runner::detail::teardown_shared_fixture_runtime(teardown_errors, session);
+            } else if (!setup_ok) {
+                teardown_ok = warm->release(teardown_errors);
+            }
+            finalized = true;
         }
     }
 
     bool ok() const { return setup_ok && teardown_ok; }
-    bool gate_rejected() const { return session.gate_rejected; }
+    bool gate_rejected() const { return warm ? warm->session.gate_rejected : session.gate_rejected; }
 
     ~SharedFixtureRunGuard() { finalize(); }
 };
 
+// Applies --async-virtual-time to async fixture hooks, which run outside the
+// batch scheduler, for the duration of one run.
+class BlockingVirtualTimeScope {
+  public:
+    explicit BlockingVirtualTimeScope(bool enabled) : previous_(gentest::detail::set_blocking_async_virtual_time(enabled)) {}
+
+    BlockingVirtualTimeScope(const BlockingVirtualTimeScope &)            = delete;
+    BlockingVirtualTimeScope &operator=(const BlockingVirtualTimeScope &) = delete;
+
+    ~BlockingVirtualTimeScope() { (void)gentest::detail::set_blocking_async_virtual_time(previous_); }
+
+  private:
+    bool previous_;
+};
+
 struct OrchestratorState {
     bool                                              color_output   = true;
     bool                                              record_results = false;
@@ -284,6 +310,28 @@ void record_runner_level_failure(OrchestratorState &state, std::string_view name
     gentest::runner::record_runner_level_failure(state.acc, name, std::move(message));
 }
 
+// Pins the measuring thread when requested and snapshots the host state that
+// the measured report embeds. Table/markdown runs print findings up front so
+// they sit next to the numbers they may have skewed. A requested pin that
+// cannot be applied is a runner-level failure and yields no environment, so
+// the caller skips the measured phases instead of measuring unpinned.
+std::optional<BenchEnvironment> prepare_measured_environment(OrchestratorState &state, const CliOptions &opt, ScopedCpuPin &pin) {
+    if (opt.bench_pin_cpu >= 0) {
+        std::string error;
+        if (!pin.pin(opt.bench_pin_cpu, error)) {
+            record_runner_level_failure(state, "gentest/bench_pin_cpu", fmt::format("--bench-pin-cpu={}: {}", opt.bench_pin_cpu, error));
+            return std::nullopt;
+        }
+    }
+    BenchEnvironment env = probe_bench_environment(pin.cpu());
+    if (opt.measured_report_format == MeasuredReportFormat::Table || opt.measured_report_format == MeasuredReportFormat::Markdown) {
+        for (const auto &warning : bench_environment_warnings(env)) {
+            fmt::print(stderr, "warning: bench environment: {}\n", warning);
+        }
+    }
+    return env;
+}
+
 RunResult make_measured_failure_result(const MeasurementCaseFailure &failure, std::string_view failure_message) {
     RunResult result;
     if (failure.skipped) {
@@ -466,7 +514,8 @@ std::string format_run_summary(const TestCounters &counters, const TimedRunStatu
     return fmt::to_string(summary);
 }
 
-int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt, const SelectionResult &selection, bool has_selection) {
+int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt, const SelectionResult &selection, bool has_selection,
+                  gentest::runner::detail::WarmSharedFixtures *warm_fixtures) {
     const auto &test_idxs   = selection.test_idxs;
     const auto &bench_idxs  = selection.bench_idxs;
     const auto &jitter_idxs = selection.jitter_idxs;
@@ -475,8 +524,9 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
     state.color_output   = opt.color_output;
     state.record_results = (opt.junit_path != nullptr) || (opt.allure_dir != nullptr);
 
-    SharedFixtureRunGuard fixture_guard;
-    TestCounters          counters;
+    BlockingVirtualTimeScope virtual_time_scope(opt.async_virtual_time);
+    SharedFixtureRunGuard    fixture_guard(warm_fixtures);
+    TestCounters             counters;
 
     if (!fixture_guard.setup_ok) {
         for (const auto &message : fixture_guard.setup_errors) {
@@ -488,11 +538,16 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
     bool tests_stopped = false;
     if (!fixture_runtime_blocked && !test_idxs.empty()) {
         TestRunContext test_state{};
-        test_state.color_output   = state.color_output;
-        test_state.record_results = state.record_results;
-        test_state.async_log_tail = opt.async_log_tail;
-        test_state.acc            = &state.acc;
-        const auto test_plans     = gentest::runner::build_suite_execution_plan(
+        test_state.color_output       = state.color_output;
+        test_state.record_results     = state.record_results;
+        test_state.async_log_tail     = opt.async_log_tail;
+        test_state.async_workers      = opt.async_workers;
+        test_state.async_virtual_time = opt.async_virtual_time;
+        test_state.async_alloc_stats  = opt.async_alloc_stats;
+        test_state.async_timer_wheel  = opt.async_timer_wheel;
+        test_state.async_live_diff    = opt.async_live_diff;
+        test_state.acc                = &state.acc;
+        const auto test_plans         = gentest::runner::build_suite_execution_plan(
             kCases, std::span<const std::size_t>{test_idxs.data(), test_idxs.size()}, opt.shuffle, opt.shuffle_seed);
 
         if (opt.shuffle && !has_selection)
@@ -506,11 +561,18 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
         }
     }
 
-    TimedRunStatus               bench_status{};
-    TimedRunStatus               jitter_status{};
-    std::vector<BenchReportRow>  bench_report_rows;
-    std::vector<JitterReportRow> jitter_report_rows;
-    if (!fixture_runtime_blocked && !(opt.fail_fast && tests_stopped)) {
+    TimedRunStatus                  bench_status{};
+    TimedRunStatus                  jitter_status{};
+    std::vector<BenchReportRow>     bench_report_rows;
+    std::vector<JitterReportRow>    jitter_report_rows;
+    ScopedCpuPin                    measured_pin;
+    std::optional<BenchEnvironment> measured_environment;
+    bool                            measured_blocked = false;
+    if (!fixture_runtime_blocked && !(opt.fail_fast && tests_stopped) && (!bench_idxs.empty() || !jitter_idxs.empty())) {
+        measured_environment = prepare_measured_environment(state, opt, measured_pin);
+        measured_blocked     = !measured_environment.has_value();
+    }
+    if (!fixture_runtime_blocked && !measured_blocked && !(opt.fail_fast && tests_stopped)) {
         bench_status = gentest::runner::run_selected_benches(
             kCases, std::span<const std::size_t>{bench_idxs.data(), bench_idxs.size()}, opt, opt.fail_fast,
             [&](const gentest::Case &measured, const gentest::runner::BenchResult &result) {
@@ -525,7 +587,7 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
             },
             &bench_report_rows);
     }
-    if (!fixture_runtime_blocked && !(opt.fail_fast && (tests_stopped || bench_status.stopped))) {
+    if (!fixture_runtime_blocked && !measured_blocked && !(opt.fail_fast && (tests_stopped || bench_status.stopped))) {
         jitter_status = gentest::runner::run_selected_jitters(
             kCases, std::span<const std::size_t>{jitter_idxs.data(), jitter_idxs.size()}, opt, opt.fail_fast,
             [&](const gentest::Case &measured, const gentest::runner::JitterResult &result) {
@@ -584,7 +646,7 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
         const bool include_jitter_report =
             (jitter_status.total != 0) || (machine_measured_report && measured_only_selection && !jitter_idxs.empty());
         gentest::runner::print_measured_report(bench_report_rows, jitter_report_rows, opt, issues, include_bench_report,
-                                               include_jitter_report);
+                                               include_jitter_report, measured_environment ? &*measured_environment : nullptr);
     }
 
     if (!selection.idxs.empty() || !state.acc.failure_items.empty()) {
@@ -605,7 +667,7 @@ int run_execution(std::span<const gentest::Case> kCases, const CliOptions &opt,
 
 } // namespace
 
-int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &opt) {
+int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &opt, detail::WarmSharedFixtures *warm_fixtures) {
     constexpr int kExitCaseNotFound = 3;
 
     switch (opt.mode) {
@@ -623,9 +685,13 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
         fmt::print("  --list-death          List death test names (one per line)\n");
         fmt::print("  --list-benches        List benchmark/jitter names (one per line)\n");
         fmt::print("  --run=<name>          Run a single case by exact name\n");
+        fmt::print("  --run-list=<file>     Run the cases named in <file>, one exact name per line\n");
         fmt::print("  --filter=<pattern>    Run cases matching wildcard pattern (*, ?)\n");
         fmt::print("  --kind=<kind>         Restrict to kind: all|test|bench|jitter (default all)\n");
         fmt::print("  --include-death       Allow running tests tagged 'death'\n");
+        fmt::print("  --death-fork-server   Run the selected death tests in forked children of one warm process\n");
+        fmt::print("  --death-expect-substring=<text>  With --death-fork-server, require <text> in each death test's output\n");
+        fmt::print("  --death-timeout=<sec>  With --death-fork-server, fail a death test still running after <sec> (default 60)\n");
         fmt::print("  --no-color            Disable colorized output (also disabled for dumb/captured output)\n");
         fmt::print("  --github-annotations  Emit GitHub Actions annotations (::error ...) on failures\n");
         fmt::print("  --junit=<file>        Write JUnit XML report to file\n");
@@ -635,8 +701,16 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
         fmt::print("  --fail-fast           Stop after the first failing case\n");
         fmt::print("  --repeat=N            Repeat selected tests N times (default 1)\n");
         fmt::print("  --async-log-tail=N    Live async log lines per case (default 5, 0 disables)\n");
+        fmt::print("  --async-workers=N     Threads resuming async cases (default 1, 0 = hardware concurrency)\n");
+        fmt::print("  --async-virtual-time  Run every async case on a virtual clock (instant sleeps/timeouts)\n");
+        fmt::print("  --async-alloc-stats   Print per-case async frame pool allocation counts (debug)\n");
+        fmt::print("  --async-timer-queue=<kind> Async timer queue: heap|wheel (default heap)\n");
+        fmt::print("  --async-live-render=<mode> Live async panel refresh: redraw|diff (default redraw)\n");
         fmt::print("  --shuffle             Shuffle tests (respects fixture/grouping)\n");
         fmt::print("  --seed N              RNG seed used with --shuffle\n");
+        fmt::print("  --serve=<socket>      Set up shared fixtures once and serve runs from --connect clients\n");
+        fmt::print("  --connect=<socket>    Send the other options to a --serve process and print its output\n");
+        fmt::print("  --shutdown            With --connect, tear down the server's fixtures and stop it\n");
         fmt::print("\nBenchmark options:\n");
         fmt::print("  --bench-table         Print a summary table per suite (runs benches)\n");
         fmt::print("  --bench-min-epoch-time-s=<sec>  Minimum epoch time\n");
@@ -644,8 +718,12 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
         fmt::print("  --bench-warmup=<N>    Warmup epochs (default 1)\n");
         fmt::print("  --bench-min-total-time-s=<sec>  Min total time per benchmark (may exceed --bench-epochs)\n");
         fmt::print("  --bench-max-total-time-s=<sec>  Max total time per benchmark\n");
+        fmt::print("  --bench-cache-mode=<mode>  Cache state: auto|warm|cold|both (default auto: cache(...) attribute, else warm)\n");
+        fmt::print("  --bench-pin-cpu=<N>   Pin bench/jitter measuring threads to CPU N (Linux)\n");
         fmt::print("\nJitter options:\n");
         fmt::print("  --jitter-bins=<N>     Histogram bins (default 10)\n");
+        fmt::print("  --jitter-clock=<clock>  Sample clock: steady|tsc (default steady)\n");
+        fmt::print("  --jitter-hdr-digits=<N>  Sample histogram precision in significant digits, 1-5 (default 3)\n");
         return 0;
     case Mode::ListTests:
         for (const auto &t : kCases)
@@ -677,6 +755,9 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
             if (t.is_benchmark || t.is_jitter)
                 fmt::print("{}\n", t.name);
         return 0;
+    case Mode::Serve:
+    case Mode::Connect: fmt::print(stderr, "error: --serve/--connect cannot be used inside a served run\n"); return 1;
+    case Mode::DeathForkServer: fmt::print(stderr, "error: --death-fork-server cannot be used inside a served run\n"); return 1;
     case Mode::Execute: break;
     }
 
@@ -686,7 +767,7 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
 
     switch (selection.status) {
     case SelectionStatus::Ok: break;
-    case SelectionStatus::CaseNotFound: fmt::print(stderr, "Case not found: {}\n", opt.run_exact); return kExitCaseNotFound;
+    case SelectionStatus::CaseNotFound: fmt::print(stderr, "Case not found: {}\n", selection.missing_case); return kExitCaseNotFound;
     case SelectionStatus::KindMismatch:
         fmt::print(stderr, "Case '{}' does not match --kind={}\n", opt.run_exact, gentest::runner::kind_to_string(opt.kind));
         return 1;
@@ -752,7 +833,7 @@ int run_from_options(std::span<const gentest::Case> kCases, const CliOptions &op
                    selection.filtered_death);
     }
 
-    return run_execution(kCases, opt, selection, has_selection);
+    return run_execution(kCases, opt, selection, has_selection, warm_fixtures);
 }
 
 } // namespace gentest::runner
@@ -7,6 +7,12 @@
 
 namespace gentest::runner {
 
-int run_from_options(std::span<const gentest::Case> cases, const CliOptions &opt);
+namespace detail {
+struct WarmSharedFixtures;
+} // namespace detail
+
+// `warm_fixtures` is set by `--serve`; the run then reuses fixtures that are
+// already set up instead of owning their setup and teardown.
+int run_from_options(std::span<const gentest::Case> cases, const CliOptions &opt, detail::WarmSharedFixtures *warm_fixtures = nullptr);
 
 } // namespace gentest::runner
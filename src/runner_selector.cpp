@@ -3,6 +3,7 @@
 #include "runner_tag_utils.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace gentest::runner {
 
@@ -74,7 +75,7 @@ std::string_view kind_to_string(KindFilter kind) {
 SelectionResult select_cases(std::span<const gentest::Case> cases, const CliOptions &opt) {
     SelectionResult          result;
     std::vector<std::size_t> idxs;
-    result.has_selection = (opt.run_exact != nullptr) || (opt.filter_pat != nullptr);
+    result.has_selection = (opt.run_exact != nullptr) || (opt.filter_pat != nullptr) || !opt.run_list.empty();
 
     if (opt.run_exact) {
         const std::string_view exact = opt.run_exact;
@@ -113,7 +114,8 @@ SelectionResult select_cases(std::span<const gentest::Case> cases, const CliOpti
                     suffix_kind_matches.push_back(i);
             }
             if (suffix_matches.empty()) {
-                result.status = SelectionStatus::CaseNotFound;
+                result.status       = SelectionStatus::CaseNotFound;
+                result.missing_case = exact;
                 return result;
             }
             if (suffix_kind_matches.empty()) {
@@ -127,6 +129,24 @@ SelectionResult select_cases(std::span<const gentest::Case> cases, const CliOpti
             }
             idxs.push_back(suffix_kind_matches.front());
         }
+    } else if (!opt.run_list.empty()) {
+        // Exact names only: batched CTest entries must never pick up a case
+        // through suffix matching. Every case carrying a listed name runs.
+        std::unordered_set<std::string_view> wanted(opt.run_list.begin(), opt.run_list.end());
+        std::unordered_set<std::string_view> found;
+        for (std::size_t i = 0; i < cases.size(); ++i) {
+            if (wanted.contains(cases[i].name)) {
+                idxs.push_back(i);
+                found.insert(cases[i].name);
+            }
+        }
+        for (const auto &name : opt.run_list) {
+            if (!found.contains(name)) {
+                result.status       = SelectionStatus::CaseNotFound;
+                result.missing_case = name;
+                return result;
+            }
+        }
     } else if (opt.filter_pat) {
         for (std::size_t i = 0; i < cases.size(); ++i) {
             if (wildcard_match(cases[i].name, opt.filter_pat))
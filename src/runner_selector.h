@@ -31,6 +31,7 @@ struct SelectionResult {
     std::vector<std::size_t> jitter_idxs;
     bool                     has_selection  = false;
     std::size_t              filtered_death = 0;
+    std::string_view         missing_case; // first unmatched --run/--run-list name
 };
 
 SelectionResult  select_cases(std::span<const gentest::Case> cases, const CliOptions &opt);
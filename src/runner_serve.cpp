@@ -0,0 +1,571 @@
+#include "runner_serve.h"
+
+#include "runner_fixture_runtime.h"
+#include "runner_orchestrator.h"
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GENTEST_RUNNER_SERVE 1
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Wire format (integers are little-endian u32):
+//   request:  kind ('r' run | 's' shutdown) cwd_len cwd argc argc x { len bytes }
+//   response: frames of { tag len payload }; tag 'o' stdout, 'e' stderr,
+//             'x' exit code (payload is one u32, always the last frame)
+namespace gentest::runner {
+
+#if defined(GENTEST_RUNNER_SERVE)
+namespace {
+
+constexpr char kRequestRun      = 'r';
+constexpr char kRequestShutdown = 's';
+constexpr char kFrameStdout     = 'o';
+constexpr char kFrameStderr     = 'e';
+constexpr char kFrameExit       = 'x';
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// A client sends its whole request right after connecting. One that stays
+// silent this long is dropped so it cannot hold the serial accept loop.
+constexpr int kRequestReadTimeoutSec = 5;
+
+volatile std::sig_atomic_t g_stop_requested = 0;
+
+void on_stop_signal(int) { g_stop_requested = 1; }
+
+void put_u32(std::string &out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xffu));
+    }
+}
+
+auto get_u32(const char *bytes) -> std::uint32_t {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+bool write_all(int fd, const char *data, std::size_t size) {
+    while (size != 0) {
+        const auto n = ::send(fd, data, size, kSendFlags);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool read_all(int fd, char *data, std::size_t size) {
+    while (size != 0) {
+        const auto n = ::recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool read_u32(int fd, std::uint32_t &value) {
+    std::array<char, 4> bytes{};
+    if (!read_all(fd, bytes.data(), bytes.size())) {
+        return false;
+    }
+    value = get_u32(bytes.data());
+    return true;
+}
+
+bool send_frame(int fd, char tag, std::string_view payload) {
+    std::string header(1, tag);
+    put_u32(header, static_cast<std::uint32_t>(payload.size()));
+    return write_all(fd, header.data(), header.size()) && write_all(fd, payload.data(), payload.size());
+}
+
+bool send_exit_frame(int fd, int code) {
+    std::string payload;
+    put_u32(payload, static_cast<std::uint32_t>(code));
+    return send_frame(fd, kFrameExit, payload);
+}
+
+auto make_address(const char *path, sockaddr_un &addr, std::string &error) -> bool {
+    addr            = sockaddr_un{};
+    addr.sun_family = AF_UNIX;
+    const std::string_view p(path);
+    if (p.size() >= sizeof(addr.sun_path)) {
+        error = fmt::format("socket path is longer than {} bytes", sizeof(addr.sun_path) - 1);
+        return false;
+    }
+    std::memcpy(addr.sun_path, p.data(), p.size());
+    return true;
+}
+
+// Probe for a live server: connect() succeeds on a listening socket and fails
+// with ECONNREFUSED on a stale file nobody is bound to.
+bool socket_accepts_connections(const sockaddr_un &addr) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int rc = 0;
+    do {
+        rc = ::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+    } while (rc != 0 && errno == EINTR);
+    ::close(fd);
+    return rc == 0;
+}
+
+struct ServeRequest {
+    bool                     shutdown = false;
+    std::string              cwd;
+    std::vector<std::string> args;
+};
+
+bool read_string(int fd, std::string &value) {
+    std::uint32_t len = 0;
+    if (!read_u32(fd, len)) {
+        return false;
+    }
+    value.assign(len, '\0');
+    return read_all(fd, value.data(), value.size());
+}
+
+// Bounds every recv() on the client socket; read_all() then fails with
+// EAGAIN once the client has been idle for kRequestReadTimeoutSec.
+bool set_request_timeout(int fd) {
+    timeval timeout{};
+    timeout.tv_sec = kRequestReadTimeoutSec;
+    return ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+bool read_request(int fd, ServeRequest &request) {
+    char kind = 0;
+    if (!read_all(fd, &kind, 1) || (kind != kRequestRun && kind != kRequestShutdown)) {
+        return false;
+    }
+    request.shutdown = kind == kRequestShutdown;
+    if (!read_string(fd, request.cwd)) {
+        return false;
+    }
+    std::uint32_t argc = 0;
+    if (!read_u32(fd, argc)) {
+        return false;
+    }
+    request.args.reserve(argc);
+    for (std::uint32_t i = 0; i < argc; ++i) {
+        std::string arg;
+        if (!read_string(fd, arg)) {
+            return false;
+        }
+        request.args.push_back(std::move(arg));
+    }
+    return true;
+}
+
+// Runs a request from the client's working directory, so relative paths on
+// its command line (--junit, --run-list, ...) and in the cases resolve as they
+// would in a local run. chdir() is process-wide, which is why serve_cases()
+// handles one connection at a time: serving requests concurrently would need
+// the runner and every case to resolve paths against a per-request directory.
+class ScopedWorkingDirectory {
+  public:
+    ScopedWorkingDirectory() = default;
+    ScopedWorkingDirectory(const ScopedWorkingDirectory &)            = delete;
+    ScopedWorkingDirectory &operator=(const ScopedWorkingDirectory &) = delete;
+    ~ScopedWorkingDirectory() {
+        if (saved_fd_ >= 0) {
+            (void)::fchdir(saved_fd_);
+            ::close(saved_fd_);
+        }
+    }
+
+    bool enter(const std::string &dir, std::string &error) {
+        if (dir.empty()) {
+            return true;
+        }
+        saved_fd_ = ::open(".", O_RDONLY | O_CLOEXEC);
+        if (saved_fd_ < 0) {
+            error = fmt::format("cannot save the server working directory: {}", std::strerror(errno));
+            return false;
+        }
+        if (::chdir(dir.c_str()) != 0) {
+            error = fmt::format("cannot enter client working directory '{}': {}", dir, std::strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    int saved_fd_ = -1;
+};
+
+// Points stdout/stderr at pipes for the duration of one request and forwards
+// whatever the reporters (and the cases) write as frames to the client.
+class OutputCapture {
+  public:
+    explicit OutputCapture(int client_fd) : client_fd_(client_fd) {}
+    OutputCapture(const OutputCapture &)            = delete;
+    OutputCapture &operator=(const OutputCapture &) = delete;
+    ~OutputCapture() { finish(); }
+
+    bool start(std::string &error) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+        for (std::size_t i = 0; i < kStreams.size(); ++i) {
+            std::array<int, 2> fds{-1, -1};
+            if (::pipe(fds.data()) != 0) {
+                error = fmt::format("pipe failed: {}", std::strerror(errno));
+                finish();
+                return false;
+            }
+            (void)::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+            saved_[i] = ::dup(kStreams[i]);
+            (void)::fcntl(saved_[i], F_SETFD, FD_CLOEXEC);
+            (void)::dup2(fds[1], kStreams[i]);
+            ::close(fds[1]);
+            read_ends_[i] = fds[0];
+        }
+        pump_ = std::thread([this] { pump(); });
+        return true;
+    }
+
+    // Restores the original streams; the pump drains until both pipes close.
+    void finish() {
+        std::fflush(stdout);
+        std::fflush(stderr);
+        for (std::size_t i = 0; i < kStreams.size(); ++i) {
+            if (saved_[i] >= 0) {
+                (void)::dup2(saved_[i], kStreams[i]);
+                ::close(saved_[i]);
+                saved_[i] = -1;
+            }
+        }
+        if (pump_.joinable()) {
+            pump_.join();
+        }
+        for (int &fd : read_ends_) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+  private:
+    static constexpr std::array<int, 2>  kStreams{STDOUT_FILENO, STDERR_FILENO};
+    static constexpr std::array<char, 2> kTags{kFrameStdout, kFrameStderr};
+
+    void pump() {
+        std::array<pollfd, 2>  fds{};
+        std::array<char, 8192> buf{};
+        bool                   client_ok = true;
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            fds[i].fd     = read_ends_[i];
+            fds[i].events = POLLIN;
+        }
+        while (fds[0].fd >= 0 || fds[1].fd >= 0) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            for (std::size_t i = 0; i < fds.size(); ++i) {
+                if (fds[i].fd < 0 || fds[i].revents == 0) {
+                    continue;
+                }
+                const auto n = ::read(fds[i].fd, buf.data(), buf.size());
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    fds[i].fd = -1;
+                    continue;
+                }
+                // A client that went away must not block the run; keep draining.
+                client_ok = client_ok && send_frame(client_fd_, kTags[i], std::string_view(buf.data(), static_cast<std::size_t>(n)));
+            }
+        }
+    }
+
+    int                client_fd_;
+    std::array<int, 2> saved_{-1, -1};
+    std::array<int, 2> read_ends_{-1, -1};
+    std::thread        pump_;
+};
+
+int serve_request(int client_fd, std::span<const gentest::Case> cases, const ServeRequest &request, detail::WarmSharedFixtures &warm) {
+    std::vector<const char *> argv;
+    argv.reserve(request.args.size() + 1);
+    argv.push_back("gentest-serve");
+    for (const auto &arg : request.args) {
+        argv.push_back(arg.c_str());
+    }
+
+    ScopedWorkingDirectory cwd;
+    OutputCapture          capture(client_fd);
+    std::string            error;
+    if (!cwd.enter(request.cwd, error) || !capture.start(error)) {
+        (void)send_frame(client_fd, kFrameStderr, fmt::format("gentest: serve: {}\n", error));
+        return 1;
+    }
+    int        code = 1;
+    CliOptions options{};
+    if (parse_cli(std::span<const char *>{argv.data(), argv.size()}, options)) {
+        code = run_from_options(cases, options, &warm);
+    }
+    capture.finish();
+    return code;
+}
+
+int release_warm_fixtures(detail::WarmSharedFixtures &warm, int client_fd) {
+    std::vector<std::string> errors;
+    if (warm.release(errors)) {
+        return 0;
+    }
+    if (errors.empty()) {
+        errors.emplace_back("shared fixture teardown failed");
+    }
+    for (const auto &message : errors) {
+        const std::string line = fmt::format("gentest: serve: {}\n", message);
+        if (client_fd < 0 || !send_frame(client_fd, kFrameStderr, line)) {
+            fmt::print(stderr, "{}", line);
+        }
+    }
+    return 1;
+}
+
+struct ScopedStopSignals {
+    struct sigaction old_int{};
+    struct sigaction old_term{};
+    struct sigaction old_pipe{};
+
+    ScopedStopSignals() {
+        g_stop_requested = 0;
+        struct sigaction stop{};
+        stop.sa_handler = &on_stop_signal;
+        sigemptyset(&stop.sa_mask);
+        stop.sa_flags = 0; // no SA_RESTART: accept() must return EINTR
+        (void)::sigaction(SIGINT, &stop, &old_int);
+        (void)::sigaction(SIGTERM, &stop, &old_term);
+        struct sigaction ignore{};
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        (void)::sigaction(SIGPIPE, &ignore, &old_pipe);
+    }
+
+    ~ScopedStopSignals() {
+        (void)::sigaction(SIGINT, &old_int, nullptr);
+        (void)::sigaction(SIGTERM, &old_term, nullptr);
+        (void)::sigaction(SIGPIPE, &old_pipe, nullptr);
+    }
+
+    ScopedStopSignals(const ScopedStopSignals &)            = delete;
+    ScopedStopSignals &operator=(const ScopedStopSignals &) = delete;
+};
+
+} // namespace
+
+int serve_cases(std::span<const gentest::Case> cases, const CliOptions &opt) {
+    sockaddr_un addr{};
+    std::string error;
+    if (!make_address(opt.serve_socket, addr, error)) {
+        fmt::print(stderr, "error: --serve={}: {}\n", opt.serve_socket, error);
+        return 1;
+    }
+    const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        fmt::print(stderr, "error: --serve: socket failed: {}\n", std::strerror(errno));
+        return 1;
+    }
+    (void)::fcntl(listen_fd, F_SETFD, FD_CLOEXEC);
+    // A socket file left behind by a killed server would make bind() fail, but
+    // one that still accepts connections belongs to a live server.
+    struct stat st{};
+    if (::lstat(opt.serve_socket, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        if (socket_accepts_connections(addr)) {
+            fmt::print(stderr, "error: --serve={}: a gentest server is already listening on this socket\n", opt.serve_socket);
+            ::close(listen_fd);
+            return 1;
+        }
+        (void)::unlink(opt.serve_socket);
+    }
+    if (::bind(listen_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(listen_fd, 8) != 0) {
+        fmt::print(stderr, "error: --serve={}: {}\n", opt.serve_socket, std::strerror(errno));
+        ::close(listen_fd);
+        return 1;
+    }
+
+    ScopedStopSignals          signals;
+    detail::WarmSharedFixtures warm;
+    std::vector<std::string>   setup_errors;
+    if (!warm.ensure_setup(setup_errors)) {
+        for (const auto &message : setup_errors) {
+            fmt::print(stderr, "gentest: serve: {}\n", message);
+        }
+        // Runs retry the setup and report the failure to their client.
+        (void)release_warm_fixtures(warm, -1);
+    }
+    fmt::print("gentest: serving {} case(s) on {}\n", cases.size(), opt.serve_socket);
+    std::fflush(stdout);
+
+    int exit_code = 0;
+    while (g_stop_requested == 0) {
+        const int client_fd = ::accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            fmt::print(stderr, "gentest: serve: accept failed: {}\n", std::strerror(errno));
+            exit_code = 1;
+            break;
+        }
+        (void)::fcntl(client_fd, F_SETFD, FD_CLOEXEC);
+        ServeRequest request;
+        if (!set_request_timeout(client_fd) || !read_request(client_fd, request)) {
+            ::close(client_fd);
+            continue;
+        }
+        if (request.shutdown) {
+            exit_code = release_warm_fixtures(warm, client_fd);
+            (void)send_exit_frame(client_fd, exit_code);
+            ::close(client_fd);
+            break;
+        }
+        (void)send_exit_frame(client_fd, serve_request(client_fd, cases, request, warm));
+        ::close(client_fd);
+    }
+    if (warm.live) {
+        exit_code = release_warm_fixtures(warm, -1);
+    }
+
+    ::close(listen_fd);
+    (void)::unlink(opt.serve_socket);
+    return exit_code;
+}
+
+int run_connected(const CliOptions &opt, std::span<const char *> args) {
+    sockaddr_un addr{};
+    std::string error;
+    if (!make_address(opt.connect_socket, addr, error)) {
+        fmt::print(stderr, "error: --connect={}: {}\n", opt.connect_socket, error);
+        return 1;
+    }
+
+    // The server resolves relative paths against the client's directory.
+    std::error_code   cwd_error;
+    const std::string cwd = std::filesystem::current_path(cwd_error).string();
+    std::string       request(1, opt.shutdown_server ? kRequestShutdown : kRequestRun);
+    put_u32(request, cwd_error ? 0u : static_cast<std::uint32_t>(cwd.size()));
+    request += cwd_error ? std::string_view{} : std::string_view{cwd};
+
+    std::string   forwarded;
+    std::uint32_t argc = 0;
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        if (!args[i]) {
+            continue;
+        }
+        const std::string_view arg(args[i]);
+        if (arg == "--connect") {
+            ++i;
+            continue;
+        }
+        if (arg.starts_with("--connect=") || arg == "--shutdown") {
+            continue;
+        }
+        put_u32(forwarded, static_cast<std::uint32_t>(arg.size()));
+        forwarded.append(arg);
+        ++argc;
+    }
+    put_u32(request, argc);
+    request += forwarded;
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+        fmt::print(stderr, "error: cannot connect to gentest server at '{}': {}\n", opt.connect_socket, std::strerror(errno));
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return 1;
+    }
+    if (!write_all(fd, request.data(), request.size())) {
+        fmt::print(stderr, "error: failed to send request to '{}': {}\n", opt.connect_socket, std::strerror(errno));
+        ::close(fd);
+        return 1;
+    }
+
+    std::string payload;
+    for (;;) {
+        char          tag = 0;
+        std::uint32_t len = 0;
+        if (!read_all(fd, &tag, 1) || !read_u32(fd, len)) {
+            break;
+        }
+        payload.resize(len);
+        if (!read_all(fd, payload.data(), payload.size())) {
+            break;
+        }
+        if (tag == kFrameExit && payload.size() == 4) {
+            ::close(fd);
+            std::fflush(stdout);
+            std::fflush(stderr);
+            return static_cast<int>(get_u32(payload.data()));
+        }
+        std::FILE *out = tag == kFrameStderr ? stderr : stdout;
+        std::fwrite(payload.data(), 1, payload.size(), out);
+        std::fflush(out);
+    }
+    ::close(fd);
+    fmt::print(stderr, "error: gentest server at '{}' closed the connection before the run finished\n", opt.connect_socket);
+    return 1;
+}
+
+#else
+
+int serve_cases(std::span<const gentest::Case>, const CliOptions &) {
+    fmt::print(stderr, "error: --serve requires Unix domain sockets, which this platform build does not support\n");
+    return 1;
+}
+
+int run_connected(const CliOptions &, std::span<const char *>) {
+    fmt::print(stderr, "error: --connect requires Unix domain sockets, which this platform build does not support\n");
+    return 1;
+}
+
+#endif
+
+} // namespace gentest::runner
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "gentest/runner.h"
+#include "runner_cli.h"
+
+#include <span>
+
+namespace gentest::runner {
+
+// `--serve=<socket>`: sets shared fixtures up once, then runs one request per
+// client connection on a Unix socket until a `--shutdown` request or
+// SIGINT/SIGTERM. Each request is parsed like a command line and reported with
+// the normal reporters; its stdout/stderr are streamed back to the client.
+int serve_cases(std::span<const gentest::Case> cases, const CliOptions &opt);
+
+// `--connect=<socket>`: forwards `args` (minus --connect/--shutdown) to a
+// server, prints the streamed output and returns the server-side exit code.
+int run_connected(const CliOptions &opt, std::span<const char *> args);
+
+} // namespace gentest::runner
@@ -25,6 +25,11 @@ struct TestRunContext {
     bool            record_results       = false;
     bool            suppress_case_output = false;
     std::size_t     async_log_tail       = 5;
+    std::size_t     async_workers        = 1;
+    bool            async_virtual_time   = false;
+    bool            async_alloc_stats    = false;
+    bool            async_timer_wheel    = false;
+    bool            async_live_diff      = false;
     RunAccumulator *acc                  = nullptr;
 };
 
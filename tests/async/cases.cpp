@@ -1,5 +1,15 @@
 #include "cases.hpp"
 
+#if !defined(_WIN32)
+#include <array>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 namespace async {
 
 gentest::async_test<void> wait_for_child_pass() {
@@ -485,6 +495,250 @@ gentest::async_test<void> fail_fast_final_drain_async_should_not_run_after_failu
 
 namespace async {
 
+#if !defined(_WIN32)
+struct io_socket {
+    int fd = -1;
+
+    explicit io_socket(int value) : fd(value) {}
+    io_socket(const io_socket &)            = delete;
+    io_socket &operator=(const io_socket &) = delete;
+    ~io_socket() { reset(); }
+
+    void reset() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+struct io_socket_pair {
+    io_socket a{-1};
+    io_socket b{-1};
+
+    io_socket_pair() {
+        std::array<int, 2> fds{-1, -1};
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) != 0) {
+            throw std::runtime_error("socketpair failed");
+        }
+        a.fd = fds[0];
+        b.fd = fds[1];
+        set_nonblocking(a.fd);
+        set_nonblocking(b.fd);
+    }
+
+    static void set_nonblocking(int fd) { (void)::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK); }
+};
+#endif
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_socketpair_readable() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair pair;
+    std::thread    writer([fd = pair.b.fd] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        (void)!::write(fd, "x", 1);
+    });
+    co_await gentest::async::readable(pair.a.fd);
+    writer.join();
+    char byte = 0;
+    EXPECT_EQ(::read(pair.a.fd, &byte, 1), 1);
+    EXPECT_EQ(byte, 'x');
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_socketpair_writable() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair        pair;
+    std::array<char, 4096> chunk{};
+    while (::write(pair.a.fd, chunk.data(), chunk.size()) > 0) {
+    }
+    ASSERT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+    std::thread reader([fd = pair.b.fd] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::array<char, 4096> sink{};
+        while (::read(fd, sink.data(), sink.size()) > 0) {
+        }
+    });
+    co_await gentest::async::writable(pair.a.fd);
+    reader.join();
+    EXPECT_TRUE(::write(pair.a.fd, chunk.data(), 1) == 1);
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_peer_close_wakes_reader() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair pair;
+    pair.b.reset();
+    co_await gentest::async::readable(pair.a.fd);
+    char byte = 0;
+    EXPECT_EQ(::read(pair.a.fd, &byte, 1), 0);
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_wait_for_readable_times_out() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair pair;
+    auto           result = co_await gentest::async::wait_for(gentest::async::readable(pair.a.fd), std::chrono::milliseconds(10));
+    EXPECT_TRUE(result.timed_out());
+
+    (void)!::write(pair.b.fd, "x", 1);
+    auto ready = co_await gentest::async::wait_for(gentest::async::readable(pair.a.fd), std::chrono::seconds(5));
+    EXPECT_TRUE(ready.ready());
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_loopback_tcp_echo() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket listener(::socket(AF_INET, SOCK_STREAM, 0));
+    ASSERT_TRUE(listener.fd >= 0);
+    io_socket_pair::set_nonblocking(listener.fd);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len   = sizeof(addr);
+    ASSERT_EQ(::bind(listener.fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(listener.fd, 1), 0);
+    ASSERT_EQ(::getsockname(listener.fd, reinterpret_cast<sockaddr *>(&addr), &addr_len), 0);
+
+    io_socket client(::socket(AF_INET, SOCK_STREAM, 0));
+    ASSERT_TRUE(client.fd >= 0);
+    io_socket_pair::set_nonblocking(client.fd);
+    const int rc = ::connect(client.fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    ASSERT_TRUE(rc == 0 || errno == EINPROGRESS);
+
+    co_await gentest::async::readable(listener.fd);
+    io_socket server(::accept(listener.fd, nullptr, nullptr));
+    ASSERT_TRUE(server.fd >= 0);
+    io_socket_pair::set_nonblocking(server.fd);
+    co_await gentest::async::writable(client.fd);
+
+    ASSERT_EQ(::write(client.fd, "echo", 4), 4);
+    co_await gentest::async::readable(server.fd);
+    std::array<char, 4> buf{};
+    ASSERT_EQ(::read(server.fd, buf.data(), buf.size()), 4);
+    ASSERT_EQ(::write(server.fd, buf.data(), buf.size()), 4);
+    co_await gentest::async::readable(client.fd);
+    std::array<char, 4> echoed{};
+    ASSERT_EQ(::read(client.fd, echoed.data(), echoed.size()), 4);
+    EXPECT_EQ(std::string(echoed.data(), echoed.size()), "echo");
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+#if !defined(_WIN32)
+// Blocking peer for io/05 and io/06: a plain thread that answers on the other
+// end of the case's own pair, so each case passes on its own.
+auto io_peer_read(int fd, std::array<char, 4> &buf) -> bool {
+    pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+    return ::poll(&pfd, 1, 5000) == 1 && ::read(fd, buf.data(), buf.size()) == 4;
+}
+#endif
+
+gentest::async_test<void> io_ping() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair pair;
+    ASSERT_EQ(::write(pair.a.fd, "ping", 4), 4);
+    std::jthread peer([fd = pair.b.fd] {
+        std::array<char, 4> buf{};
+        if (io_peer_read(fd, buf) && std::string(buf.data(), buf.size()) == "ping") {
+            (void)!::write(fd, "pong", 4);
+        }
+    });
+    auto result = co_await gentest::async::wait_for(gentest::async::readable(pair.a.fd), std::chrono::seconds(5));
+    ASSERT_TRUE(result.ready());
+    std::array<char, 4> buf{};
+    ASSERT_EQ(::read(pair.a.fd, buf.data(), buf.size()), 4);
+    EXPECT_EQ(std::string(buf.data(), buf.size()), "pong");
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> io_pong() {
+#if defined(_WIN32)
+    gentest::skip("fd readiness needs POSIX sockets");
+    co_return;
+#else
+    io_socket_pair      pair;
+    std::array<char, 4> reply{};
+    bool                replied = false;
+    std::jthread        peer([fd = pair.a.fd, &reply, &replied] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        (void)!::write(fd, "ping", 4);
+        replied = io_peer_read(fd, reply);
+    });
+    auto result = co_await gentest::async::wait_for(gentest::async::readable(pair.b.fd), std::chrono::seconds(5));
+    ASSERT_TRUE(result.ready());
+    std::array<char, 4> buf{};
+    ASSERT_EQ(::read(pair.b.fd, buf.data(), buf.size()), 4);
+    EXPECT_EQ(std::string(buf.data(), buf.size()), "ping");
+    co_await gentest::async::writable(pair.b.fd);
+    EXPECT_EQ(::write(pair.b.fd, "pong", 4), 4);
+    peer.join();
+    EXPECT_TRUE(replied);
+    EXPECT_EQ(std::string(reply.data(), reply.size()), "pong");
+#endif
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> pool_child_tasks_share_case_pool() {
+    int sum = 0;
+    for (int i = 0; i < 2000; ++i) {
+        sum += co_await wait_for_child_value();
+    }
+    EXPECT_EQ(sum, 2000 * 42);
+}
+
+} // namespace async
+
+namespace async {
+
 gentest::async_test<void> timer_sleep_for_waits() {
     timer_fairness_order.clear();
     co_await gentest::async::sleep_for(std::chrono::milliseconds(10));
@@ -642,6 +896,36 @@ gentest::async_test<void> timer_stress_simultaneous_sleeper_d() { co_await timer
 
 namespace async {
 
+gentest::async_test<void> virtual_time_hour_sleep_is_instant() {
+    const auto wall_start    = std::chrono::steady_clock::now();
+    const auto virtual_start = gentest::async::now();
+
+    co_await gentest::async::sleep_for(std::chrono::hours(1));
+
+    EXPECT_TRUE(gentest::async::now() - virtual_start >= std::chrono::hours(1));
+    EXPECT_TRUE(std::chrono::steady_clock::now() - wall_start < std::chrono::minutes(1));
+}
+
+} // namespace async
+
+namespace async {
+
+gentest::async_test<void> virtual_time_timeouts_fire_in_deadline_order() {
+    gentest::async::event<int> never;
+    const auto                 start = gentest::async::now();
+
+    auto first = co_await gentest::async::wait_for(never.wait("first"), std::chrono::seconds(30));
+    EXPECT_TRUE(first.timed_out());
+    EXPECT_TRUE(gentest::async::now() - start == std::chrono::seconds(30));
+
+    co_await gentest::async::sleep_until(start + std::chrono::minutes(5));
+    EXPECT_TRUE(gentest::async::now() - start == std::chrono::minutes(5));
+}
+
+} // namespace async
+
+namespace async {
+
 gentest::async_test<void> wait_for_event_ready_before_timeout() {
     gentest::async::event<int> event;
     event.set("ready", 7);
@@ -653,6 +653,30 @@ gentest::async_test<void> fail_fast_final_drain_async_fail_after_adopted_release
 [[using gentest: test("fail_fast_final_drain/01_async_should_not_run_after_failure")]]
 gentest::async_test<void> fail_fast_final_drain_async_should_not_run_after_failure();
 
+[[using gentest: test("io/00_socketpair_readable")]]
+gentest::async_test<void> io_socketpair_readable();
+
+[[using gentest: test("io/01_socketpair_writable")]]
+gentest::async_test<void> io_socketpair_writable();
+
+[[using gentest: test("io/02_peer_close_wakes_reader")]]
+gentest::async_test<void> io_peer_close_wakes_reader();
+
+[[using gentest: test("io/03_wait_for_readable_times_out")]]
+gentest::async_test<void> io_wait_for_readable_times_out();
+
+[[using gentest: test("io/04_loopback_tcp_echo")]]
+gentest::async_test<void> io_loopback_tcp_echo();
+
+[[using gentest: test("io/05_ping")]]
+gentest::async_test<void> io_ping();
+
+[[using gentest: test("io/06_pong")]]
+gentest::async_test<void> io_pong();
+
+[[using gentest: test("pool/00_child_tasks_share_case_pool")]]
+gentest::async_test<void> pool_child_tasks_share_case_pool();
+
 [[using gentest: test("timer/00_sleep_for_waits")]]
 gentest::async_test<void> timer_sleep_for_waits();
 
@@ -688,6 +712,12 @@ gentest::async_test<void> timer_stress_simultaneous_sleeper_c();
 [[using gentest: test("timer_stress/07_simultaneous_sleeper_d")]]
 gentest::async_test<void> timer_stress_simultaneous_sleeper_d();
 
+[[using gentest: test("virtual_time/00_hour_sleep_is_instant"), virtual_time]]
+gentest::async_test<void> virtual_time_hour_sleep_is_instant();
+
+[[using gentest: test("virtual_time/01_timeouts_fire_in_deadline_order"), virtual_time]]
+gentest::async_test<void> virtual_time_timeouts_fire_in_deadline_order();
+
 [[using gentest: test("wait_for/event_ready_before_timeout")]]
 gentest::async_test<void> wait_for_event_ready_before_timeout();
 
@@ -41,6 +41,27 @@ void bench_sqrt() {
     gentest::doNotOptimizeAway(r);
 }
 
+void bench_lookup_table_scan() {
+    static const std::vector<std::uint32_t> table = [] {
+        std::vector<std::uint32_t> values(16 * 1024);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<std::uint32_t>(i * 2654435761U);
+        return values;
+    }();
+    std::uint32_t acc = 0;
+    for (std::size_t i = 0; i < table.size(); i += 16)
+        acc ^= table[i];
+    gentest::doNotOptimizeAway(acc);
+}
+
+void bench_vector_fill(std::size_t n) {
+    std::vector<std::size_t> values(n);
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = i;
+    gentest::doNotOptimizeAway(values.data());
+    gentest::clobberMemory();
+}
+
 } // namespace benchmarks
 
 namespace benchmarks {
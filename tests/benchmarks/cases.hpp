@@ -1,11 +1,15 @@
 #pragma once
 
+#include "async_timer_queue.h"
 #include "gentest/attributes.h"
 #include "gentest/bench_util.h"
 #include "gentest/runner.h"
 
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <complex>
 #include <cstdlib>
 #include <memory>
@@ -92,6 +96,52 @@ template <typename Mutex> inline void lock_guard_small() {
 }
 } // namespace spacing
 
+namespace timers {
+using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
+
+inline constexpr std::size_t kTimers = 1024;
+
+inline auto make_tokens() -> std::vector<WaiterTokenPtr> {
+    std::vector<WaiterTokenPtr> tokens;
+    tokens.reserve(kTimers);
+    for (std::size_t i = 0; i < kTimers; ++i) {
+        tokens.push_back(std::make_shared<gentest::detail::AsyncWaiterToken>(std::weak_ptr<gentest::detail::AsyncScheduler::Control>{}));
+    }
+    return tokens;
+}
+
+// The common wait_for outcome: every timeout is armed, then canceled because
+// the awaited event won.
+template <typename Queue> inline void arm_cancel() {
+    Queue       queue;
+    auto        tokens = make_tokens();
+    const auto  now    = std::chrono::steady_clock::now();
+    std::size_t i      = 0;
+    for (const auto &token : tokens) {
+        queue.push(now + std::chrono::milliseconds(100 + i++), token);
+    }
+    for (const auto &token : tokens) {
+        token->cancel();
+    }
+    gentest::doNotOptimizeAway(queue.has_pending());
+}
+
+// Timeouts that do fire: scattered deadlines drained in 16 ms steps.
+template <typename Queue> inline void arm_fire() {
+    Queue      queue;
+    auto       tokens = make_tokens();
+    const auto now    = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        queue.push(now + std::chrono::milliseconds((i * 7919) % kTimers), tokens[i]);
+    }
+    std::size_t fired = 0;
+    for (auto at = now; queue.has_pending(); at += std::chrono::milliseconds(16)) {
+        fired += queue.pop_due(at).size();
+    }
+    gentest::doNotOptimizeAway(fired);
+}
+} // namespace timers
+
 [[using gentest: bench("string/concat_small"), baseline, items_per_call(3)]]
 void bench_concat_small();
 
@@ -101,6 +151,12 @@ void bench_csv_comma_name();
 [[using gentest: bench("math/sqrt"), baseline]]
 void bench_sqrt();
 
+[[using gentest: bench("lookup/table_scan"), cache(warm, cold)]]
+void bench_lookup_table_scan();
+
+[[using gentest: bench("containers/vector_fill"), geom(n, 16, 4, 4), complexity(n)]]
+void bench_vector_fill(std::size_t n);
+
 [[using gentest: jitter("math/sin_jitter")]]
 void jitter_sin();
 
@@ -126,6 +182,24 @@ inline void bench_lock_guard_small() {
     spacing::lock_guard_small<Mutex>();
 }
 
+template <typename Queue>
+// clang-format off
+[[using gentest: bench("async_timers/arm_cancel"), baseline, items_per_call(1024)]]
+[[using gentest: template(Queue, gentest::detail::AsyncTimerHeap, gentest::detail::AsyncTimerWheel)]]
+// clang-format on
+inline void bench_timers_arm_cancel() {
+    timers::arm_cancel<Queue>();
+}
+
+template <typename Queue>
+// clang-format off
+[[using gentest: bench("async_timers/arm_fire"), baseline, items_per_call(1024)]]
+[[using gentest: template(Queue, gentest::detail::AsyncTimerHeap, gentest::detail::AsyncTimerWheel)]]
+// clang-format on
+inline void bench_timers_arm_fire() {
+    timers::arm_fire<Queue>();
+}
+
 template <typename T>
 // clang-format off
 [[using gentest: jitter("spacing/jitter_template_params")]]
@@ -85,6 +85,7 @@ set(_gentest_manual_regressions
     "gentest_regression_shared_fixture_runtime_registration_during_run|shared_fixture_runtime_registration_during_run.cpp"
     "gentest_regression_shared_fixture_retry_after_failure|shared_fixture_retry_after_failure.cpp"
     "gentest_regression_runtime_case_snapshot_isolated|runtime_case_snapshot_isolated.cpp"
+    "gentest_regression_case_table_merge|case_table_merge.cpp"
     "gentest_regression_logging_output|logging_output_regressions.cpp"
     "gentest_regression_shared_fixture_runtime_reentry_rejected|shared_fixture_runtime_reentry_rejected.cpp"
     "gentest_regression_shared_fixture_suite_scope_descendant|shared_fixture_suite_scope_descendant.cpp"
@@ -112,8 +113,13 @@ set(_gentest_manual_regressions
     "gentest_regression_runtime_reporting|runtime_reporting_regressions.cpp"
     "gentest_regression_runtime_selection|runtime_selection_regressions.cpp"
     "gentest_regression_async_blocking_timer_starvation|async_blocking_timer_starvation.cpp"
+    "gentest_regression_async_blocking_virtual_time|async_blocking_virtual_time.cpp"
     "gentest_regression_async_stale_waiter|async_stale_waiter.cpp"
     "gentest_regression_async_adopted_ready_queue|async_adopted_ready_queue.cpp"
+    "gentest_regression_async_worker_pool|async_worker_pool.cpp"
+    "gentest_regression_async_timer_wheel_ordering|async_timer_wheel_ordering.cpp"
+    "gentest_regression_async_io_wakeup|async_io_wakeup.cpp"
+    "gentest_regression_mock_trace_corrupt_counts|mock_trace_corrupt_counts.cpp"
     "gentest_regression_reporting_attachment_collision|reporting_attachment_collision.cpp")
 
 foreach(_gentest_manual_regression IN LISTS _gentest_manual_regressions)
@@ -464,6 +470,30 @@ gentest_add_cmake_script_test(
         "EXPECT_RC=1"
         "REQUIRED_SUBSTRING=runtime_selection_regressions.cpp:20")
 
+# --run-list selects exact names only (CRLF tolerated) and runs every case
+# carrying a listed name; a suffix that --run would accept is not found.
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/runtime_selection_exact.run_list"
+    "regressions/runtime_selection/mixed_summary_test_pass\r\nregressions/runtime_selection/duplicate_name\n\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/runtime_selection_suffix.run_list" "runtime_selection/mixed_summary_test_pass\n")
+
+gentest_add_cmake_script_test(
+    NAME regression_runtime_selection_run_list_exact
+    PROG $<TARGET_FILE:gentest_regression_runtime_selection>
+    SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoSubstring.cmake"
+    ARGS --run-list=${CMAKE_CURRENT_BINARY_DIR}/runtime_selection_exact.run_list --kind=test
+    DEFINES
+        "EXPECT_RC=1"
+        "REQUIRED_SUBSTRING=Summary: passed 1/3")
+
+gentest_add_cmake_script_test(
+    NAME regression_runtime_selection_run_list_rejects_suffix
+    PROG $<TARGET_FILE:gentest_regression_runtime_selection>
+    SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoSubstring.cmake"
+    ARGS --run-list=${CMAKE_CURRENT_BINARY_DIR}/runtime_selection_suffix.run_list
+    DEFINES
+        "EXPECT_RC=3"
+        "REQUIRED_SUBSTRING=Case not found: runtime_selection/mixed_summary_test_pass")
+
 gentest_add_check_contains(
     NAME regression_runtime_selection_list_death
     PROG $<TARGET_FILE:gentest_regression_runtime_selection>
@@ -1442,6 +1472,33 @@ gentest_add_cmake_script_test(
     SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoTimeout.cmake"
     DEFINES TIMEOUT_SEC=5 EXPECT_RC=0)
 
+gentest_add_check_exit_code(
+    NAME regression_async_timer_wheel_long_deadline_ordering
+    PROG $<TARGET_FILE:gentest_regression_async_timer_wheel_ordering>
+    EXPECT_RC 0)
+
+# Interrupts the fd poller from several threads while it waits, then checks
+# that later interrupts still wake it and that a failed open throws.
+gentest_add_cmake_script_test(
+    NAME regression_async_io_wakeup_survives_racing_interrupts
+    PROG $<TARGET_FILE:gentest_regression_async_io_wakeup>
+    SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoTimeout.cmake"
+    DEFINES TIMEOUT_SEC=30 EXPECT_RC=0)
+
+# A trace header whose counts exceed the file must be rejected before the
+# parser reserves storage for them.
+gentest_add_cmake_script_test(
+    NAME regression_mock_trace_rejects_oversized_counts
+    PROG $<TARGET_FILE:gentest_regression_mock_trace_corrupt_counts>
+    SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoTimeout.cmake"
+    DEFINES TIMEOUT_SEC=30 EXPECT_RC=0)
+
+gentest_add_cmake_script_test(
+    NAME regression_async_blocking_virtual_time_skips_sleeps
+    PROG $<TARGET_FILE:gentest_regression_async_blocking_virtual_time>
+    SCRIPT "${PROJECT_SOURCE_DIR}/tests/cmake/scripts/CheckNoTimeout.cmake"
+    DEFINES TIMEOUT_SEC=10 EXPECT_RC=0)
+
 gentest_add_cmake_script_test(
     NAME regression_async_adopted_ready_queue_completion_no_deadlock
     PROG $<TARGET_FILE:gentest_regression_async_adopted_ready_queue>
@@ -1482,6 +1539,13 @@ gentest_add_cmake_script_test(
         EXPECT_RC=0
         "REQUIRED_SUBSTRING=stop callback observed leased gentest context")
 
+# Runs the cases with 4 and with 1 async worker and checks that no case is
+# resumed concurrently with itself and that the pooled run uses several threads.
+gentest_add_check_exit_code(
+    NAME regression_async_worker_pool_owner_affinity
+    PROG $<TARGET_FILE:gentest_regression_async_worker_pool>
+    EXPECT_RC 0)
+
 if(WIN32 AND GENTEST_SKIP_WINDOWS_DEBUG_DEATH_TESTS)
     set_tests_properties(
         regression_local_fixture_teardown_noexceptions_fatal_assert_runs_teardown
@@ -2100,6 +2164,26 @@ gentest_add_check_exit_code(
     PROG $<TARGET_FILE:gentest_regression_shared_fixture_retry_after_failure>
     EXPECT_RC 0)
 
+if(UNIX)
+    gentest_add_manual_regression(
+        TARGET gentest_regression_serve_warm_fixtures
+        SOURCE ${CMAKE_CURRENT_SOURCE_DIR}/regressions/serve_warm_fixtures.cpp)
+
+    gentest_add_check_exit_code(
+        NAME regression_serve_warm_fixtures
+        PROG $<TARGET_FILE:gentest_regression_serve_warm_fixtures>
+        EXPECT_RC 0)
+
+    gentest_add_manual_regression(
+        TARGET gentest_regression_death_fork_server
+        SOURCE ${CMAKE_CURRENT_SOURCE_DIR}/regressions/death_fork_server.cpp)
+
+    gentest_add_check_exit_code(
+        NAME regression_death_fork_server
+        PROG $<TARGET_FILE:gentest_regression_death_fork_server>
+        EXPECT_RC 0)
+endif()
+
 gentest_add_check_counts(
     NAME regression_runtime_case_snapshot_isolated
     PROG $<TARGET_FILE:gentest_regression_runtime_case_snapshot_isolated>
@@ -2108,6 +2192,13 @@ gentest_add_check_counts(
     SKIP 0
     ARGS --filter=regressions/runtime_case_snapshot_isolated/* --kind=test)
 
+gentest_add_check_counts(
+    NAME regression_case_table_merge
+    PROG $<TARGET_FILE:gentest_regression_case_table_merge>
+    PASS 8
+    FAIL 0
+    SKIP 0)
+
 gentest_add_check_counts(
     NAME regression_shared_fixture_runtime_reentry_is_rejected
     PROG $<TARGET_FILE:gentest_regression_shared_fixture_runtime_reentry_rejected>
@@ -2197,3 +2288,45 @@ gentest_add_check_death(
     PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
     REQUIRED_SUBSTRING "error: duplicate --time-unit"
     ARGS --time-unit=auto --time-unit=ns)
+
+gentest_add_check_death(
+    NAME regression_jitter_clock_invalid_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: --jitter-clock must be one of steady,tsc"
+    ARGS --jitter-clock=hpet)
+
+gentest_add_check_death(
+    NAME regression_jitter_clock_duplicate_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: duplicate --jitter-clock"
+    ARGS --jitter-clock=steady --jitter-clock=tsc)
+
+gentest_add_check_death(
+    NAME regression_jitter_hdr_digits_out_of_range
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: --jitter-hdr-digits must be between 1 and 5"
+    ARGS --jitter-hdr-digits=6)
+
+gentest_add_check_death(
+    NAME regression_bench_cache_mode_invalid_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: --bench-cache-mode must be one of auto,warm,cold,both"
+    ARGS --bench-cache-mode=hot)
+
+gentest_add_check_death(
+    NAME regression_bench_cache_mode_duplicate_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: duplicate --bench-cache-mode"
+    ARGS --bench-cache-mode=warm --bench-cache-mode=cold)
+
+gentest_add_check_death(
+    NAME regression_bench_pin_cpu_invalid_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: --bench-pin-cpu must be a non-negative decimal integer"
+    ARGS --bench-pin-cpu=first)
+
+gentest_add_check_death(
+    NAME regression_bench_pin_cpu_duplicate_value
+    PROG $<TARGET_FILE:gentest_regression_time_unit_scaling>
+    REQUIRED_SUBSTRING "error: duplicate --bench-pin-cpu"
+    ARGS --bench-pin-cpu=0 --bench-pin-cpu=1)
@@ -0,0 +1,7 @@
+#include "alpha_cases.hpp"
+
+namespace codegen_batch_subdirs::alpha {
+
+void first_case() { gentest::expect(true); }
+
+} // namespace codegen_batch_subdirs::alpha
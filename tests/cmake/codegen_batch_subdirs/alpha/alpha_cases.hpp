@@ -0,0 +1,10 @@
+#pragma once
+
+#include <gentest/runner.h>
+
+namespace codegen_batch_subdirs::alpha {
+
+[[using gentest: test("batch/alpha/first")]]
+void first_case();
+
+} // namespace codegen_batch_subdirs::alpha
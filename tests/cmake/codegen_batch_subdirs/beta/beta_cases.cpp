@@ -0,0 +1,9 @@
+#include "beta_cases.hpp"
+
+#include <string_view>
+
+namespace codegen_batch_subdirs::beta {
+
+void first_case() { gentest::expect(!std::string_view{BATCH_BETA_CONFIG}.empty()); }
+
+} // namespace codegen_batch_subdirs::beta
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <gentest/runner.h>
+
+namespace codegen_batch_subdirs::beta {
+
+[[using gentest: test("batch/beta/first")]]
+void first_case();
+
+} // namespace codegen_batch_subdirs::beta
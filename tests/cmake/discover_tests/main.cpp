@@ -1,4 +1,6 @@
+#include <fstream>
 #include <iostream>
+#include <string>
 #include <string_view>
 
 static void list_tests() {
@@ -57,13 +59,28 @@ int main(int argc, char **argv) {
             return 0;
         }
         if (arg == "--list") {
+#ifdef DEMO_REFUSE_LIST
+            std::cerr << "--list must not run under inventory discovery\n";
+            return 1;
+#else
             list_meta();
             return 0;
+#endif
         }
         if (arg == "--list-death") {
             std::cout << "demo/death\n";
             return 0;
         }
+        constexpr std::string_view kRunList = "--run-list=";
+        if (arg.rfind(kRunList, 0) == 0) {
+            std::ifstream list{std::string(arg.substr(kRunList.size()))};
+            int           rc = 0;
+            for (std::string name; std::getline(list, name);) {
+                if (!name.empty() && run_one(name) != 0)
+                    rc = 1;
+            }
+            return rc;
+        }
         constexpr std::string_view kRun = "--run=";
         if (arg.rfind(kRun, 0) == 0) {
             return run_one(arg.substr(kRun.size()));
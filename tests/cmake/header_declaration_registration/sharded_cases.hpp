@@ -0,0 +1,34 @@
+#pragma once
+
+#include <gentest/runner.h>
+
+// Enough cases to exceed one registration shard's estimated wrapper cost.
+namespace header_declaration_registration::sharded {
+
+#define GENTEST_SHARDED_CASE(id)                                                                                                           \
+    [[using gentest: test]] inline void sharded_##id() { gentest::expect(true); }
+
+GENTEST_SHARDED_CASE(000) GENTEST_SHARDED_CASE(001) GENTEST_SHARDED_CASE(002) GENTEST_SHARDED_CASE(003)
+GENTEST_SHARDED_CASE(010) GENTEST_SHARDED_CASE(011) GENTEST_SHARDED_CASE(012) GENTEST_SHARDED_CASE(013)
+GENTEST_SHARDED_CASE(020) GENTEST_SHARDED_CASE(021) GENTEST_SHARDED_CASE(022) GENTEST_SHARDED_CASE(023)
+GENTEST_SHARDED_CASE(030) GENTEST_SHARDED_CASE(031) GENTEST_SHARDED_CASE(032) GENTEST_SHARDED_CASE(033)
+GENTEST_SHARDED_CASE(040) GENTEST_SHARDED_CASE(041) GENTEST_SHARDED_CASE(042) GENTEST_SHARDED_CASE(043)
+GENTEST_SHARDED_CASE(050) GENTEST_SHARDED_CASE(051) GENTEST_SHARDED_CASE(052) GENTEST_SHARDED_CASE(053)
+GENTEST_SHARDED_CASE(060) GENTEST_SHARDED_CASE(061) GENTEST_SHARDED_CASE(062) GENTEST_SHARDED_CASE(063)
+GENTEST_SHARDED_CASE(070) GENTEST_SHARDED_CASE(071) GENTEST_SHARDED_CASE(072) GENTEST_SHARDED_CASE(073)
+GENTEST_SHARDED_CASE(080) GENTEST_SHARDED_CASE(081) GENTEST_SHARDED_CASE(082) GENTEST_SHARDED_CASE(083)
+GENTEST_SHARDED_CASE(090) GENTEST_SHARDED_CASE(091) GENTEST_SHARDED_CASE(092) GENTEST_SHARDED_CASE(093)
+GENTEST_SHARDED_CASE(100) GENTEST_SHARDED_CASE(101) GENTEST_SHARDED_CASE(102) GENTEST_SHARDED_CASE(103)
+GENTEST_SHARDED_CASE(110) GENTEST_SHARDED_CASE(111) GENTEST_SHARDED_CASE(112) GENTEST_SHARDED_CASE(113)
+GENTEST_SHARDED_CASE(120) GENTEST_SHARDED_CASE(121) GENTEST_SHARDED_CASE(122) GENTEST_SHARDED_CASE(123)
+GENTEST_SHARDED_CASE(130) GENTEST_SHARDED_CASE(131) GENTEST_SHARDED_CASE(132) GENTEST_SHARDED_CASE(133)
+GENTEST_SHARDED_CASE(140) GENTEST_SHARDED_CASE(141) GENTEST_SHARDED_CASE(142) GENTEST_SHARDED_CASE(143)
+GENTEST_SHARDED_CASE(150) GENTEST_SHARDED_CASE(151) GENTEST_SHARDED_CASE(152) GENTEST_SHARDED_CASE(153)
+GENTEST_SHARDED_CASE(160) GENTEST_SHARDED_CASE(161) GENTEST_SHARDED_CASE(162) GENTEST_SHARDED_CASE(163)
+GENTEST_SHARDED_CASE(170) GENTEST_SHARDED_CASE(171) GENTEST_SHARDED_CASE(172) GENTEST_SHARDED_CASE(173)
+GENTEST_SHARDED_CASE(180) GENTEST_SHARDED_CASE(181) GENTEST_SHARDED_CASE(182) GENTEST_SHARDED_CASE(183)
+GENTEST_SHARDED_CASE(190) GENTEST_SHARDED_CASE(191) GENTEST_SHARDED_CASE(192) GENTEST_SHARDED_CASE(193)
+
+#undef GENTEST_SHARDED_CASE
+
+} // namespace header_declaration_registration::sharded
@@ -0,0 +1,107 @@
+# Requires the variables listed in CheckCodegenTuFixtureCommon.cmake.
+#
+# Regression test for `gentest_codegen batch`: two invocations described by
+# per-target args files run in one process, share a stamp and depfile, and are
+# skipped on reruns until a source, header, depends-file entry or output of
+# theirs changes.
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckCodegenTuFixtureCommon.cmake")
+
+# One args file per source stands in for two test targets; the batch runs
+# both invocations in one process and writes a depfile for the shared stamp.
+set(_manifest "${_work_dir}/batch.manifest")
+set(_stamp "${_work_dir}/batch.stamp")
+set(_extra_dep "${_work_dir}/target_a.extra")
+file(WRITE "${_extra_dep}" "extra\n")
+file(WRITE "${_work_dir}/target_a.codegen_depends" "${_extra_dep}\n")
+file(WRITE "${_work_dir}/target_b.codegen_depends" "\n")
+set(_manifest_text "")
+foreach(_name IN ITEMS a b)
+  set(_target_dir "${_work_dir}/target_${_name}")
+  set(_args
+    "--tu-out-dir" "${_target_dir}"
+    "--tu-header-output" "${_target_dir}/tu_${_name}.gentest.h"
+    "--depfile" "${_target_dir}/codegen.d"
+    "--compdb" "${_work_dir}"
+    "${_work_dir_norm}/${_name}.cpp")
+  list(JOIN _args "\n" _args_text)
+  file(WRITE "${_work_dir}/target_${_name}.codegen_args" "${_args_text}\n")
+  string(APPEND _manifest_text "target_${_name}.codegen_args;target_${_name}.codegen_depends\n")
+endforeach()
+file(WRITE "${_manifest}" "${_manifest_text}")
+
+# Runs the batch and checks how many invocations it found up to date.
+function(_gentest_run_batch_step label expect_up_to_date)
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E env GENTEST_CODEGEN_LOG_PARSE_POLICY=1
+      "${PROG}" batch --manifest "${_manifest}" --stamp "${_stamp}" --depfile "${_depfile}" --jobs=2
+    RESULT_VARIABLE _rc
+    OUTPUT_VARIABLE _out
+    ERROR_VARIABLE _err
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_STRIP_TRAILING_WHITESPACE)
+  if(NOT _rc EQUAL 0)
+    message(FATAL_ERROR
+      "gentest_codegen batch failed (${label}).\n"
+      "--- stdout ---\n${_out}\n--- stderr ---\n${_err}")
+  endif()
+  string(FIND "${_err}" "batch of 2 invocation(s), ${expect_up_to_date} up to date" _pos)
+  if(_pos EQUAL -1)
+    message(FATAL_ERROR "Expected ${expect_up_to_date} up-to-date invocation(s) (${label}).\n--- stderr ---\n${_err}")
+  endif()
+  set(_err "${_err}" PARENT_SCOPE)
+endfunction()
+
+_gentest_run_batch_step("cold" 0)
+foreach(_expected IN ITEMS
+    "${_work_dir}/target_a/tu_a.gentest.h"
+    "${_work_dir}/target_b/tu_b.gentest.h"
+    "${_work_dir}/target_a/codegen.d"
+    "${_work_dir}/target_b/codegen.d"
+    "${_stamp}")
+  if(NOT EXISTS "${_expected}")
+    message(FATAL_ERROR "gentest_codegen batch did not write '${_expected}'. Errors:\n${_err}")
+  endif()
+endforeach()
+
+# Every step must see the batch depfile cover both targets, whether their
+# invocations ran or were skipped.
+function(_gentest_check_batch_depfile label)
+  file(READ "${_depfile}" _depfile_text)
+  foreach(_needle IN ITEMS "batch.stamp" "batch.manifest" "target_a.codegen_args" "target_a.codegen_depends" "a.cpp" "a.hpp"
+      "b.cpp" "b.hpp" "compile_commands.json")
+    string(FIND "${_depfile_text}" "${_needle}" _pos)
+    if(_pos EQUAL -1)
+      message(FATAL_ERROR
+        "Batch depfile is missing '${_needle}' (${label}). Full depfile:\n${_depfile_text}")
+    endif()
+  endforeach()
+endfunction()
+_gentest_check_batch_depfile("cold")
+
+# Coarse file system timestamps must not make an edit look as old as the
+# depfile of the run before it.
+function(_gentest_batch_edit path content)
+  execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 1)
+  file(WRITE "${path}" "${content}")
+endfunction()
+
+_gentest_run_batch_step("unchanged" 2)
+_gentest_check_batch_depfile("unchanged")
+
+file(READ "${_b_hpp}" _b_hpp_text)
+_gentest_batch_edit("${_b_hpp}" "${_b_hpp_text}\n// edited\n")
+_gentest_run_batch_step("header of b edited" 1)
+_gentest_check_batch_depfile("header of b edited")
+_gentest_run_batch_step("after rerunning b" 2)
+
+# Depends-file entries stand in for build-system dependencies the
+# invocation's own depfile cannot record.
+_gentest_batch_edit("${_extra_dep}" "extra edited\n")
+_gentest_run_batch_step("extra dependency of a edited" 1)
+
+file(REMOVE "${_work_dir}/target_b/tu_b.gentest.h")
+_gentest_run_batch_step("output of b removed" 1)
+if(NOT EXISTS "${_work_dir}/target_b/tu_b.gentest.h")
+  message(FATAL_ERROR "gentest_codegen batch did not restore the removed output of b")
+endif()
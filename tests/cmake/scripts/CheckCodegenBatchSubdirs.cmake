@@ -0,0 +1,189 @@
+# Requires the standard _gentest_add_cmake_helper_test variables.
+#
+# Configures and builds a project with GENTEST_CODEGEN_BATCH=ON whose two
+# additive (header_declaration) test targets live in different subdirectories:
+#
+#   1. the batch command deferred to the top-level directory generates the
+#      registration sources that the subdirectory targets compile;
+#   2. Ninja Multi-Config evaluates one args file and one manifest per
+#      configuration and builds every configuration from its own;
+#   3. a no-op rebuild runs nothing, and editing one target's header reruns
+#      only that target's invocation inside the batch;
+#   4. a case added to the other target reaches that target's binary.
+
+if(NOT DEFINED SOURCE_DIR OR NOT DEFINED BUILD_ROOT OR NOT DEFINED GENTEST_SOURCE_DIR)
+  message(FATAL_ERROR "CheckCodegenBatchSubdirs.cmake: required helper variable missing")
+endif()
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckRunOrFail.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/CheckModuleFixtureCommon.cmake")
+
+gentest_resolve_clang_fixture_compilers(_clang _clangxx)
+if(NOT _clang OR NOT _clangxx)
+  gentest_skip_test("batched codegen subdirectory regression: clang/clang++ not found")
+  return()
+endif()
+gentest_find_supported_ninja(_supported_ninja _supported_ninja_reason)
+if(NOT _supported_ninja)
+  gentest_skip_test("batched codegen subdirectory regression: ${_supported_ninja_reason}")
+  return()
+endif()
+
+set(_cache_args
+  "-DGENTEST_SOURCE_DIR=${GENTEST_SOURCE_DIR}"
+  "-DCMAKE_C_COMPILER=${_clang}"
+  "-DCMAKE_CXX_COMPILER=${_clangxx}"
+  "-DCMAKE_MAKE_PROGRAM=${_supported_ninja}")
+if(DEFINED PROG AND NOT "${PROG}" STREQUAL "")
+  list(APPEND _cache_args "-DGENTEST_CODEGEN_EXECUTABLE=${PROG}")
+endif()
+if(DEFINED LLVM_DIR AND NOT "${LLVM_DIR}" STREQUAL "")
+  list(APPEND _cache_args "-DLLVM_DIR=${LLVM_DIR}")
+endif()
+if(DEFINED Clang_DIR AND NOT "${Clang_DIR}" STREQUAL "")
+  list(APPEND _cache_args "-DClang_DIR=${Clang_DIR}")
+endif()
+gentest_append_host_apple_sysroot(_cache_args)
+
+set(_exe_suffix "")
+if(CMAKE_HOST_WIN32)
+  set(_exe_suffix ".exe")
+endif()
+
+# Builds with the batch reporting how many invocations it skipped.
+function(_gentest_batch_build label build_dir out_output)
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E env GENTEST_CODEGEN_LOG_PARSE_POLICY=1
+      "${CMAKE_COMMAND}" --build "${build_dir}" ${ARGN}
+    RESULT_VARIABLE _rc
+    OUTPUT_VARIABLE _out
+    ERROR_VARIABLE _err)
+  if(NOT _rc EQUAL 0)
+    message(FATAL_ERROR "Build failed (${label}).\n--- stdout ---\n${_out}\n--- stderr ---\n${_err}")
+  endif()
+  set(${out_output} "${_out}\n${_err}" PARENT_SCOPE)
+endfunction()
+
+function(_gentest_expect_output label output needle)
+  string(FIND "${output}" "${needle}" _pos)
+  if(_pos EQUAL -1)
+    message(FATAL_ERROR "Expected '${needle}' (${label}). Output:\n${output}")
+  endif()
+endfunction()
+
+function(_gentest_expect_cases label exe)
+  gentest_check_run_or_fail(
+    COMMAND "${exe}" --list-tests
+    OUTPUT_VARIABLE _list
+    STRIP_TRAILING_WHITESPACE)
+  foreach(_case IN LISTS ARGN)
+    _gentest_expect_output("${label}" "${_list}" "${_case}")
+  endforeach()
+endfunction()
+
+# Coarse file system timestamps must not make an edit look as old as the
+# depfile of the build before it.
+function(_gentest_batch_edit path search replace)
+  execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 1)
+  file(READ "${path}" _text)
+  string(REPLACE "${search}" "${replace}" _edited "${_text}")
+  if(_edited STREQUAL _text)
+    message(FATAL_ERROR "Edit of '${path}' changed nothing")
+  endif()
+  file(WRITE "${path}" "${_edited}")
+endfunction()
+
+foreach(_generator IN ITEMS "Ninja" "Ninja Multi-Config")
+  string(MAKE_C_IDENTIFIER "${_generator}" _generator_id)
+  set(_work_dir "${BUILD_ROOT}/codegen_batch_subdirs/${_generator_id}")
+  set(_src_dir "${_work_dir}/src")
+  set(_build_dir "${_work_dir}/build")
+  file(REMOVE_RECURSE "${_work_dir}")
+  file(MAKE_DIRECTORY "${_work_dir}")
+  file(COPY "${SOURCE_DIR}/" DESTINATION "${_src_dir}")
+
+  set(_generator_args ${_cache_args})
+  if(_generator STREQUAL "Ninja")
+    set(_configs "")
+    if(DEFINED BUILD_TYPE AND NOT "${BUILD_TYPE}" STREQUAL "")
+      list(APPEND _generator_args "-DCMAKE_BUILD_TYPE=${BUILD_TYPE}")
+    endif()
+  else()
+    set(_configs Debug Release)
+  endif()
+
+  gentest_check_run_or_fail(
+    COMMAND "${CMAKE_COMMAND}" -G "${_generator}" -S "${_src_dir}" -B "${_build_dir}" ${_generator_args}
+    WORKING_DIRECTORY "${_work_dir}"
+    STRIP_TRAILING_WHITESPACE)
+
+  set(_build_configs ${_configs})
+  if(NOT _build_configs)
+    set(_build_configs "-")
+  endif()
+  foreach(_config IN LISTS _build_configs)
+    set(_config_args "")
+    set(_config_suffix "")
+    set(_exe_dir "")
+    if(NOT _config STREQUAL "-")
+      set(_config_args --config "${_config}")
+      set(_config_suffix ".${_config}")
+      set(_exe_dir "/${_config}")
+    endif()
+    set(_label "${_generator}${_config_suffix}")
+
+    _gentest_batch_build("${_label}" "${_build_dir}" _output ${_config_args})
+    _gentest_expect_output("${_label}" "${_output}" "Running gentest_codegen for 2 target(s)")
+    _gentest_expect_output("${_label}" "${_output}" "batch of 2 invocation(s), 0 up to date")
+
+    set(_manifest "${_build_dir}/gentest_codegen_batch/batch${_config_suffix}.manifest")
+    foreach(_batch_file IN ITEMS "${_manifest}" "${_build_dir}/gentest_codegen_batch/batch${_config_suffix}.stamp")
+      if(NOT EXISTS "${_batch_file}")
+        message(FATAL_ERROR "Expected the batch file '${_batch_file}' (${_label})")
+      endif()
+    endforeach()
+    file(STRINGS "${_manifest}" _manifest_lines)
+    list(LENGTH _manifest_lines _manifest_line_count)
+    if(NOT _manifest_line_count EQUAL 2)
+      message(FATAL_ERROR "Expected two args file entries in '${_manifest}' (${_label}), got:\n${_manifest_lines}")
+    endif()
+    # Each subdirectory evaluates its own target's args file.
+    foreach(_dir IN ITEMS alpha beta)
+      file(GLOB_RECURSE _args_files "${_build_dir}/${_dir}/generated/*${_config_suffix}.codegen_args")
+      if(NOT _args_files)
+        message(FATAL_ERROR "Expected a ${_dir} args file for '${_label}' under '${_build_dir}/${_dir}/generated'")
+      endif()
+    endforeach()
+
+    _gentest_expect_cases("${_label}" "${_build_dir}/alpha${_exe_dir}/batch_alpha_tests${_exe_suffix}" "batch/alpha/first")
+    _gentest_expect_cases("${_label}" "${_build_dir}/beta${_exe_dir}/batch_beta_tests${_exe_suffix}" "batch/beta/first")
+  endforeach()
+
+  # Incremental builds use the first configuration only.
+  list(GET _build_configs 0 _config)
+  set(_config_args "")
+  set(_exe_dir "")
+  if(NOT _config STREQUAL "-")
+    set(_config_args --config "${_config}")
+    set(_exe_dir "/${_config}")
+  endif()
+
+  _gentest_batch_build("${_generator} no-op" "${_build_dir}" _output ${_config_args})
+  string(FIND "${_output}" "Running gentest_codegen" _rerun_pos)
+  if(NOT _rerun_pos EQUAL -1)
+    message(FATAL_ERROR "A no-op ${_generator} build reran codegen. Output:\n${_output}")
+  endif()
+
+  _gentest_batch_edit("${_src_dir}/alpha/alpha_cases.hpp" "void first_case();" "void first_case(); // edited")
+  _gentest_batch_build("${_generator} alpha header edited" "${_build_dir}" _output ${_config_args})
+  _gentest_expect_output("${_generator} alpha header edited" "${_output}" "batch of 2 invocation(s), 1 up to date")
+
+  _gentest_batch_edit("${_src_dir}/beta/beta_cases.hpp" "void first_case();" [=[void first_case();
+
+[[using gentest: test("batch/beta/added")]]
+inline void added_case() { gentest::expect(true); }]=])
+  _gentest_batch_build("${_generator} beta case added" "${_build_dir}" _output ${_config_args})
+  _gentest_expect_output("${_generator} beta case added" "${_output}" "batch of 2 invocation(s), 1 up to date")
+  _gentest_expect_cases("${_generator} beta case added" "${_build_dir}/beta${_exe_dir}/batch_beta_tests${_exe_suffix}"
+    "batch/beta/first" "batch/beta/added")
+endforeach()
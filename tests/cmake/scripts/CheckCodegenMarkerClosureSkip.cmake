@@ -0,0 +1,72 @@
+# Requires the variables listed in CheckCodegenTuFixtureCommon.cmake.
+#
+# Regression test for the marker-closure skip: a source whose include closure
+# has no codegen markers is parsed once, skipped by unchanged reruns, and
+# parsed again when a closure file changes or gains a marker.
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckCodegenTuFixtureCommon.cmake")
+
+# b.cpp and its closure carry no codegen markers: the first run parses it and
+# records the closure, an unchanged rerun skips Clang for that slot, and any
+# change to a closure file makes the next run parse it again.
+gentest_fixture_write_file("${_b_cpp}" [=[
+#include "b.hpp"
+
+int plain_b() { return dep_b_value(); }
+]=])
+set(_skip_b "skipping Clang for '${_b_cpp_norm}'")
+set(_skip_a "skipping Clang for '${_a_cpp_norm}'")
+
+function(_gentest_run_marker_closure_step label expect_skip expect_entries)
+  set(ENV{GENTEST_CODEGEN_LOG_PARSE_POLICY} 1)
+  _gentest_run_tu_codegen("${_depfile}" _rc _out _err)
+  unset(ENV{GENTEST_CODEGEN_LOG_PARSE_POLICY})
+  if(NOT _rc EQUAL 0)
+    message(FATAL_ERROR "gentest_codegen failed (${label}).\n--- stdout ---\n${_out}\n--- stderr ---\n${_err}")
+  endif()
+  set(_all "${_out}\n${_err}")
+  string(FIND "${_all}" "${_skip_b}" _skip_b_pos)
+  if(expect_skip AND _skip_b_pos EQUAL -1)
+    message(FATAL_ERROR "Expected the marker-free slot to be skipped (${label}). Output:\n${_all}")
+  elseif(NOT expect_skip AND NOT _skip_b_pos EQUAL -1)
+    message(FATAL_ERROR "Expected the marker-free slot to be parsed (${label}). Output:\n${_all}")
+  endif()
+  string(FIND "${_all}" "${_skip_a}" _skip_a_pos)
+  if(NOT _skip_a_pos EQUAL -1)
+    message(FATAL_ERROR "The slot with test markers must never be skipped (${label}). Output:\n${_all}")
+  endif()
+  file(GLOB _entries "${_tu_output_dir}/.gentest_codegen_modules_*/marker_closures/*.json")
+  list(LENGTH _entries _entry_count)
+  if(NOT _entry_count EQUAL expect_entries)
+    message(FATAL_ERROR "Expected ${expect_entries} marker closure file(s) (${label}), found: ${_entries}")
+  endif()
+  if(NOT EXISTS "${_output_b}")
+    message(FATAL_ERROR "Expected '${_output_b}' to be written (${label})")
+  endif()
+  file(READ "${_depfile}" _depfile_text)
+  string(FIND "${_depfile_text}" "b.hpp" _b_hpp_pos)
+  if(_b_hpp_pos EQUAL -1)
+    message(FATAL_ERROR "Depfile lost the skipped slot's closure (${label}):\n${_depfile_text}")
+  endif()
+endfunction()
+
+_gentest_run_marker_closure_step("cold" FALSE 1)
+_gentest_run_marker_closure_step("unchanged" TRUE 1)
+
+# A different size, so the stamp changes even on coarse mtime filesystems.
+gentest_fixture_write_file("${_b_hpp}" [=[
+#pragma once
+inline int dep_b_value() { return 20; }
+]=])
+_gentest_run_marker_closure_step("header edited" FALSE 1)
+_gentest_run_marker_closure_step("after reparse" TRUE 1)
+
+# The prefilter also counts markers inside comments, so this is enough to
+# force the slot back through Clang and drop its entry.
+gentest_fixture_write_file("${_b_hpp}" [=[
+#pragma once
+// Mentions gentest.
+inline int dep_b_value() { return 2; }
+]=])
+_gentest_run_marker_closure_step("marker added" FALSE 0)
+_gentest_run_marker_closure_step("marker kept" FALSE 0)
@@ -0,0 +1,160 @@
+# Requires:
+#  -DBUILD_ROOT=<path>
+#  -DGENTEST_SOURCE_DIR=<path to gentest source tree>
+#  -DPROG=<path to gentest_codegen>
+#
+# Regression test for the per-source clang-scan-deps cache kept under the
+# codegen module cache directory:
+#
+#   1. a cold run rescans the source and stores its entry;
+#   2. an unchanged rerun answers it from the cache;
+#   3. editing a header the source includes invalidates the entry;
+#   4. GENTEST_CODEGEN_SCAN_DEPS_CACHE=0 bypasses the cache entirely.
+#
+# GENTEST_CODEGEN_LOG_SCAN_DEPS=1 makes codegen report the hit/rescan counts
+# that the checks below match.
+
+if(NOT DEFINED BUILD_ROOT OR "${BUILD_ROOT}" STREQUAL "")
+  message(FATAL_ERROR "CheckCodegenScanDepsCache.cmake: BUILD_ROOT not set")
+endif()
+if(NOT DEFINED GENTEST_SOURCE_DIR OR "${GENTEST_SOURCE_DIR}" STREQUAL "")
+  message(FATAL_ERROR "CheckCodegenScanDepsCache.cmake: GENTEST_SOURCE_DIR not set")
+endif()
+if(NOT DEFINED PROG OR "${PROG}" STREQUAL "")
+  message(FATAL_ERROR "CheckCodegenScanDepsCache.cmake: PROG not set")
+endif()
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckRunOrFail.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/CheckFixtureWriteHelpers.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/CheckModuleFixtureCommon.cmake")
+
+gentest_resolve_clang_fixture_compilers(_clang _clangxx)
+if(NOT _clang OR NOT _clangxx)
+  gentest_skip_test("scan-deps cache: clang/clang++ not found")
+  return()
+endif()
+
+gentest_find_clang_scan_deps(_clang_scan_deps "${_clangxx}")
+if("${_clang_scan_deps}" STREQUAL "")
+  gentest_skip_test("scan-deps cache: clang-scan-deps not found")
+  return()
+endif()
+
+set(_work_dir "${BUILD_ROOT}/codegen_scan_deps_cache")
+set(_generated_dir "${_work_dir}/generated")
+set(_consumer "${_work_dir}/consumer.cppm")
+set(_header "${_work_dir}/scan_cache_dep.h")
+set(_compdb "${_work_dir}/compile_commands.json")
+
+file(REMOVE_RECURSE "${_work_dir}")
+file(MAKE_DIRECTORY "${_generated_dir}")
+
+gentest_fixture_write_file("${_header}" [=[
+#pragma once
+
+inline auto scan_cache_dep_value() -> int { return 1; }
+]=])
+
+gentest_fixture_write_file("${_consumer}" [=[
+module;
+
+#include "scan_cache_dep.h"
+
+export module gentest.scan_cache_consumer;
+
+export namespace gentest::scan_cache_consumer {
+
+[[using gentest: test("scan/cache")]]
+void uses_included_header() {
+  (void)scan_cache_dep_value();
+}
+
+} // namespace gentest::scan_cache_consumer
+]=])
+
+gentest_fixture_make_compdb_entry(
+  _entry
+  DIRECTORY "${_work_dir}"
+  FILE "${_consumer}"
+  ARGUMENTS
+    "clang++"
+    "-std=c++20"
+    "-I${_work_dir}"
+    "${_consumer}")
+gentest_fixture_write_compdb("${_compdb}" "${_entry}")
+
+set(_command
+  "${PROG}"
+  --compdb "${_work_dir}"
+  --clang-scan-deps "${_clang_scan_deps}"
+  --host-clang "${_clangxx}"
+  --tu-out-dir "${_generated_dir}"
+  --artifact-manifest "${_generated_dir}/artifact_manifest.json"
+  --tu-header-output "${_generated_dir}/consumer.gentest.h"
+  --module-registration-output "${_generated_dir}/tu_0000_consumer.registration.gentest.cpp"
+  --source-root "${_work_dir}"
+  "${_consumer}"
+  --
+  "-DGENTEST_CODEGEN=1"
+  "-Wno-unknown-attributes"
+  "-Wno-attributes"
+  "-Wno-unknown-warning-option")
+
+# Runs codegen with the given extra environment and checks that its output
+# contains `expected` (or, with an empty `expected`, no cache report at all).
+function(_gentest_run_scan_deps_cache_step label expected)
+  message(STATUS "Run gentest_codegen for scan-deps cache regression (${label})...")
+  gentest_check_run_or_fail(
+    COMMAND
+      "${CMAKE_COMMAND}"
+      -E
+      env
+      GENTEST_CODEGEN_LOG_SCAN_DEPS=1
+      ${ARGN}
+      ${_command}
+    OUTPUT_VARIABLE _output
+    WORKING_DIRECTORY "${_work_dir}"
+    STRIP_TRAILING_WHITESPACE)
+
+  if(NOT EXISTS "${_generated_dir}/consumer.gentest.h")
+    message(FATAL_ERROR "Expected consumer registration header to be generated (${label})")
+  endif()
+  string(FIND "${_output}" "using clang-scan-deps for named-module dependency discovery" _used_pos)
+  if(_used_pos EQUAL -1)
+    message(FATAL_ERROR "Expected clang-scan-deps results to be used (${label}). Output:\n${_output}")
+  endif()
+
+  if("${expected}" STREQUAL "")
+    string(FIND "${_output}" "clang-scan-deps cache:" _cache_pos)
+    if(NOT _cache_pos EQUAL -1)
+      message(FATAL_ERROR "Expected the scan-deps cache to be bypassed (${label}). Output:\n${_output}")
+    endif()
+  else()
+    string(FIND "${_output}" "${expected}" _expected_pos)
+    if(_expected_pos EQUAL -1)
+      message(FATAL_ERROR "Expected '${expected}' (${label}). Output:\n${_output}")
+    endif()
+  endif()
+endfunction()
+
+_gentest_run_scan_deps_cache_step("cold" "clang-scan-deps cache: 0 hit(s), 1 source(s) to rescan")
+
+file(GLOB _cache_entries "${_generated_dir}/.gentest_codegen_modules_*/scan_deps/*.json")
+list(LENGTH _cache_entries _cache_entry_count)
+if(NOT _cache_entry_count EQUAL 1)
+  message(FATAL_ERROR "Expected one scan-deps cache entry after the cold run, found: ${_cache_entries}")
+endif()
+
+_gentest_run_scan_deps_cache_step("warm" "clang-scan-deps cache: 1 hit(s), 0 source(s) to rescan")
+
+# Same size and same source, so only the recorded header hash can tell the
+# entry is stale.
+gentest_fixture_write_file("${_header}" [=[
+#pragma once
+
+inline auto scan_cache_dep_value() -> int { return 2; }
+]=])
+_gentest_run_scan_deps_cache_step("header edited" "clang-scan-deps cache: 0 hit(s), 1 source(s) to rescan")
+_gentest_run_scan_deps_cache_step("after rescan" "clang-scan-deps cache: 1 hit(s), 0 source(s) to rescan")
+
+_gentest_run_scan_deps_cache_step("cache disabled" "" GENTEST_CODEGEN_SCAN_DEPS_CACHE=0)
@@ -0,0 +1,40 @@
+# Requires the variables listed in CheckCodegenTuFixtureCommon.cmake.
+#
+# Runs TU-mode codegen over the two-source fixture with --trace-out and checks
+# that the Chrome trace holds the phase, per-slot and frontend events.
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckCodegenTuFixtureCommon.cmake")
+
+set(_trace "${_work_dir}/codegen_trace.json")
+_gentest_run_tu_codegen("${_depfile}" _rc _out _err "--trace-out=${_trace}" "--trace-granularity-us=0" "--jobs=2")
+
+if(NOT _rc EQUAL 0)
+  message(FATAL_ERROR
+    "gentest_codegen failed while writing a trace.\n"
+    "--- stdout ---\n${_out}\n--- stderr ---\n${_err}")
+endif()
+if(NOT EXISTS "${_trace}")
+  message(FATAL_ERROR "gentest_codegen did not write the trace '${_trace}'. Errors:\n${_err}")
+endif()
+
+file(READ "${_trace}" _trace_text)
+string(JSON _event_count ERROR_VARIABLE _json_error LENGTH "${_trace_text}" traceEvents)
+if(_json_error OR _event_count EQUAL 0)
+  message(FATAL_ERROR "Trace '${_trace}' has no traceEvents array: ${_json_error}")
+endif()
+foreach(_needle IN ITEMS
+    "\"name\":\"LoadCompilationDatabase\""
+    "\"name\":\"PrepareSources\""
+    "\"name\":\"Parse\""
+    "\"name\":\"ParseSlot\""
+    "\"name\":\"MergeAndValidate\""
+    "\"name\":\"Emit\""
+    "\"name\":\"EmitSlot\""
+    "\"detail\":\"${_a_cpp_norm}\""
+    "\"detail\":\"${_b_cpp_norm}\""
+    "\"name\":\"Frontend\"")
+  string(FIND "${_trace_text}" "${_needle}" _pos)
+  if(_pos EQUAL -1)
+    message(FATAL_ERROR "Trace '${_trace}' is missing ${_needle}.")
+  endif()
+endforeach()
@@ -0,0 +1,116 @@
+# Shared by the TU-mode codegen checks. Copies the two-source fixture from
+# tests/cmake/codegen_tu_depfile_aggregation into a fresh work directory,
+# writes its compile_commands.json and defines _gentest_run_tu_codegen().
+#
+# Requires:
+#  -DPROG=<path to gentest_codegen>
+#  -DBUILD_ROOT=<path>
+#  -DSOURCE_DIR=<path to gentest source tree>
+#  -DCODEGEN_STD=<language standard flag>
+# Optional:
+#  -DTARGET_ARG=<cross target flag>
+
+get_filename_component(_gentest_tu_fixture_script "${CMAKE_SCRIPT_MODE_FILE}" NAME)
+
+if(NOT DEFINED PROG)
+  message(FATAL_ERROR "${_gentest_tu_fixture_script}: PROG not set")
+endif()
+if(NOT DEFINED BUILD_ROOT)
+  message(FATAL_ERROR "${_gentest_tu_fixture_script}: BUILD_ROOT not set")
+endif()
+if(NOT DEFINED SOURCE_DIR)
+  message(FATAL_ERROR "${_gentest_tu_fixture_script}: SOURCE_DIR not set")
+endif()
+if(NOT DEFINED CODEGEN_STD OR "${CODEGEN_STD}" STREQUAL "")
+  message(FATAL_ERROR "${_gentest_tu_fixture_script}: CODEGEN_STD not set")
+endif()
+
+include("${CMAKE_CURRENT_LIST_DIR}/CheckFixtureWriteHelpers.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/CheckModuleFixtureCommon.cmake")
+
+find_program(_real_clang NAMES clang++-23 clang++-22 clang++-21 clang++-20 clang++-19 clang++ clang++.exe REQUIRED)
+file(TO_CMAKE_PATH "${_real_clang}" _real_clang_norm)
+file(TO_CMAKE_PATH "${SOURCE_DIR}" _source_dir_norm)
+
+set(_work_dir "${BUILD_ROOT}/codegen_tu_depfile_aggregation")
+file(REMOVE_RECURSE "${_work_dir}")
+file(MAKE_DIRECTORY "${_work_dir}")
+file(TO_CMAKE_PATH "${_work_dir}" _work_dir_norm)
+
+set(_a_hpp "${_work_dir}/a.hpp")
+set(_b_hpp "${_work_dir}/b.hpp")
+set(_a_cpp "${_work_dir}/a.cpp")
+set(_b_cpp "${_work_dir}/b.cpp")
+set(_depfile "${_work_dir}/dep_tu.d")
+set(_tu_output_dir "${_work_dir}/generated")
+set(_output_a "${_tu_output_dir}/tu_a.gentest.h")
+set(_output_b "${_tu_output_dir}/tu_b.gentest.h")
+set(_mock_registry "${_work_dir}/dep_tu_mock_registry.hpp")
+set(_mock_impl "${_work_dir}/dep_tu_mock_impl.hpp")
+set(_mock_registry_domain "${_work_dir}/dep_tu_mock_registry__domain_0000_header.hpp")
+set(_mock_impl_domain "${_work_dir}/dep_tu_mock_impl__domain_0000_header.hpp")
+file(MAKE_DIRECTORY "${_tu_output_dir}")
+
+file(COPY
+  "${SOURCE_DIR}/tests/cmake/codegen_tu_depfile_aggregation/a.hpp"
+  "${SOURCE_DIR}/tests/cmake/codegen_tu_depfile_aggregation/b.hpp"
+  "${SOURCE_DIR}/tests/cmake/codegen_tu_depfile_aggregation/a.cpp"
+  "${SOURCE_DIR}/tests/cmake/codegen_tu_depfile_aggregation/b.cpp"
+  DESTINATION "${_work_dir}")
+
+file(TO_CMAKE_PATH "${_a_cpp}" _a_cpp_norm)
+file(TO_CMAKE_PATH "${_b_cpp}" _b_cpp_norm)
+
+set(_compile_command_args_a "${_real_clang_norm}")
+set(_compile_command_args_b "${_real_clang_norm}")
+if(DEFINED TARGET_ARG AND NOT "${TARGET_ARG}" STREQUAL "")
+  list(APPEND _compile_command_args_a "${TARGET_ARG}")
+  list(APPEND _compile_command_args_b "${TARGET_ARG}")
+endif()
+gentest_make_public_api_include_args(
+  _public_include_args
+  SOURCE_ROOT "${_source_dir_norm}"
+  APPLE_SYSROOT)
+gentest_normalize_std_flag_for_compiler(_compdb_std "${_real_clang_norm}" "${CODEGEN_STD}")
+gentest_normalize_include_args_for_compiler(_compdb_include_args "${_real_clang_norm}" ${_public_include_args})
+list(APPEND _compile_command_args_a "${_compdb_std}" ${_compdb_include_args} "-I${_work_dir_norm}" "-c" "${_a_cpp_norm}")
+list(APPEND _compile_command_args_a "-o" "${_work_dir_norm}/a.o")
+list(APPEND _compile_command_args_b "${_compdb_std}" ${_compdb_include_args} "-I${_work_dir_norm}" "-c" "${_b_cpp_norm}")
+list(APPEND _compile_command_args_b "-o" "${_work_dir_norm}/b.o")
+
+gentest_fixture_make_compdb_entry(_a_entry
+  DIRECTORY "${_work_dir_norm}"
+  FILE "${_a_cpp_norm}"
+  ARGUMENTS ${_compile_command_args_a})
+gentest_fixture_make_compdb_entry(_b_entry
+  DIRECTORY "${_work_dir_norm}"
+  FILE "${_b_cpp_norm}"
+  ARGUMENTS ${_compile_command_args_b})
+gentest_fixture_write_compdb("${_work_dir}/compile_commands.json" "${_a_entry}" "${_b_entry}")
+
+function(_gentest_run_tu_codegen depfile_path out_rc out_out out_err)
+  execute_process(
+    COMMAND
+      "${PROG}"
+      --tu-out-dir "${_tu_output_dir}"
+      --tu-header-output "${_output_a}"
+      --tu-header-output "${_output_b}"
+      --mock-registry "${_mock_registry}"
+      --mock-impl "${_mock_impl}"
+      --mock-domain-registry-output "${_mock_registry_domain}"
+      --mock-domain-impl-output "${_mock_impl_domain}"
+      --depfile "${depfile_path}"
+      --compdb "${_work_dir}"
+      ${ARGN}
+      "${_a_cpp_norm}"
+      "${_b_cpp_norm}"
+    RESULT_VARIABLE _rc
+    OUTPUT_VARIABLE _out
+    ERROR_VARIABLE _err
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_STRIP_TRAILING_WHITESPACE)
+
+  set(${out_rc} "${_rc}" PARENT_SCOPE)
+  set(${out_out} "${_out}" PARENT_SCOPE)
+  set(${out_err} "${_err}" PARENT_SCOPE)
+endfunction()
@@ -115,89 +115,119 @@ if(NOT _forwarded_token_warning_pos EQUAL -1)
     "Forwarded EXTRA_ARGS token EXPECT_SUBSTRING must not trigger legacy option handling. Output:\n${_forwarded_token_configure_out}")
 endif()
 
-message(STATUS "Configure gentest_discover_tests fixture...")
-gentest_check_run_or_fail(
-  COMMAND
-    "${CMAKE_COMMAND}"
-    ${_cmake_gen_args}
-    -S "${SOURCE_DIR}"
-    -B "${_build_dir}"
-    ${_cmake_cache_args}
-  STRIP_TRAILING_WHITESPACE
-  WORKING_DIRECTORY "${_work_dir}"
-)
-
-message(STATUS "Build gentest_discover_tests fixture...")
-set(_build_args --build "${_build_dir}")
-if(DEFINED BUILD_CONFIG AND NOT "${BUILD_CONFIG}" STREQUAL "")
-  list(APPEND _build_args --config "${BUILD_CONFIG}")
-endif()
-gentest_check_run_or_fail(COMMAND "${CMAKE_COMMAND}" ${_build_args} STRIP_TRAILING_WHITESPACE WORKING_DIRECTORY "${_work_dir}")
+function(_gentest_check_discover_fixture label build_dir batched)
+  message(STATUS "Configure gentest_discover_tests ${label} fixture...")
+  gentest_check_run_or_fail(
+    COMMAND
+      "${CMAKE_COMMAND}"
+      ${_cmake_gen_args}
+      -S "${SOURCE_DIR}"
+      -B "${build_dir}"
+      ${_cmake_cache_args}
+      ${ARGN}
+    STRIP_TRAILING_WHITESPACE
+    WORKING_DIRECTORY "${_work_dir}"
+  )
+
+  message(STATUS "Build gentest_discover_tests ${label} fixture...")
+  set(_build_args --build "${build_dir}")
+  if(DEFINED BUILD_CONFIG AND NOT "${BUILD_CONFIG}" STREQUAL "")
+    list(APPEND _build_args --config "${BUILD_CONFIG}")
+  endif()
+  gentest_check_run_or_fail(COMMAND "${CMAKE_COMMAND}" ${_build_args} STRIP_TRAILING_WHITESPACE WORKING_DIRECTORY "${_work_dir}")
+
+  message(STATUS "List discovered tests...")
+  gentest_check_run_or_fail(
+    COMMAND "${_ctest_cmd}" -N ${_ctest_common_args}
+    STRIP_TRAILING_WHITESPACE
+    WORKING_DIRECTORY "${build_dir}"
+    OUTPUT_VARIABLE _list_out
+  )
+
+  if(batched)
+    # BATCH_SIZE 2 over the four runnable cases; death cases stay per-case.
+    set(_expected_tests
+      "batch/1"
+      "batch/2"
+      "death/demo/death")
+    set(_normal_regex "^batch/")
+  else()
+    set(_expected_tests
+      "demo/a"
+      "demo/b"
+      "demo/skip"
+      "demo/has [bracket]"
+      "death/demo/death")
+    set(_normal_regex "^demo/")
+  endif()
 
-message(STATUS "List discovered tests...")
-gentest_check_run_or_fail(
-  COMMAND "${_ctest_cmd}" -N ${_ctest_common_args}
-  STRIP_TRAILING_WHITESPACE
-  WORKING_DIRECTORY "${_build_dir}"
-  OUTPUT_VARIABLE _list_out
-)
+  string(REPLACE "\r" "" _list_out_normalized "${_list_out}")
+  string(REPLACE "\n" ";" _list_lines "${_list_out_normalized}")
+  set(_discovered_tests)
+  foreach(_line IN LISTS _list_lines)
+    if(_line MATCHES "^[ \t]*Test #[0-9]+: (.+)$")
+      list(APPEND _discovered_tests "${CMAKE_MATCH_1}")
+    endif()
+  endforeach()
+
+  list(LENGTH _discovered_tests _discovered_count)
+  list(LENGTH _expected_tests _expected_count)
+  if(NOT _discovered_count EQUAL _expected_count)
+    message(FATAL_ERROR
+      "Unexpected discovered test count. Expected ${_expected_count}, got ${_discovered_count}. ctest -N output:\n${_list_out}")
+  endif()
 
-set(_expected_tests
-  "demo/a"
-  "demo/b"
-  "demo/skip"
-  "demo/has [bracket]"
-  "death/demo/death")
-
-string(REPLACE "\r" "" _list_out_normalized "${_list_out}")
-string(REPLACE "\n" ";" _list_lines "${_list_out_normalized}")
-set(_discovered_tests)
-foreach(_line IN LISTS _list_lines)
-  if(_line MATCHES "^[ \t]*Test #[0-9]+: (.+)$")
-    list(APPEND _discovered_tests "${CMAKE_MATCH_1}")
+  list(SORT _discovered_tests)
+  list(SORT _expected_tests)
+  if(NOT _discovered_tests STREQUAL _expected_tests)
+    string(JOIN "\n  " _expected_block ${_expected_tests})
+    string(JOIN "\n  " _actual_block ${_discovered_tests})
+    message(FATAL_ERROR
+      "Discovered test set mismatch.\nExpected:\n  ${_expected_block}\nActual:\n  ${_actual_block}\nFull ctest -N output:\n${_list_out}")
   endif()
-endforeach()
 
-list(LENGTH _discovered_tests _discovered_count)
-list(LENGTH _expected_tests _expected_count)
-if(NOT _discovered_count EQUAL _expected_count)
-  message(FATAL_ERROR
-    "Unexpected discovered test count. Expected ${_expected_count}, got ${_discovered_count}. ctest -N output:\n${_list_out}")
-endif()
+  if(_list_out MATCHES "(^|\\n)[ \t]*Test #[0-9]+: demo/death([ \t]*$)")
+    message(FATAL_ERROR "Death test should not be registered as a normal test: 'demo/death'. ctest -N output:\n${_list_out}")
+  endif()
+  if(_list_out MATCHES "(^|\\n)[ \t]*Test #[0-9]+: death/demo/death_skip([ \t]*$)")
+    message(FATAL_ERROR "Skipped death test should not be registered as a CTest death case: 'demo/death_skip'. ctest -N output:\n${_list_out}")
+  endif()
 
-list(SORT _discovered_tests)
-list(SORT _expected_tests)
-if(NOT _discovered_tests STREQUAL _expected_tests)
-  string(JOIN "\n  " _expected_block ${_expected_tests})
-  string(JOIN "\n  " _actual_block ${_discovered_tests})
-  message(FATAL_ERROR
-    "Discovered test set mismatch.\nExpected:\n  ${_expected_block}\nActual:\n  ${_actual_block}\nFull ctest -N output:\n${_list_out}")
-endif()
+  message(STATUS "Run discovered tests...")
+  gentest_check_run_or_fail(
+    COMMAND "${_ctest_cmd}" -V ${_ctest_common_args} -R "${_normal_regex}"
+    STRIP_TRAILING_WHITESPACE
+    WORKING_DIRECTORY "${build_dir}"
+    OUTPUT_VARIABLE _run_out
+  )
+  foreach(_case_line IN ITEMS "[ PASS ] demo/a" "[ PASS ] demo/b" "[ SKIP ] demo/skip" "[ PASS ] demo/has [bracket]")
+    string(FIND "${_run_out}" "${_case_line}" _case_pos)
+    if(_case_pos EQUAL -1)
+      message(FATAL_ERROR "Expected per-case result '${_case_line}'. Output:\n${_run_out}")
+    endif()
+  endforeach()
+
+  message(STATUS "Run discovered death tests...")
+  gentest_check_run_or_fail(
+    COMMAND "${_ctest_cmd}" -V ${_ctest_common_args} -R "^death/"
+    STRIP_TRAILING_WHITESPACE
+    WORKING_DIRECTORY "${build_dir}"
+    OUTPUT_VARIABLE _death_out
+  )
+  string(FIND "${_death_out}" "Death test passed" _pos)
+  if(_pos EQUAL -1)
+    message(FATAL_ERROR "Expected death harness success message. Output:\n${_death_out}")
+  endif()
+endfunction()
 
-if(_list_out MATCHES "(^|\\n)[ \t]*Test #[0-9]+: demo/death([ \t]*$)")
-  message(FATAL_ERROR "Death test should not be registered as a normal test: 'demo/death'. ctest -N output:\n${_list_out}")
-endif()
-if(_list_out MATCHES "(^|\\n)[ \t]*Test #[0-9]+: death/demo/death_skip([ \t]*$)")
-  message(FATAL_ERROR "Skipped death test should not be registered as a CTest death case: 'demo/death_skip'. ctest -N output:\n${_list_out}")
-endif()
+_gentest_check_discover_fixture("execution" "${_build_dir}" FALSE)
 
-message(STATUS "Run discovered tests...")
-gentest_check_run_or_fail(
-  COMMAND "${_ctest_cmd}" ${_ctest_common_args} -R "^demo/"
-  STRIP_TRAILING_WHITESPACE
-  WORKING_DIRECTORY "${_build_dir}"
-)
+# Inventory discovery reads the build-time case list; the fixture binary
+# refuses --list in this configuration, so any execution fails the build.
+_gentest_check_discover_fixture("inventory" "${_work_dir}/inventory_build" FALSE -DGENTEST_DISCOVER_TESTS_INVENTORY=ON)
 
-message(STATUS "Run discovered death tests...")
-gentest_check_run_or_fail(
-  COMMAND "${_ctest_cmd}" -V ${_ctest_common_args} -R "^death/"
-  STRIP_TRAILING_WHITESPACE
-  WORKING_DIRECTORY "${_build_dir}"
-  OUTPUT_VARIABLE _death_out
-)
-string(FIND "${_death_out}" "Death test passed" _pos)
-if(_pos EQUAL -1)
-  message(FATAL_ERROR "Expected death harness success message. Output:\n${_death_out}")
-endif()
+# Batched entries hand each process an exact --run-list.
+_gentest_check_discover_fixture("batched" "${_work_dir}/batched_build" TRUE
+  -DGENTEST_DISCOVER_TESTS_INVENTORY=ON -DGENTEST_DISCOVER_TESTS_BATCH=ON)
 
 message(STATUS "gentest_discover_tests fixture passed")
@@ -126,6 +126,7 @@ gentest_check_run_or_fail(
     header_declaration_dual_2
     header_declaration_header_only_tests
     header_declaration_header_only_alias_tests
+    header_declaration_sharded_tests
   WORKING_DIRECTORY "${_work_dir}"
   STRIP_TRAILING_WHITESPACE)
 
@@ -156,6 +157,18 @@ foreach(_metadata IN ITEMS
     message(FATAL_ERROR "Header-declaration JSON inventory missed metadata '${_metadata}'.\n${_json_inventory}")
   endif()
 endforeach()
+file(GLOB _build_inventories "${_build_dir}/generated/header_declaration_registration_tests*.inventory.json")
+list(LENGTH _build_inventories _build_inventory_count)
+if(NOT _build_inventory_count EQUAL 1)
+  message(FATAL_ERROR "Expected one build-time case inventory, found: ${_build_inventories}")
+endif()
+file(READ "${_build_inventories}" _build_inventory)
+string(STRIP "${_build_inventory}" _build_inventory)
+string(REPLACE "\r\n" "\n" _runtime_inventory "${_json_inventory}")
+if(NOT _build_inventory STREQUAL _runtime_inventory)
+  message(FATAL_ERROR
+    "Build-time case inventory differs from --list-json.\nBuild-time:\n${_build_inventory}\nRuntime:\n${_runtime_inventory}")
+endif()
 foreach(_name IN ITEMS
     "header_declaration/a"
     "header_declaration/b"
@@ -184,6 +197,45 @@ gentest_check_run_or_fail(
   WORKING_DIRECTORY "${_build_dir}"
   STRIP_TRAILING_WHITESPACE)
 
+# REGISTRATION_SHARDS 3: the 80-case slot fills two shards and leaves the third
+# predeclared shard as a stub, and the manifest lists both extra shards.
+file(GLOB _sharded_primary "${_build_dir}/generated_sharded/*sharded_cases.header_registration.gentest.cpp")
+file(GLOB _sharded_first "${_build_dir}/generated_sharded/*sharded_cases.header_registration.shard1.gentest.cpp")
+file(GLOB _sharded_second "${_build_dir}/generated_sharded/*sharded_cases.header_registration.shard2.gentest.cpp")
+foreach(_shard_var IN ITEMS _sharded_primary _sharded_first _sharded_second)
+  list(LENGTH ${_shard_var} _shard_count)
+  if(NOT _shard_count EQUAL 1)
+    message(FATAL_ERROR "Expected one generated registration source for ${_shard_var}, got: ${${_shard_var}}")
+  endif()
+endforeach()
+file(READ "${_sharded_primary}" _sharded_primary_text)
+file(READ "${_sharded_first}" _sharded_first_text)
+file(READ "${_sharded_second}" _sharded_second_text)
+if(NOT _sharded_primary_text MATCHES "kCases" OR NOT _sharded_first_text MATCHES "register_tu_[0-9]+_shard1")
+  message(FATAL_ERROR "Expected the sharded slot to register cases from the primary source and shard 1")
+endif()
+if(NOT _sharded_second_text MATCHES "No gentest registrations were assigned to this shard")
+  message(FATAL_ERROR "Expected the unused shard 2 to be a stub.\n${_sharded_second_text}")
+endif()
+file(GLOB _sharded_manifest "${_build_dir}/generated_sharded/*.artifact_manifest.json")
+file(READ "${_sharded_manifest}" _sharded_manifest_text)
+string(JSON _sharded_shard_outputs LENGTH "${_sharded_manifest_text}" artifacts 0 shard_outputs)
+if(NOT _sharded_shard_outputs EQUAL 2)
+  message(FATAL_ERROR "Expected two extra shard outputs in the sharded artifact manifest.\n${_sharded_manifest_text}")
+endif()
+set(_sharded_exe "${_build_dir}/header_declaration_sharded_tests")
+if(CMAKE_HOST_WIN32)
+  set(_sharded_exe "${_sharded_exe}.exe")
+endif()
+gentest_check_run_or_fail(
+  COMMAND "${_sharded_exe}"
+  WORKING_DIRECTORY "${_build_dir}"
+  STRIP_TRAILING_WHITESPACE
+  OUTPUT_VARIABLE _sharded_output)
+if(NOT _sharded_output MATCHES "passed 80/80")
+  message(FATAL_ERROR "Expected all 80 sharded cases to run.\n${_sharded_output}")
+endif()
+
 # The scanner is always the host Clang tool, but the authored and additive
 # registration sources must remain valid when the target compiler is GCC.
 if(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
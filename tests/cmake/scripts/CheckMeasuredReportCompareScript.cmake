@@ -26,6 +26,10 @@ set(_truncated_csv "${_work_dir}/truncated.csv")
 set(_zero_baseline_json "${_work_dir}/zero-baseline.json")
 set(_zero_current_json "${_work_dir}/zero-current.json")
 set(_missing_metric_json "${_work_dir}/missing-metric.json")
+set(_complexity_baseline_json "${_work_dir}/complexity-baseline.json")
+set(_complexity_current_json "${_work_dir}/complexity-current.json")
+set(_environment_baseline_json "${_work_dir}/environment-baseline.json")
+set(_environment_current_csv "${_work_dir}/environment-current.csv")
 set(_summary_md "${_work_dir}/summary.md")
 
 file(WRITE "${_baseline_json}" [=[
@@ -72,6 +76,14 @@ file(WRITE "${_missing_metric_json}" [=[
 {"report":"measured","tables":[{"report":"bench","id":"bench.summary","title":"Benchmarks","rows":[{"benchmark":"bench/fast","suite":"bench","items_per_call":1,"median_ns_per_item":112.0}]}],"issues":[]}
 ]=])
 
+file(WRITE "${_complexity_baseline_json}" [=[
+{"report":"bench","tables":[{"report":"bench","id":"bench.summary","title":"Benchmarks","rows":[{"benchmark":"bench/insert/8","suite":"bench","median_ns_per_item":10.0,"p95_ns_per_item":11.0}]},{"report":"bench","id":"bench.complexity","title":"Bench complexity","rows":[{"series":"bench/insert(n)","suite":"bench","points":4,"best_fit":"O(n)","coefficient_ns_per_item":1.0,"rms_pct":2.0},{"series":"bench/lookup(n)","suite":"bench","points":4,"best_fit":"O(n)","coefficient_ns_per_item":1.0,"rms_pct":2.0}]}],"issues":[]}
+]=])
+
+file(WRITE "${_complexity_current_json}" [=[
+{"report":"bench","tables":[{"report":"bench","id":"bench.summary","title":"Benchmarks","rows":[{"benchmark":"bench/insert/8","suite":"bench","median_ns_per_item":10.0,"p95_ns_per_item":11.0}]},{"report":"bench","id":"bench.complexity","title":"Bench complexity","rows":[{"series":"bench/insert(n)","suite":"bench","points":4,"best_fit":"O(n^2)","coefficient_ns_per_item":0.1,"rms_pct":3.0},{"series":"bench/lookup(n)","suite":"bench","points":4,"best_fit":"O(log n)","coefficient_ns_per_item":1.0,"rms_pct":2.0}]}],"issues":[]}
+]=])
+
 execute_process(
   COMMAND "${Python3_EXECUTABLE}" "${_script}" --help
   RESULT_VARIABLE _help_rc
@@ -149,6 +161,81 @@ foreach(_threshold IN ITEMS nan inf -inf)
   endif()
 endforeach()
 
+execute_process(
+  COMMAND "${Python3_EXECUTABLE}" "${_script}"
+    --baseline "${_complexity_baseline_json}"
+    --current "${_complexity_current_json}"
+    --metric median_ns_per_item
+  RESULT_VARIABLE _complexity_fail_rc
+  OUTPUT_VARIABLE _complexity_fail_out
+  ERROR_VARIABLE _complexity_fail_err)
+if(NOT _complexity_fail_rc EQUAL 1)
+  message(FATAL_ERROR
+    "A best-fit complexity class that gets worse versus the baseline must fail the comparison.\n"
+    "stdout:\n${_complexity_fail_out}\n"
+    "stderr:\n${_complexity_fail_err}")
+endif()
+foreach(_required_complexity IN ITEMS "Complexity Changes" "| regression | <code>bench/insert(n)</code> | <code>O(n)</code> | <code>O(n^2)</code> |"
+                                      "| improvement | <code>bench/lookup(n)</code>")
+  string(FIND "${_complexity_fail_out}" "${_required_complexity}" _complexity_pos)
+  if(_complexity_pos EQUAL -1)
+    message(FATAL_ERROR
+      "Complexity comparison output missing '${_required_complexity}'.\n"
+      "stdout:\n${_complexity_fail_out}")
+  endif()
+endforeach()
+
+file(WRITE "${_environment_baseline_json}" [=[
+{"report":"bench","environment":{"cpu_governor":"performance","no_turbo":true,"smt_active":false,"loadavg_1m":0.1,"loadavg_5m":0.1,"loadavg_15m":0.1,"aslr":0,"online_cpus":8,"pinned_cpu":2,"pinned_cpu_siblings":"2"},"tables":[{"report":"bench","id":"bench.summary","title":"Benchmarks","rows":[{"benchmark":"bench/env","suite":"bench","median_ns_per_item":10.0}]}],"issues":[]}
+]=])
+file(WRITE "${_environment_current_csv}" [=[
+report,table,row,field,type,value
+measured,environment,0,cpu_governor,string,powersave
+measured,environment,0,no_turbo,bool,true
+measured,environment,0,smt_active,bool,false
+measured,environment,0,loadavg_1m,number,3.5
+measured,environment,0,aslr,number,0
+measured,environment,0,online_cpus,number,8
+measured,environment,0,pinned_cpu,null,
+bench,bench.summary,0,benchmark,string,bench/env
+bench,bench.summary,0,suite,string,bench
+bench,bench.summary,0,median_ns_per_item,number,10
+]=])
+
+foreach(_environment_policy IN ITEMS report fail)
+  set(_environment_args)
+  set(_environment_expected_rc 0)
+  if(_environment_policy STREQUAL "fail")
+    set(_environment_args --fail-on-environment-mismatch)
+    set(_environment_expected_rc 1)
+  endif()
+  execute_process(
+    COMMAND "${Python3_EXECUTABLE}" "${_script}"
+      --baseline "${_environment_baseline_json}"
+      --current "${_environment_current_csv}"
+      --metric median_ns_per_item
+      ${_environment_args}
+    RESULT_VARIABLE _environment_rc
+    OUTPUT_VARIABLE _environment_out
+    ERROR_VARIABLE _environment_err)
+  if(NOT _environment_rc EQUAL _environment_expected_rc)
+    message(FATAL_ERROR
+      "Environment differences should exit ${_environment_expected_rc} under the '${_environment_policy}' policy.\n"
+      "stdout:\n${_environment_out}\n"
+      "stderr:\n${_environment_err}")
+  endif()
+  foreach(_required_environment IN ITEMS "| Environment differences | 2 |"
+                                         "| <code>cpu_governor</code> | <code>performance</code> | <code>powersave</code> |"
+                                         "| <code>pinned_cpu</code> | <code>2</code> | <code>null</code> |")
+    string(FIND "${_environment_out}" "${_required_environment}" _environment_pos)
+    if(_environment_pos EQUAL -1)
+      message(FATAL_ERROR
+        "Environment comparison output missing '${_required_environment}'.\n"
+        "stdout:\n${_environment_out}")
+    endif()
+  endforeach()
+endforeach()
+
 execute_process(
   COMMAND "${Python3_EXECUTABLE}" "${_script}"
     --baseline "${_truncated_csv}"
@@ -123,8 +123,9 @@ else()
 endif()
 
 function(_gentest_run_codegen_fixture output_stem)
-  set(multi_value_args SOURCES)
-  cmake_parse_arguments(GENTEST "" "" "${multi_value_args}" ${ARGN})
+  set(one_value_args OUTPUT_VARIABLE)
+  set(multi_value_args SOURCES LAUNCHER EXTRA_ARGS)
+  cmake_parse_arguments(GENTEST "" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
   if(NOT GENTEST_SOURCES)
     message(FATAL_ERROR "_gentest_run_codegen_fixture requires at least one source")
@@ -158,6 +159,7 @@ function(_gentest_run_codegen_fixture output_stem)
 
   gentest_check_run_or_fail(
     COMMAND
+      ${GENTEST_LAUNCHER}
       "${_codegen_exe}"
       --tu-out-dir "${_tu_output_dir}"
       ${_tu_output_args}
@@ -174,6 +176,7 @@ function(_gentest_run_codegen_fixture output_stem)
       --clang-scan-deps "${_clang_scan_deps}"
       --host-clang "${_clangxx}"
       --source-root "${_src_dir}"
+      ${GENTEST_EXTRA_ARGS}
       ${GENTEST_SOURCES}
       --
       -std=c++20
@@ -181,7 +184,11 @@ function(_gentest_run_codegen_fixture output_stem)
       c++-module
       -DGENTEST_CODEGEN=1
     WORKING_DIRECTORY "${_work_dir}"
+    OUTPUT_VARIABLE _codegen_output
     STRIP_TRAILING_WHITESPACE)
+  if(GENTEST_OUTPUT_VARIABLE)
+    set(${GENTEST_OUTPUT_VARIABLE} "${_codegen_output}" PARENT_SCOPE)
+  endif()
 endfunction()
 
 message(STATUS "Run gentest_codegen for the dot module target...")
@@ -231,4 +238,39 @@ list(LENGTH _pcm_basename_unique _pcm_basename_unique_count)
 _gentest_expect_equal("${_pcm_basename_count}" "2" "total PCM basename count")
 _gentest_expect_equal("${_pcm_basename_unique_count}" "2" "unique PCM basename count")
 
+message(STATUS "Run gentest_codegen for two targets sharing a content-addressed BMI store...")
+set(_bmi_store "${_work_dir}/bmi_store")
+_gentest_run_codegen_fixture(
+  "pcm_store_first_generated"
+  EXTRA_ARGS "--module-bmi-cache=${_bmi_store}"
+  SOURCES
+    "${_src_dir}/alpha_dot_provider.cppm"
+    "${_src_dir}/alpha_dot_consumer.cppm")
+file(GLOB _stored_bmis LIST_DIRECTORIES FALSE "${_bmi_store}/*.pcm")
+file(GLOB _stored_entries LIST_DIRECTORIES FALSE "${_bmi_store}/*.json")
+list(LENGTH _stored_bmis _stored_bmi_count)
+list(LENGTH _stored_entries _stored_entry_count)
+if(_stored_bmi_count LESS 1)
+  message(FATAL_ERROR "Expected the first run to populate the BMI store '${_bmi_store}', found no BMIs")
+endif()
+_gentest_expect_equal("${_stored_entry_count}" "${_stored_bmi_count}" "BMI store entry count")
+
+_gentest_run_codegen_fixture(
+  "pcm_store_second_generated"
+  LAUNCHER "${CMAKE_COMMAND}" -E env GENTEST_CODEGEN_LOG_PRECOMPILE=1
+  EXTRA_ARGS "--module-bmi-cache=${_bmi_store}"
+  OUTPUT_VARIABLE _second_store_output
+  SOURCES
+    "${_src_dir}/alpha_dot_provider.cppm"
+    "${_src_dir}/alpha_dot_consumer.cppm")
+if(NOT _second_store_output MATCHES "reused cached BMI [0-9a-f]+ for module 'gentest\\.pcm_cache\\.alpha\\.beta\\.provider'")
+  message(FATAL_ERROR "Expected the second target to reuse the stored provider BMI. Output:\n${_second_store_output}")
+endif()
+if(_second_store_output MATCHES "module precompile command for 'gentest\\.pcm_cache\\.alpha\\.beta\\.provider'")
+  message(FATAL_ERROR "Expected no provider precompile in the second target. Output:\n${_second_store_output}")
+endif()
+file(GLOB _stored_bmis_after LIST_DIRECTORIES FALSE "${_bmi_store}/*.pcm")
+list(LENGTH _stored_bmis_after _stored_bmi_count_after)
+_gentest_expect_equal("${_stored_bmi_count_after}" "${_stored_bmi_count}" "BMI store size after a cached run")
+
 message(STATUS "Shared-build-tree PCM cache isolation regression passed")
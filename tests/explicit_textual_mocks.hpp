@@ -7,6 +7,7 @@ namespace gentest::test_mocks {
 
 using ConsumerServiceMock            = gentest::mock<consumer::Service>;
 using CalculatorMock                 = gentest::mock<mocking::Calculator>;
+using ScalerMock                     = gentest::mock<mocking::Scaler>;
 using RefProviderMock                = gentest::mock<mocking::RefProvider>;
 using TickerMock                     = gentest::mock<mocking::Ticker>;
 using NoDefaultMock                  = gentest::mock<mocking::NoDefault>;
@@ -31,6 +31,46 @@ void predicate_mismatch() {
 
 namespace failing {
 
+void composed_predicate_mismatch() {
+    using namespace gentest::match;
+    gentest::mock<mocking::Ticker> mock_obj;
+    gentest::expect<&mocking::Ticker::tick>(mock_obj, "::mocking::Ticker::tick").where_args(Eq(1) || Eq(2)).times(1);
+    mock_obj.tick(4);
+}
+
+} // namespace failing
+
+namespace failing {
+
+void replay_argument_mismatch() {
+    struct Adder final : mocking::Calculator {
+        int  compute(int lhs, int rhs) override { return lhs + rhs; }
+        void reset() override {}
+    };
+    const std::string trace = (std::filesystem::temp_directory_path() /
+                               ("gentest_failing_replay_mismatch-" + std::to_string(std::random_device{}()) + ".trace"))
+                                  .string();
+
+    Adder real;
+    {
+        gentest::mock<mocking::Calculator> recorder;
+        gentest::record_calls(recorder, real, trace);
+        mocking::Calculator *iface = &recorder;
+        (void)iface->compute(2, 3);
+    }
+    gentest::mock<mocking::Calculator> replayer;
+    gentest::replay_calls(replayer, trace);
+    mocking::Calculator *iface = &replayer;
+    // Mismatch: the second argument differs from the recorded call
+    (void)iface->compute(2, 4);
+    std::error_code ec;
+    std::filesystem::remove(trace, ec);
+}
+
+} // namespace failing
+
+namespace failing {
+
 void ambiguous_template_member_pointer() {
     gentest::mock<mocking::Ticker> mock_obj;
     gentest::expect(mock_obj, &mocking::Ticker::tadd<int>).times(1);
@@ -5,8 +5,11 @@ using namespace gentest::asserts;
 
 #include "public/gentest_textual_suite_mocks.hpp"
 
+#include <filesystem>
 #include <memory>
+#include <random>
 #include <stdexcept>
+#include <string>
 
 namespace failing {
 
@@ -33,6 +36,12 @@ void will_fail();
 [[using gentest: test("mocking/predicate_mismatch")]]
 void predicate_mismatch();
 
+[[using gentest: test("mocking/composed_predicate_mismatch")]]
+void composed_predicate_mismatch();
+
+[[using gentest: test("mocking/replay_argument_mismatch")]]
+void replay_argument_mismatch();
+
 [[using gentest: test("mocking/ambiguous_template_member_pointer")]]
 void ambiguous_template_member_pointer();
 
@@ -520,6 +520,106 @@ void matchers_ge_anyof() {
 
 namespace mocking {
 
+void matchers_compose() {
+    using namespace gentest::match;
+    gentest::mock<Ticker> mock_tick;
+    int                   count = 0;
+    EXPECT_CALL(mock_tick, tick).times(3).where_args((Ge(1) && Le(9) && !Eq(3)) || Eq(42)).invokes([&](int) { ++count; });
+
+    mock_tick.tick(1);
+    mock_tick.tick(9);
+    mock_tick.tick(42);
+    EXPECT_EQ(count, 3);
+
+    const auto in_range = Ge(1) && Le(9) && !Eq(3);
+    EXPECT_TRUE(in_range.test(5));
+    EXPECT_FALSE(in_range.test(3));
+    EXPECT_EQ(in_range.describe(3), std::string("expected all of: expected >= 1, got 3; expected <= 9, got 3; not(expected == 3, got 3)"));
+}
+
+} // namespace mocking
+
+namespace mocking {
+
+void actions_large_capture() {
+    // The capture does not fit the expectation's inline buffer, so the action is held on the heap.
+    std::array<int, 64> weights{};
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = static_cast<int>(i);
+    }
+    gentest::mock<Calculator> mock_calc;
+    EXPECT_CALL(mock_calc, compute).times(2).invokes([weights](int lhs, int rhs) { return weights[lhs] + weights[rhs]; });
+
+    Calculator *iface = &mock_calc;
+    EXPECT_EQ(iface->compute(3, 4), 7);
+    EXPECT_EQ(iface->compute(60, 63), 123);
+}
+
+} // namespace mocking
+
+namespace mocking {
+
+void record_replay_calculator() {
+    struct Adder final : Calculator {
+        int  resets = 0;
+        int  compute(int lhs, int rhs) override { return lhs + rhs; }
+        void reset() override { ++resets; }
+    };
+    const scoped_trace_file trace("gentest_mocking_record_replay");
+
+    Adder real;
+    {
+        gentest::mock<Calculator> recorder;
+        gentest::record_calls(recorder, real, trace.path);
+        Calculator *iface = &recorder;
+        EXPECT_EQ(iface->compute(2, 3), 5);
+        iface->reset();
+        EXPECT_EQ(iface->compute(10, -4), 6);
+    }
+    EXPECT_EQ(real.resets, 1);
+
+    gentest::mock<Calculator> replayer;
+    gentest::replay_calls(replayer, trace.path);
+    Calculator *iface = &replayer;
+    EXPECT_EQ(iface->compute(2, 3), 5);
+    iface->reset();
+    EXPECT_EQ(iface->compute(10, -4), 6);
+}
+
+} // namespace mocking
+
+namespace mocking {
+
+void record_replay_overloads() {
+    struct Real final : Scaler {
+        int    scale(int value) override { return value * 10; }
+        double scale(double value) override { return value * 100.0; }
+    };
+    const scoped_trace_file trace("gentest_mocking_record_replay_overloads");
+
+    Real real;
+    {
+        gentest::mock<Scaler> recorder;
+        gentest::record_calls(recorder, real, trace.path);
+        Scaler *iface = &recorder;
+        EXPECT_EQ(iface->scale(2), 20);
+        EXPECT_EQ(iface->scale(2.5), 250.0);
+        EXPECT_EQ(iface->scale(3), 30);
+    }
+
+    // Each overload replays its own calls, whatever the interleaving.
+    gentest::mock<Scaler> replayer;
+    gentest::replay_calls(replayer, trace.path);
+    Scaler *iface = &replayer;
+    EXPECT_EQ(iface->scale(2), 20);
+    EXPECT_EQ(iface->scale(3), 30);
+    EXPECT_EQ(iface->scale(2.5), 250.0);
+}
+
+} // namespace mocking
+
+namespace mocking {
+
 void concurrency_adopted_ordered_dispatch() {
     gentest::mock<Calculator> mock_calc;
     std::mutex                gate_mtx;
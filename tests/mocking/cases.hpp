@@ -8,8 +8,11 @@
 #include <array>
 #include <atomic>
 #include <condition_variable>
+#include <filesystem>
 #include <list>
 #include <mutex>
+#include <random>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <type_traits>
@@ -18,6 +21,20 @@
 using namespace gentest::asserts;
 namespace mocking {
 
+// Per-run trace file under the temp directory, removed again on scope exit.
+struct scoped_trace_file {
+    std::string path;
+
+    explicit scoped_trace_file(const std::string &stem)
+        : path((std::filesystem::temp_directory_path() / (stem + "-" + std::to_string(std::random_device{}()) + ".trace")).string()) {}
+    scoped_trace_file(const scoped_trace_file &)            = delete;
+    scoped_trace_file &operator=(const scoped_trace_file &) = delete;
+    ~scoped_trace_file() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
 static_assert(!std::is_default_constructible_v<gentest::mock<NoDefault>>);
 static_assert(std::is_nothrow_constructible_v<gentest::mock<NoDefault>, int>);
 static_assert(std::is_constructible_v<gentest::mock<NoDefault>, int, long>);
@@ -132,6 +149,18 @@ void matchers_near();
 [[using gentest: test("mocking/matchers/ge_anyof")]]
 void matchers_ge_anyof();
 
+[[using gentest: test("mocking/matchers/compose")]]
+void matchers_compose();
+
+[[using gentest: test("mocking/actions/large_capture")]]
+void actions_large_capture();
+
+[[using gentest: test("mocking/record_replay/calculator")]]
+void record_replay_calculator();
+
+[[using gentest: test("mocking/record_replay/overloads")]]
+void record_replay_overloads();
+
 [[using gentest: test("mocking/concurrency/adopted_ordered_dispatch")]]
 void concurrency_adopted_ordered_dispatch();
 
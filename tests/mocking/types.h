@@ -15,6 +15,12 @@ struct Calculator {
     virtual void reset()                   = 0;
 };
 
+struct Scaler {
+    virtual ~Scaler()                  = default;
+    virtual int    scale(int value)    = 0;
+    virtual double scale(double value) = 0;
+};
+
 struct RefProvider {
     virtual ~RefProvider() = default;
     virtual int &value()   = 0;
@@ -30,6 +30,9 @@ struct CaseLayoutMirror {
     bool                              is_async{false};
     std::uint64_t                     items_per_call{1};
     std::string_view                  owner{};
+    double                            complexity_n{0.0};
+    std::string_view                  complexity_series{};
+    gentest::BenchCache               bench_cache{gentest::BenchCache::Default};
 };
 
 static_assert(!kCompleteType<gentest::detail::AsyncTask>, "gentest/test.h and Case must not parse the full async implementation");
@@ -55,6 +58,9 @@ static_assert(offsetof(gentest::Case, async_fn) == offsetof(CaseLayoutMirror, as
 static_assert(offsetof(gentest::Case, is_async) == offsetof(CaseLayoutMirror, is_async));
 static_assert(offsetof(gentest::Case, items_per_call) == offsetof(CaseLayoutMirror, items_per_call));
 static_assert(offsetof(gentest::Case, owner) == offsetof(CaseLayoutMirror, owner));
+static_assert(offsetof(gentest::Case, complexity_n) == offsetof(CaseLayoutMirror, complexity_n));
+static_assert(offsetof(gentest::Case, complexity_series) == offsetof(CaseLayoutMirror, complexity_series));
+static_assert(offsetof(gentest::Case, bench_cache) == offsetof(CaseLayoutMirror, bench_cache));
 
 [[using gentest: test("narrow_surface/metadata"), fast, req("NARROW-1"), owner("headers"), skip("compile-only")]]
 void synchronous_case_declaration() {}
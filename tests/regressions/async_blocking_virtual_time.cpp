@@ -0,0 +1,59 @@
+#include "gentest/async.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+auto sleep_an_hour() -> gentest::async_test<void> {
+    const auto start = gentest::async::now();
+    co_await gentest::async::sleep_for(1h);
+    if (gentest::async::now() - start < 1h) {
+        throw std::runtime_error("virtual clock did not advance to the sleep deadline");
+    }
+}
+
+auto sleep_briefly_on_steady_clock() -> gentest::async_test<void> {
+    const auto start = std::chrono::steady_clock::now();
+    co_await gentest::async::sleep_for(2ms);
+    if (gentest::async::now() - start < 2ms) {
+        throw std::runtime_error("real-time sleep returned before its deadline");
+    }
+}
+
+auto fail(std::string_view message) -> int {
+    std::cerr << message << '\n';
+    return 1;
+}
+
+} // namespace
+
+int main() try {
+    std::string error;
+    if (gentest::detail::set_blocking_async_virtual_time(true)) {
+        return fail("blocking virtual time should default to off");
+    }
+    const auto wall_start = std::chrono::steady_clock::now();
+    if (!gentest::detail::run_async_task_blocking(sleep_an_hour(), "blocking virtual time", error)) {
+        return fail(error);
+    }
+    if (std::chrono::steady_clock::now() - wall_start > 5s) {
+        return fail("virtual-time sleep waited on the wall clock");
+    }
+
+    if (!gentest::detail::set_blocking_async_virtual_time(false)) {
+        return fail("set_blocking_async_virtual_time should return the previous setting");
+    }
+    if (!gentest::detail::run_async_task_blocking(sleep_briefly_on_steady_clock(), "blocking real time", error)) {
+        return fail(error);
+    }
+    return 0;
+} catch (const std::exception &ex) { return fail(ex.what()); } catch (...) {
+    return fail("unknown exception");
+}
@@ -0,0 +1,175 @@
+#include "../../src/async_io_poller.h"
+#include "gentest/async.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#define GENTEST_REGRESSION_HAS_POSIX_IO 1
+#endif
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using gentest::runner::AsyncIoPoller;
+
+constexpr int  kNotifiers        = 4;
+constexpr auto kStressDuration   = 300ms;
+constexpr int  kFollowUpWakeups  = 100;
+constexpr auto kWakeupDeadline   = 2s;
+constexpr auto kMaxWakeupLatency = 1s;
+
+auto make_token() -> gentest::detail::AsyncScheduler::WaiterTokenPtr {
+    return std::make_shared<gentest::detail::AsyncWaiterToken>(std::weak_ptr<gentest::detail::AsyncScheduler::Control>{});
+}
+
+auto fail(std::string_view message) -> int {
+    std::cerr << "FAIL: " << message << '\n';
+    return 1;
+}
+
+#if defined(GENTEST_REGRESSION_HAS_POSIX_IO)
+struct Pipe {
+    int read_end  = -1;
+    int write_end = -1;
+
+    Pipe() {
+        int fds[2] = {-1, -1};
+        if (::pipe(fds) == 0) {
+            read_end  = fds[0];
+            write_end = fds[1];
+        }
+    }
+    Pipe(const Pipe &)            = delete;
+    Pipe &operator=(const Pipe &) = delete;
+    ~Pipe() {
+        if (read_end >= 0) {
+            ::close(read_end);
+        }
+        if (write_end >= 0) {
+            ::close(write_end);
+        }
+    }
+};
+
+// Several threads interrupt while the waiter loops in wait(). A drain that
+// swallowed a notification without clearing `pending` would leave every later
+// interrupt without a write, so the follow-up waits would sleep to their
+// deadline.
+auto interrupts_racing_drain_are_not_lost() -> int {
+    AsyncIoPoller poller;
+    Pipe          idle;
+    if (idle.read_end < 0) {
+        return fail("pipe() failed");
+    }
+    // A watch that never fires keeps wait() blocking in the kernel.
+    poller.watch(idle.read_end, gentest::detail::AsyncIoInterest::Readable, make_token());
+
+    const auto               interrupt = poller.interrupter();
+    const auto               until     = std::chrono::steady_clock::now() + kStressDuration;
+    std::atomic<bool>        done{false};
+    std::vector<std::thread> notifiers;
+    for (int i = 0; i < kNotifiers; ++i) {
+        notifiers.emplace_back([&] {
+            while (std::chrono::steady_clock::now() < until) {
+                interrupt();
+            }
+        });
+    }
+    std::thread waiter([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            (void)poller.wait(std::chrono::steady_clock::now() + 10ms);
+        }
+    });
+    for (auto &notifier : notifiers) {
+        notifier.join();
+    }
+    done.store(true, std::memory_order_release);
+    waiter.join();
+
+    for (int i = 0; i < kFollowUpWakeups; ++i) {
+        interrupt();
+        const auto start = std::chrono::steady_clock::now();
+        (void)poller.wait(start + kWakeupDeadline);
+        if (std::chrono::steady_clock::now() - start >= kMaxWakeupLatency) {
+            return fail("an interrupt after concurrent notifications did not wake wait()");
+        }
+    }
+    return 0;
+}
+#endif
+
+#if defined(__linux__)
+// With no descriptor numbers left the poller cannot open its eventfd; watch()
+// must report that instead of dropping the waiter.
+auto watch_reports_open_failure() -> int {
+    rlimit saved{};
+    if (::getrlimit(RLIMIT_NOFILE, &saved) != 0) {
+        return fail("getrlimit failed");
+    }
+    const int lowest_free = ::dup(0);
+    if (lowest_free < 0) {
+        return fail("dup failed");
+    }
+    ::close(lowest_free);
+    rlimit exhausted   = saved;
+    exhausted.rlim_cur = static_cast<rlim_t>(lowest_free);
+    if (::setrlimit(RLIMIT_NOFILE, &exhausted) != 0) {
+        return fail("setrlimit failed");
+    }
+    // Inspect the exception only once descriptors are available again.
+    AsyncIoPoller      poller;
+    std::exception_ptr failure;
+    try {
+        poller.watch(0, gentest::detail::AsyncIoInterest::Readable, make_token());
+    } catch (...) { failure = std::current_exception(); }
+    (void)::setrlimit(RLIMIT_NOFILE, &saved);
+
+    std::error_code error;
+    try {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    } catch (const std::system_error &ex) { error = ex.code(); }
+    if (error != std::errc::too_many_files_open) {
+        return fail("watch() did not throw EMFILE when the poller could not be opened");
+    }
+    if (poller.has_watches()) {
+        return fail("a watch that failed to open still counted as registered");
+    }
+    return 0;
+}
+#endif
+
+} // namespace
+
+int main() {
+#if defined(GENTEST_REGRESSION_HAS_POSIX_IO)
+    if (const int rc = interrupts_racing_drain_are_not_lost(); rc != 0) {
+        return rc;
+    }
+#else
+    AsyncIoPoller poller;
+    try {
+        poller.watch(0, gentest::detail::AsyncIoInterest::Readable, make_token());
+        return fail("watch() succeeded on a platform without an fd backend");
+    } catch (const std::system_error &) {}
+#endif
+#if defined(__linux__)
+    if (const int rc = watch_reports_open_failure(); rc != 0) {
+        return rc;
+    }
+#endif
+    return 0;
+}
@@ -86,6 +86,15 @@ class TrackingScheduler final : public gentest::detail::AsyncScheduler {
   public:
     void post(std::coroutine_handle<> handle) override { post_frame_from_core(handle); }
 
+    // Tokens reach the core either way; a late post is one that still queued
+    // its frame.
+    void post_waiter(gentest::detail::AsyncWaiterToken &token) override {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (core_.post_waiter(token) && record_late_posts_) {
+            ++late_posts_;
+        }
+    }
+
     void post_frame(const gentest::detail::AsyncFramePtr &frame) override {
         std::lock_guard<std::mutex> lk(mtx_);
         if (record_late_posts_) {
@@ -293,6 +302,29 @@ auto timed_wait_cleanup_after_scheduler_shutdown_task(std::shared_ptr<std::atomi
     }
 }
 
+// Makes a waiter for the awaiting frame, cancels it and resumes the frame
+// directly, the way a lost wait_for race leaves its waiter behind.
+struct CanceledWaiterAwaitable {
+    [[nodiscard]] constexpr auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        auto *scheduler = gentest::detail::current_async_scheduler();
+        scheduler->make_waiter(handle)->cancel();
+        scheduler->post(handle);
+    }
+
+    constexpr void await_resume() const noexcept {}
+};
+
+auto canceled_waiters_then_event_task(gentest::async::event<int> &event) -> gentest::async_test<void> {
+    for (int i = 0; i != 1000; ++i) {
+        co_await CanceledWaiterAwaitable{};
+    }
+    (void)co_await event.wait("done");
+}
+
+auto parked_task() -> gentest::async_test<void> { co_await std::suspend_always{}; }
+
 auto blocking_timer_stress_task() -> gentest::async_test<void> {
     for (int i = 0; i != 32; ++i) {
         auto result =
@@ -1050,6 +1082,91 @@ int main() try {
         }
     }
 
+    {
+        gentest::async::event<int> event;
+        TrackingScheduler          scheduler;
+        auto                       task = canceled_waiters_then_event_task(event);
+        scheduler.run_until_blocked(task);
+        if (gentest::runner::AsyncFramePool::frame_record(task.handle().address()) != task.frame().get()) {
+            return fail("a registered frame's allocation header did not point at its AsyncFrame");
+        }
+        if (task.frame()->links.waiter_count > 16) {
+            return fail("canceled waiters piled up on the frame's waiter list");
+        }
+        event.set("done", 1);
+        scheduler.run_ready();
+        if (!task.handle().done()) {
+            return fail("the event waiter behind many canceled waiters did not resume");
+        }
+        scheduler.cancel_waiters();
+        if (gentest::runner::AsyncFramePool::frame_record(task.handle().address()) != nullptr) {
+            return fail("an unlinked frame's allocation header still pointed at its AsyncFrame");
+        }
+    }
+
+    {
+        // Each owner's frames sit behind their own lock: posts for different
+        // owners from different threads must all land in the ready lanes.
+        constexpr std::size_t                  kOwners = 4;
+        constexpr std::size_t                  kPosts  = 500;
+        gentest::runner::AsyncSchedulerCore    core;
+        std::vector<gentest::async_test<void>> tasks;
+        for (std::size_t owner = 0; owner != kOwners; ++owner) {
+            tasks.push_back(parked_task());
+            core.register_frame(owner, tasks.back().frame());
+        }
+        std::atomic<bool>        wrong_owner{false};
+        std::vector<std::thread> threads;
+        for (std::size_t owner = 0; owner != kOwners; ++owner) {
+            threads.emplace_back([&, owner] {
+                const auto handle = tasks[owner].handle();
+                for (std::size_t i = 0; i != kPosts; ++i) {
+                    core.block(handle, "parked");
+                    core.make_waiter(handle, nullptr)->cancel();
+                    core.post(handle);
+                    if (core.owner_for(handle) != owner) {
+                        wrong_owner.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        if (wrong_owner.load(std::memory_order_relaxed)) {
+            return fail("a frame reported another owner while other owners posted");
+        }
+        if (core.ready_size() != kOwners * kPosts) {
+            return fail("concurrent posts for different owners were lost");
+        }
+        core.cancel_owner(0);
+        if (core.ready_size() != (kOwners - 1) * kPosts || !tasks[0].frame()->is_canceled() || tasks[1].frame()->is_canceled()) {
+            return fail("canceling one owner touched another owner's frames");
+        }
+    }
+
+    {
+        // A child attached under a parent of another owner moves to that owner
+        // together with the waiters made for it.
+        gentest::runner::AsyncSchedulerCore core;
+        auto                                parent = parked_task();
+        auto                                child  = parked_task();
+        core.register_frame(1, parent.frame());
+        core.register_frame(0, child.frame());
+        auto token = core.make_waiter(child.handle(), nullptr);
+        core.attach_child(child.frame(), parent.handle());
+        if (core.owner_for(child.handle()) != 1) {
+            return fail("a child attached across owners did not move to its parent's owner");
+        }
+        if (!core.post_waiter(*token) || core.owner_for(core.pop_ready()) != 1) {
+            return fail("a waiter made before its frame moved did not queue it under the new owner");
+        }
+        core.cancel_owner(1);
+        if (!child.frame()->is_canceled()) {
+            return fail("canceling the new owner did not cancel the moved child");
+        }
+    }
+
     {
         gentest::async::event<int> event;
         TrackingScheduler          scheduler;
@@ -1,5 +1,6 @@
 #include "../../src/runner_async_status_renderer.h"
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -484,6 +485,70 @@ int main() {
         return fail("terminal result lines should not be escaped like user log messages", raw_result_output);
     }
 
+    using Refresh = gentest::runner::AsyncStatusRenderer::Refresh;
+
+    auto                                 diff_now = gentest::runner::AsyncStatusRenderer::MonotonicClock::time_point{};
+    std::ostringstream                   diff_out;
+    gentest::runner::AsyncStatusRenderer diff(diff_out, gentest::runner::AsyncStatusRenderer::Mode::Terminal, false,
+                                              {.width = 80, .height = 12}, 2, [&diff_now] { return diff_now; }, Refresh::Diff);
+    diff.add_case(0, "async/live/diff_first");
+    diff.add_case(1, "async/live/diff_second");
+    diff.add_case(2, "async/live/diff_third");
+    diff_now += gentest::runner::AsyncStatusRenderer::kTerminalRefreshInterval;
+    diff.refresh_if_due();
+    if (!contains(diff_out.str(), "async/live/diff_third")) {
+        return fail("diff refresh should append rows added since the last refresh", diff_out.str());
+    }
+
+    auto before_patch = diff_out.str();
+    diff_now += gentest::runner::AsyncStatusRenderer::kTerminalRefreshInterval;
+    diff.mark_suspended(1, "patched");
+    auto patch = diff_out.str().substr(before_patch.size());
+    if (!contains(patch, "\033[2A\r\033[2K[ SUSPENDED ] async/live/diff_second :: patched") || contains(patch, "diff_first") ||
+        contains(patch, "diff_third") || !contains(patch, "\033[2B\r")) {
+        return fail("diff refresh should rewrite only the changed row in place", patch);
+    }
+
+    before_patch = diff_out.str();
+    diff.mark_suspended(1, "patched");
+    diff_now += gentest::runner::AsyncStatusRenderer::kTerminalRefreshInterval;
+    diff.refresh_if_due();
+    if (diff_out.str() != before_patch) {
+        return fail("diff refresh should write nothing when no visible line changed", diff_out.str().substr(before_patch.size()));
+    }
+
+    diff.append_log(0, "diff log one", 1);
+    diff.append_log(0, "diff log two", 2);
+    diff.append_log(0, "diff log three", 3);
+    snapshot = diff.render_snapshot_for_test();
+    if (!contains(snapshot, "diff_first :: 3 log(s)") || contains(snapshot, "\ndiff log one\n") ||
+        !contains(snapshot, "\ndiff log two\n") || !contains(snapshot, "\ndiff log three\n")) {
+        return fail("appended logs should keep only the newest tail lines", snapshot);
+    }
+
+    diff_now += gentest::runner::AsyncStatusRenderer::kTerminalRefreshInterval;
+    diff.refresh_if_due();
+    before_patch = diff_out.str();
+    diff.mark_final(2, gentest::runner::AsyncLiveStatus::Pass, {}, 3);
+    patch = diff_out.str().substr(before_patch.size());
+    if (patch != "\033[1A\r\033[2K\r") {
+        return fail("finishing the last row should only blank its line", patch);
+    }
+    diff.finish();
+
+    auto                                 slow_now = gentest::runner::AsyncStatusRenderer::MonotonicClock::time_point{};
+    std::ostringstream                   slow_out;
+    gentest::runner::AsyncStatusRenderer slow(
+        slow_out, gentest::runner::AsyncStatusRenderer::Mode::Terminal, false, {.width = 80, .height = 12}, 5,
+        [&slow_now] { return slow_now += std::chrono::milliseconds(100); }, Refresh::Diff);
+    slow.add_case(0, "async/live/slow_render");
+    slow.mark_suspended(0, "throttled");
+    const auto slow_deadline = slow.next_refresh_deadline();
+    if (!slow_deadline.has_value() || *slow_deadline < slow_now + std::chrono::milliseconds(300)) {
+        return fail("an expensive diff refresh should stretch the refresh interval", slow_out.str());
+    }
+    slow.finish();
+
     std::ostringstream                   disabled_out;
     gentest::runner::AsyncStatusRenderer disabled(disabled_out, gentest::runner::AsyncStatusRenderer::Mode::Disabled, true);
     disabled.add_case(0, "async/live/disabled");
@@ -0,0 +1,226 @@
+#include "../../src/async_timer_queue.h"
+#include "gentest/async.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using gentest::detail::AsyncTimerHeap;
+using gentest::detail::AsyncTimerWheel;
+using time_point     = std::chrono::steady_clock::time_point;
+using WaiterTokenPtr = gentest::detail::AsyncScheduler::WaiterTokenPtr;
+
+// The wheel's ticks are 2^20 ns; four 64-slot levels cover 2^24 ticks.
+constexpr auto kTick        = std::chrono::nanoseconds{std::int64_t{1} << 20};
+constexpr auto kWheelSpan   = kTick * (std::int64_t{1} << 24);
+const auto     kEpoch       = time_point{} + 24h;
+constexpr int  kRandomCount = 2000;
+
+struct Timer {
+    time_point     deadline;
+    WaiterTokenPtr token;
+};
+
+auto make_token() -> WaiterTokenPtr {
+    return std::make_shared<gentest::detail::AsyncWaiterToken>(std::weak_ptr<gentest::detail::AsyncScheduler::Control>{});
+}
+
+auto fail(std::string_view message) -> bool {
+    std::cerr << "FAIL: " << message << '\n';
+    return false;
+}
+
+// Steps the queue the way the virtual clock does: jump to the next deadline
+// and take what is due there. Returns the tokens in firing order.
+template <typename Queue> auto drain_by_deadline(Queue &queue, std::vector<time_point> *fired_at = nullptr) -> std::vector<WaiterTokenPtr> {
+    std::vector<WaiterTokenPtr> fired;
+    while (auto deadline = queue.next_deadline()) {
+        auto due = queue.pop_due(*deadline);
+        if (due.empty()) {
+            fired.clear();
+            return fired;
+        }
+        for (auto &token : due) {
+            if (fired_at) {
+                fired_at->push_back(*deadline);
+            }
+            fired.push_back(std::move(token));
+        }
+    }
+    return fired;
+}
+
+auto expect_order(const std::vector<WaiterTokenPtr> &fired, const std::vector<Timer> &expected, std::string_view what) -> bool {
+    if (fired.size() != expected.size()) {
+        return fail(what);
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        if (fired[i] != expected[i].token) {
+            return fail(what);
+        }
+    }
+    return true;
+}
+
+// Deadlines on every level, pushed out of order, including a tie that must
+// keep push order.
+auto long_deadlines_fire_in_order() -> bool {
+    const std::vector<std::chrono::nanoseconds> offsets{3h, 1s, 70s, 30min, 5ms, 1s, 4h + 50min, 2ms};
+    std::vector<Timer>                          timers;
+    AsyncTimerWheel                             wheel;
+    (void)wheel.pop_due(kEpoch);
+    for (const auto offset : offsets) {
+        timers.push_back(Timer{.deadline = kEpoch + offset, .token = make_token()});
+        wheel.push(timers.back().deadline, timers.back().token);
+    }
+    std::ranges::stable_sort(timers, {}, &Timer::deadline);
+
+    std::vector<time_point> fired_at;
+    const auto              fired = drain_by_deadline(wheel, &fired_at);
+    if (!expect_order(fired, timers, "long deadlines fired out of order")) {
+        return false;
+    }
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+        if (fired_at[i] != timers[i].deadline) {
+            return fail("a long deadline fired at the wrong time");
+        }
+    }
+    return true;
+}
+
+// A timer pushed while the clock is far away sits on a high level; advancing
+// in small steps must move it down level by level without firing it early.
+auto reslotting_never_fires_early() -> bool {
+    AsyncTimerWheel wheel;
+    (void)wheel.pop_due(kEpoch);
+    const auto deadline = kEpoch + 2h + 3min + 7s + 11ms;
+    auto       token    = make_token();
+    wheel.push(deadline, token);
+
+    for (auto now = kEpoch; now < deadline; now += 17s + 3ms) {
+        if (!wheel.pop_due(now).empty()) {
+            return fail("re-slotted timer fired before its deadline");
+        }
+        if (wheel.next_deadline() != deadline) {
+            return fail("re-slotted timer lost its deadline");
+        }
+    }
+    if (!wheel.pop_due(deadline - 1ns).empty()) {
+        return fail("re-slotted timer fired one nanosecond early");
+    }
+    const auto due = wheel.pop_due(deadline);
+    if (due.size() != 1 || due.front() != token || wheel.has_pending()) {
+        return fail("re-slotted timer did not fire at its deadline");
+    }
+    return true;
+}
+
+// Deadlines past the wheel's 2^24-tick span wait in the overflow list and must
+// still come out in order once the clock gets close enough to re-slot them.
+auto overflow_deadlines_fire_in_order() -> bool {
+    AsyncTimerWheel wheel;
+    (void)wheel.pop_due(kEpoch);
+    std::vector<Timer> timers{
+        Timer{.deadline = kEpoch + kWheelSpan * 3 + 5s, .token = make_token()},
+        Timer{.deadline = kEpoch + 10ms, .token = make_token()},
+        Timer{.deadline = kEpoch + kWheelSpan + 1ms, .token = make_token()},
+        Timer{.deadline = kEpoch + kWheelSpan * 40, .token = make_token()},
+        Timer{.deadline = kEpoch + kWheelSpan + 1ms, .token = make_token()},
+    };
+    for (const auto &timer : timers) {
+        wheel.push(timer.deadline, timer.token);
+    }
+    std::ranges::stable_sort(timers, {}, &Timer::deadline);
+
+    const auto early = wheel.pop_due(kEpoch + kWheelSpan);
+    if (early.size() != 1 || early.front() != timers.front().token) {
+        return fail("overflow timers fired before their deadline");
+    }
+    if (wheel.next_deadline() != timers[1].deadline) {
+        return fail("overflow timer was not the next deadline");
+    }
+    timers.erase(timers.begin());
+    return expect_order(drain_by_deadline(wheel), timers, "overflow timers fired out of order");
+}
+
+// next_deadline() answers from the cached overflow minimum; it must follow a
+// canceled minimum, an earlier push, and a push behind an unknown minimum.
+auto overflow_minimum_follows_cancel_and_push() -> bool {
+    AsyncTimerWheel wheel;
+    (void)wheel.pop_due(kEpoch);
+    const auto first  = make_token();
+    const auto second = make_token();
+    wheel.push(kEpoch + kWheelSpan * 2, first);
+    wheel.push(kEpoch + kWheelSpan * 3, second);
+    if (wheel.next_deadline() != kEpoch + kWheelSpan * 2) {
+        return fail("overflow minimum was not the next deadline");
+    }
+    first->cancel();
+    if (wheel.next_deadline() != kEpoch + kWheelSpan * 3) {
+        return fail("a canceled overflow minimum was still reported");
+    }
+    const auto earlier = make_token();
+    wheel.push(kEpoch + kWheelSpan + 5s, earlier);
+    if (wheel.next_deadline() != kEpoch + kWheelSpan + 5s) {
+        return fail("an earlier overflow push did not become the next deadline");
+    }
+    earlier->cancel();
+    const auto later = make_token();
+    wheel.push(kEpoch + kWheelSpan * 4, later);
+    if (wheel.next_deadline() != kEpoch + kWheelSpan * 3) {
+        return fail("a push after the overflow minimum was canceled hid the real minimum");
+    }
+    return true;
+}
+
+// Random deadlines across all levels and the overflow list, with a third of
+// them canceled, must drain in the same order from the wheel and the heap.
+auto wheel_matches_heap() -> bool {
+    std::mt19937_64                             rng{0x5eed};
+    std::uniform_int_distribution<std::int64_t> ticks{0, std::int64_t{1} << 26};
+    std::uniform_int_distribution<std::int64_t> jitter{0, kTick.count() - 1};
+    AsyncTimerWheel                             wheel;
+    AsyncTimerHeap                              heap;
+    std::vector<WaiterTokenPtr>                 tokens;
+    (void)wheel.pop_due(kEpoch);
+    for (int i = 0; i < kRandomCount; ++i) {
+        const auto deadline = kEpoch + kTick * ticks(rng) + std::chrono::nanoseconds{jitter(rng)};
+        tokens.push_back(make_token());
+        wheel.push(deadline, tokens.back());
+        heap.push(deadline, tokens.back());
+    }
+    for (std::size_t i = 0; i < tokens.size(); i += 3) {
+        tokens[i]->cancel();
+    }
+
+    const auto from_wheel = drain_by_deadline(wheel);
+    const auto from_heap  = drain_by_deadline(heap);
+    if (from_heap.size() != tokens.size() - (tokens.size() + 2) / 3) {
+        return fail("heap reference drained the wrong number of timers");
+    }
+    if (from_wheel != from_heap) {
+        return fail("wheel order differs from the heap");
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok      = long_deadlines_fire_in_order() && ok;
+    ok      = reslotting_never_fires_early() && ok;
+    ok      = overflow_deadlines_fire_in_order() && ok;
+    ok      = overflow_minimum_follows_cancel_and_push() && ok;
+    ok      = wheel_matches_heap() && ok;
+    return ok ? 0 : 1;
+}
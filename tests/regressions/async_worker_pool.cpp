@@ -0,0 +1,145 @@
+#include "gentest/async.h"
+#include "gentest/detail/registration_runtime.h"
+#include "gentest/runner.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <source_location>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kCaseCount  = 8;
+constexpr int         kIterations = 40;
+
+std::array<std::atomic<bool>, kCaseCount> g_suspending{};
+std::atomic<int>                          g_overlaps{0};
+std::mutex                                g_threads_mtx;
+std::set<std::thread::id>                 g_threads;
+
+void spin_for(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+void note_resume(std::size_t index) {
+    if (g_suspending[index].load(std::memory_order_acquire)) {
+        g_overlaps.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lk(g_threads_mtx);
+    g_threads.insert(std::this_thread::get_id());
+}
+
+// Makes the frame ready again before it has finished suspending and keeps the
+// suspending thread busy afterwards. A scheduler that let another worker take
+// the frame in that window would resume the case while `g_suspending` is set.
+struct requeue_while_suspending {
+    std::size_t index;
+
+    [[nodiscard]] constexpr auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        auto *scheduler = gentest::detail::current_async_scheduler();
+        if (!scheduler) {
+            std::abort();
+        }
+        g_suspending[index].store(true, std::memory_order_release);
+        scheduler->yield_at(handle, std::source_location::current());
+        spin_for(std::chrono::microseconds{100});
+        g_suspending[index].store(false, std::memory_order_release);
+    }
+
+    void await_resume() const { note_resume(index); }
+};
+
+auto requeue_loop(std::size_t index) -> gentest::async_test<void> {
+    note_resume(index);
+    for (int i = 0; i < kIterations; ++i) {
+        spin_for(std::chrono::microseconds{50});
+        co_await requeue_while_suspending{index};
+    }
+}
+
+void unused_sync(void *) {}
+
+template <std::size_t Index> auto requeue_loop_fn(void *) -> gentest::detail::AsyncTaskPtr {
+    return gentest::detail::make_async_task(requeue_loop(Index));
+}
+
+constexpr auto make_case(std::string_view name, gentest::detail::AsyncTaskPtr (*fn)(void *)) -> gentest::Case {
+    return {
+        .name             = name,
+        .fn               = &unused_sync,
+        .file             = __FILE__,
+        .line             = __LINE__,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = {},
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = {},
+        .fixture_lifetime = gentest::FixtureLifetime::None,
+        .suite            = "regressions",
+        .async_fn         = fn,
+        .is_async         = true,
+    };
+}
+
+gentest::Case kCases[] = {
+    make_case("regressions/async_worker_pool/00", &requeue_loop_fn<0>),
+    make_case("regressions/async_worker_pool/01", &requeue_loop_fn<1>),
+    make_case("regressions/async_worker_pool/02", &requeue_loop_fn<2>),
+    make_case("regressions/async_worker_pool/03", &requeue_loop_fn<3>),
+    make_case("regressions/async_worker_pool/04", &requeue_loop_fn<4>),
+    make_case("regressions/async_worker_pool/05", &requeue_loop_fn<5>),
+    make_case("regressions/async_worker_pool/06", &requeue_loop_fn<6>),
+    make_case("regressions/async_worker_pool/07", &requeue_loop_fn<7>),
+};
+
+auto run_with_workers(const char *argv0, const char *workers) -> int {
+    g_overlaps.store(0, std::memory_order_relaxed);
+    g_threads.clear();
+    std::vector<const char *> args{argv0, "--filter=regressions/async_worker_pool/*", "--kind=test", "--no-color", workers};
+    return gentest::run_all_tests(std::span<const char *>{args.data(), args.size()});
+}
+
+bool expect(bool condition, std::string_view message) {
+    if (!condition) {
+        std::fprintf(stderr, "FAIL: %.*s\n", static_cast<int>(message.size()), message.data());
+    }
+    return condition;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gentest::detail::register_cases(std::span<const gentest::Case>(kCases));
+    if (argc > 1) {
+        return gentest::run_all_tests(argc, argv);
+    }
+
+    bool ok = true;
+
+    ok = expect(run_with_workers(argv[0], "--async-workers=4") == 0, "pooled run should pass") && ok;
+    ok = expect(g_overlaps.load() == 0, "a case was resumed while its previous resume was still running") && ok;
+    ok = expect(g_threads.size() >= 2, "ready cases should spread across more than one worker") && ok;
+
+    ok = expect(run_with_workers(argv[0], "--async-workers=1") == 0, "serial run should pass") && ok;
+    ok = expect(g_threads.size() == 1 && g_threads.contains(std::this_thread::get_id()),
+                "a single worker should resume every case on the runner thread") &&
+         ok;
+    return ok ? 0 : 1;
+}
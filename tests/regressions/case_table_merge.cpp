@@ -0,0 +1,98 @@
+#include "gentest/detail/registration_runtime.h"
+#include "gentest/runner.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string_view>
+
+namespace {
+
+void noop(void *) {}
+
+constexpr gentest::Case make_case(std::string_view name, std::string_view file, unsigned line) {
+    return {
+        .name             = name,
+        .fn               = &noop,
+        .file             = file,
+        .line             = line,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = {},
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = {},
+        .fixture_lifetime = gentest::FixtureLifetime::None,
+        .suite            = "regressions",
+    };
+}
+
+// Two generated-style tables, each in registry order, whose names interleave
+// and collide so the merge has to honour the file and line tie-breaks.
+constexpr std::array<gentest::Case, 3> kFirstRun = {
+    make_case("regressions/case_table/a", "a.cpp", 1),
+    make_case("regressions/case_table/c", "a.cpp", 3),
+    make_case("regressions/case_table/same", "b.cpp", 9),
+};
+constexpr std::array<gentest::Case, 3> kSecondRun = {
+    make_case("regressions/case_table/b", "c.cpp", 2),
+    make_case("regressions/case_table/same", "a.cpp", 5),
+    make_case("regressions/case_table/same", "b.cpp", 4),
+};
+// A table that is not in registry order is sorted before the merge.
+constexpr std::array<gentest::Case, 3> kUnsortedRun = {
+    make_case("regressions/case_table/e", "d.cpp", 1),
+    make_case("regressions/case_table/bb", "d.cpp", 2),
+    make_case("regressions/case_table/same", "a.cpp", 1),
+};
+
+#if defined(GENTEST_CASE_TABLE_SECTION)
+GENTEST_CASE_TABLE_ENTRY const gentest::detail::CaseTableRun kFirstTableRun{kFirstRun.data(), kFirstRun.data() + kFirstRun.size()};
+GENTEST_CASE_TABLE_ENTRY const gentest::detail::CaseTableRun kSecondTableRun{kSecondRun.data(), kSecondRun.data() + kSecondRun.size()};
+GENTEST_CASE_TABLE_ENTRY const gentest::detail::CaseTableRun kUnsortedTableRun{kUnsortedRun.data(),
+                                                                              kUnsortedRun.data() + kUnsortedRun.size()};
+#else
+struct TableRegistrar {
+    TableRegistrar() {
+        gentest::detail::register_cases(std::span{kFirstRun});
+        gentest::detail::register_cases(std::span{kSecondRun});
+        gentest::detail::register_cases(std::span{kUnsortedRun});
+    }
+};
+const TableRegistrar kTableRegistrar{};
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // Runtime registrations arrive unsorted and are merged with the tables.
+    const std::array<gentest::Case, 2> dynamic = {
+        make_case("regressions/case_table/d", "z.cpp", 1),
+        make_case("regressions/case_table/0", "z.cpp", 1),
+    };
+    gentest::detail::register_cases(std::span{dynamic});
+    if (argc > 1) {
+        return gentest::run_all_tests(argc, argv);
+    }
+
+    const auto cases = gentest::registered_cases();
+    const bool sorted =
+        std::ranges::is_sorted(cases, [](const gentest::Case &lhs, const gentest::Case &rhs) {
+            if (lhs.name != rhs.name)
+                return lhs.name < rhs.name;
+            if (lhs.file != rhs.file)
+                return lhs.file < rhs.file;
+            return lhs.line < rhs.line;
+        });
+    if (cases.size() != 11 || !sorted) {
+        std::fprintf(stderr, "FAIL: expected 11 cases in registry order, got %zu (sorted=%d)\n", cases.size(), sorted ? 1 : 0);
+        for (const auto &c : cases) {
+            std::fprintf(stderr, "  %.*s (%.*s:%u)\n", static_cast<int>(c.name.size()), c.name.data(), static_cast<int>(c.file.size()),
+                         c.file.data(), c.line);
+        }
+        return 1;
+    }
+    return gentest::run_all_tests(argc, argv);
+}
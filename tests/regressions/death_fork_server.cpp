@@ -0,0 +1,136 @@
+#include "gentest/assertions.h"
+#include "gentest/detail/generated_runtime.h"
+#include "gentest/runner.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view kFixtureName = "regressions::DeathForkFixture";
+constexpr std::string_view kDeathTag[]  = {"death"};
+
+std::atomic<int> g_setups{0};
+
+std::shared_ptr<void> create_fixture(std::string_view, std::string &) { return std::make_shared<int>(0); }
+
+void setup_fixture(void *, std::string &) { g_setups.fetch_add(1, std::memory_order_relaxed); }
+
+void aborts_with_warm_fixture(void *ctx) {
+    if (ctx != nullptr && g_setups.load(std::memory_order_relaxed) == 1) {
+        std::fputs("fatal path\n", stderr);
+    }
+    std::abort();
+}
+
+void exits_non_zero(void *) {
+    std::puts("fatal path");
+    std::fflush(stdout);
+    std::_Exit(7);
+}
+
+void returns_normally(void *) {}
+
+void fails_assertion(void *) { gentest::expect(false, "normal failure inside a death test"); }
+
+void not_a_death_test(void *) { std::abort(); }
+
+void hangs(void *) { std::this_thread::sleep_for(std::chrono::hours(1)); }
+
+constexpr gentest::Case make_case(std::string_view name, void (*fn)(void *), unsigned line, bool death) {
+    return {
+        .name             = name,
+        .fn               = fn,
+        .file             = __FILE__,
+        .line             = line,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = death ? std::span<const std::string_view>(kDeathTag) : std::span<const std::string_view>{},
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = {},
+        .fixture_lifetime = gentest::FixtureLifetime::None,
+        .suite            = "regressions",
+    };
+}
+
+gentest::Case kCases[] = {
+    make_case("regressions/death_fork/bad/fails_assertion", &fails_assertion, 41, true),
+    make_case("regressions/death_fork/bad/returns_normally", &returns_normally, 39, true),
+    make_case("regressions/death_fork/ok/exits_non_zero", &exits_non_zero, 33, true),
+    make_case("regressions/death_fork/ok/not_a_death_test", &not_a_death_test, 43, false),
+    make_case("regressions/death_fork/hang/hangs", &hangs, 45, true),
+    {
+        .name             = "regressions/death_fork/ok/aborts_with_warm_fixture",
+        .fn               = &aborts_with_warm_fixture,
+        .file             = __FILE__,
+        .line             = 26,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = kDeathTag,
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = kFixtureName,
+        .fixture_lifetime = gentest::FixtureLifetime::MemberGlobal,
+        .suite            = "regressions",
+    },
+};
+
+int run(std::vector<const char *> args) { return gentest::run_all_tests(std::span<const char *>{args.data(), args.size()}); }
+
+bool check_rc(std::string_view label, int actual, int expected) {
+    if (actual == expected) {
+        return true;
+    }
+    std::fprintf(stderr, "FAIL: %.*s returned %d, expected %d\n", static_cast<int>(label.size()), label.data(), actual, expected);
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gentest::detail::register_shared_fixture(gentest::detail::SharedFixtureScope::Global, std::string_view{}, kFixtureName, &create_fixture,
+                                             &setup_fixture, nullptr);
+    gentest::detail::register_cases(std::span<const gentest::Case>(kCases));
+    if (argc > 1) {
+        return gentest::run_all_tests(argc, argv);
+    }
+
+    bool ok = true;
+
+    // The non-death case in the same group would abort the run if it were forked.
+    ok = check_rc("passing death cases",
+                  run({argv[0], "--death-fork-server", "--filter=regressions/death_fork/ok/*",
+                       "--death-expect-substring=fatal path"}),
+                  0) &&
+         ok;
+    ok = check_rc("fixture setups in the parent", g_setups.load(std::memory_order_relaxed), 1) && ok;
+    ok = check_rc("failing death cases", run({argv[0], "--death-fork-server", "--filter=regressions/death_fork/bad/*"}), 1) && ok;
+    ok = check_rc("missing expected output",
+                  run({argv[0], "--death-fork-server", "--filter=regressions/death_fork/ok/*",
+                       "--death-expect-substring=not printed"}),
+                  1) &&
+         ok;
+
+    const auto hang_start = std::chrono::steady_clock::now();
+    ok = check_rc("hanging death case",
+                  run({argv[0], "--death-fork-server", "--filter=regressions/death_fork/hang/*", "--death-timeout=1"}), 1) &&
+         ok;
+    ok = check_rc("hanging death case killed at its deadline",
+                  std::chrono::steady_clock::now() - hang_start < std::chrono::seconds(30) ? 0 : 1, 0) &&
+         ok;
+    ok = check_rc("timeout without fork server", run({argv[0], "--death-timeout=1"}), 1) && ok;
+    ok = check_rc("expect without fork server", run({argv[0], "--death-expect-substring=fatal path"}), 1) && ok;
+    return ok ? 0 : 1;
+}
@@ -89,6 +89,9 @@ JitterResult make_jitter_result(std::vector<double> samples, int stored_bins) {
     result.p05_ns             = stats.p05;
     result.p95_ns             = stats.p95;
     result.histogram          = compute_histogram(result.samples_ns, stored_bins);
+    for (const double sample : result.samples_ns) {
+        result.sample_histogram.record(sample);
+    }
     return result;
 }
 
@@ -185,6 +188,28 @@ void check_jitter_histogram_recompute_and_truncation() {
     expect(contains(samplesJson, ",2049]"), "samples JSON should keep the last sample");
 }
 
+void check_histogram_only_jitter_attachments() {
+    auto jitter = make_jitter_result({}, 4);
+    for (std::size_t i = 0; i < 10'000; ++i) {
+        jitter.sample_histogram.record(static_cast<double>(i % 100));
+    }
+    jitter.p99_ns = jitter.sample_histogram.percentile(0.99);
+
+    const auto  jitter_case = make_case("regressions/measured_report/jitter_histogram_only", "measured_suite", false, true, false);
+    const auto  attachments = gentest::runner::make_jitter_allure_attachments(jitter_case, jitter, 5);
+    const auto &metrics     = find_attachment(attachments, "metrics").contents;
+    const auto &histogram   = find_attachment(attachments, "histogram").contents;
+    const auto &samplesJson = find_attachment(attachments, "samples").contents;
+
+    expect(contains(metrics, "samples\t10000"), "jitter metrics should count histogram samples without raw samples");
+    expect(contains(metrics, "p99_ns_per_call\t98."), "jitter metrics should report p99 from the sample histogram");
+    expect(contains(metrics, "hdr_significant_digits\t3"), "jitter metrics should report histogram precision");
+    expect(std::count(histogram.begin(), histogram.end(), '\n') == 6, "histogram TSV should be rebuilt from the sample histogram");
+    expect(contains(histogram, "\t2000\t20\t"), "histogram-only bins should carry recorded counts");
+    expect(contains(samplesJson, R"("sample_count":10000,"stored_count":0,"truncated":true)"),
+           "samples JSON should report histogram count when raw samples were not kept");
+}
+
 void check_zero_and_one_sample_attachments() {
     const auto jitter_case = make_case("regressions/measured_report/jitter_zero", "edge_suite", false, true, false);
 
@@ -237,14 +262,17 @@ void check_mixed_baseline_output() {
     jitter_empty_baseline.min_ns    = 8.0;
     jitter_empty_baseline.max_ns    = 8.0;
 
-    auto jitter_delta               = make_jitter_result({8.0, 9.0, 11.0, 12.0}, 2);
-    jitter_delta.batch_mode         = true;
-    jitter_delta.median_ns          = 10.0;
-    jitter_delta.mean_ns            = 10.0;
-    jitter_delta.stddev_ns          = 4.0;
-    jitter_delta.overhead_mean_ns   = 1.5;
-    jitter_delta.overhead_sd_ns     = 0.5;
-    jitter_delta.overhead_ratio_pct = 7.5;
+    auto jitter_delta                = make_jitter_result({8.0, 9.0, 11.0, 12.0}, 2);
+    jitter_delta.batch_mode          = true;
+    jitter_delta.median_ns           = 10.0;
+    jitter_delta.mean_ns             = 10.0;
+    jitter_delta.stddev_ns           = 4.0;
+    jitter_delta.overhead_mean_ns    = 1.5;
+    jitter_delta.overhead_sd_ns      = 0.5;
+    jitter_delta.overhead_ratio_pct  = 7.5;
+    jitter_delta.clock               = gentest::runner::JitterClockMode::Tsc;
+    jitter_delta.clock_requested     = gentest::runner::JitterClockMode::Tsc;
+    jitter_delta.clock_resolution_ns = 0.25;
 
     auto jitter_nobase             = make_jitter_result({30.0}, 1);
     jitter_nobase.overhead_mean_ns = 0.0;
@@ -268,6 +296,8 @@ void check_mixed_baseline_output() {
     expect(contains(jitter_output, "+25.00%"), "jitter report should show median delta against baseline");
     expect(contains(jitter_output, "+100.00%"), "jitter report should show stddev delta against baseline");
     expect(contains(jitter_output, "batch"), "jitter debug table should report batch mode");
+    expect(contains(jitter_output, "Clock res"), "jitter debug table should render clock resolution column");
+    expect(contains(line_containing(jitter_output, "batch"), "tsc"), "jitter debug table should report the sample clock");
     expect(contains(line_containing(jitter_output, "jitter_nobase_row"), "-"),
            "jitter report should show '-' when suite baseline data is missing");
     expect(contains(jitter_output, "Jitter histogram (bins=4, name=regressions/measured_report/jitter_empty_baseline)"),
@@ -357,15 +387,133 @@ void check_measured_report_formats_and_items() {
     expect(contains(escaped_json, R"(pipe|quote\"comma,\nline)"), "json output should escape quotes and newlines");
 }
 
+void check_bench_cache_table() {
+    const auto both_case = make_case("regressions/measured_report/cache_both", "cache_suite", true, false, false);
+    const auto cold_case = make_case("regressions/measured_report/cache_cold", "cache_suite", true, false, false);
+
+    auto cold_result               = make_bench_result(60.0, 62.0, 0.001, 12);
+    cold_result.cold_cache         = true;
+    cold_result.evictions          = 12;
+    cold_result.evict_buffer_bytes = std::size_t{64} << 20;
+    std::vector<BenchReportRow> rows{
+        BenchReportRow{.c = &both_case, .result = make_bench_result(20.0, 21.0, 0.001, 300), .cold = cold_result},
+        BenchReportRow{.c = &cold_case, .result = cold_result},
+    };
+
+    CliOptions        table_opt{};
+    const std::string table_output = capture_stdout([&] { gentest::runner::print_bench_report(rows, table_opt); });
+    expect(contains(table_output, "Bench cache"), "benches measured warm and cold should add a cache table");
+    expect(contains(table_output, "3.00x"), "cache table should show the cold/warm median ratio");
+    expect(contains(table_output, "64 MiB"), "cache table should show the eviction buffer size");
+
+    CliOptions json_opt{};
+    json_opt.measured_report_format = gentest::runner::MeasuredReportFormat::Json;
+    const std::string json_output   = capture_stdout([&] { gentest::runner::print_bench_report(rows, json_opt); });
+    expect(contains(json_output, R"("benchmark":"regressions/measured_report/cache_cold","suite":"cache_suite","is_baseline":false)"),
+           "cold-only benches should stay in the summary table");
+    expect(contains(json_output, R"("cache":"cold")"), "summary rows should carry the measured cache state");
+    expect(contains(json_output, R"("warm_median_ns_per_item":20,"cold_median_ns_per_item":60,"cold_warm_ratio":3)"),
+           "cache rows should carry warm and cold medians side by side");
+    expect(!contains(json_output, R"("benchmark":"regressions/measured_report/cache_cold","suite":"cache_suite","warm_median)"),
+           "cold-only benches should not appear in the cache comparison table");
+
+    const auto metrics = find_attachment(gentest::runner::make_bench_allure_attachments(cold_case, cold_result), "metrics").contents;
+    expect(contains(metrics, "cache\tcold\n"), "bench metrics should report the cache state");
+    expect(contains(metrics, "evictions\t12\n"), "bench metrics should report eviction count");
+}
+
+void check_bench_complexity_table() {
+    std::vector<Case>           cases;
+    std::vector<BenchReportRow> rows;
+    cases.reserve(4);
+    for (const double n : {16.0, 64.0, 256.0, 1024.0}) {
+        auto c              = make_case("regressions/measured_report/insert", "complexity_suite", true, false, false);
+        c.complexity_n      = n;
+        c.complexity_series = "regressions/measured_report/insert(n)";
+        cases.push_back(c);
+    }
+    for (const auto &c : cases) {
+        rows.push_back(BenchReportRow{.c = &c, .result = make_bench_result(0.25 * c.complexity_n * c.complexity_n, 1.0, 0.001, 3)});
+    }
+    const auto plain_case = make_case("regressions/measured_report/plain", "complexity_suite", true, false, false);
+    rows.push_back(BenchReportRow{.c = &plain_case, .result = make_bench_result(5.0, 5.0, 0.001, 3)});
+
+    CliOptions        table_opt{};
+    const std::string table_output = capture_stdout([&] { gentest::runner::print_bench_report(rows, table_opt); });
+    expect(contains(table_output, "Bench complexity"), "complexity benches should add a complexity table");
+    expect(contains(line_containing(table_output, "insert(n)"), "O(n^2)"), "quadratic medians should fit O(n^2)");
+    expect(!contains(line_containing(table_output, "insert(n)"), "plain"), "benches without complexity(n) should not join a series");
+
+    CliOptions json_opt{};
+    json_opt.measured_report_format = gentest::runner::MeasuredReportFormat::Json;
+    const std::string json_output   = capture_stdout([&] { gentest::runner::print_bench_report(rows, json_opt); });
+    expect(contains(json_output, R"("id":"bench.complexity")"), "json output should include the complexity table");
+    expect(contains(json_output, R"json("series":"regressions/measured_report/insert(n)","suite":"complexity_suite","points":4)json"),
+           "json complexity rows should carry series and point count");
+    expect(contains(json_output, R"json("best_fit":"O(n^2)")json"), "json complexity rows should carry the best fit class");
+
+    std::vector<BenchReportRow> plain_rows{rows.back()};
+    const std::string           plain_json = capture_stdout([&] { gentest::runner::print_bench_report(plain_rows, json_opt); });
+    expect(!contains(plain_json, "bench.complexity"), "reports without complexity benches should omit the table");
+}
+
+void check_environment_header() {
+    const auto                  bench_case = make_case("regressions/measured_report/env", "env_suite", true, false, false);
+    std::vector<BenchReportRow> rows{BenchReportRow{.c = &bench_case, .result = make_bench_result(10.0, 10.0, 0.001, 3)}};
+
+    gentest::runner::BenchEnvironment env{};
+    env.cpu_governor        = "powersave";
+    env.no_turbo            = false;
+    env.loadavg_1m          = 3.5;
+    env.aslr                = 2;
+    env.online_cpus         = 4;
+    env.pinned_cpu          = 2;
+    env.pinned_cpu_siblings = "2,6";
+
+    CliOptions json_opt{};
+    json_opt.measured_report_format = gentest::runner::MeasuredReportFormat::Json;
+    const std::string json_output   = capture_stdout([&] {
+        gentest::runner::print_measured_report(rows, {}, json_opt, {}, false, false, &env);
+    });
+    expect(contains(json_output, R"({"report":"bench","environment":{"cpu_governor":"powersave","no_turbo":false,"smt_active":null,)"),
+           "json reports should lead with the environment object");
+    expect(contains(json_output, R"("aslr":2,"online_cpus":4,"pinned_cpu":2,"pinned_cpu_siblings":"2,6"},"tables":[)"),
+           "json environment should carry ASLR, CPU count and pinning");
+
+    CliOptions csv_opt{};
+    csv_opt.measured_report_format = gentest::runner::MeasuredReportFormat::Csv;
+    const std::string csv_output   = capture_stdout([&] {
+        gentest::runner::print_measured_report(rows, {}, csv_opt, {}, false, false, &env);
+    });
+    expect(csv_output.starts_with("report,table,row,field,type,value\nmeasured,environment,0,cpu_governor,string,powersave\n"),
+           "csv reports should emit environment rows right after the header");
+    expect(contains(csv_output, "measured,environment,0,loadavg_5m,null,\n"), "unknown environment values should be null");
+
+    const std::string plain_json = capture_stdout([&] { gentest::runner::print_measured_report(rows, {}, json_opt); });
+    expect(!contains(plain_json, "environment"), "reports without a probed environment should omit the header");
+
+    const auto warnings = gentest::runner::bench_environment_warnings(env);
+    expect(warnings.size() == 4, "governor, turbo, load and SMT sibling findings should each warn");
+    gentest::runner::BenchEnvironment aslr_only{};
+    aslr_only.aslr = 2;
+    expect(gentest::runner::bench_environment_warnings(aslr_only).empty(), "default-on ASLR should not warn");
+    expect(gentest::runner::bench_environment_warnings(gentest::runner::BenchEnvironment{}).empty(),
+           "an unreadable environment should not warn");
+}
+
 } // namespace
 
 int main() {
     try {
         check_bench_attachments();
         check_jitter_histogram_recompute_and_truncation();
+        check_histogram_only_jitter_attachments();
         check_zero_and_one_sample_attachments();
         check_mixed_baseline_output();
         check_measured_report_formats_and_items();
+        check_bench_cache_table();
+        check_bench_complexity_table();
+        check_environment_header();
     } catch (const std::exception &e) {
         std::cerr << e.what() << '\n';
         return 1;
@@ -0,0 +1,99 @@
+#include "gentest/detail/mock_trace.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+using gentest::detail::mocking::MockTraceRecord;
+
+// Header layout: 8-byte magic, then method_count and record_count as u32.
+constexpr std::size_t kMethodCountOffset = 8;
+constexpr std::size_t kRecordCountOffset = 12;
+
+auto fail(std::string_view message) -> int {
+    std::cerr << "FAIL: " << message << '\n';
+    return 1;
+}
+
+auto read_file(const std::filesystem::path &path) -> std::string {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::filesystem::path &path, const std::string &bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void put_u32_at(std::string &bytes, std::size_t offset, std::uint32_t value) {
+    for (std::size_t i = 0; i < 4; ++i) {
+        bytes[offset + i] = static_cast<char>((value >> (8 * i)) & 0xffu);
+    }
+}
+
+// A header count larger than the file could hold must be rejected as corrupt
+// instead of sizing a buffer from it.
+auto rejects_count(const std::filesystem::path &path, const std::string &valid, std::size_t offset, std::uint32_t value,
+                   std::string_view expected_error) -> int {
+    std::string corrupt = valid;
+    put_u32_at(corrupt, offset, value);
+    write_file(path, corrupt);
+
+    std::string error;
+    try {
+        if (gentest::detail::mocking::open_mock_trace(path.string(), error) != nullptr) {
+            return fail("a trace with an oversized count was accepted");
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << "FAIL: loading a trace with an oversized count threw: " << ex.what() << '\n';
+        return 1;
+    }
+    if (error != expected_error) {
+        std::cerr << "FAIL: unexpected error '" << error << "', expected '" << expected_error << "'\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    std::error_code  ec;
+    const auto       path    = std::filesystem::temp_directory_path(ec) / "gentest_mock_trace_corrupt_counts.trace";
+    const std::array records = {
+        MockTraceRecord{.method = "Calculator::compute(int, int)", .args = "ab", .result = "c"},
+        MockTraceRecord{.method = "Calculator::reset()", .args = {}, .result = {}},
+    };
+    if (const std::string error = gentest::detail::mocking::write_mock_trace(path.string(), records); !error.empty()) {
+        return fail("could not write the baseline trace: " + error);
+    }
+    const std::string valid = read_file(path);
+
+    std::string error;
+    const auto  trace = gentest::detail::mocking::open_mock_trace(path.string(), error);
+    if (!trace || gentest::detail::mocking::mock_trace_records(*trace).size() != records.size()) {
+        return fail("the baseline trace did not load");
+    }
+
+    int rc = 0;
+    if (rc == 0) {
+        rc = rejects_count(path, valid, kMethodCountOffset, 0xffffffffu, "truncated method table");
+    }
+    if (rc == 0) {
+        rc = rejects_count(path, valid, kRecordCountOffset, 0xffffffffu, "truncated or corrupt call record");
+    }
+    if (rc == 0) {
+        // Just past what the remaining bytes could encode at the minimum record size.
+        rc = rejects_count(path, valid, kRecordCountOffset, static_cast<std::uint32_t>(valid.size()), "truncated or corrupt call record");
+    }
+    std::filesystem::remove(path, ec);
+    return rc;
+}
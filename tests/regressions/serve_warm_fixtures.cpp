@@ -0,0 +1,228 @@
+#include "gentest/assertions.h"
+#include "gentest/detail/generated_runtime.h"
+#include "gentest/runner.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view kFixtureName = "regressions::ServeWarmFixture";
+
+std::atomic<int> g_setups{0};
+
+std::shared_ptr<void> create_fixture(std::string_view, std::string &) { return std::make_shared<int>(0); }
+
+void setup_fixture(void *, std::string &) { g_setups.fetch_add(1, std::memory_order_relaxed); }
+
+void warm_fixture(void *ctx) {
+    gentest::expect(ctx != nullptr, "served case receives the warm fixture");
+    gentest::expect_eq(g_setups.load(std::memory_order_relaxed), 1, "global fixture is set up once per server");
+}
+
+void failing(void *) { gentest::expect(false, "served failure reaches the client"); }
+
+gentest::Case kCases[] = {
+    {
+        .name             = "regressions/serve/failing",
+        .fn               = &failing,
+        .file             = __FILE__,
+        .line             = 32,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = {},
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = {},
+        .fixture_lifetime = gentest::FixtureLifetime::None,
+        .suite            = "regressions",
+    },
+    {
+        .name             = "regressions/serve/warm_fixture",
+        .fn               = &warm_fixture,
+        .file             = __FILE__,
+        .line             = 27,
+        .is_benchmark     = false,
+        .is_jitter        = false,
+        .is_baseline      = false,
+        .tags             = {},
+        .requirements     = {},
+        .skip_reason      = {},
+        .should_skip      = false,
+        .fixture          = kFixtureName,
+        .fixture_lifetime = gentest::FixtureLifetime::MemberGlobal,
+        .suite            = "regressions",
+    },
+};
+
+int run(std::vector<const char *> args) { return gentest::run_all_tests(std::span<const char *>{args.data(), args.size()}); }
+
+// Runs in-process with stdout and stderr sent to `log_path`; `output` receives
+// what the client printed, i.e. the frames the server streamed back.
+int run_captured(std::vector<const char *> args, const std::string &log_path, std::string &output) {
+    std::fflush(stdout);
+    std::fflush(stderr);
+    const int saved_out = ::dup(STDOUT_FILENO);
+    const int saved_err = ::dup(STDERR_FILENO);
+    if (std::FILE *log = std::fopen(log_path.c_str(), "w")) {
+        (void)::dup2(::fileno(log), STDOUT_FILENO);
+        (void)::dup2(::fileno(log), STDERR_FILENO);
+        std::fclose(log);
+    }
+    const int rc = run(std::move(args));
+    std::fflush(stdout);
+    std::fflush(stderr);
+    (void)::dup2(saved_out, STDOUT_FILENO);
+    (void)::dup2(saved_err, STDERR_FILENO);
+    ::close(saved_out);
+    ::close(saved_err);
+    std::ifstream in(log_path);
+    output.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return rc;
+}
+
+// Returns a connected socket, or -1.
+int connect_raw(const std::string &socket_path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    socket_path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0) {
+        return fd;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return -1;
+}
+
+// The server binds before its fixture setup; retry until it accepts.
+bool wait_for_server(const std::string &socket_path) {
+    for (int i = 0; i < 500; ++i) {
+        if (const int fd = connect_raw(socket_path); fd >= 0) {
+            ::close(fd);
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+bool check_rc(std::string_view label, int actual, int expected) {
+    if (actual == expected) {
+        return true;
+    }
+    std::fprintf(stderr, "FAIL: %.*s returned %d, expected %d\n", static_cast<int>(label.size()), label.data(), actual, expected);
+    return false;
+}
+
+bool check_output(std::string_view label, const std::string &output, std::string_view needle) {
+    if (output.find(needle) != std::string::npos) {
+        return true;
+    }
+    std::fprintf(stderr, "FAIL: %.*s output lacks '%.*s':\n%s\n", static_cast<int>(label.size()), label.data(),
+                 static_cast<int>(needle.size()), needle.data(), output.c_str());
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gentest::detail::register_shared_fixture(gentest::detail::SharedFixtureScope::Global, std::string_view{}, kFixtureName, &create_fixture,
+                                             &setup_fixture, nullptr);
+    gentest::detail::register_cases(std::span<const gentest::Case>(kCases));
+    if (argc > 1) {
+        return gentest::run_all_tests(argc, argv);
+    }
+
+    const auto        temp_dir    = std::filesystem::temp_directory_path();
+    const std::string tag         = std::to_string(::getpid());
+    const std::string socket_path = (temp_dir / ("gentest_serve_" + tag + ".sock")).string();
+    const std::string log_path    = (temp_dir / ("gentest_serve_" + tag + ".log")).string();
+    const auto        client_dir  = temp_dir / ("gentest_serve_" + tag + "_client");
+    const std::string serve_arg   = "--serve=" + socket_path;
+    const std::string connect_arg = "--connect=" + socket_path;
+
+    const pid_t server = ::fork();
+    if (server < 0) {
+        std::perror("fork");
+        return 1;
+    }
+    if (server == 0) {
+        std::fflush(stdout);
+        ::_exit(run({argv[0], serve_arg.c_str()}));
+    }
+
+    bool        ok = check_rc("server accepts connections", wait_for_server(socket_path) ? 0 : 1, 0);
+    std::string output;
+
+    ok = check_rc("first warm run", run_captured({argv[0], connect_arg.c_str(), "--run=regressions/serve/warm_fixture", "--no-color"},
+                                                 log_path, output),
+                  0) &&
+         ok;
+    ok = check_output("first warm run", output, "[ PASS ] regressions/serve/warm_fixture") && ok;
+    ok = check_rc("second warm run", run({argv[0], connect_arg.c_str(), "--run=regressions/serve/warm_fixture"}), 0) && ok;
+    const int failing_rc =
+        run_captured({argv[0], "--connect", socket_path.c_str(), "--run=regressions/serve/failing", "--no-color"}, log_path, output);
+    ok = check_rc("failing run", failing_rc, 1) && ok;
+    ok = check_output("failing run", output, "served failure reaches the client") && ok;
+    ok = check_rc("list", run_captured({argv[0], connect_arg.c_str(), "--list-tests"}, log_path, output), 0) && ok;
+    ok = check_output("list", output, "regressions/serve/failing") && ok;
+
+    // A second server must not take the socket over from the live one.
+    ok = check_rc("second server", run_captured({argv[0], serve_arg.c_str()}, log_path, output), 1) && ok;
+    ok = check_output("second server", output, "already listening") && ok;
+    ok = check_rc("run after second server", run({argv[0], connect_arg.c_str(), "--run=regressions/serve/warm_fixture"}), 0) && ok;
+
+    // A client that connects and stalls mid-request is dropped after the
+    // server's read timeout instead of blocking the requests queued behind it.
+    const int idle_fd = connect_raw(socket_path);
+    ok                = check_rc("idle client connects", idle_fd >= 0 ? 0 : 1, 0) && ok;
+    if (idle_fd >= 0) {
+        (void)::send(idle_fd, "r", 1, 0);
+    }
+    ok = check_rc("run behind idle client", run({argv[0], connect_arg.c_str(), "--run=regressions/serve/warm_fixture"}), 0) && ok;
+    if (idle_fd >= 0) {
+        char byte = 0;
+        ok        = check_rc("idle client dropped", ::recv(idle_fd, &byte, 1, 0) == 0 ? 0 : 1, 0) && ok;
+        ::close(idle_fd);
+    }
+
+    // Relative report paths resolve against the client's working directory.
+    std::error_code ec;
+    std::filesystem::create_directories(client_dir, ec);
+    const auto server_dir = std::filesystem::current_path();
+    std::filesystem::current_path(client_dir);
+    const int junit_rc = run({argv[0], connect_arg.c_str(), "--run=regressions/serve/warm_fixture", "--junit=served.xml"});
+    ok                 = check_rc("relative junit", junit_rc, 0) && ok;
+    std::filesystem::current_path(server_dir);
+    ok = check_rc("junit in client directory", std::filesystem::exists(client_dir / "served.xml") ? 0 : 1, 0) && ok;
+    std::filesystem::remove_all(client_dir, ec);
+
+    ok = check_rc("shutdown", run({argv[0], connect_arg.c_str(), "--shutdown"}), 0) && ok;
+
+    int status = 0;
+    if (::waitpid(server, &status, 0) != server || !WIFEXITED(status)) {
+        std::fprintf(stderr, "FAIL: server did not exit cleanly\n");
+        return 1;
+    }
+    ok = check_rc("server", WEXITSTATUS(status), 0) && ok;
+    ok = check_rc("socket removed", std::filesystem::exists(socket_path) ? 1 : 0, 0) && ok;
+    std::filesystem::remove(log_path, ec);
+    return ok ? 0 : 1;
+}
@@ -74,7 +74,8 @@ bool same_case(const gentest::Case &lhs, const gentest::Case &rhs) {
            std::ranges::equal(lhs.tags, rhs.tags) && std::ranges::equal(lhs.requirements, rhs.requirements) &&
            lhs.skip_reason == rhs.skip_reason && lhs.should_skip == rhs.should_skip && lhs.fixture == rhs.fixture &&
            lhs.fixture_lifetime == rhs.fixture_lifetime && lhs.suite == rhs.suite && lhs.async_fn == rhs.async_fn &&
-           lhs.is_async == rhs.is_async && lhs.items_per_call == rhs.items_per_call && lhs.owner == rhs.owner;
+           lhs.is_async == rhs.is_async && lhs.items_per_call == rhs.items_per_call && lhs.owner == rhs.owner &&
+           lhs.complexity_n == rhs.complexity_n && lhs.complexity_series == rhs.complexity_series && lhs.bench_cache == rhs.bench_cache;
 }
 
 bool same_registry(const std::vector<gentest::Case> &lhs, const std::vector<gentest::Case> &rhs) {
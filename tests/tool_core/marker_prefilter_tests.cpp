@@ -0,0 +1,82 @@
+#include "marker_prefilter.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using gentest::codegen::scan::bytes_may_contain_codegen_markers;
+
+namespace {
+
+struct Run {
+    int  failures = 0;
+    void expect(bool ok, std::string_view msg) {
+        if (!ok) {
+            ++failures;
+            std::cerr << "FAIL: " << msg << "\n";
+        }
+    }
+};
+
+// 'x' is not a needle lead byte, so only `needle` can produce a hit.
+std::string padded(std::string_view needle, std::size_t offset, std::size_t tail) {
+    std::string bytes(offset, 'x');
+    bytes.append(needle);
+    bytes.append(tail, 'x');
+    return bytes;
+}
+
+// Slides `needle` across the first three 16-byte blocks so every split over a
+// block boundary, and the scalar tail after the last full block, is covered.
+void expect_at_every_offset(Run &t, std::string_view needle, bool expected) {
+    for (std::size_t offset = 0; offset < 48; ++offset) {
+        for (std::size_t tail : {std::size_t{0}, std::size_t{1}, std::size_t{17}}) {
+            const std::string bytes = padded(needle, offset, tail);
+            if (bytes_may_contain_codegen_markers(bytes) != expected) {
+                t.expect(false, "'" + std::string(needle) + "' at offset " + std::to_string(offset) + " with tail " + std::to_string(tail) +
+                                    (expected ? " was missed" : " was reported"));
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    Run t;
+
+    t.expect(!bytes_may_contain_codegen_markers({}), "empty input has no markers");
+    t.expect(!bytes_may_contain_codegen_markers("int main() {}"), "short marker-free input");
+    t.expect(!bytes_may_contain_codegen_markers(std::string(4096, 'x')), "long marker-free input");
+    t.expect(bytes_may_contain_codegen_markers("gentest"), "bare needle shorter than a block");
+    t.expect(bytes_may_contain_codegen_markers("mock<T>"), "short mock spelling");
+    t.expect(bytes_may_contain_codegen_markers("[[using a: b]]"), "short attribute");
+
+    expect_at_every_offset(t, "gentest", true);
+    expect_at_every_offset(t, "GENTEST_", true);
+    expect_at_every_offset(t, "GenTest", true);
+    expect_at_every_offset(t, "mock<", true);
+    expect_at_every_offset(t, "mock <", true);
+    expect_at_every_offset(t, "mock\n\t<", true);
+    expect_at_every_offset(t, "[[using", true);
+    expect_at_every_offset(t, "[[ using", true);
+    expect_at_every_offset(t, "[[\n  using", true);
+
+    // Lead bytes without the rest of a needle, including ones cut off by the
+    // end of the input.
+    expect_at_every_offset(t, "gentes", false);
+    expect_at_every_offset(t, "g e n t e s t", false);
+    expect_at_every_offset(t, "mock", false);
+    expect_at_every_offset(t, "mockup<", false);
+    expect_at_every_offset(t, "[[", false);
+    expect_at_every_offset(t, "[[nodiscard]]", false);
+    expect_at_every_offset(t, "[ [using", false);
+    expect_at_every_offset(t, "[[usin", false);
+
+    if (t.failures != 0) {
+        std::cerr << "Total failures: " << t.failures << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -276,6 +276,68 @@ int main() {
         t.expect(summary.items_per_call == 1024, "items_per_call value is recorded");
     }
 
+    {
+        auto                     attrs = parse_attribute_list(R"(bench("x"), geom(n, 8, 4, 5), complexity(n))");
+        std::vector<std::string> diags;
+        auto                     summary = validate_attributes(attrs, [&](const std::string &m) { diags.push_back(m); });
+        t.expect(!summary.had_error, "complexity naming a geom axis is valid on bench");
+        t.expect(diags.empty(), "complexity should not report diagnostics");
+        t.expect(summary.complexity_param && *summary.complexity_param == "n", "complexity parameter is recorded");
+    }
+
+    {
+        const std::vector<std::string> invalid_complexity{
+            R"(test("x"), range(n, 1, 1, 4), complexity(n))",
+            R"(bench("x"), range(n, 1, 1, 4), complexity(m))",
+            R"(bench("x"), range(n, 1, 1, 4), complexity())",
+            R"(bench("x"), range(n, 1, 1, 4), complexity(n, n))",
+            R"(bench("x"), range(n, 1, 1, 4), complexity(n), complexity(n))",
+        };
+        for (const auto &source : invalid_complexity) {
+            auto                     attrs = parse_attribute_list(source);
+            std::vector<std::string> diags;
+            auto                     summary = validate_attributes(attrs, [&](const std::string &m) { diags.push_back(m); });
+            t.expect(summary.had_error, "invalid complexity form errors: " + source);
+            t.expect(!diags.empty(), "invalid complexity form reports a diagnostic: " + source);
+        }
+    }
+
+    {
+        auto                     attrs = parse_attribute_list(R"(bench("x"), cache(cold, warm))");
+        std::vector<std::string> diags;
+        auto                     summary = validate_attributes(attrs, [&](const std::string &m) { diags.push_back(m); });
+        t.expect(!summary.had_error, "cache(warm, cold) is valid on bench");
+        t.expect(diags.empty(), "cache should not report diagnostics");
+        t.expect(summary.cache_warm && summary.cache_cold, "cache modes are recorded");
+    }
+
+    {
+        const std::vector<std::string> invalid_cache{
+            R"(test("x"), cache(cold))",
+            R"(bench("x"), cache())",
+            R"(bench("x"), cache(hot))",
+            R"(bench("x"), cache(cold, cold))",
+            R"(bench("x"), cache(warm, cold, warm))",
+            R"(bench("x"), cache(cold), cache(warm))",
+        };
+        for (const auto &source : invalid_cache) {
+            auto                     attrs = parse_attribute_list(source);
+            std::vector<std::string> diags;
+            auto                     summary = validate_attributes(attrs, [&](const std::string &m) { diags.push_back(m); });
+            t.expect(summary.had_error, "invalid cache form errors: " + source);
+            t.expect(!diags.empty(), "invalid cache form reports a diagnostic: " + source);
+        }
+    }
+
+    {
+        auto                     attrs = parse_attribute_list(R"(test("x"), virtual_time)");
+        std::vector<std::string> diags;
+        auto                     summary = validate_attributes(attrs, [&](const std::string &m) { diags.push_back(m); });
+        t.expect(!summary.had_error, "virtual_time is a valid flag");
+        t.expect(diags.empty(), "virtual_time should not report diagnostics");
+        t.expect(std::ranges::find(summary.tags, "virtual_time") != summary.tags.end(), "virtual_time is recorded as a tag");
+    }
+
     {
         auto                     attrs = parse_attribute_list(R"(jitter("x"), ops_per_call(7))");
         std::vector<std::string> diags;
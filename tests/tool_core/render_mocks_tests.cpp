@@ -108,9 +108,19 @@ int main() {
             t.contains(registry->content, "#include \"../fixture/service.hpp\"", "gentest backend includes target definition");
             t.contains(registry->content, "detail::MockAccess", "gentest backend keeps native expectation access");
             t.contains(registry->content, "__gentest_state_", "gentest backend keeps native mock state");
+            t.contains(registry->content, "::gentest::detail::mocking::InstanceState &state(mock<::fixture::Service> &instance)",
+                       "gentest backend exposes mock state for record/replay");
             t.excludes(registry->content, "#include <gmock/gmock.h>", "gentest backend does not include gmock");
             t.excludes(registry->content, "#include <trompeloeil/mock.hpp>", "gentest backend does not include trompeloeil");
         }
+        const MockGeneratedFile *impl = find_file(result, "public_mocks_inline.hpp");
+        t.expect(impl != nullptr, "gentest backend emits an implementation header");
+        if (impl != nullptr) {
+            t.contains(impl->content, "(token, fallback_token, static_cast<", "gentest backend passes the mocked method to dispatch");
+            t.contains(impl->content,
+                       "\"::fixture::Service::compute\", \"::fixture::Service::compute(::std::vector<int>) const & noexcept\"",
+                       "gentest backend keys record/replay traces by the full signature");
+        }
     }
 
     {
@@ -53,11 +53,15 @@ int main() {
                "generated light preamble does not parse the async implementation");
     t.contains(gentest::codegen::tpl::registration_preamble_full, "GENTEST_CASE_API_VERSION",
                "generated full preamble checks the Case API version");
-    t.contains(gentest::codegen::tpl::registration_preamble_light, "GENTEST_CASE_API_HAS_OWNER",
-               "generated light preamble checks the Case owner capability");
-    t.contains(gentest::codegen::tpl::registration_preamble_full, "GENTEST_CASE_API_HAS_OWNER",
-               "generated full preamble checks the Case owner capability");
+    t.contains(gentest::codegen::tpl::registration_preamble_light, "GENTEST_CASE_API_HAS_BENCH_CACHE",
+               "generated light preamble checks the Case bench cache capability");
+    t.contains(gentest::codegen::tpl::registration_preamble_full, "GENTEST_CASE_API_HAS_BENCH_CACHE",
+               "generated full preamble checks the Case bench cache capability");
     t.contains(gentest::codegen::tpl::case_entry, ".owner = {owner}", "generated Case initializer includes structured owner metadata");
+    t.contains(gentest::codegen::tpl::case_entry, ".complexity_series = {complexity_series}",
+               "generated Case initializer includes the complexity series");
+    t.contains(gentest::codegen::tpl::case_entry, ".bench_cache = {bench_cache}",
+               "generated Case initializer includes the bench cache mode");
 
     {
         std::vector<TestCaseInfo> cases(2);
@@ -126,6 +130,30 @@ int main() {
         t.contains(rendered, "IPC=18446744073709551615ULL", "render_case_entries suffixes max uint64 item count");
     }
 
+    {
+        std::vector<TestCaseInfo> cases(2);
+        cases[0].display_name            = "suite/plain";
+        cases[1].display_name            = "bench/sort(64)";
+        cases[1].is_benchmark            = true;
+        cases[1].complexity_n_expression = "64";
+        cases[1].complexity_series       = "bench/sort(n)";
+        const std::string rendered =
+            render_case_entries(cases, {"kTags_0", "kTags_1"}, {"kReqs_0", "kReqs_1"}, "CN={complexity_n}|CS={complexity_series}\n");
+        t.contains(rendered, "CN=0.0|CS=std::string_view{}\n", "render_case_entries leaves non-complexity cases unset");
+        t.contains(rendered, "CN=static_cast<double>(64)|CS=\"bench/sort(n)\"\n", "render_case_entries renders complexity size and series");
+    }
+
+    {
+        std::vector<TestCaseInfo> cases(2);
+        cases[0].display_name      = "suite/plain";
+        cases[1].display_name      = "bench/scan";
+        cases[1].is_benchmark      = true;
+        cases[1].bench_cache       = "Both";
+        const std::string rendered = render_case_entries(cases, {"kTags_0", "kTags_1"}, {"kReqs_0", "kReqs_1"}, "BC={bench_cache}\n");
+        t.contains(rendered, "BC=gentest::BenchCache::Default\n", "render_case_entries defaults the bench cache mode");
+        t.contains(rendered, "BC=gentest::BenchCache::Both\n", "render_case_entries renders the bench cache mode");
+    }
+
     {
         std::vector<FixtureDeclInfo> fixtures;
         fixtures.push_back(FixtureDeclInfo{
@@ -216,6 +216,64 @@ void bench_stats_hist_skewed() {
 
 namespace unit {
 
+void bench_stats_log_linear_percentiles() {
+    gentest::detail::LogLinearHistogram hist(3);
+    for (int i = 1; i <= 10'000; ++i)
+        hist.record(static_cast<double>(i));
+    const auto stats = hist.stats();
+    EXPECT_EQ(stats.count, std::size_t{10'000});
+    EXPECT_EQ(stats.min, 1.0);
+    EXPECT_EQ(stats.max, 10'000.0);
+    using gentest::approx::Approx;
+    EXPECT_EQ(stats.mean, Approx(5000.5).abs(0.001));
+    EXPECT_EQ(stats.median, Approx(5000.0).rel(0.1));
+    EXPECT_EQ(hist.percentile(0.99), Approx(9900.0).rel(0.1));
+    EXPECT_EQ(hist.percentile(0.999), Approx(9990.0).rel(0.1));
+
+    const auto bins = hist.histogram(4);
+    EXPECT_EQ(bins.bins.size(), std::size_t{4});
+    std::size_t total = 0;
+    for (const auto &bin : bins.bins)
+        total += bin.count;
+    EXPECT_EQ(total, std::size_t{10'000});
+    EXPECT_EQ(static_cast<double>(bins.bins[0].count), Approx(2500.0).abs(10.0));
+}
+
+void bench_stats_complexity_fit() {
+    using gentest::detail::ComplexityClass;
+    using gentest::detail::fit_complexity;
+    using gentest::approx::Approx;
+    const std::vector<double> sizes{8.0, 64.0, 512.0, 4096.0};
+    std::vector<double>       linear;
+    std::vector<double>       quadratic;
+    std::vector<double>       linearithmic;
+    for (double n : sizes) {
+        linear.push_back(3.0 * n + 1.0);
+        quadratic.push_back(0.5 * n * n);
+        linearithmic.push_back(2.0 * n * std::log2(n));
+    }
+
+    const auto lin = fit_complexity(sizes, linear);
+    EXPECT_TRUE(lin.best_fit == ComplexityClass::Linear);
+    EXPECT_EQ(lin.coefficient, Approx(3.0).rel(1.0));
+    EXPECT_EQ(lin.points, std::size_t{4});
+    EXPECT_TRUE(fit_complexity(sizes, quadratic).best_fit == ComplexityClass::Quadratic);
+    EXPECT_TRUE(fit_complexity(sizes, linearithmic).best_fit == ComplexityClass::Linearithmic);
+    EXPECT_EQ(gentest::detail::complexity_class_name(ComplexityClass::Linearithmic), std::string_view{"O(n log n)"});
+
+    const std::vector<double> flat{10.0, 10.0, 10.0, 10.0};
+    const auto                constant = fit_complexity(sizes, flat);
+    EXPECT_TRUE(constant.best_fit == ComplexityClass::Constant);
+    EXPECT_EQ(constant.rms_pct, Approx(0.0).abs(1e-9));
+
+    const std::vector<double> one_size{16.0, 16.0};
+    EXPECT_TRUE(fit_complexity(one_size, std::vector<double>{5.0, 7.0}).best_fit == ComplexityClass::Constant);
+}
+
+} // namespace unit
+
+namespace unit {
+
 void bench_util_clobber_memory_smoke() {
     int        value     = 7;
     const int &value_ref = value;
@@ -90,6 +90,12 @@ void bench_stats_hist_bimodal();
 [[using gentest: test("bench_stats/hist_skewed")]]
 void bench_stats_hist_skewed();
 
+[[using gentest: test("bench_stats/log_linear_percentiles")]]
+void bench_stats_log_linear_percentiles();
+
+[[using gentest: test("bench_stats/complexity_fit")]]
+void bench_stats_complexity_fit();
+
 [[using gentest: test("bench_util/clobber_memory_smoke")]]
 void bench_util_clobber_memory_smoke();
 
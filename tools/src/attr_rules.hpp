@@ -9,7 +9,7 @@ namespace gentest::detail {
 
 // Value attributes that fall through to the generic validation branch.
 inline constexpr std::array<std::string_view, 1> kAllowedValueAttributes{"owner"};
-inline constexpr std::array<std::string_view, 5> kAllowedFlagAttributes{"fast", "slow", "linux", "windows", "death"};
+inline constexpr std::array<std::string_view, 6> kAllowedFlagAttributes{"fast", "slow", "linux", "windows", "death", "virtual_time"};
 inline constexpr std::array<std::string_view, 1> kAllowedFixtureAttributes{"fixture"};
 
 inline bool is_allowed_value_attribute(std::string_view name) {
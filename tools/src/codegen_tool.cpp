@@ -2,14 +2,18 @@
 #include "discovery.hpp"
 #include "emit.hpp"
 #include "log.hpp"
+#include "marker_prefilter.hpp"
 #include "mock_discovery.hpp"
 #include "mock_domain_plan.hpp"
 #include "mock_manifest.hpp"
 #include "model.hpp"
 #include "parallel_for.hpp"
+#include "process_launch.hpp"
+#include "render.hpp"
 #include "scan_utils.hpp"
 #include "source_inspection.hpp"
 #include "tooling_support.hpp"
+#include "trace.hpp"
 
 #include <algorithm>
 #include <array>
@@ -35,6 +39,7 @@
 #include <fstream>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <llvm/ADT/IntrusiveRefCntPtr.h>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/SmallVector.h>
@@ -49,6 +54,7 @@
 #include <llvm/Support/Program.h>
 #include <llvm/Support/SHA256.h>
 #include <llvm/Support/StringSaver.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <llvm/Support/raw_ostream.h>
 #include <map>
 #include <memory>
@@ -84,6 +90,7 @@ using gentest::codegen::TestCaseInfo;
 static constexpr std::string_view kMissingCompdbSyntheticCommandMarker = "__gentest_missing_compdb_entry__";
 
 namespace {
+using gentest::codegen::scan::bytes_may_contain_codegen_markers;
 using gentest::codegen::scan::is_global_module_fragment_scan_line;
 using gentest::codegen::scan::is_preprocessor_directive_scan_line;
 using gentest::codegen::scan::is_private_module_fragment_scan_line;
@@ -732,6 +739,10 @@ void append_depfile_escaped(std::string &out, std::string_view path) {
         for (std::size_t idx = 0; idx < options.sources.size(); ++idx) {
             if (idx < options.textual_registration_outputs.size() && !options.textual_registration_outputs[idx].empty()) {
                 targets.push_back(options.textual_registration_outputs[idx]);
+                const std::size_t extra_shards = options.textual_registration_shard_outputs.size() / options.sources.size();
+                for (std::size_t shard = 0; shard < extra_shards; ++shard) {
+                    targets.push_back(options.textual_registration_shard_outputs[idx * extra_shards + shard]);
+                }
             } else if (idx < options.tu_output_headers.size() && !options.tu_output_headers[idx].empty()) {
                 targets.push_back(options.tu_output_headers[idx]);
             } else {
@@ -751,6 +762,9 @@ void append_depfile_escaped(std::string &out, std::string_view path) {
     if (!options.artifact_manifest_path.empty()) {
         targets.push_back(options.artifact_manifest_path);
     }
+    if (!options.inventory_path.empty()) {
+        targets.push_back(options.inventory_path);
+    }
     if (!options.mock_manifest_output_path.empty()) {
         targets.push_back(options.mock_manifest_output_path);
     }
@@ -867,6 +881,7 @@ struct ArtifactManifestValidationOptions {
     std::vector<std::string>                                            expected_compile_context_ids;
     std::vector<std::string>                                            expected_scan_slot_kinds;
     std::vector<std::string>                                            expected_source_registration_outputs;
+    std::vector<std::string>                                            expected_registration_shard_outputs;
     std::vector<std::string>                                            expected_modules;
     std::unordered_map<std::string, std::vector<std::filesystem::path>> expected_source_scan_include_dirs;
     std::unordered_map<std::string, std::vector<std::string>>           expected_source_scan_args;
@@ -1045,6 +1060,10 @@ using ArtifactManifestSourceScanContexts = std::unordered_map<std::string, Artif
             if (!parse_list_option(options.expected_source_registration_outputs, idx)) {
                 return false;
             }
+        } else if (arg == "--expected-registration-shard-output") {
+            if (!parse_list_option(options.expected_registration_shard_outputs, idx)) {
+                return false;
+            }
         } else if (arg == "--expected-module") {
             if (!parse_list_option(options.expected_modules, idx)) {
                 return false;
@@ -1351,6 +1370,33 @@ using ArtifactManifestSourceScanContexts = std::unordered_map<std::string, Artif
             return false;
         }
     }
+    if (additive_header_registration) {
+        // `shard_outputs` is optional for unsharded slots, so manifests written
+        // before registration sharding stay valid.
+        const std::size_t extra_shards  = options.expected_registration_shard_outputs.size() / options.expected_sources.size();
+        const auto       *shard_outputs = artifact.getArray("shard_outputs");
+        if (shard_outputs == nullptr && (artifact.get("shard_outputs") != nullptr || extra_shards != 0)) {
+            error = fmt::format("gentest artifact manifest {} field 'shard_outputs' must be an array", location);
+            return false;
+        }
+        const std::size_t actual_shards = shard_outputs != nullptr ? shard_outputs->size() : 0;
+        if (actual_shards != extra_shards) {
+            error = fmt::format("gentest artifact manifest {}.shard_outputs has {} entries, expected {}", location, actual_shards,
+                                extra_shards);
+            return false;
+        }
+        for (std::size_t shard = 0; shard < extra_shards; ++shard) {
+            const auto shard_output = (*shard_outputs)[shard].getAsString();
+            if (!shard_output) {
+                error = fmt::format("gentest artifact manifest {}.shard_outputs[{}] must be a string", location, shard);
+                return false;
+            }
+            if (!expect_equal(fmt::format("{}.shard_outputs[{}]", location, shard),
+                              options.expected_registration_shard_outputs[idx * extra_shards + shard], shard_output->str(), error)) {
+                return false;
+            }
+        }
+    }
     const auto depfile = json_string_field(artifact, "depfile", location, error);
     if (!depfile || !expect_equal(fmt::format("{}.depfile", location), options.expected_depfile, *depfile, error)) {
         return false;
@@ -1547,6 +1593,11 @@ using ArtifactManifestSourceScanContexts = std::unordered_map<std::string, Artif
                                       error)) {
         return false;
     }
+    if (options.expected_registration_shard_outputs.size() % std::max<std::size_t>(expected_count, 1) != 0) {
+        error = fmt::format("--expected-registration-shard-output has {} value(s), expected a multiple of {}",
+                            options.expected_registration_shard_outputs.size(), expected_count);
+        return false;
+    }
     if (!options.expected_modules.empty() &&
         !validate_expected_list_count("--expected-module", options.expected_modules, expected_count, error)) {
         return false;
@@ -1666,18 +1717,8 @@ void prime_llvm_statistics_registry() {
     [[maybe_unused]] const auto statistics = llvm::GetStatistics();
 }
 
-[[nodiscard]] bool write_depfile(const CollectorOptions &options, const std::vector<std::string> &dependencies) {
-    if (!options.depfile_path || options.depfile_path->empty()) {
-        return true;
-    }
-
-    const std::filesystem::path build_dir =
-        options.compilation_database ? options.compilation_database->lexically_normal() : std::filesystem::current_path();
-    const std::vector<std::filesystem::path> dep_targets = depfile_targets_for(options);
-    if (dep_targets.empty()) {
-        return true;
-    }
-
+[[nodiscard]] bool write_depfile_for_targets(const std::filesystem::path &depfile_path, std::span<const std::filesystem::path> dep_targets,
+                                             const std::vector<std::string> &dependencies, const std::filesystem::path &build_dir) {
     std::vector<std::string> normalized_deps;
     normalized_deps.reserve(dependencies.size());
     for (const auto &dependency : dependencies) {
@@ -1703,9 +1744,9 @@ void prime_llvm_statistics_registry() {
     depfile_text += '\n';
 
     std::error_code      ec;
-    llvm::raw_fd_ostream depfile_stream(options.depfile_path->string(), ec, llvm::sys::fs::OF_Text);
+    llvm::raw_fd_ostream depfile_stream(depfile_path.string(), ec, llvm::sys::fs::OF_Text);
     if (ec) {
-        gentest::codegen::log_err("gentest_codegen: failed to write depfile '{}': {}\n", options.depfile_path->string(), ec.message());
+        gentest::codegen::log_err("gentest_codegen: failed to write depfile '{}': {}\n", depfile_path.string(), ec.message());
         return false;
     }
     depfile_stream << depfile_text;
@@ -1713,6 +1754,72 @@ void prime_llvm_statistics_registry() {
     return true;
 }
 
+struct DepfileEntries {
+    std::vector<std::filesystem::path> targets;
+    std::vector<std::filesystem::path> dependencies;
+};
+
+// Reads back a depfile written by write_depfile_for_targets(), undoing its
+// escapes and resolving relative entries against `build_dir`.
+[[nodiscard]] std::optional<DepfileEntries> read_depfile_entries(const std::filesystem::path &depfile_path,
+                                                                 const std::filesystem::path &build_dir) {
+    auto buffer = llvm::MemoryBuffer::getFile(depfile_path.string());
+    if (!buffer) {
+        return std::nullopt;
+    }
+    std::error_code             ec;
+    const std::filesystem::path base = std::filesystem::absolute(build_dir, ec);
+    DepfileEntries              entries;
+    bool                        seen_colon = false;
+    std::string                 current;
+    auto                        flush = [&] {
+        if (current.empty()) {
+            return;
+        }
+        std::filesystem::path path{current};
+        if (path.is_relative()) {
+            path = (ec ? build_dir : base) / path;
+        }
+        (seen_colon ? entries.dependencies : entries.targets).push_back(path.lexically_normal());
+        current.clear();
+    };
+    const std::string_view text = (*buffer)->getBuffer();
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char ch = text[i];
+        if (ch == '\\' && i + 1 < text.size()) {
+            current.push_back(text[++i]);
+        } else if (ch == ':' && !seen_colon) {
+            flush();
+            seen_colon = true;
+        } else if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            flush();
+        } else {
+            current.push_back(ch);
+        }
+    }
+    flush();
+    if (!seen_colon) {
+        return std::nullopt;
+    }
+    return entries;
+}
+
+[[nodiscard]] std::filesystem::path depfile_build_dir(const CollectorOptions &options) {
+    return options.compilation_database ? options.compilation_database->lexically_normal() : std::filesystem::current_path();
+}
+
+[[nodiscard]] bool write_depfile(const CollectorOptions &options, const std::vector<std::string> &dependencies) {
+    if (!options.depfile_path || options.depfile_path->empty()) {
+        return true;
+    }
+
+    const std::vector<std::filesystem::path> dep_targets = depfile_targets_for(options);
+    if (dep_targets.empty()) {
+        return true;
+    }
+    return write_depfile_for_targets(*options.depfile_path, dep_targets, dependencies, depfile_build_dir(options));
+}
+
 class DependencyRecorder final : public clang::PPCallbacks {
   public:
     DependencyRecorder(clang::SourceManager &source_manager, std::vector<std::string> &dependencies)
@@ -2275,6 +2382,13 @@ std::optional<std::filesystem::path> resolve_wrapped_source_from_codegen_shim(co
 }
 
 bool source_contains_codegen_markers(const std::filesystem::path &path) {
+    // Most wrapped sources have no marker bytes at all; rule those out from the
+    // mapped file before falling back to the comment-aware line scan.
+    if (auto buffer = llvm::MemoryBuffer::getFile(path.string(), /*IsText=*/false, /*RequiresNullTerminator=*/false);
+        buffer && !bytes_may_contain_codegen_markers((*buffer)->getBuffer())) {
+        return false;
+    }
+
     std::ifstream in(path);
     if (!in) {
         return true;
@@ -2541,6 +2655,7 @@ struct ScanDepsSourceInfo {
     std::string              provided_module_name;
     std::vector<std::string> named_module_deps;
     std::vector<std::string> module_file_args;
+    std::vector<std::string> file_deps;
 };
 
 using ScanDepsInfoBySource = std::unordered_map<std::string, ScanDepsSourceInfo>;
@@ -2726,6 +2841,7 @@ std::vector<std::string> normalize_module_file_args(std::vector<std::string> arg
 
 std::optional<ScanDepsInfoBySource> run_clang_scan_deps(std::span<const ScanDepsPreparedCommand> prepared_commands,
                                                         std::string_view explicit_scan_deps_path, std::string &error_message) {
+    llvm::TimeTraceScope trace_span("RunClangScanDeps", [&] { return fmt::format("{} source(s)", prepared_commands.size()); });
     error_message.clear();
     if (prepared_commands.empty()) {
         return ScanDepsInfoBySource{};
@@ -2886,6 +3002,10 @@ std::optional<ScanDepsInfoBySource> run_clang_scan_deps(std::span<const ScanDeps
             info.module_file_args.insert(info.module_file_args.end(), std::make_move_iterator(module_file_args.begin()),
                                          std::make_move_iterator(module_file_args.end()));
 
+            auto file_deps = collect_scan_deps_string_array(*command, "file-deps");
+            info.file_deps.insert(info.file_deps.end(), std::make_move_iterator(file_deps.begin()),
+                                  std::make_move_iterator(file_deps.end()));
+
             std::ranges::sort(info.named_module_deps);
             const auto dep_tail = std::ranges::unique(info.named_module_deps);
             info.named_module_deps.erase(dep_tail.begin(), dep_tail.end());
@@ -2896,6 +3016,256 @@ std::optional<ScanDepsInfoBySource> run_clang_scan_deps(std::span<const ScanDeps
     return results;
 }
 
+// Per-source clang-scan-deps results are cached under the codegen module cache
+// directory. An entry is reused only when the scan command fingerprint matches
+// and every recorded input (the source, its file-deps, and the interface
+// sources of modules it imports from the same batch) still hashes the same.
+constexpr std::int64_t kScanDepsCacheVersion = 1;
+
+bool scan_deps_cache_enabled() {
+    const auto value = get_env_value("GENTEST_CODEGEN_SCAN_DEPS_CACHE");
+    return !value.has_value() || *value != "0";
+}
+
+std::string sha256_hex(llvm::SHA256 &hasher) {
+    const auto            digest       = hasher.final();
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    std::string           result       = "sha256:";
+    result.reserve(result.size() + digest.size() * 2);
+    for (const std::uint8_t byte : digest) {
+        result.push_back(hex_digits[byte >> 4U]);
+        result.push_back(hex_digits[byte & 0x0FU]);
+    }
+    return result;
+}
+
+// Length-prefixed so that adjacent tokens cannot run into each other.
+void sha256_update_token(llvm::SHA256 &hasher, std::string_view token) {
+    const std::string size = std::to_string(token.size());
+    hasher.update(size);
+    hasher.update(llvm::StringRef{"\0", 1});
+    hasher.update(llvm::StringRef{token.data(), token.size()});
+    hasher.update(llvm::StringRef{"\0", 1});
+}
+
+std::optional<std::string> sha256_file_hex(const std::string &path) {
+    auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (!buffer) {
+        return std::nullopt;
+    }
+    llvm::SHA256 hasher;
+    hasher.update((*buffer)->getBuffer());
+    return sha256_hex(hasher);
+}
+
+std::string scan_deps_command_fingerprint(const ScanDepsPreparedCommand &prepared, std::string_view scan_deps_executable) {
+    llvm::SHA256 hasher;
+    sha256_update_token(hasher, scan_deps_executable);
+    sha256_update_token(hasher, prepared.source_file);
+    sha256_update_token(hasher, prepared.output_file);
+    sha256_update_token(hasher, prepared.working_directory);
+    for (const auto &arg : prepared.command_line) {
+        sha256_update_token(hasher, arg);
+    }
+    return sha256_hex(hasher);
+}
+
+// Concurrent codegen runs may race on the same cache entry; writing a unique
+// temporary and renaming it over the entry keeps every published file whole.
+bool write_cache_json_atomically(const std::filesystem::path &path, const llvm::json::Value &value) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+        return false;
+    }
+    llvm::SmallString<256> tmp_path_storage;
+    int                    tmp_fd = -1;
+    if (llvm::sys::fs::createUniqueFile(path.string() + ".tmp-%%%%%%", tmp_fd, tmp_path_storage)) {
+        return false;
+    }
+    {
+        llvm::raw_fd_ostream out(tmp_fd, /*shouldClose=*/true);
+        out << value;
+        out.flush();
+        if (out.has_error()) {
+            out.clear_error();
+            ignore_cleanup_result(llvm::sys::fs::remove(tmp_path_storage.str()));
+            return false;
+        }
+    }
+    if (llvm::sys::fs::rename(tmp_path_storage.str(), path.string())) {
+        ignore_cleanup_result(llvm::sys::fs::remove(tmp_path_storage.str()));
+        return false;
+    }
+    return true;
+}
+
+std::optional<ScanDepsSourceInfo> load_scan_deps_cache_entry(const std::filesystem::path &entry_path, std::string_view fingerprint) {
+    auto buffer = llvm::MemoryBuffer::getFile(entry_path.string());
+    if (!buffer) {
+        return std::nullopt;
+    }
+    auto parsed = llvm::json::parse((*buffer)->getBuffer());
+    if (!parsed) {
+        llvm::consumeError(parsed.takeError());
+        return std::nullopt;
+    }
+    const auto *root = parsed->getAsObject();
+    if (!root || root->getInteger("version") != kScanDepsCacheVersion || root->getString("command") != llvm::StringRef{fingerprint}) {
+        return std::nullopt;
+    }
+    const auto *inputs = root->getArray("inputs");
+    if (!inputs || inputs->empty()) {
+        return std::nullopt;
+    }
+    for (const auto &input_value : *inputs) {
+        const auto *input = input_value.getAsObject();
+        if (!input) {
+            return std::nullopt;
+        }
+        const auto path = input->getString("path");
+        const auto hash = input->getString("hash");
+        if (!path.has_value() || !hash.has_value() || sha256_file_hex(path->str()) != hash->str()) {
+            return std::nullopt;
+        }
+    }
+
+    ScanDepsSourceInfo info;
+    if (const auto named_module = root->getString("named-module"); named_module.has_value()) {
+        info.provided_module_name = named_module->str();
+    }
+    info.named_module_deps = collect_scan_deps_string_array(*root, "named-module-deps");
+    info.module_file_args  = collect_scan_deps_string_array(*root, "module-file-args");
+    info.file_deps         = collect_scan_deps_string_array(*root, "file-deps");
+    return info;
+}
+
+// Best effort: a cache entry that cannot be written only costs a rescan next time.
+void store_scan_deps_cache_entry(const std::filesystem::path &entry_path, std::string_view fingerprint, const ScanDepsSourceInfo &info,
+                                 std::span<const std::string> input_paths) {
+    llvm::json::Array inputs;
+    inputs.reserve(input_paths.size());
+    for (const auto &path : input_paths) {
+        const auto hash = sha256_file_hex(path);
+        if (!hash.has_value()) {
+            return;
+        }
+        inputs.push_back(llvm::json::Object{{.K = "path", .V = path}, {.K = "hash", .V = *hash}});
+    }
+    auto to_json_array = [](std::span<const std::string> values) {
+        llvm::json::Array array;
+        array.reserve(values.size());
+        for (const auto &value : values) {
+            array.emplace_back(value);
+        }
+        return array;
+    };
+    const llvm::json::Value entry(llvm::json::Object{
+        {.K = "version", .V = kScanDepsCacheVersion},
+        {.K = "command", .V = std::string(fingerprint)},
+        {.K = "inputs", .V = std::move(inputs)},
+        {.K = "named-module", .V = info.provided_module_name},
+        {.K = "named-module-deps", .V = to_json_array(info.named_module_deps)},
+        {.K = "module-file-args", .V = to_json_array(info.module_file_args)},
+        {.K = "file-deps", .V = to_json_array(info.file_deps)},
+    });
+
+    ignore_cleanup_result(write_cache_json_atomically(entry_path, entry));
+}
+
+// Cached front end for run_clang_scan_deps: sources whose entry is still valid
+// are answered from `cache_dir` and only the remaining ones are rescanned. An
+// empty `cache_dir` disables the cache.
+std::optional<ScanDepsInfoBySource> run_clang_scan_deps_cached(std::span<const ScanDepsPreparedCommand> prepared_commands,
+                                                               std::string_view                         explicit_scan_deps_path,
+                                                               const std::filesystem::path &cache_dir, std::string &error_message) {
+    llvm::TimeTraceScope trace_span("ScanDeps", [&] { return fmt::format("{} source(s)", prepared_commands.size()); });
+    if (cache_dir.empty() || prepared_commands.empty() || !scan_deps_cache_enabled()) {
+        return run_clang_scan_deps(prepared_commands, explicit_scan_deps_path, error_message);
+    }
+    error_message.clear();
+
+    const std::string compiler_path =
+        prepared_commands.front().command_line.empty() ? std::string{} : prepared_commands.front().command_line.front();
+    const std::string scan_deps_executable = resolve_clang_scan_deps_executable(explicit_scan_deps_path, compiler_path);
+
+    struct PendingScan {
+        std::string           source_key;
+        std::string           fingerprint;
+        std::filesystem::path entry_path;
+    };
+
+    ScanDepsInfoBySource                 results;
+    std::vector<ScanDepsPreparedCommand> misses;
+    std::vector<PendingScan>             pending;
+    for (const auto &prepared : prepared_commands) {
+        std::string source_key  = normalize_compdb_lookup_path(prepared.source_file);
+        std::string fingerprint = scan_deps_command_fingerprint(prepared, scan_deps_executable);
+        auto        entry_path  = cache_dir / (stable_hash_hex(source_key) + ".json");
+        if (auto cached = load_scan_deps_cache_entry(entry_path, fingerprint); cached.has_value()) {
+            results.insert_or_assign(std::move(source_key), std::move(*cached));
+            continue;
+        }
+        misses.push_back(prepared);
+        pending.push_back(PendingScan{
+            .source_key  = std::move(source_key),
+            .fingerprint = std::move(fingerprint),
+            .entry_path  = std::move(entry_path),
+        });
+    }
+
+    if (should_log_scan_deps_decisions()) {
+        gentest::codegen::log_err("gentest_codegen: clang-scan-deps cache: {} hit(s), {} source(s) to rescan\n",
+                                  prepared_commands.size() - misses.size(), misses.size());
+    }
+    if (misses.empty()) {
+        return results;
+    }
+
+    auto scanned = run_clang_scan_deps(misses, explicit_scan_deps_path, error_message);
+    if (!scanned.has_value()) {
+        return std::nullopt;
+    }
+    for (auto &[source_key, info] : *scanned) {
+        results.insert_or_assign(source_key, info);
+    }
+
+    std::unordered_map<std::string, std::string> interface_source_by_module;
+    for (const auto &[source_key, info] : results) {
+        if (!info.provided_module_name.empty()) {
+            interface_source_by_module.emplace(info.provided_module_name, source_key);
+        }
+    }
+
+    for (std::size_t idx = 0; idx < misses.size(); ++idx) {
+        const auto &entry     = pending[idx];
+        const auto  result_it = scanned->find(entry.source_key);
+        if (result_it == scanned->end()) {
+            continue;
+        }
+        const auto &info = result_it->second;
+
+        std::vector<std::string>        input_paths;
+        std::unordered_set<std::string> seen_inputs;
+        auto                            add_input = [&](std::string path) {
+            if (!path.empty() && seen_inputs.insert(path).second) {
+                input_paths.push_back(std::move(path));
+            }
+        };
+        add_input(entry.source_key);
+        for (const auto &file_dep : info.file_deps) {
+            add_input(normalize_compdb_lookup_path(file_dep, misses[idx].working_directory));
+        }
+        for (const auto &module_name : info.named_module_deps) {
+            if (const auto interface_it = interface_source_by_module.find(module_name); interface_it != interface_source_by_module.end()) {
+                add_input(interface_it->second);
+            }
+        }
+        store_scan_deps_cache_entry(entry.entry_path, entry.fingerprint, info, input_paths);
+    }
+    return results;
+}
+
 std::string normalize_compdb_lookup_path(std::string_view path, std::string_view directory) {
     if (path.empty()) {
         return {};
@@ -3090,21 +3460,9 @@ std::optional<std::size_t> compiler_arg_index_for_resource_dir_probe(const clang
     const auto   tokens = normalized_semantic_compile_context(command, source_file);
     llvm::SHA256 hasher;
     for (const auto &token : tokens) {
-        const std::string size = std::to_string(token.size());
-        hasher.update(size);
-        hasher.update(llvm::StringRef{"\0", 1});
-        hasher.update(token);
-        hasher.update(llvm::StringRef{"\0", 1});
-    }
-    const auto            digest       = hasher.final();
-    static constexpr char hex_digits[] = "0123456789abcdef";
-    std::string           result       = "sha256:";
-    result.reserve(result.size() + digest.size() * 2);
-    for (const std::uint8_t byte : digest) {
-        result.push_back(hex_digits[byte >> 4U]);
-        result.push_back(hex_digits[byte & 0x0FU]);
+        sha256_update_token(hasher, token);
     }
-    return result;
+    return sha256_hex(hasher);
 }
 
 bool        has_sysroot_arg(std::span<const std::string> args);
@@ -3562,12 +3920,6 @@ bool execute_module_precompile(const clang::tooling::CommandLineArguments &comma
     launch_basename                 = basename_without_extension(resolved_path);
     launch_args.front()             = resolved_path;
 
-    std::vector<llvm::StringRef> llvm_args;
-    llvm_args.reserve(launch_args.size());
-    for (const auto &arg : launch_args) {
-        llvm_args.emplace_back(arg);
-    }
-
     if (const auto log_precompile = get_env_value("GENTEST_CODEGEN_LOG_PRECOMPILE"); log_precompile && *log_precompile != "0") {
         gentest::codegen::log_err("gentest_codegen: module precompile command for '{}':\n", module_name);
         for (const auto &arg : launch_args) {
@@ -3575,10 +3927,13 @@ bool execute_module_precompile(const clang::tooling::CommandLineArguments &comma
         }
     }
 
+    // The precompile runs inside the compile command's directory. Only the child
+    // starts there: batch runs execute invocations concurrently, and their
+    // threads resolve relative paths against this process's working directory.
     std::string     err_msg;
     std::error_code cwd_ec;
-    const auto      saved_cwd = std::filesystem::current_path(cwd_ec);
-    if (cwd_ec) {
+    const auto      current_dir = std::filesystem::current_path(cwd_ec);
+    if (cwd_ec && working_directory.empty()) {
         err_msg = fmt::format("failed to query current working directory: {}", cwd_ec.message());
         gentest::codegen::log_err("gentest_codegen: failed to precompile named module '{}' from '{}': {}\n", module_name, source_file,
                                   err_msg);
@@ -3597,13 +3952,9 @@ bool execute_module_precompile(const clang::tooling::CommandLineArguments &comma
             break;
         }
     }
-    llvm_args.clear();
-    llvm_args.reserve(launch_args.size());
-    for (const auto &arg : launch_args) {
-        llvm_args.emplace_back(arg);
-    }
 
-    const std::filesystem::path launch_cwd = working_directory.empty() ? saved_cwd : std::filesystem::path{std::string(working_directory)};
+    const std::filesystem::path launch_cwd =
+        working_directory.empty() ? current_dir : std::filesystem::path{std::string(working_directory)};
 
     struct AlternatePcmCandidateState {
         std::filesystem::path           path;
@@ -3638,22 +3989,8 @@ bool execute_module_precompile(const clang::tooling::CommandLineArguments &comma
         alternate_pcm_candidates.push_back(capture_candidate_state(launch_cwd / (source_stem + ".ifc")));
     }
 
-    std::error_code set_cwd_ec;
-    std::filesystem::current_path(launch_cwd, set_cwd_ec);
-    if (set_cwd_ec) {
-        err_msg = fmt::format("failed to change working directory to '{}': {}", launch_cwd.string(), set_cwd_ec.message());
-        gentest::codegen::log_err("gentest_codegen: failed to precompile named module '{}' from '{}': {}\n", module_name, source_file,
-                                  err_msg);
-        return false;
-    }
+    const int rc = gentest::codegen::execute_in_directory(resolved_path, launch_args, launch_cwd, err_msg);
 
-    const int       rc = llvm::sys::ExecuteAndWait(resolved_path, llvm_args, std::nullopt, {}, 0, 0, &err_msg);
-    std::error_code restore_cwd_ec;
-    std::filesystem::current_path(saved_cwd, restore_cwd_ec);
-    if (restore_cwd_ec) {
-        gentest::codegen::log_err("gentest_codegen: warning: failed to restore working directory after precompiling '{}': {}\n",
-                                  module_name, restore_cwd_ec.message());
-    }
     auto publish_pcm_output = [&](const std::filesystem::path &produced_path) -> bool {
         if (produced_path == pcm_path) {
             return std::filesystem::exists(pcm_path);
@@ -3744,80 +4081,544 @@ bool execute_module_precompile(const clang::tooling::CommandLineArguments &comma
     return false;
 }
 
-bool is_clang_like_compiler(std::string_view path) {
-    const std::string name = basename_without_extension(path);
-    return name == "clang" || name == "clang++" || name == "clang-cl" || has_numeric_suffix_after(name, "clang-") ||
-           has_numeric_suffix_after(name, "clang++-");
-}
+// Content-addressed store of precompiled module interfaces, shared by every
+// codegen run that points at the same directory. A BMI is keyed on the
+// interface source, the keys of the BMIs it imports (so the key covers its
+// transitive imports), the precompile command with output paths removed, and
+// the identity of the compiler that runs it. The entry next to it records the
+// headers the interface pulled in; they are re-hashed before reuse. Entries
+// are touched on reuse and the least recently used ones are evicted once the
+// store grows beyond `max_bytes`.
+struct ModuleBmiCache {
+    std::filesystem::path                        dir;
+    std::uintmax_t                               max_bytes = 0; // 0 = unbounded
+    std::unordered_map<std::string, std::string> key_by_pcm_path;
+};
 
-std::optional<std::size_t> parse_jobs_string(std::string_view raw_value) {
-    llvm::StringRef value{raw_value.data(), raw_value.size()};
-    value = value.trim();
-    if (value.empty()) {
-        return std::nullopt;
-    }
-    if (value.equals_insensitive("auto")) {
-        return 0;
-    }
+constexpr std::int64_t kModuleBmiCacheVersion = 1;
 
-    std::size_t out    = 0;
-    const auto  result = std::from_chars(value.begin(), value.end(), out);
-    if (result.ec != std::errc{} || result.ptr != value.end()) {
-        return std::nullopt;
+std::string memoize_toolchain_probe(std::string key, const std::function<std::string()> &probe);
+std::string resolve_resource_dir(const std::string &compiler_path);
+bool        has_resource_dir_arg(std::span<const std::string> args);
+
+// The precompile command names the compiler but not its build. The resolved
+// binary's size and mtime, plus its default resource directory when the command
+// does not pass one, make an upgraded or swapped compiler miss the cache
+// instead of reusing BMIs it cannot read.
+std::string module_bmi_compiler_identity(const clang::tooling::CommandLineArguments &precompile_command) {
+    if (precompile_command.empty()) {
+        return {};
     }
-    return out;
+    const std::string &compiler = precompile_command.front();
+    std::string        identity = memoize_toolchain_probe(fmt::format("bmi-compiler:{}", compiler), [&] {
+        const std::string          resolved = resolve_program_invocation_path(compiler);
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(resolved, status)) {
+            return resolved;
+        }
+        return fmt::format("{}|size={}|mtime={}", resolved, status.getSize(),
+                           status.getLastModificationTime().time_since_epoch().count());
+    });
+    if (!has_resource_dir_arg(precompile_command)) {
+        identity += fmt::format("|resource-dir={}", resolve_resource_dir(compiler));
+    }
+    return identity;
 }
 
-std::string resolve_default_compiler_path(std::string_view explicit_host_clang_path = {}) {
-    if (!explicit_host_clang_path.empty()) {
-        return resolve_program_invocation_path(explicit_host_clang_path);
+std::optional<std::string> module_bmi_cache_key(const ModuleBmiCache &cache, const clang::tooling::CommandLineArguments &precompile_command,
+                                                std::string_view source_file, const std::filesystem::path &pcm_path,
+                                                std::string_view working_directory) {
+    const auto source_hash = sha256_file_hex(normalize_compdb_lookup_path(source_file, working_directory));
+    if (!source_hash.has_value()) {
+        return std::nullopt;
     }
 
-    static constexpr std::string_view                kDefault = "clang++";
-    static constexpr std::array<std::string_view, 2> kEnvVars = {"CXX", "CC"};
-
-    for (const auto env_name : kEnvVars) {
-        const auto env_value = get_env_value(env_name);
-        if (!env_value.has_value()) {
+    llvm::SHA256 hasher;
+    sha256_update_token(hasher, fmt::format("gentest-bmi-v{}", kModuleBmiCacheVersion));
+    sha256_update_token(hasher, module_bmi_compiler_identity(precompile_command));
+    sha256_update_token(hasher, *source_hash);
+    const std::string output_path = pcm_path.string();
+    for (const auto &arg : precompile_command) {
+        if (arg == output_path) {
+            sha256_update_token(hasher, "<output>");
             continue;
         }
-        auto              resolved  = llvm::sys::findProgramByName(*env_value);
-        const std::string candidate = resolved ? *resolved : *env_value;
-        if (is_clang_like_compiler(candidate)) {
-            return candidate;
+        // A prebuilt module directory cannot be content-addressed.
+        if (llvm::StringRef{arg}.starts_with("-fprebuilt-module-path")) {
+            return std::nullopt;
         }
-    }
-#if defined(_WIN32)
-    const std::array<std::string, 8> kCandidates = {
-        "clang++.exe",
-        "clang++",
-        "clang.exe",
-        "clang",
-        fmt::format("clang++-{}.exe", CLANG_VERSION_MAJOR),
-        fmt::format("clang++-{}", CLANG_VERSION_MAJOR),
-        fmt::format("clang-{}.exe", CLANG_VERSION_MAJOR),
-        fmt::format("clang-{}", CLANG_VERSION_MAJOR),
-    };
-#else
-    const std::string                versioned   = std::string("clang++-") + std::to_string(CLANG_VERSION_MAJOR);
-    const std::string                versioned_c = std::string("clang-") + std::to_string(CLANG_VERSION_MAJOR);
-    const std::array<std::string, 4> kCandidates = {versioned, std::string(kDefault), versioned_c, std::string("clang")};
-#endif
-    for (const auto &candidate : kCandidates) {
-        auto path = llvm::sys::findProgramByName(candidate);
-        if (path) {
-            return *path;
+        if (llvm::StringRef{arg}.starts_with("-fmodule-file=")) {
+            std::string_view value = std::string_view{arg}.substr(std::string_view{"-fmodule-file="}.size());
+            std::string_view name;
+            if (const auto module_name = named_module_from_module_file_arg(arg); module_name.has_value()) {
+                name = *module_name;
+                value.remove_prefix(name.size() + 1);
+            }
+            // BMIs this run did not build (e.g. from the build system) are keyed on their bytes.
+            std::optional<std::string> import_key;
+            if (const auto import_it = cache.key_by_pcm_path.find(std::string(value)); import_it != cache.key_by_pcm_path.end()) {
+                import_key = import_it->second;
+            } else {
+                import_key = sha256_file_hex(normalize_compdb_lookup_path(value, working_directory));
+            }
+            if (!import_key.has_value()) {
+                return std::nullopt;
+            }
+            sha256_update_token(hasher, fmt::format("-fmodule-file={}={}", name, *import_key));
+            continue;
         }
+        sha256_update_token(hasher, arg);
     }
-    return std::string{kDefault};
+    auto key = sha256_hex(hasher);
+    return key.substr(std::string_view{"sha256:"}.size());
 }
 
-std::optional<std::string> resolve_explicit_host_clang_path(std::string_view raw_value, std::string_view setting_name) {
-    if (raw_value.empty()) {
-        return std::nullopt;
+// Parses the inputs of a Make-style depfile written by `-dependency-file`.
+std::vector<std::string> read_depfile_inputs(const std::filesystem::path &depfile, std::string_view working_directory) {
+    std::vector<std::string> inputs;
+    auto                     buffer = llvm::MemoryBuffer::getFile(depfile.string());
+    if (!buffer) {
+        return inputs;
+    }
+    const std::string_view text  = (*buffer)->getBuffer();
+    const auto             colon = text.find(": ");
+    if (colon == std::string_view::npos) {
+        return inputs;
     }
 
-    std::string resolved = resolve_program_invocation_path(raw_value);
+    std::string current;
+    auto        flush = [&] {
+        if (!current.empty()) {
+            inputs.push_back(normalize_compdb_lookup_path(current, working_directory));
+            current.clear();
+        }
+    };
+    for (std::size_t i = colon + 2; i < text.size(); ++i) {
+        const char ch = text[i];
+        if (ch == '\\' && i + 1 < text.size()) {
+            const char next = text[i + 1];
+            if (next == '\n' || next == '\r') {
+                flush();
+                ++i;
+                continue;
+            }
+            if (next == ' ' || next == '#' || next == '\\') {
+                current.push_back(next);
+                ++i;
+                continue;
+            }
+        }
+        if (ch == '$' && i + 1 < text.size() && text[i + 1] == '$') {
+            current.push_back('$');
+            ++i;
+            continue;
+        }
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            flush();
+            continue;
+        }
+        current.push_back(ch);
+    }
+    flush();
+    return inputs;
+}
+
+void enforce_module_bmi_cache_limit(const ModuleBmiCache &cache) {
+    if (cache.max_bytes == 0) {
+        return;
+    }
+    struct StoredBmi {
+        std::filesystem::path           bmi;
+        std::filesystem::path           entry;
+        std::filesystem::file_time_type last_used{};
+        std::uintmax_t                  size = 0;
+    };
+    std::vector<StoredBmi> stored;
+    std::uintmax_t         total_size = 0;
+    std::error_code        ec;
+    for (std::filesystem::directory_iterator it{cache.dir, ec}, end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ".pcm") {
+            continue;
+        }
+        StoredBmi       bmi{.bmi = it->path(), .entry = it->path()};
+        std::error_code stat_ec;
+        bmi.entry.replace_extension(".json");
+        bmi.size = std::filesystem::file_size(bmi.bmi, stat_ec);
+        if (stat_ec) {
+            continue;
+        }
+        bmi.last_used = std::filesystem::last_write_time(bmi.entry, stat_ec);
+        if (stat_ec) {
+            bmi.last_used = std::filesystem::last_write_time(bmi.bmi, stat_ec);
+        }
+        total_size += bmi.size;
+        stored.push_back(std::move(bmi));
+    }
+    if (total_size <= cache.max_bytes) {
+        return;
+    }
+
+    std::ranges::sort(stored, {}, &StoredBmi::last_used);
+    for (const auto &bmi : stored) {
+        if (total_size <= cache.max_bytes) {
+            break;
+        }
+        // Drop the entry first so a concurrent reader cannot validate a BMI that is about to vanish.
+        std::error_code remove_ec;
+        std::filesystem::remove(bmi.entry, remove_ec);
+        std::filesystem::remove(bmi.bmi, remove_ec);
+        total_size -= bmi.size;
+    }
+}
+
+// Publishes `source` at `target` as a hard link, or as a copy where links are unsupported.
+bool link_or_copy_file(const std::filesystem::path &source, const std::filesystem::path &target) {
+    std::error_code ec;
+    std::filesystem::remove(target, ec);
+    ec.clear();
+    std::filesystem::create_hard_link(source, target, ec);
+    if (!ec) {
+        return true;
+    }
+    ec.clear();
+    std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing, ec);
+    return !ec;
+}
+
+bool restore_module_bmi(const ModuleBmiCache &cache, std::string_view key, const std::filesystem::path &pcm_path) {
+    const auto entry_path = cache.dir / fmt::format("{}.json", key);
+    auto       buffer     = llvm::MemoryBuffer::getFile(entry_path.string());
+    if (!buffer) {
+        return false;
+    }
+    auto parsed = llvm::json::parse((*buffer)->getBuffer());
+    if (!parsed) {
+        llvm::consumeError(parsed.takeError());
+        return false;
+    }
+    const auto *root   = parsed->getAsObject();
+    const auto *inputs = root ? root->getArray("inputs") : nullptr;
+    if (!inputs || root->getInteger("version") != kModuleBmiCacheVersion) {
+        return false;
+    }
+    for (const auto &input_value : *inputs) {
+        const auto *input = input_value.getAsObject();
+        if (!input) {
+            return false;
+        }
+        const auto path = input->getString("path");
+        const auto hash = input->getString("hash");
+        if (!path.has_value() || !hash.has_value() || sha256_file_hex(path->str()) != hash->str()) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(pcm_path.parent_path(), ec);
+    if (!link_or_copy_file(cache.dir / fmt::format("{}.pcm", key), pcm_path)) {
+        return false;
+    }
+    std::filesystem::last_write_time(entry_path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+// Best effort: a BMI that cannot be published is simply rebuilt by the next run.
+void store_module_bmi(const ModuleBmiCache &cache, std::string_view key, const std::filesystem::path &pcm_path,
+                      std::span<const std::string> input_paths) {
+    llvm::json::Array inputs;
+    inputs.reserve(input_paths.size());
+    for (const auto &path : input_paths) {
+        const auto hash = sha256_file_hex(path);
+        if (!hash.has_value()) {
+            return;
+        }
+        inputs.push_back(llvm::json::Object{{.K = "path", .V = path}, {.K = "hash", .V = *hash}});
+    }
+
+    const auto      bmi_path = cache.dir / fmt::format("{}.pcm", key);
+    std::error_code ec;
+    std::filesystem::create_directories(cache.dir, ec);
+    if (ec) {
+        return;
+    }
+    llvm::SmallString<256> tmp_path_storage;
+    llvm::sys::fs::createUniquePath(bmi_path.string() + ".tmp-%%%%%%", tmp_path_storage, /*MakeAbsolute=*/false);
+    const std::filesystem::path tmp_path{tmp_path_storage.str().str()};
+    if (!link_or_copy_file(pcm_path, tmp_path)) {
+        std::filesystem::remove(tmp_path, ec);
+        return;
+    }
+    std::filesystem::rename(tmp_path, bmi_path, ec);
+    // rename() is a no-op when both names already link the same file, so always drop the temporary.
+    std::error_code cleanup_ec;
+    std::filesystem::remove(tmp_path, cleanup_ec);
+    if (ec) {
+        return;
+    }
+
+    const llvm::json::Value entry(llvm::json::Object{
+        {.K = "version", .V = kModuleBmiCacheVersion},
+        {.K = "inputs", .V = std::move(inputs)},
+    });
+    if (write_cache_json_atomically(cache.dir / fmt::format("{}.json", key), entry)) {
+        enforce_module_bmi_cache_limit(cache);
+    }
+}
+
+// Precompiles one named module, reusing a BMI from `cache` when one with the
+// same key is still valid. A null `cache` always runs the compiler.
+bool precompile_module_interface(ModuleBmiCache *cache, const clang::tooling::CommandLineArguments &command_line,
+                                 std::string_view module_name, std::string_view source_file, const std::filesystem::path &pcm_path,
+                                 std::string_view working_directory) {
+    llvm::TimeTraceScope trace_span("PrecompileModule", module_name);
+    const auto key = cache != nullptr ? module_bmi_cache_key(*cache, command_line, source_file, pcm_path, working_directory)
+                                      : std::optional<std::string>{};
+    if (!key.has_value()) {
+        return execute_module_precompile(command_line, module_name, source_file, pcm_path, working_directory);
+    }
+
+    const bool log_precompile = [] {
+        const auto value = get_env_value("GENTEST_CODEGEN_LOG_PRECOMPILE");
+        return value.has_value() && *value != "0";
+    }();
+    if (restore_module_bmi(*cache, *key, pcm_path)) {
+        if (log_precompile) {
+            gentest::codegen::log_err("gentest_codegen: reused cached BMI {} for module '{}'\n", *key, module_name);
+        }
+        cache->key_by_pcm_path.insert_or_assign(pcm_path.string(), *key);
+        return true;
+    }
+
+    // cc1 spellings work under both the GCC-style and the cl driver.
+    const std::filesystem::path          depfile{pcm_path.string() + ".d"};
+    clang::tooling::CommandLineArguments command = command_line;
+    const std::array<std::string, 8>     depfile_args{"-Xclang", "-dependency-file", "-Xclang", depfile.string(),
+                                                      "-Xclang", "-MT",              "-Xclang", pcm_path.string()};
+    command.insert(command.begin() + 1, depfile_args.begin(), depfile_args.end());
+    if (!execute_module_precompile(command, module_name, source_file, pcm_path, working_directory)) {
+        return false;
+    }
+
+    auto inputs = read_depfile_inputs(depfile, working_directory);
+    std::error_code ec;
+    std::filesystem::remove(depfile, ec);
+    if (!inputs.empty()) {
+        store_module_bmi(*cache, *key, pcm_path, inputs);
+    }
+    cache->key_by_pcm_path.insert_or_assign(pcm_path.string(), *key);
+    return true;
+}
+
+// A slot whose whole include closure has no marker bytes yields no cases,
+// fixtures or mocks, so later runs may skip Clang for it. After a parse the
+// closure is recorded with each file's size and mtime; the record is trusted
+// only while the compile command matches and every file in it is unchanged.
+constexpr std::int64_t kMarkerClosureVersion = 1;
+
+bool marker_prefilter_enabled() {
+    const auto value = get_env_value("GENTEST_CODEGEN_MARKER_PREFILTER");
+    return !value.has_value() || *value != "0";
+}
+
+struct FileStamp {
+    std::uint64_t size     = 0;
+    std::int64_t  mtime_ns = 0;
+
+    bool operator==(const FileStamp &) const = default;
+};
+
+std::optional<FileStamp> stat_file_stamp(const std::string &path) {
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(path, status) || !llvm::sys::fs::is_regular_file(status)) {
+        return std::nullopt;
+    }
+    const auto mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(status.getLastModificationTime().time_since_epoch());
+    return FileStamp{.size = status.getSize(), .mtime_ns = static_cast<std::int64_t>(mtime.count())};
+}
+
+// Memoized per path and stamp: authored slots share most of their headers, so
+// each file is mapped and scanned once per run. Unreadable files count as hits.
+bool file_may_contain_codegen_markers(const std::string &path, const FileStamp &stamp) {
+    struct ScannedFile {
+        FileStamp stamp;
+        bool      may_contain_markers = true;
+    };
+    static std::mutex                                   mutex;
+    static std::unordered_map<std::string, ScannedFile> scanned;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (const auto it = scanned.find(path); it != scanned.end() && it->second.stamp == stamp) {
+            return it->second.may_contain_markers;
+        }
+    }
+
+    bool may_contain_markers = true;
+    if (auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false, /*RequiresNullTerminator=*/false); buffer) {
+        may_contain_markers = bytes_may_contain_codegen_markers((*buffer)->getBuffer());
+    }
+    const std::lock_guard<std::mutex> lock(mutex);
+    scanned.insert_or_assign(path, ScannedFile{.stamp = stamp, .may_contain_markers = may_contain_markers});
+    return may_contain_markers;
+}
+
+std::string marker_closure_command_fingerprint(std::span<const clang::tooling::CompileCommand> commands) {
+    llvm::SHA256 hasher;
+    for (const auto &command : commands) {
+        sha256_update_token(hasher, command.Directory);
+        sha256_update_token(hasher, command.Filename);
+        for (const auto &arg : command.CommandLine) {
+            sha256_update_token(hasher, arg);
+        }
+    }
+    return sha256_hex(hasher);
+}
+
+// Returns the recorded closure when the entry is still valid and none of its
+// files may contain markers.
+std::optional<std::vector<std::string>> load_marker_free_closure(const std::filesystem::path &entry_path, std::string_view fingerprint) {
+    auto buffer = llvm::MemoryBuffer::getFile(entry_path.string());
+    if (!buffer) {
+        return std::nullopt;
+    }
+    auto parsed = llvm::json::parse((*buffer)->getBuffer());
+    if (!parsed) {
+        llvm::consumeError(parsed.takeError());
+        return std::nullopt;
+    }
+    const auto *root  = parsed->getAsObject();
+    const auto *files = root ? root->getArray("files") : nullptr;
+    if (!files || root->getInteger("version") != kMarkerClosureVersion || root->getString("command") != llvm::StringRef{fingerprint}) {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> closure;
+    closure.reserve(files->size());
+    for (const auto &file_value : *files) {
+        const auto *file = file_value.getAsObject();
+        if (!file) {
+            return std::nullopt;
+        }
+        const auto path     = file->getString("path");
+        const auto size     = file->getInteger("size");
+        const auto mtime_ns = file->getInteger("mtime_ns");
+        if (!path.has_value() || !size.has_value() || !mtime_ns.has_value()) {
+            return std::nullopt;
+        }
+        const auto stamp = stat_file_stamp(path->str());
+        if (!stamp.has_value() || stamp->size != static_cast<std::uint64_t>(*size) || stamp->mtime_ns != *mtime_ns ||
+            file_may_contain_codegen_markers(path->str(), *stamp)) {
+            return std::nullopt;
+        }
+        closure.push_back(path->str());
+    }
+    return closure;
+}
+
+// Records a marker-free closure for the next run; a closure with markers only
+// drops any stale entry, because its slot has to be parsed anyway.
+void store_marker_closure(const std::filesystem::path &entry_path, std::string_view fingerprint, std::vector<std::string> closure) {
+    std::ranges::sort(closure);
+    const auto tail = std::ranges::unique(closure);
+    closure.erase(tail.begin(), tail.end());
+
+    llvm::json::Array files;
+    files.reserve(closure.size());
+    for (const auto &path : closure) {
+        const auto stamp = stat_file_stamp(path);
+        if (!stamp.has_value() || file_may_contain_codegen_markers(path, *stamp)) {
+            std::error_code ec;
+            std::filesystem::remove(entry_path, ec);
+            return;
+        }
+        files.push_back(llvm::json::Object{
+            {.K = "path", .V = path},
+            {.K = "size", .V = static_cast<std::int64_t>(stamp->size)},
+            {.K = "mtime_ns", .V = stamp->mtime_ns},
+        });
+    }
+
+    const llvm::json::Value entry(llvm::json::Object{
+        {.K = "version", .V = kMarkerClosureVersion},
+        {.K = "command", .V = std::string{fingerprint}},
+        {.K = "files", .V = std::move(files)},
+    });
+    ignore_cleanup_result(write_cache_json_atomically(entry_path, entry));
+}
+
+bool is_clang_like_compiler(std::string_view path) {
+    const std::string name = basename_without_extension(path);
+    return name == "clang" || name == "clang++" || name == "clang-cl" || has_numeric_suffix_after(name, "clang-") ||
+           has_numeric_suffix_after(name, "clang++-");
+}
+
+std::optional<std::size_t> parse_jobs_string(std::string_view raw_value) {
+    llvm::StringRef value{raw_value.data(), raw_value.size()};
+    value = value.trim();
+    if (value.empty()) {
+        return std::nullopt;
+    }
+    if (value.equals_insensitive("auto")) {
+        return 0;
+    }
+
+    std::size_t out    = 0;
+    const auto  result = std::from_chars(value.begin(), value.end(), out);
+    if (result.ec != std::errc{} || result.ptr != value.end()) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+std::string probe_default_compiler_path(std::string_view explicit_host_clang_path) {
+    if (!explicit_host_clang_path.empty()) {
+        return resolve_program_invocation_path(explicit_host_clang_path);
+    }
+
+    static constexpr std::string_view                kDefault = "clang++";
+    static constexpr std::array<std::string_view, 2> kEnvVars = {"CXX", "CC"};
+
+    for (const auto env_name : kEnvVars) {
+        const auto env_value = get_env_value(env_name);
+        if (!env_value.has_value()) {
+            continue;
+        }
+        auto              resolved  = llvm::sys::findProgramByName(*env_value);
+        const std::string candidate = resolved ? *resolved : *env_value;
+        if (is_clang_like_compiler(candidate)) {
+            return candidate;
+        }
+    }
+#if defined(_WIN32)
+    const std::array<std::string, 8> kCandidates = {
+        "clang++.exe",
+        "clang++",
+        "clang.exe",
+        "clang",
+        fmt::format("clang++-{}.exe", CLANG_VERSION_MAJOR),
+        fmt::format("clang++-{}", CLANG_VERSION_MAJOR),
+        fmt::format("clang-{}.exe", CLANG_VERSION_MAJOR),
+        fmt::format("clang-{}", CLANG_VERSION_MAJOR),
+    };
+#else
+    const std::string                versioned   = std::string("clang++-") + std::to_string(CLANG_VERSION_MAJOR);
+    const std::string                versioned_c = std::string("clang-") + std::to_string(CLANG_VERSION_MAJOR);
+    const std::array<std::string, 4> kCandidates = {versioned, std::string(kDefault), versioned_c, std::string("clang")};
+#endif
+    for (const auto &candidate : kCandidates) {
+        auto path = llvm::sys::findProgramByName(candidate);
+        if (path) {
+            return *path;
+        }
+    }
+    return std::string{kDefault};
+}
+
+std::optional<std::string> resolve_explicit_host_clang_path(std::string_view raw_value, std::string_view setting_name) {
+    if (raw_value.empty()) {
+        return std::nullopt;
+    }
+
+    std::string resolved = resolve_program_invocation_path(raw_value);
     if (!is_clang_like_compiler(resolved)) {
         gentest::codegen::log_err("gentest_codegen: warning: ignoring {}='{}' because it is not clang-like\n", setting_name, raw_value);
         return std::nullopt;
@@ -3952,7 +4753,8 @@ std::string compiler_for_resource_dir_probe(const clang::tooling::CommandLineArg
     return command_line[*compiler_index];
 }
 
-std::string resolve_resource_dir(const std::string &compiler_path) {
+std::string probe_resource_dir(const std::string &compiler_path) {
+    llvm::TimeTraceScope trace_span("ResolveResourceDir", compiler_path);
     if (const auto override_resource_dir = get_env_value("GENTEST_CODEGEN_RESOURCE_DIR");
         override_resource_dir && !override_resource_dir->empty()) {
         if (std::filesystem::exists(*override_resource_dir)) {
@@ -4005,7 +4807,8 @@ std::string resolve_resource_dir(const std::string &compiler_path) {
     return trimmed.str();
 }
 
-std::string resolve_default_sysroot() {
+std::string probe_default_sysroot() {
+    llvm::TimeTraceScope trace_span("ResolveSysroot");
 #if !defined(__APPLE__)
     return {};
 #else
@@ -4058,6 +4861,79 @@ std::string resolve_default_sysroot() {
 #endif
 }
 
+// Toolchain probes spawn the host compiler. Their answers only depend on the
+// process environment, so a batch run probes once and every invocation reuses
+// the result.
+std::string memoize_toolchain_probe(std::string key, const std::function<std::string()> &probe) {
+    static std::mutex                                   cache_mutex;
+    static std::unordered_map<std::string, std::string> cache;
+    std::lock_guard<std::mutex>                         lock(cache_mutex);
+    if (const auto it = cache.find(key); it != cache.end()) {
+        return it->second;
+    }
+    return cache.emplace(std::move(key), probe()).first->second;
+}
+
+std::string resolve_default_compiler_path(std::string_view explicit_host_clang_path = {}) {
+    return memoize_toolchain_probe(fmt::format("compiler:{}", explicit_host_clang_path),
+                                   [&] { return probe_default_compiler_path(explicit_host_clang_path); });
+}
+
+std::string resolve_resource_dir(const std::string &compiler_path) {
+    return memoize_toolchain_probe(fmt::format("resource-dir:{}", compiler_path), [&] { return probe_resource_dir(compiler_path); });
+}
+
+std::string resolve_default_sysroot() { return memoize_toolchain_probe("sysroot", [] { return probe_default_sysroot(); }); }
+
+// A loaded compilation database together with its per-file command index.
+// Batch invocations that name the same --compdb share one instance, so lookups
+// that miss the index are serialized on `lookup_mutex`.
+struct IndexedCompilationDatabase {
+    std::unique_ptr<clang::tooling::CompilationDatabase>                         database;
+    std::unordered_map<std::string, std::vector<clang::tooling::CompileCommand>> commands_by_file;
+    std::vector<std::string>                                                     files;
+    mutable std::mutex                                                           lookup_mutex;
+
+    [[nodiscard]] std::vector<clang::tooling::CompileCommand> lookup(const std::string &file_path) const {
+        std::lock_guard<std::mutex> lock(lookup_mutex);
+        return database->getCompileCommands(file_path);
+    }
+};
+
+[[nodiscard]] std::shared_ptr<const IndexedCompilationDatabase>
+index_compilation_database(std::unique_ptr<clang::tooling::CompilationDatabase> database) {
+    auto indexed = std::make_shared<IndexedCompilationDatabase>();
+    for (const auto &command : database->getAllCompileCommands()) {
+        const std::string key = normalize_compdb_lookup_path(command.Filename, command.Directory);
+        if (key.empty()) {
+            continue;
+        }
+        indexed->commands_by_file[key].push_back(command);
+    }
+    indexed->files.reserve(indexed->commands_by_file.size());
+    for (const auto &[file, _] : indexed->commands_by_file) {
+        indexed->files.push_back(file);
+    }
+    indexed->database = std::move(database);
+    return indexed;
+}
+
+[[nodiscard]] std::shared_ptr<const IndexedCompilationDatabase> load_compilation_database(const std::filesystem::path &directory,
+                                                                                          std::string                 &error) {
+    static std::mutex                                                                         cache_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const IndexedCompilationDatabase>> cache;
+    const std::string                                                                         key = directory.lexically_normal().string();
+    std::lock_guard<std::mutex>                                                               lock(cache_mutex);
+    if (const auto it = cache.find(key); it != cache.end()) {
+        return it->second;
+    }
+    auto database = clang::tooling::CompilationDatabase::loadFromDirectory(directory.string(), error);
+    if (!database) {
+        return nullptr;
+    }
+    return cache.emplace(key, index_compilation_database(std::move(database))).first->second;
+}
+
 enum class MockPhaseCommand {
     None,
     InspectMocks,
@@ -4067,6 +4943,8 @@ enum class MockPhaseCommand {
 struct ParsedArguments {
     CollectorOptions                   options;
     std::optional<std::string>         explicit_host_clang_path;
+    std::string                        trace_output_path;
+    unsigned                           trace_granularity_us                 = 500;
     MockPhaseCommand                   mock_phase                           = MockPhaseCommand::None;
     bool                               inspect_source                       = false;
     bool                               removed_output_requested             = false;
@@ -4092,6 +4970,11 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
         "textual-registration-output",
         llvm::cl::desc("Explicit additive header-declaration registration source path (repeat once per positional source)"),
         llvm::cl::ZeroOrMore, llvm::cl::cat(category)};
+    static llvm::cl::list<std::string> textual_registration_shard_output_option{
+        "textual-registration-shard-output",
+        llvm::cl::desc("Extra registration shard source for an additive registration slot (repeat N-1 times per positional source, "
+                       "slot-major)"),
+        llvm::cl::ZeroOrMore, llvm::cl::cat(category)};
     static llvm::cl::list<std::string> module_wrapper_output_option{
         "module-wrapper-output",
         llvm::cl::desc("Explicit output module wrapper path for a TU-mode input source (repeat once per positional source)"),
@@ -4103,6 +4986,9 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     static llvm::cl::opt<std::string>  artifact_manifest_option{"artifact-manifest",
                                                                 llvm::cl::desc("Path to a generated artifact manifest JSON file"),
                                                                 llvm::cl::init(""), llvm::cl::cat(category)};
+    static llvm::cl::opt<std::string>  inventory_output_option{
+        "inventory-output", llvm::cl::desc("Path to write the discovered case inventory (--list-json schema) for CTest discovery"),
+        llvm::cl::init(""), llvm::cl::cat(category)};
     static llvm::cl::list<std::string> compile_context_id_option{
         "compile-context-id",
         llvm::cl::desc("Build-system compile context identity for an input source (repeat once per positional source)"),
@@ -4127,9 +5013,21 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     static llvm::cl::opt<std::string> scan_deps_executable_option{
         "clang-scan-deps", llvm::cl::desc("Path to the clang-scan-deps executable used for named-module dependency discovery"),
         llvm::cl::init(""), llvm::cl::cat(category)};
+    static llvm::cl::opt<std::string> module_bmi_cache_option{
+        "module-bmi-cache", llvm::cl::desc("Directory of a content-addressed BMI store shared across codegen runs"), llvm::cl::init(""),
+        llvm::cl::cat(category)};
+    static llvm::cl::opt<unsigned>    module_bmi_cache_max_mb_option{
+        "module-bmi-cache-max-mb", llvm::cl::desc("Evict least recently used BMIs once the store exceeds this size (0=unbounded)"),
+        llvm::cl::init(0), llvm::cl::cat(category)};
     static llvm::cl::opt<std::string> host_clang_option{
         "host-clang", llvm::cl::desc("Path to the host Clang executable used for Clang-only codegen operations"), llvm::cl::init(""),
         llvm::cl::cat(category)};
+    static llvm::cl::opt<std::string> trace_out_option{
+        "trace-out", llvm::cl::desc("Write per-phase and per-slot spans, including Clang's own, as a Chrome trace to this file"),
+        llvm::cl::init(""), llvm::cl::cat(category)};
+    static llvm::cl::opt<unsigned> trace_granularity_option{
+        "trace-granularity-us", llvm::cl::desc("Drop --trace-out spans shorter than this many microseconds (default 500)"),
+        llvm::cl::init(500), llvm::cl::cat(category)};
     static llvm::cl::list<std::string> external_module_source_option{"external-module-source",
                                                                      llvm::cl::desc("Explicit named-module source mapping (module=path)"),
                                                                      llvm::cl::ZeroOrMore, llvm::cl::cat(category)};
@@ -4223,6 +5121,8 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     opts.sources.assign(source_option.begin(), source_option.end());
     opts.tu_output_headers.assign(tu_header_output_option.begin(), tu_header_output_option.end());
     opts.textual_registration_outputs.assign(textual_registration_output_option.begin(), textual_registration_output_option.end());
+    opts.textual_registration_shard_outputs.assign(textual_registration_shard_output_option.begin(),
+                                                   textual_registration_shard_output_option.end());
     opts.module_wrapper_outputs.assign(module_wrapper_output_option.begin(), module_wrapper_output_option.end());
     opts.module_registration_outputs.assign(module_registration_output_option.begin(), module_registration_output_option.end());
     opts.scan_slot_kinds.assign(scan_slot_kind_option.begin(), scan_slot_kind_option.end());
@@ -4232,6 +5132,9 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     if (!artifact_manifest_option.getValue().empty()) {
         opts.artifact_manifest_path = std::filesystem::path{artifact_manifest_option.getValue()};
     }
+    if (!inventory_output_option.getValue().empty()) {
+        opts.inventory_path = std::filesystem::path{inventory_output_option.getValue()};
+    }
     opts.clang_args = std::move(clang_args);
     strip_shell_control_tail(opts.clang_args);
     opts.check_only  = check_option.getValue();
@@ -4241,6 +5144,24 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     } else if (const auto scan_deps_env = get_env_value("GENTEST_CODEGEN_CLANG_SCAN_DEPS"); scan_deps_env && !scan_deps_env->empty()) {
         opts.clang_scan_deps_executable = std::filesystem::path{*scan_deps_env};
     }
+    if (module_bmi_cache_option.getNumOccurrences() != 0 && !module_bmi_cache_option.getValue().empty()) {
+        opts.module_bmi_cache_dir = std::filesystem::path{module_bmi_cache_option.getValue()};
+    } else if (const auto bmi_cache_env = get_env_value("GENTEST_CODEGEN_BMI_CACHE"); bmi_cache_env && !bmi_cache_env->empty()) {
+        opts.module_bmi_cache_dir = std::filesystem::path{*bmi_cache_env};
+    }
+    opts.module_bmi_cache_max_bytes = std::uint64_t{module_bmi_cache_max_mb_option.getValue()} * 1024U * 1024U;
+    if (module_bmi_cache_max_mb_option.getNumOccurrences() == 0) {
+        if (const auto max_mb_env = get_env_value("GENTEST_CODEGEN_BMI_CACHE_MAX_MB"); max_mb_env.has_value()) {
+            std::uint64_t max_mb = 0;
+            const auto [ptr, ec] = std::from_chars(max_mb_env->data(), max_mb_env->data() + max_mb_env->size(), max_mb);
+            if (ec != std::errc{} || ptr != max_mb_env->data() + max_mb_env->size()) {
+                gentest::codegen::log_err("gentest_codegen: warning: ignoring invalid GENTEST_CODEGEN_BMI_CACHE_MAX_MB='{}'\n",
+                                          *max_mb_env);
+            } else {
+                opts.module_bmi_cache_max_bytes = max_mb * 1024U * 1024U;
+            }
+        }
+    }
     for (const auto &raw_mapping : external_module_source_option) {
         const auto separator = raw_mapping.find('=');
         if (separator == std::string::npos || separator == 0 || separator + 1 >= raw_mapping.size()) {
@@ -4340,6 +5261,8 @@ ParsedArguments parse_arguments(int argc, const char **argv) {
     return ParsedArguments{
         .options                    = std::move(opts),
         .explicit_host_clang_path   = std::move(explicit_host_clang_path),
+        .trace_output_path          = trace_out_option.getValue(),
+        .trace_granularity_us       = trace_granularity_option.getValue(),
         .mock_phase                 = mock_phase,
         .inspect_source             = inspect_source_option.getValue(),
         .removed_output_requested   = output_option.getNumOccurrences() != 0,
@@ -4385,7 +5308,7 @@ void diagnose_missing_mock_phase_manifest(MockPhaseCommand mock_phase, const Col
             gentest::codegen::log_err_raw("gentest_codegen: inspect-mocks cannot be combined with --check\n");
             return false;
         }
-        if (!options.tu_output_dir.empty() || !options.artifact_manifest_path.empty()) {
+        if (!options.tu_output_dir.empty() || !options.artifact_manifest_path.empty() || !options.inventory_path.empty()) {
             gentest::codegen::log_err_raw("gentest_codegen: inspect-mocks only writes a mock manifest\n");
             return false;
         }
@@ -4412,20 +5335,28 @@ void diagnose_missing_mock_phase_manifest(MockPhaseCommand mock_phase, const Col
     return true;
 }
 
-} // namespace
-
-int run_codegen_tool(int argc, const char **argv) {
-    llvm::InitLLVM llvm_init(argc, argv);
-
-    if (argc >= 2 && argv[1] != nullptr && std::string_view{argv[1]} == "validate-artifact-manifest") {
-        return run_artifact_manifest_validator(argc - 1, argv + 1);
-    }
-
-    const auto  parsed_arguments = parse_arguments(argc, argv);
-    const auto &options          = parsed_arguments.options;
-    if (parsed_arguments.invalid_arguments) {
-        return 1;
-    }
+// Runs one parsed codegen command. Batch runs call this concurrently, one
+// invocation per worker; `recorded_dependencies` then collects every depfile
+// dependency so the batch can publish a single depfile for all of them, and
+// `batch_args_file` is listed in the invocation's own depfile so a later batch
+// knows which args file that depfile belongs to.
+int run_codegen_invocation(const ParsedArguments &parsed_arguments, std::vector<std::string> *recorded_dependencies,
+                           std::string_view batch_args_file = {}) {
+    const auto &options = parsed_arguments.options;
+    // Top-level phases run one after another on this thread; emplacing the next
+    // phase ends the previous one.
+    std::optional<llvm::TimeTraceScope> phase_span;
+    const auto write_invocation_depfile = [&](const CollectorOptions &depfile_options, const std::vector<std::string> &dependencies) {
+        if (recorded_dependencies != nullptr) {
+            recorded_dependencies->insert(recorded_dependencies->end(), dependencies.begin(), dependencies.end());
+        }
+        if (batch_args_file.empty()) {
+            return write_depfile(depfile_options, dependencies);
+        }
+        std::vector<std::string> with_args_file = dependencies;
+        with_args_file.emplace_back(batch_args_file);
+        return write_depfile(depfile_options, with_args_file);
+    };
     if (parsed_arguments.removed_output_requested) {
         gentest::codegen::log_err_raw(
             "gentest_codegen: --output legacy manifest/single-TU mode was removed in gentest 2.0.0; use --tu-out-dir with explicit "
@@ -4492,7 +5423,7 @@ int run_codegen_tool(int argc, const char **argv) {
             gentest::codegen::log_err_raw("gentest_codegen: --mock-manifest-input cannot be combined with --mock-manifest-output\n");
             return 1;
         }
-        if (!options.tu_output_dir.empty() || !options.artifact_manifest_path.empty()) {
+        if (!options.tu_output_dir.empty() || !options.artifact_manifest_path.empty() || !options.inventory_path.empty()) {
             gentest::codegen::log_err_raw("gentest_codegen: --mock-manifest-input only emits mock outputs\n");
             return 1;
         }
@@ -4544,12 +5475,13 @@ int run_codegen_tool(int argc, const char **argv) {
         }
         const std::vector<TestCaseInfo>    empty_cases;
         const std::vector<FixtureDeclInfo> empty_fixtures;
-        const int                          emit_status = gentest::codegen::emit(emit_options, empty_cases, empty_fixtures, manifest.mocks);
+        phase_span.emplace("Emit");
+        const int emit_status = gentest::codegen::emit(emit_options, empty_cases, empty_fixtures, manifest.mocks);
         if (emit_status != 0) {
             return emit_status;
         }
         std::vector<std::string> depfile_dependencies{options.mock_manifest_input_path.generic_string()};
-        if (!write_depfile(emit_options, depfile_dependencies)) {
+        if (!write_invocation_depfile(emit_options, depfile_dependencies)) {
             return 1;
         }
         return 0;
@@ -4601,7 +5533,7 @@ int run_codegen_tool(int argc, const char **argv) {
             "gentest_codegen: --mock-manifest-output without --tu-out-dir cannot be combined with final mock output paths\n");
         return 1;
     }
-    if (mock_manifest_discovery_only && !options.artifact_manifest_path.empty()) {
+    if (mock_manifest_discovery_only && (!options.artifact_manifest_path.empty() || !options.inventory_path.empty())) {
         gentest::codegen::log_err_raw("gentest_codegen: --mock-manifest-output without --tu-out-dir cannot emit artifact manifests\n");
         return 1;
     }
@@ -4624,6 +5556,14 @@ int run_codegen_tool(int argc, const char **argv) {
                                   options.sources.size(), options.sources.size(), options.textual_registration_outputs.size());
         return 1;
     }
+    if (!options.textual_registration_shard_outputs.empty() &&
+        (options.textual_registration_outputs.empty() ||
+         options.textual_registration_shard_outputs.size() % options.textual_registration_outputs.size() != 0)) {
+        gentest::codegen::log_err("gentest_codegen: expected --textual-registration-shard-output values in multiples of {} input "
+                                  "source(s), got {}\n",
+                                  options.sources.size(), options.textual_registration_shard_outputs.size());
+        return 1;
+    }
     if (!options.textual_registration_outputs.empty() &&
         (!options.module_wrapper_outputs.empty() || !options.module_registration_outputs.empty() || !options.tu_output_headers.empty())) {
         gentest::codegen::log_err_raw(
@@ -4676,18 +5616,21 @@ int run_codegen_tool(int argc, const char **argv) {
     const std::string explicit_host_clang_path = parsed_arguments.explicit_host_clang_path.value_or(std::string{});
     const auto        default_compiler_path    = resolve_default_compiler_path(explicit_host_clang_path);
 
-    std::unique_ptr<clang::tooling::CompilationDatabase> database;
-    std::string                                          db_error;
+    phase_span.emplace("LoadCompilationDatabase");
+    std::shared_ptr<const IndexedCompilationDatabase> database;
+    std::string                                       db_error;
     if (options.compilation_database) {
-        database = clang::tooling::CompilationDatabase::loadFromDirectory(options.compilation_database->string(), db_error);
+        database = load_compilation_database(*options.compilation_database, db_error);
         if (!database) {
             gentest::codegen::log_err("gentest_codegen: failed to load compilation database at '{}': {}\n",
                                       options.compilation_database->string(), db_error);
             return 1;
         }
     } else {
-        database = std::make_unique<clang::tooling::FixedCompilationDatabase>(".", std::vector<std::string>{});
+        database = index_compilation_database(std::make_unique<clang::tooling::FixedCompilationDatabase>(".", std::vector<std::string>{}));
     }
+    // Resource-dir probing, scan-deps and module precompiles record nested spans.
+    phase_span.emplace("PrepareSources");
 
 #if CLANG_VERSION_MAJOR < 21
     llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diag_options;
@@ -4775,19 +5718,8 @@ int run_codegen_tool(int argc, const char **argv) {
         std::unordered_map<std::string, std::vector<clang::tooling::CompileCommand>> commands_by_file_;
     };
 
-    std::unordered_map<std::string, std::vector<clang::tooling::CompileCommand>> compile_commands_by_file;
-    for (const auto &command : database->getAllCompileCommands()) {
-        const std::string key = normalize_compdb_lookup_path(command.Filename, command.Directory);
-        if (key.empty()) {
-            continue;
-        }
-        compile_commands_by_file[key].push_back(command);
-    }
-    std::vector<std::string> compdb_files;
-    compdb_files.reserve(compile_commands_by_file.size());
-    for (const auto &[file, _] : compile_commands_by_file) {
-        compdb_files.push_back(file);
-    }
+    const auto &compile_commands_by_file = database->commands_by_file;
+    const auto &compdb_files             = database->files;
 
     auto get_expanded_compile_commands_for_file = [&](std::string_view file_path) {
         std::vector<clang::tooling::CompileCommand> direct_commands;
@@ -4796,7 +5728,7 @@ int run_codegen_tool(int argc, const char **argv) {
             direct_commands = direct_it->second;
         }
         if (direct_commands.empty() && !options.tu_output_dir.empty()) {
-            direct_commands = database->getCompileCommands(std::string(file_path));
+            direct_commands = database->lookup(std::string(file_path));
         }
         for (auto &command : direct_commands) {
             command.CommandLine = expand_compile_command_response_files(command.CommandLine, command.Directory);
@@ -4985,6 +5917,8 @@ int run_codegen_tool(int argc, const char **argv) {
 
     bool        used_scan_deps = false;
     std::string scan_deps_error;
+    const auto  scan_deps_cache_dir =
+        resolve_codegen_module_cache_dir(options, default_compiler_path, default_resource_dir, default_sysroot) / "scan_deps";
     if (options.clang_scan_deps_executable.has_value() && !options.header_declaration_registration) {
         std::vector<ScanDepsPreparedCommand> prepared_scan_deps_commands;
         prepared_scan_deps_commands.reserve(options.sources.size());
@@ -5028,9 +5962,10 @@ int run_codegen_tool(int argc, const char **argv) {
         }
 
         if (can_run_scan_deps) {
-            if (const auto scan_deps_results = run_clang_scan_deps(
+            if (const auto scan_deps_results = run_clang_scan_deps_cached(
                     prepared_scan_deps_commands,
-                    options.clang_scan_deps_executable ? options.clang_scan_deps_executable->string() : std::string{}, scan_deps_error);
+                    options.clang_scan_deps_executable ? options.clang_scan_deps_executable->string() : std::string{},
+                    scan_deps_cache_dir, scan_deps_error);
                 scan_deps_results.has_value()) {
                 std::vector<NamedModuleSourceInfo>                        scan_deps_named_module_sources;
                 std::unordered_map<std::string, std::size_t>              scan_deps_named_module_index_by_name;
@@ -5356,6 +6291,13 @@ int run_codegen_tool(int argc, const char **argv) {
     if (!named_module_sources.empty() || has_any_named_module_imports) {
         const std::filesystem::path module_cache_dir =
             resolve_codegen_module_cache_dir(options, default_compiler_path, default_resource_dir, default_sysroot);
+        std::optional<ModuleBmiCache> module_bmi_cache;
+        if (options.module_bmi_cache_dir.has_value()) {
+            module_bmi_cache.emplace(ModuleBmiCache{
+                .dir       = std::filesystem::absolute(*options.module_bmi_cache_dir),
+                .max_bytes = options.module_bmi_cache_max_bytes,
+            });
+        }
         for (auto &module_source : named_module_sources) {
             module_source.pcm_path = module_cache_dir / fmt::format("m_{:04d}_{}.pcm", static_cast<unsigned>(module_source.source_index),
                                                                     stable_hash_hex(module_source.module_name));
@@ -5505,7 +6447,7 @@ int run_codegen_tool(int argc, const char **argv) {
                             external_scan_deps_command_line, candidate.string(), resource_dir_for_compiler, default_compiler_path,
                             default_sysroot, extra_args, compdb_dir, {}, explicit_host_clang_path, external_forced_compiler_path, true);
                         std::string external_scan_deps_error;
-                        if (const auto scan_deps_results = run_clang_scan_deps(
+                        if (const auto scan_deps_results = run_clang_scan_deps_cached(
                                 std::array<ScanDepsPreparedCommand, 1>{ScanDepsPreparedCommand{
                                     .source_file       = candidate.string(),
                                     .output_file       = external_scan_command->Output,
@@ -5513,7 +6455,7 @@ int run_codegen_tool(int argc, const char **argv) {
                                     .command_line      = std::move(adjusted_scan_deps_command),
                                 }},
                                 options.clang_scan_deps_executable ? options.clang_scan_deps_executable->string() : std::string{},
-                                external_scan_deps_error);
+                                scan_deps_cache_dir, external_scan_deps_error);
                             scan_deps_results.has_value()) {
                             if (const auto scan_deps_it = scan_deps_results->find(normalize_compdb_lookup_path(candidate.string()));
                                 scan_deps_it != scan_deps_results->end()) {
@@ -5732,9 +6674,9 @@ int run_codegen_tool(int argc, const char **argv) {
             const auto precompile_command = build_module_precompile_command(
                 adjusted_command, module_source.source_path.string(),
                 source_commands.empty() ? compdb_dir : source_commands.front().Directory, module_source.pcm_path, true);
-            if (!execute_module_precompile(precompile_command, module_source.module_name, module_source.source_path.string(),
-                                           module_source.pcm_path,
-                                           source_commands.empty() ? compdb_dir : source_commands.front().Directory)) {
+            if (!precompile_module_interface(module_bmi_cache ? &*module_bmi_cache : nullptr, precompile_command, module_source.module_name,
+                                             module_source.source_path.string(), module_source.pcm_path,
+                                             source_commands.empty() ? compdb_dir : source_commands.front().Directory)) {
                 state = ModuleBuildState::Failed;
                 return false;
             }
@@ -5790,8 +6732,8 @@ int run_codegen_tool(int argc, const char **argv) {
                                             explicit_host_clang_path, module_source->resolution_context.forced_compiler_path);
             const auto precompile_command = build_module_precompile_command(adjusted_command, module_source->source_path.string(),
                                                                             external_working_directory, module_source->pcm_path, true);
-            if (!execute_module_precompile(precompile_command, module_name, module_source->source_path.string(), module_source->pcm_path,
-                                           external_working_directory)) {
+            if (!precompile_module_interface(module_bmi_cache ? &*module_bmi_cache : nullptr, precompile_command, module_name,
+                                             module_source->source_path.string(), module_source->pcm_path, external_working_directory)) {
                 state = ModuleBuildState::Failed;
                 return false;
             }
@@ -5938,16 +6880,21 @@ int run_codegen_tool(int argc, const char **argv) {
     if (parse_jobs > 1 && serial_parse_reason.has_value()) {
         parse_jobs = 1;
     }
+    // The batch driver primes the statistics registry before lending its pool.
+    gentest::codegen::JobBudget *const shared_jobs = serial_parse_reason.has_value() ? nullptr : options.job_budget;
     if (multi_tu && parse_jobs > 1) {
         prime_llvm_statistics_registry();
     }
     if (multi_tu && should_log_parse_policy()) {
         if (serial_parse_reason.has_value()) {
             gentest::codegen::log_err("gentest_codegen: forcing serial multi-TU parse ({})\n", *serial_parse_reason);
+        } else if (shared_jobs != nullptr) {
+            gentest::codegen::log_err("gentest_codegen: using multi-TU parse jobs from the batch pool\n");
         } else {
             gentest::codegen::log_err("gentest_codegen: using multi-TU parse jobs={}\n", parse_jobs);
         }
     }
+    phase_span.emplace("Parse", [&] { return fmt::format("{} slot(s)", options.sources.size()); });
     if (multi_tu) {
         // Snapshot each TU's compile command up front so every worker gets an
         // immutable one-file view and does not need to share lookup state while
@@ -5955,7 +6902,18 @@ int run_codegen_tool(int argc, const char **argv) {
         std::vector<ParseResult> results(options.sources.size());
         std::vector<std::string> diag_texts(options.sources.size());
 
+        // Named-module imports reach declarations through BMIs, which a textual
+        // include closure cannot vouch for.
+        const bool use_marker_closures = marker_prefilter_enabled() && named_module_sources.empty() && !has_any_named_module_imports;
+        std::filesystem::path marker_closure_dir;
+        if (use_marker_closures) {
+            marker_closure_dir =
+                resolve_codegen_module_cache_dir(options, default_compiler_path, default_resource_dir, default_sysroot) / "marker_closures";
+        }
+
         const auto parse_one = [&](std::size_t idx) {
+            const gentest::codegen::ThreadTraceScope thread_trace;
+            llvm::TimeTraceScope                     slot_span("ParseSlot", options.sources[idx]);
             if (const auto delay = get_env_value("GENTEST_CODEGEN_TEST_DELAY_SLOT"); delay.has_value()) {
                 const std::size_t separator = delay->find(':');
                 std::size_t       delayed_slot{};
@@ -5989,6 +6947,23 @@ int run_codegen_tool(int argc, const char **argv) {
                 }
             }
 
+            std::string           marker_closure_fingerprint;
+            std::filesystem::path marker_closure_entry;
+            if (use_marker_closures) {
+                marker_closure_fingerprint = marker_closure_command_fingerprint(tool_compile_commands[idx]);
+                marker_closure_entry = marker_closure_dir / (stable_hash_hex(normalize_compdb_lookup_path(options.sources[idx])) + ".json");
+                if (auto closure = load_marker_free_closure(marker_closure_entry, marker_closure_fingerprint); closure.has_value()) {
+                    if (should_log_parse_policy()) {
+                        gentest::codegen::log_err("gentest_codegen: skipping Clang for '{}': no markers in {} include closure file(s)\n",
+                                                  options.sources[idx], closure->size());
+                    }
+                    // The recorded closure still feeds the depfile and fallback-header reachability.
+                    results[idx] = ParseResult{.dependencies = std::move(*closure)};
+                    diag_texts[idx].clear();
+                    return;
+                }
+            }
+
 #if CLANG_VERSION_MAJOR < 21
             llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> tu_diag_options;
 #else
@@ -6079,7 +7054,11 @@ int run_codegen_tool(int argc, const char **argv) {
             result.fixtures     = std::move(local_fixtures);
             result.mocks        = std::move(local_mocks);
             result.dependencies = std::move(local_dependencies);
-            results[idx]        = std::move(result);
+            if (use_marker_closures && result.status == 0 && !result.had_test_errors && !result.had_fixture_errors &&
+                !result.had_mock_errors) {
+                store_marker_closure(marker_closure_entry, marker_closure_fingerprint, result.dependencies);
+            }
+            results[idx] = std::move(result);
 
             diag_stream.flush();
             diag_texts[idx] = std::move(diag_buffer);
@@ -6101,14 +7080,16 @@ int run_codegen_tool(int argc, const char **argv) {
             // Run one input serially to initialize Clang/LLVM lazy globals
             // before the first parallel wave. Every subsequent worker still
             // writes only its own pre-indexed ParseResult.
-            if (parse_jobs > 1 && !llvm_warmed) {
+            if ((parse_jobs > 1 || shared_jobs != nullptr) && !llvm_warmed) {
                 parse_one(indices.front());
                 llvm_warmed    = true;
                 parallel_start = 1;
             }
-            if (parse_jobs > 1) {
-                gentest::codegen::parallel_for(indices.size() - parallel_start, parse_jobs,
-                                               [&](std::size_t local_idx) { parse_one(indices[parallel_start + local_idx]); });
+            const auto parse_at = [&](std::size_t local_idx) { parse_one(indices[parallel_start + local_idx]); };
+            if (shared_jobs != nullptr) {
+                gentest::codegen::parallel_for(indices.size() - parallel_start, *shared_jobs, parse_at);
+            } else if (parse_jobs > 1) {
+                gentest::codegen::parallel_for(indices.size() - parallel_start, parse_jobs, parse_at);
             } else {
                 for (const std::size_t idx : indices) {
                     parse_one(idx);
@@ -6165,8 +7146,17 @@ int run_codegen_tool(int argc, const char **argv) {
             file_commands.emplace(normalize_compdb_lookup_path(options.sources[i]), tool_compile_commands[i]);
         }
         const SnapshotCompilationDatabase file_database{std::move(file_commands)};
-        clang::tooling::ClangTool         tool{file_database, options.sources};
-        std::vector<std::string>          normalized_overlays;
+        // Batch runs parse other invocations concurrently, so this tool must
+        // not move the process working directory either.
+        auto                                            physical_fs_unique = llvm::vfs::createPhysicalFileSystem();
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> base_fs;
+        if (physical_fs_unique) {
+            base_fs = llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(physical_fs_unique.release());
+        } else {
+            base_fs = llvm::vfs::getRealFileSystem();
+        }
+        clang::tooling::ClangTool tool{file_database, options.sources, std::make_shared<clang::PCHContainerOperations>(), base_fs};
+        std::vector<std::string>  normalized_overlays;
         normalized_overlays.reserve(options.sources.size());
         for (std::size_t i = 0; i < options.sources.size(); ++i) {
             const auto overlay_include_paths =
@@ -6219,6 +7209,7 @@ int run_codegen_tool(int argc, const char **argv) {
         depfile_dependencies = std::move(depfile_dependencies_local);
     }
 
+    phase_span.emplace("MergeAndValidate");
     merge_duplicate_mocks(mocks);
 
     if (options.header_declaration_registration) {
@@ -6237,7 +7228,7 @@ int run_codegen_tool(int argc, const char **argv) {
         return 1;
     }
 
-    std::ranges::sort(cases, {}, &TestCaseInfo::display_name);
+    std::ranges::sort(cases, gentest::codegen::render::registry_order_less);
 
     if (!options.check_only && options.tu_output_dir.empty() && options.mock_manifest_output_path.empty()) {
         gentest::codegen::log_err_raw("gentest_codegen: --tu-out-dir is required unless --check is specified\n");
@@ -6336,6 +7327,7 @@ int run_codegen_tool(int argc, const char **argv) {
     if (options.check_only) {
         return 0;
     }
+    phase_span.emplace("Emit");
     const auto mock_output_domain_modules = mock_domain_modules_from_context(final_options);
     if (!options.mock_manifest_output_path.empty()) {
         std::string manifest_error;
@@ -6344,7 +7336,7 @@ int run_codegen_tool(int argc, const char **argv) {
             return 1;
         }
         if (mock_manifest_discovery_only) {
-            if (!write_depfile(final_options, depfile_dependencies)) {
+            if (!write_invocation_depfile(final_options, depfile_dependencies)) {
                 return 1;
             }
             return 0;
@@ -6362,8 +7354,379 @@ int run_codegen_tool(int argc, const char **argv) {
     if (emit_status != 0) {
         return emit_status;
     }
-    if (!write_depfile(final_options, depfile_dependencies)) {
+    if (!write_invocation_depfile(final_options, depfile_dependencies)) {
         return 1;
     }
     return 0;
 }
+
+// `gentest_codegen batch --manifest <file>` runs many codegen commands in one
+// process. Every non-empty manifest line names an args file holding one
+// command's arguments without the program name, one per line. Items inside a
+// line are split at `;` and empty items dropped, matching how CMake expands a
+// custom command with COMMAND_EXPAND_LISTS, so build systems can write the
+// same argument lists they would otherwise pass on the command line.
+//
+// A manifest line may add `;<depends file>` after the args file, listing the
+// paths the command depends on besides what its own depfile records, i.e.
+// the file dependencies a build system would attach to a per-target command.
+// A command with a `--depfile` whose recorded inputs, args file, depends file
+// entries and the codegen executable are all older than that depfile is
+// skipped, so editing one target's sources reruns only that target.
+struct BatchOptions {
+    std::filesystem::path      manifest;
+    std::filesystem::path      depfile;
+    std::filesystem::path      stamp;
+    std::string                trace_output_path;
+    unsigned                   trace_granularity_us = 500;
+    std::optional<std::size_t> jobs;
+};
+
+[[nodiscard]] bool parse_batch_args(int argc, const char **argv, BatchOptions &options, std::string &error) {
+    for (int idx = 1; idx < argc; ++idx) {
+        const std::string_view raw_arg = argv[idx] ? std::string_view{argv[idx]} : std::string_view{};
+        const std::string_view arg     = raw_arg.substr(0, raw_arg.find('='));
+        if (arg != "--manifest" && arg != "--depfile" && arg != "--stamp" && arg != "--jobs" && arg != "--trace-out" &&
+            arg != "--trace-granularity-us") {
+            error = fmt::format("unknown batch option '{}'", raw_arg);
+            return false;
+        }
+        std::string value;
+        if (!take_cli_value(argc, argv, idx, value, error)) {
+            return false;
+        }
+        if (arg == "--manifest") {
+            options.manifest = std::filesystem::path{value};
+        } else if (arg == "--depfile") {
+            options.depfile = std::filesystem::path{value};
+        } else if (arg == "--stamp") {
+            options.stamp = std::filesystem::path{value};
+        } else if (arg == "--trace-out") {
+            options.trace_output_path = std::move(value);
+        } else if (arg == "--jobs") {
+            options.jobs = parse_jobs_string(value);
+            if (!options.jobs) {
+                error = fmt::format("invalid --jobs='{}'", value);
+                return false;
+            }
+        } else {
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), options.trace_granularity_us);
+            if (ec != std::errc{} || ptr != value.data() + value.size()) {
+                error = fmt::format("invalid --trace-granularity-us='{}'", value);
+                return false;
+            }
+        }
+    }
+    if (options.manifest.empty()) {
+        error = "batch requires --manifest";
+        return false;
+    }
+    if (!options.depfile.empty() && options.stamp.empty()) {
+        error = "batch --depfile requires --stamp, which names the depfile target";
+        return false;
+    }
+    return true;
+}
+
+[[nodiscard]] std::optional<std::vector<std::string>> read_batch_lines(const std::filesystem::path &path, std::string &error) {
+    std::ifstream in{path};
+    if (!in) {
+        error = fmt::format("failed to read batch file '{}'", path.string());
+        return std::nullopt;
+    }
+    std::vector<std::string> lines;
+    std::string              line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            lines.push_back(std::move(line));
+        }
+    }
+    return lines;
+}
+
+[[nodiscard]] std::optional<std::vector<std::string>> read_batch_args_file(const std::filesystem::path &path, std::string &error) {
+    auto lines = read_batch_lines(path, error);
+    if (!lines) {
+        return std::nullopt;
+    }
+    std::vector<std::string> args;
+    for (const auto &line : *lines) {
+        llvm::SmallVector<llvm::StringRef, 8> items;
+        llvm::StringRef(line).split(items, ';', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+        for (const auto item : items) {
+            args.push_back(item.str());
+        }
+    }
+    return args;
+}
+
+[[nodiscard]] bool touch_batch_stamp(const std::filesystem::path &stamp) {
+    if (stamp.empty()) {
+        return true;
+    }
+    std::error_code ec;
+    if (stamp.has_parent_path()) {
+        std::filesystem::create_directories(stamp.parent_path(), ec);
+    }
+    {
+        std::ofstream out{stamp, std::ios::trunc};
+        if (!out) {
+            gentest::codegen::log_err("gentest_codegen: failed to write batch stamp '{}'\n", stamp.string());
+            return false;
+        }
+    }
+    std::filesystem::last_write_time(stamp, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+struct BatchInvocation {
+    std::filesystem::path    args_file;
+    std::filesystem::path    depends_file;
+    ParsedArguments          arguments;
+    std::uintmax_t           estimated_cost = 0;
+    std::vector<std::string> dependencies;
+    bool                     up_to_date = false;
+    int                      status     = 0;
+};
+
+// Decides whether `invocation` can be skipped. Outputs are only rewritten when
+// their content changes, so their timestamps say nothing about when the
+// command last ran; its depfile, which every successful run rewrites, does. On
+// a skip the previous run's inputs are kept in `invocation.dependencies` so
+// the batch depfile still covers them.
+[[nodiscard]] bool batch_invocation_up_to_date(BatchInvocation &invocation, const std::optional<std::filesystem::path> &executable) {
+    const auto &options = invocation.arguments.options;
+    if (!options.depfile_path || options.depfile_path->empty() || !executable) {
+        return false;
+    }
+    std::error_code ec;
+    const auto      ran_at = std::filesystem::last_write_time(*options.depfile_path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto entries = read_depfile_entries(*options.depfile_path, depfile_build_dir(options));
+    if (!entries || entries->targets.empty()) {
+        return false;
+    }
+    for (const auto &target : entries->targets) {
+        if (!std::filesystem::exists(target, ec)) {
+            return false;
+        }
+    }
+    // Configurations share the depfile but not the args file; a depfile left by
+    // another configuration's args file says nothing about this one.
+    const std::string args_file = normalize_dependency_path(invocation.args_file.string());
+    if (std::ranges::none_of(entries->dependencies, [&](const auto &dependency) { return dependency.generic_string() == args_file; })) {
+        return false;
+    }
+    std::vector<std::filesystem::path> inputs = entries->dependencies;
+    inputs.push_back(*executable);
+    if (!invocation.depends_file.empty()) {
+        std::string error;
+        const auto  depends = read_batch_args_file(invocation.depends_file, error);
+        if (!depends) {
+            return false;
+        }
+        inputs.push_back(invocation.depends_file);
+        inputs.insert(inputs.end(), depends->begin(), depends->end());
+    }
+    for (const auto &input : inputs) {
+        // A missing input (e.g. a deleted header) means the command must run.
+        const auto modified_at = std::filesystem::last_write_time(input, ec);
+        if (ec || modified_at > ran_at) {
+            return false;
+        }
+    }
+    for (const auto &dependency : entries->dependencies) {
+        if (dependency.generic_string() != args_file) {
+            invocation.dependencies.push_back(dependency.string());
+        }
+    }
+    return true;
+}
+
+int run_codegen_batch(int argc, const char **argv, const char *program_name) {
+    BatchOptions batch;
+    std::string  error;
+    if (!parse_batch_args(argc, argv, batch, error)) {
+        gentest::codegen::log_err("gentest_codegen: {}\n", error);
+        return 1;
+    }
+    const auto args_files = read_batch_lines(batch.manifest, error);
+    if (!args_files) {
+        gentest::codegen::log_err("gentest_codegen: {}\n", error);
+        return 1;
+    }
+
+    // llvm::cl options are process-wide, so every invocation is parsed up front
+    // on this thread before any of them runs.
+    std::vector<BatchInvocation> invocations;
+    invocations.reserve(args_files->size());
+    for (const auto &manifest_line : *args_files) {
+        const auto            separator = manifest_line.find(';');
+        std::filesystem::path args_file{manifest_line.substr(0, separator)};
+        std::filesystem::path depends_file;
+        if (separator != std::string::npos) {
+            depends_file = std::filesystem::path{manifest_line.substr(separator + 1)};
+        }
+        if (args_file.is_relative()) {
+            args_file = batch.manifest.parent_path() / args_file;
+        }
+        if (!depends_file.empty() && depends_file.is_relative()) {
+            depends_file = batch.manifest.parent_path() / depends_file;
+        }
+        const auto args = read_batch_args_file(args_file, error);
+        if (!args) {
+            gentest::codegen::log_err("gentest_codegen: {}\n", error);
+            return 1;
+        }
+        std::vector<const char *> invocation_argv;
+        invocation_argv.reserve(args->size() + 1);
+        invocation_argv.push_back("gentest_codegen");
+        for (const auto &arg : *args) {
+            invocation_argv.push_back(arg.c_str());
+        }
+        llvm::cl::ResetAllOptionOccurrences();
+        auto &invocation        = invocations.emplace_back();
+        invocation.args_file    = args_file;
+        invocation.depends_file = depends_file;
+        invocation.arguments    = parse_arguments(static_cast<int>(invocation_argv.size()), invocation_argv.data());
+        if (invocation.arguments.invalid_arguments) {
+            gentest::codegen::log_err("gentest_codegen: invalid arguments in batch args file '{}'\n", args_file.string());
+            return 1;
+        }
+        if (!invocation.arguments.trace_output_path.empty()) {
+            gentest::codegen::log_err("gentest_codegen: warning: ignoring --trace-out in batch args file '{}'; pass it to batch instead\n",
+                                      args_file.string());
+        }
+        for (const auto &source : invocation.arguments.options.sources) {
+            std::error_code size_ec;
+            const auto      size = std::filesystem::file_size(source, size_ec);
+            if (!size_ec) {
+                invocation.estimated_cost += size;
+            }
+        }
+    }
+
+    std::optional<std::filesystem::path> executable;
+    if (std::string path = llvm::sys::fs::getMainExecutable(program_name, reinterpret_cast<void *>(&run_codegen_batch)); !path.empty()) {
+        executable = std::filesystem::path{std::move(path)};
+    }
+    std::size_t up_to_date = 0;
+    for (auto &invocation : invocations) {
+        invocation.up_to_date = batch_invocation_up_to_date(invocation, executable);
+        if (invocation.up_to_date) {
+            ++up_to_date;
+        }
+    }
+
+    // Longest first, estimated by total source size, so the biggest targets
+    // start while the pool is full instead of running alone at the tail.
+    std::vector<std::size_t> order;
+    order.reserve(invocations.size() - up_to_date);
+    for (std::size_t idx = 0; idx < invocations.size(); ++idx) {
+        if (!invocations[idx].up_to_date) {
+            order.push_back(idx);
+        }
+    }
+    std::ranges::stable_sort(order, std::greater<>{}, [&](std::size_t idx) { return invocations[idx].estimated_cost; });
+
+    std::size_t total_jobs = 0;
+    if (batch.jobs.has_value()) {
+        total_jobs = *batch.jobs;
+    } else if (const auto jobs_env = get_env_value("GENTEST_CODEGEN_JOBS"); jobs_env) {
+        if (const auto parsed = parse_jobs_string(*jobs_env); parsed) {
+            total_jobs = *parsed;
+        } else {
+            gentest::codegen::log_err("gentest_codegen: warning: ignoring invalid GENTEST_CODEGEN_JOBS='{}'\n", *jobs_env);
+        }
+    }
+    if (total_jobs == 0) {
+        total_jobs = gentest::codegen::default_concurrency(std::numeric_limits<std::size_t>::max());
+    }
+    // Every invocation, parse slot and emit slot draws helper threads from one
+    // pool: this thread is the first job and the pool holds the rest. Once the
+    // last invocations have started, jobs freed by finished ones go to the
+    // slots of those still running instead of sitting idle.
+    const bool                                 serial = total_jobs == 1 || forced_serial_parse_reason().has_value();
+    std::optional<gentest::codegen::JobBudget> budget;
+    if (!serial) {
+        budget.emplace(total_jobs - 1);
+    }
+    // Without a pool an invocation runs alone and keeps every job; parse still
+    // honours a forced serial reason on its own.
+    for (auto &invocation : invocations) {
+        invocation.arguments.options.jobs       = budget ? 1 : total_jobs;
+        invocation.arguments.options.job_budget = budget ? &*budget : nullptr;
+    }
+    if (should_log_parse_policy()) {
+        gentest::codegen::log_err("gentest_codegen: batch of {} invocation(s), {} up to date, using {} shared job(s)\n", invocations.size(),
+                                  up_to_date, serial ? 1 : total_jobs);
+    }
+
+    const gentest::codegen::TraceSession trace_session{batch.trace_output_path, batch.trace_granularity_us};
+    if (budget) {
+        prime_llvm_statistics_registry();
+    }
+    const auto run_invocation = [&](std::size_t position) {
+        auto                                    &invocation = invocations[order[position]];
+        const gentest::codegen::ThreadTraceScope thread_trace;
+        llvm::TimeTraceScope                     invocation_span("BatchInvocation", invocation.args_file.string());
+        if (const auto &tu_output_dir = invocation.arguments.options.tu_output_dir; !tu_output_dir.empty()) {
+            std::error_code dir_ec;
+            std::filesystem::create_directories(tu_output_dir, dir_ec);
+        }
+        invocation.status = run_codegen_invocation(invocation.arguments, &invocation.dependencies, invocation.args_file.string());
+        if (invocation.status != 0) {
+            gentest::codegen::log_err("gentest_codegen: batch args file '{}' failed\n", invocation.args_file.string());
+        }
+    };
+    if (budget) {
+        gentest::codegen::parallel_for(order.size(), *budget, run_invocation);
+    } else {
+        gentest::codegen::parallel_for(order.size(), 1, run_invocation);
+    }
+
+    std::vector<std::string> dependencies{batch.manifest.string()};
+    for (auto &invocation : invocations) {
+        if (invocation.status != 0) {
+            return invocation.status;
+        }
+        dependencies.push_back(invocation.args_file.string());
+        if (!invocation.depends_file.empty()) {
+            dependencies.push_back(invocation.depends_file.string());
+        }
+        dependencies.insert(dependencies.end(), std::make_move_iterator(invocation.dependencies.begin()),
+                            std::make_move_iterator(invocation.dependencies.end()));
+    }
+    if (!batch.depfile.empty()) {
+        const std::array<std::filesystem::path, 1> dep_targets{batch.stamp};
+        if (!write_depfile_for_targets(batch.depfile, dep_targets, dependencies, std::filesystem::current_path())) {
+            return 1;
+        }
+    }
+    return touch_batch_stamp(batch.stamp) ? 0 : 1;
+}
+
+} // namespace
+
+int run_codegen_tool(int argc, const char **argv) {
+    llvm::InitLLVM llvm_init(argc, argv);
+
+    if (argc >= 2 && argv[1] != nullptr && std::string_view{argv[1]} == "validate-artifact-manifest") {
+        return run_artifact_manifest_validator(argc - 1, argv + 1);
+    }
+    if (argc >= 2 && argv[1] != nullptr && std::string_view{argv[1]} == "batch") {
+        return run_codegen_batch(argc - 1, argv + 1, argv[0]);
+    }
+
+    const auto parsed_arguments = parse_arguments(argc, argv);
+    if (parsed_arguments.invalid_arguments) {
+        return 1;
+    }
+    const gentest::codegen::TraceSession trace_session{parsed_arguments.trace_output_path, parsed_arguments.trace_granularity_us};
+    return run_codegen_invocation(parsed_arguments, nullptr);
+}
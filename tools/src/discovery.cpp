@@ -651,6 +651,16 @@ struct FunctionParamInfo {
     std::size_t                 fixture_index   = 0;
     std::optional<FixtureScope> required_scope;
 };
+
+std::string bench_cache_enumerator(const AttributeSummary &summary) {
+    if (summary.cache_warm && summary.cache_cold)
+        return "Both";
+    if (summary.cache_cold)
+        return "Cold";
+    if (summary.cache_warm)
+        return "Warm";
+    return {};
+}
 } // namespace
 
 TestCaseCollector::TestCaseCollector(std::vector<TestCaseInfo> &out, bool strict_fixture, bool allow_includes,
@@ -945,13 +955,22 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
         report("gentest::async_test<T> return types are supported only for test cases, not bench or jitter cases");
         return;
     }
+    if (!returns_async && std::ranges::find(summary.tags, "virtual_time") != summary.tags.end()) {
+        had_error_ = true;
+        report("'virtual_time' requires a gentest::async_test<T> return type");
+        return;
+    }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
     auto add_case = [&](const std::vector<std::string> &tpl_ordered, const std::string &display_args, const std::string &call_args,
                         const std::vector<std::string> &free_fixture_types, const std::vector<std::string> &free_fixture_emit_types,
                         const std::vector<std::string>                 &free_fixture_entity_keys,
                         const std::vector<std::optional<FixtureScope>> &free_fixture_required_scopes,
-                        const std::vector<FreeCallArg>                 &free_call_args) {
+                        const std::vector<FreeCallArg> &free_call_args, const std::string &complexity_n_expression,
+                        const std::string &complexity_series_args) {
+        const std::string series_display =
+            complexity_series_args.empty() ? std::string{} : make_display(final_base, tpl_ordered, complexity_series_args);
+
         TestCaseInfo info{};
         info.qualified_name               = make_qualified(tpl_ordered);
         info.display_name                 = make_display(final_base, tpl_ordered, display_args);
@@ -971,6 +990,9 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
         info.is_jitter                    = summary.is_jitter;
         info.is_baseline                  = summary.is_baseline;
         info.items_per_call               = summary.items_per_call;
+        info.complexity_n_expression      = complexity_n_expression;
+        info.complexity_series            = series_display;
+        info.bench_cache                  = bench_cache_enumerator(summary);
         info.template_args                = tpl_ordered;
         info.call_arguments               = call_args;
         info.is_function_template         = is_function_template;
@@ -992,6 +1014,12 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
                         info.base_name, info.suite_name, info.call_arguments, info.fixture_qualified_name,
                         static_cast<int>(info.fixture_lifetime), info.is_benchmark, info.is_jitter, info.is_baseline, info.returns_value,
                         info.returns_async, info.items_per_call, info.should_skip, info.skip_reason, info.owner);
+        if (!info.complexity_series.empty()) {
+            info.semantic_fingerprint += "|complexity:" + info.complexity_series + "=" + info.complexity_n_expression;
+        }
+        if (!info.bench_cache.empty()) {
+            info.semantic_fingerprint += "|cache:" + info.bench_cache;
+        }
         for (const auto &tag : info.tags) {
             info.semantic_fingerprint += "|tag:" + tag;
         }
@@ -1095,6 +1123,16 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
             }
         }
     }
+    if (summary.complexity_param.has_value()) {
+        const auto complexity_it =
+            std::ranges::find_if(function_params, [&](const FunctionParamInfo &param) { return param.name == *summary.complexity_param; });
+        if (complexity_it == function_params.end() || complexity_it->decl == nullptr ||
+            !complexity_it->decl->getType().getNonReferenceType()->isArithmeticType()) {
+            had_error_ = true;
+            report(fmt::format("'complexity({})' requires an arithmetic function parameter", *summary.complexity_param));
+            return;
+        }
+    }
 
     std::vector<std::string>                 inferred_fixture_types;
     std::vector<std::string>                 inferred_fixture_entity_keys;
@@ -1417,6 +1455,8 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
     auto emit_case = [&](const std::vector<std::string> &tpl_combo) {
         std::vector<std::string> value_exprs_for_display;
         std::vector<std::string> value_exprs_for_call;
+        std::vector<std::string> value_exprs_for_series;
+        std::string              complexity_n_expression;
         std::vector<FreeCallArg> free_call_args;
         free_call_args.reserve(function_params.size());
 
@@ -1455,6 +1495,12 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
             }
             value_exprs_for_call.push_back(expr);
             value_exprs_for_display.push_back(expr);
+            if (summary.complexity_param.has_value() && param.name == *summary.complexity_param) {
+                complexity_n_expression = expr;
+                value_exprs_for_series.push_back(param.name);
+            } else {
+                value_exprs_for_series.push_back(expr);
+            }
             FreeCallArg arg{};
             arg.kind             = FreeCallArgKind::Value;
             arg.value_expression = std::move(expr);
@@ -1463,8 +1509,9 @@ void TestCaseCollector::run(const MatchFinder::MatchResult &result) {
 
         const std::string display_args = join_csv(value_exprs_for_display);
         const std::string call_args    = join_csv(value_exprs_for_call);
+        const std::string series_args  = complexity_n_expression.empty() ? std::string{} : join_csv(value_exprs_for_series);
         add_case(tpl_combo, display_args, call_args, inferred_fixture_types, inferred_fixture_emit_types, inferred_fixture_entity_keys,
-                 inferred_fixture_required_scopes, free_call_args);
+                 inferred_fixture_required_scopes, free_call_args, complexity_n_expression, series_args);
     };
 
     std::function<void(std::size_t, const std::vector<std::string> &)> visit_scalars = [&](std::size_t                     idx,
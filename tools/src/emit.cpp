@@ -9,6 +9,7 @@
 #include "render_mocks.hpp"
 #include "scan_utils.hpp"
 #include "templates.hpp"
+#include "trace.hpp"
 
 #include <algorithm>
 #include <atomic>
@@ -20,9 +21,11 @@
 #include <fstream>
 #include <iterator>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <map>
 #include <ranges>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -205,6 +208,20 @@ fs::path resolve_textual_registration_output(const CollectorOptions &opts, std::
     return opts.textual_registration_outputs[idx];
 }
 
+// Extra shard sources per additive registration slot; the slot's primary
+// `--textual-registration-output` is always shard 0.
+std::size_t textual_registration_extra_shards(const CollectorOptions &opts) {
+    if (opts.sources.empty()) {
+        return 0;
+    }
+    return opts.textual_registration_shard_outputs.size() / opts.sources.size();
+}
+
+std::span<const fs::path> resolve_textual_registration_shard_outputs(const CollectorOptions &opts, std::size_t idx) {
+    const std::size_t extra = textual_registration_extra_shards(opts);
+    return std::span<const fs::path>{opts.textual_registration_shard_outputs}.subspan(idx * extra, extra);
+}
+
 std::string compile_context_id_for(const CollectorOptions &opts, std::size_t idx) {
     if (idx < opts.compile_context_ids.size() && !opts.compile_context_ids[idx].empty()) {
         return opts.compile_context_ids[idx];
@@ -237,6 +254,63 @@ struct PerSourceEmitData {
     bool                               needs_mock_codegen_include = false;
 };
 
+// A shard is filled up to roughly this estimated cost before the next
+// predeclared shard of the slot is used.
+constexpr std::size_t kRegistrationShardCost = 64;
+
+// Rough front-end cost of one generated wrapper relative to a plain free-test
+// call. Template instantiations, fixture plumbing and benchmark/async support
+// dominate the registration TU's compile time.
+std::size_t estimated_wrapper_cost(const TestCaseInfo &test) {
+    std::size_t cost = 1;
+    if (test.is_function_template) {
+        cost += 2 + test.template_args.size();
+    }
+    if (!test.call_arguments.empty()) {
+        cost += 1;
+    }
+    if (!test.fixture_qualified_name.empty()) {
+        cost += 2;
+    }
+    cost += test.free_fixtures.size();
+    if (test.is_benchmark || test.is_jitter) {
+        cost += 2;
+    }
+    if (test.returns_async) {
+        cost += 2;
+    }
+    return cost;
+}
+
+// Splits one slot's registry-ordered cases into at most `max_shards`
+// contiguous runs of similar estimated cost. Small slots stay in one shard;
+// each run keeps registry order, so every shard still contributes a sorted
+// case table.
+std::vector<std::vector<TestCaseInfo>> partition_registration_shards(const std::vector<TestCaseInfo> &cases, std::size_t max_shards) {
+    std::size_t total_cost = 0;
+    for (const auto &test : cases) {
+        total_cost += estimated_wrapper_cost(test);
+    }
+    std::size_t active = (total_cost + kRegistrationShardCost - 1) / kRegistrationShardCost;
+    active             = std::clamp<std::size_t>(active, 1, std::max<std::size_t>(1, std::min(max_shards, cases.size())));
+
+    std::vector<std::vector<TestCaseInfo>> shards(active);
+    const std::size_t                      target     = (total_cost + active - 1) / active;
+    std::size_t                            shard      = 0;
+    std::size_t                            shard_cost = 0;
+    for (std::size_t idx = 0; idx < cases.size(); ++idx) {
+        // Leave at least one case for every remaining shard.
+        const bool full = shard_cost >= target || cases.size() - idx <= active - shard - 1;
+        if (full && !shards[shard].empty() && shard + 1 < active) {
+            ++shard;
+            shard_cost = 0;
+        }
+        shard_cost += estimated_wrapper_cost(cases[idx]);
+        shards[shard].push_back(cases[idx]);
+    }
+    return shards;
+}
+
 bool is_mock_codegen_header_name(std::string_view header) {
     return header == "gentest/mock_codegen.h" || header == "gentest/mock_registry_codegen.h" || header == "gentest/mock_impl_codegen.h";
 }
@@ -1075,6 +1149,11 @@ bool write_textual_header_registration_manifest(const CollectorOptions &opts) {
         const fs::path    registration_output = resolve_textual_registration_output(opts, idx);
         const std::string context_id          = compile_context_id_for(opts, idx);
         const std::string comma               = idx + 1 == opts.sources.size() ? "" : ",";
+        std::string       shard_outputs;
+        for (const auto &shard_out : resolve_textual_registration_shard_outputs(opts, idx)) {
+            fmt::format_to(std::back_inserter(shard_outputs), "{}\"{}\"", shard_outputs.empty() ? "" : ", ",
+                           render::escape_string(shard_out.generic_string()));
+        }
         fmt::format_to(std::back_inserter(manifest),
                        "    {{\n"
                        "      \"path\": \"{}\",\n"
@@ -1087,16 +1166,27 @@ bool write_textual_header_registration_manifest(const CollectorOptions &opts) {
                        "      \"requires_module_scan\": false,\n"
                        "      \"includes_authored_source\": false,\n"
                        "      \"replaces_authored_source\": false,\n"
+                       "      \"shard_outputs\": [{}],\n"
                        "      \"depfile\": \"{}\"\n"
                        "    }}{}\n",
                        render::escape_string(registration_output.generic_string()), render::escape_string(source_path.generic_string()),
-                       render::escape_string(context_id), render::escape_string(opts.compile_context_fingerprints[idx]),
+                       render::escape_string(context_id), render::escape_string(opts.compile_context_fingerprints[idx]), shard_outputs,
                        opts.depfile_path ? render::escape_string(opts.depfile_path->generic_string()) : std::string{}, comma);
     }
     manifest.append("  ]\n}\n");
     return write_file_atomic_if_changed(opts.artifact_manifest_path, manifest);
 }
 
+bool write_case_inventory(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases) {
+    if (opts.inventory_path.empty()) {
+        return true;
+    }
+    if (!ensure_parent_dir(opts.inventory_path)) {
+        return false;
+    }
+    return write_file_atomic_if_changed(opts.inventory_path, render::render_inventory_json(cases));
+}
+
 bool write_artifact_manifest(const CollectorOptions &opts) {
     if (!write_module_registration_manifest(opts)) {
         return false;
@@ -1202,6 +1292,24 @@ bool validate_generated_artifact_outputs(const CollectorOptions &opts, std::stri
             return false;
         }
     }
+    if (!opts.textual_registration_shard_outputs.empty() &&
+        (opts.textual_registration_outputs.empty() ||
+         opts.textual_registration_shard_outputs.size() % opts.textual_registration_outputs.size() != 0)) {
+        error = fmt::format("generated artifact output alignment for --textual-registration-shard-output expected a multiple of {} "
+                            "slot(s), got {}",
+                            opts.textual_registration_outputs.size(), opts.textual_registration_shard_outputs.size());
+        return false;
+    }
+    for (std::size_t idx = 0; idx < opts.textual_registration_outputs.size(); ++idx) {
+        const auto shard_outputs = resolve_textual_registration_shard_outputs(opts, idx);
+        for (std::size_t shard = 0; shard < shard_outputs.size(); ++shard) {
+            const std::string owner =
+                fmt::format("source slot {} '{}' shard {} (--textual-registration-shard-output)", idx, opts.sources[idx], shard + 1);
+            if (!add_artifact(shard_outputs[shard], "textual header registration shard", owner)) {
+                return false;
+            }
+        }
+    }
     for (std::size_t idx = 0; idx < opts.module_wrapper_outputs.size(); ++idx) {
         // CMake passes the complete wrapper-output vector for slot alignment,
         // including ordinary TU shims.  Ordinary shims are written by CMake,
@@ -1239,6 +1347,7 @@ bool validate_generated_artifact_outputs(const CollectorOptions &opts, std::stri
         return add_artifact(path, std::string(role), fmt::format("option '{}'", option));
     };
     if (!add_option_artifact(opts.artifact_manifest_path, "artifact manifest", "--artifact-manifest") ||
+        !add_option_artifact(opts.inventory_path, "case inventory", "--inventory-output") ||
         !add_option_artifact(opts.mock_registry_path, "mock registry", "--mock-registry") ||
         !add_option_artifact(opts.mock_impl_path, "mock implementation", "--mock-impl") ||
         !add_option_artifact(opts.mock_public_header_path, "mock public header", "--mock-public-header") ||
@@ -1530,7 +1639,7 @@ int emit(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases, c
             }
         }
         for (auto &[_, data] : per_source) {
-            std::ranges::sort(data.cases, {}, &TestCaseInfo::display_name);
+            std::ranges::sort(data.cases, render::registry_order_less);
         }
 
         const auto templates = load_registration_render_templates();
@@ -1540,7 +1649,9 @@ int emit(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases, c
         const std::vector<TestCaseInfo>          empty_cases;
         const std::vector<FixtureDeclInfo>       empty_fixtures;
         const std::vector<const MockClassInfo *> empty_mocks;
-        parallel_for(opts.sources.size(), jobs, [&](std::size_t idx) {
+        const auto                               emit_one = [&](std::size_t idx) {
+            const ThreadTraceScope   thread_trace;
+            llvm::TimeTraceScope     slot_span("EmitSlot", opts.sources[idx]);
             const fs::path           source_path                     = fs::path(opts.sources[idx]);
             const std::string        key                             = normalize_path_key(source_path);
             const auto               source_it                       = per_source.find(key);
@@ -1564,35 +1675,72 @@ int emit(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases, c
                     return;
                 }
 
-                std::string registration_source = "// This file is auto-generated by gentest_codegen.\n// Do not edit manually.\n\n";
-                const auto  headers_it          = declared_headers_by_source.find(key);
+                const auto shard_outputs = resolve_textual_registration_shard_outputs(opts, idx);
+                for (const auto &shard_out : shard_outputs) {
+                    if (!ensure_parent_dir(shard_out)) {
+                        statuses[idx] = 1;
+                        return;
+                    }
+                }
+
+                constexpr std::string_view kGeneratedBanner = "// This file is auto-generated by gentest_codegen.\n"
+                                                              "// Do not edit manually.\n\n";
+                const auto                 headers_it       = declared_headers_by_source.find(key);
                 if (tu_cases.empty() && tu_fixtures.empty()) {
+                    std::string registration_source{kGeneratedBanner};
                     registration_source += "// No gentest registrations were assigned to this translation unit.\n";
-                } else {
-                    if (headers_it == declared_headers_by_source.end() || headers_it->second.empty()) {
-                        log_err("gentest_codegen: missing declaring header for additive registration source '{}'\n",
-                                registration_out.string());
+                    if (!write_file_atomic_if_changed(registration_out, registration_source)) {
                         statuses[idx] = 1;
                         return;
                     }
-                    for (const auto &header : headers_it->second) {
-                        fmt::format_to(std::back_inserter(registration_source), "#include \"{}\"\n",
-                                       additive_header_include(opts, idx, registration_out, source_path, header));
+                    std::string empty_shard{kGeneratedBanner};
+                    empty_shard += "// No gentest registrations were assigned to this shard.\n";
+                    for (const auto &shard_out : shard_outputs) {
+                        if (!write_file_atomic_if_changed(shard_out, empty_shard)) {
+                            statuses[idx] = 1;
+                            return;
+                        }
                     }
-                    registration_source += "\n";
-                    const bool has_mocks            = !source_mocks.empty() || needs_mock_codegen_include;
-                    const auto core                 = render_registration_core(tu_cases, tu_fixtures, templates, has_mocks);
-                    needs_full_registration_support = core.needs_full_registration_support;
-                    std::string body                = std::string(tpl::tu_registration_header);
-                    replace_all(body, "// This file is auto-generated by gentest_codegen.\n// Do not edit manually.\n\n", "");
-                    replace_all(body, "#pragma once\n\n", "");
-                    apply_registration_core(body, core);
-                    const std::string register_fn = fmt::format("register_tu_{:04d}", static_cast<std::uint32_t>(idx));
-                    replace_all(body, "{{REGISTER_FN}}", register_fn);
-                    registration_source += body;
+                    return;
                 }
-                if (!write_file_atomic_if_changed(registration_out, registration_source)) {
+                if (headers_it == declared_headers_by_source.end() || headers_it->second.empty()) {
+                    log_err("gentest_codegen: missing declaring header for additive registration source '{}'\n", registration_out.string());
                     statuses[idx] = 1;
+                    return;
+                }
+
+                // Shard 0 is the slot's primary registration source and also owns
+                // the fixture registrations; the predeclared extra shards receive
+                // the remaining case runs, and unused ones are left as stubs.
+                const auto shards    = partition_registration_shards(tu_cases, shard_outputs.size() + 1);
+                const bool has_mocks = !source_mocks.empty() || needs_mock_codegen_include;
+                for (std::size_t shard_idx = 0; shard_idx <= shard_outputs.size(); ++shard_idx) {
+                    const fs::path &shard_out = shard_idx == 0 ? registration_out : shard_outputs[shard_idx - 1];
+                    std::string     registration_source{kGeneratedBanner};
+                    if (shard_idx >= shards.size()) {
+                        registration_source += "// No gentest registrations were assigned to this shard.\n";
+                    } else {
+                        for (const auto &header : headers_it->second) {
+                            fmt::format_to(std::back_inserter(registration_source), "#include \"{}\"\n",
+                                           additive_header_include(opts, idx, shard_out, source_path, header));
+                        }
+                        registration_source += "\n";
+                        const auto &shard_fixtures = shard_idx == 0 ? tu_fixtures : empty_fixtures;
+                        const auto  core           = render_registration_core(shards[shard_idx], shard_fixtures, templates, has_mocks);
+                        std::string body           = std::string(tpl::tu_registration_header);
+                        replace_all(body, kGeneratedBanner, "");
+                        replace_all(body, "#pragma once\n\n", "");
+                        apply_registration_core(body, core);
+                        const std::string register_fn =
+                            shard_idx == 0 ? fmt::format("register_tu_{:04d}", static_cast<std::uint32_t>(idx))
+                                           : fmt::format("register_tu_{:04d}_shard{}", static_cast<std::uint32_t>(idx), shard_idx);
+                        replace_all(body, "{{REGISTER_FN}}", register_fn);
+                        registration_source += body;
+                    }
+                    if (!write_file_atomic_if_changed(shard_out, registration_source)) {
+                        statuses[idx] = 1;
+                        return;
+                    }
                 }
                 return;
             }
@@ -1680,7 +1828,12 @@ int emit(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases, c
                     }
                 }
             }
-        });
+        };
+        if (opts.job_budget != nullptr) {
+            parallel_for(opts.sources.size(), *opts.job_budget, emit_one);
+        } else {
+            parallel_for(opts.sources.size(), jobs, emit_one);
+        }
 
         if (std::ranges::any_of(statuses, [](int st) { return st != 0; })) {
             return 1;
@@ -1690,6 +1843,9 @@ int emit(const CollectorOptions &opts, const std::vector<TestCaseInfo> &cases, c
     if (!write_artifact_manifest(opts)) {
         return 1;
     }
+    if (!write_case_inventory(opts, cases)) {
+        return 1;
+    }
 
     const bool have_mock_paths                = !opts.mock_registry_path.empty() && !opts.mock_impl_path.empty();
     const bool mocks_consumed_by_registration = !opts.mock_registration_manifest_path.empty();
@@ -0,0 +1,100 @@
+#pragma once
+
+// Byte-level prefilter that decides whether a source or header could contain
+// anything gentest_codegen reacts to. It is deliberately conservative: any
+// `gentest` (in any letter case, so GENTEST_* macros count), any `[[using`
+// attribute, and any `mock<` spelling is a hit, even inside comments or
+// string literals. A miss therefore proves the file has no markers.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GENTEST_CODEGEN_MARKER_PREFILTER_SSE2 1
+#endif
+
+namespace gentest::codegen::scan {
+
+namespace marker_prefilter_detail {
+
+inline bool is_blank(char ch) { return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v'; }
+
+inline std::size_t skip_blanks(std::string_view bytes, std::size_t pos) {
+    while (pos < bytes.size() && is_blank(bytes[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+inline bool matches_ci(std::string_view bytes, std::size_t pos, std::string_view lower_needle) {
+    if (bytes.size() - pos < lower_needle.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lower_needle.size(); ++i) {
+        if ((static_cast<unsigned char>(bytes[pos + i]) | 0x20U) != static_cast<unsigned char>(lower_needle[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Verifies a needle at a candidate position whose first byte is 'g', 'G',
+// '[' or 'm'.
+inline bool marker_at(std::string_view bytes, std::size_t pos) {
+    switch (bytes[pos]) {
+    case 'g':
+    case 'G': return matches_ci(bytes, pos, "gentest");
+    case '[':
+        return pos + 1 < bytes.size() && bytes[pos + 1] == '[' &&
+               bytes.substr(skip_blanks(bytes, pos + 2)).starts_with("using");
+    case 'm': {
+        if (!bytes.substr(pos).starts_with("mock")) {
+            return false;
+        }
+        const std::size_t next = skip_blanks(bytes, pos + 4);
+        return next < bytes.size() && bytes[next] == '<';
+    }
+    default: return false;
+    }
+}
+
+inline bool is_candidate(unsigned char ch) { return ch == 'g' || ch == 'G' || ch == '[' || ch == 'm'; }
+
+} // namespace marker_prefilter_detail
+
+inline bool bytes_may_contain_codegen_markers(std::string_view bytes) {
+    using namespace marker_prefilter_detail;
+    std::size_t pos = 0;
+#if defined(GENTEST_CODEGEN_MARKER_PREFILTER_SSE2)
+    // Compare 16 bytes at a time against the four needle lead bytes and only
+    // verify the positions that match one of them.
+    const __m128i lower_g = _mm_set1_epi8('g');
+    const __m128i upper_g = _mm_set1_epi8('G');
+    const __m128i bracket = _mm_set1_epi8('[');
+    const __m128i lower_m = _mm_set1_epi8('m');
+    for (; pos + 16 <= bytes.size(); pos += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes.data() + pos));
+        const __m128i hits  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, lower_g), _mm_cmpeq_epi8(chunk, upper_g)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(chunk, bracket), _mm_cmpeq_epi8(chunk, lower_m)));
+        auto          mask  = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+        while (mask != 0) {
+            const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+            if (marker_at(bytes, pos + bit)) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; pos < bytes.size(); ++pos) {
+        if (is_candidate(static_cast<unsigned char>(bytes[pos])) && marker_at(bytes, pos)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace gentest::codegen::scan
@@ -16,6 +16,8 @@
 
 namespace gentest::codegen {
 
+class JobBudget;
+
 enum class FixtureLifetime {
     None,
     MemberEphemeral,
@@ -141,6 +143,10 @@ struct CollectorOptions {
     // include annotated headers and are appended to the target; they never
     // include an authored implementation source.
     std::vector<std::filesystem::path> textual_registration_outputs;
+    // Build-owned extra shard sources for each additive registration slot,
+    // slot-major: slot `i` owns entries [i * (N - 1), (i + 1) * (N - 1)) where
+    // N is the per-slot shard count. Empty keeps one registration TU per slot.
+    std::vector<std::filesystem::path> textual_registration_shard_outputs;
     // Internal scan-slot plan aligned with `sources`: "authored-tu" or
     // "fallback-header". Empty preserves the legacy all-authored behavior.
     std::vector<std::string> scan_slot_kinds;
@@ -150,6 +156,9 @@ struct CollectorOptions {
     // same commands to their authored scan inputs.
     std::vector<std::string> compile_context_fingerprints;
     std::filesystem::path    artifact_manifest_path;
+    // Build-time case inventory in the `--list-json` schema; lets CTest
+    // discovery register cases without running the test binary.
+    std::filesystem::path    inventory_path;
     // Build-owned per-domain mock outputs. When mock outputs are requested,
     // these must stay aligned with the ordered mock domain plan: header first,
     // then the first-seen unique named modules in source order.
@@ -174,6 +183,10 @@ struct CollectorOptions {
     std::optional<std::filesystem::path>                                source_root;
     MockBackend                                                         mock_backend = MockBackend::Gentest;
     std::optional<std::filesystem::path>                                clang_scan_deps_executable;
+    // Shared content-addressed store for precompiled module interfaces; unset
+    // keeps BMIs private to this run's module cache directory.
+    std::optional<std::filesystem::path> module_bmi_cache_dir;
+    std::uint64_t                        module_bmi_cache_max_bytes = 0; // 0 = unbounded
     // Maximum parallelism used when parsing/emitting multiple inputs.
     // 0 selects std::thread::hardware_concurrency().
     std::size_t jobs                            = 0;
@@ -183,6 +196,9 @@ struct CollectorOptions {
     bool        check_only                      = false;
     bool        header_declaration_registration = false;
     bool        module_importer_registration    = false;
+    // Set by `gentest_codegen batch`: parse and emit borrow helper threads from
+    // this pool, shared with the other invocations, instead of using `jobs`.
+    JobBudget *job_budget = nullptr;
 };
 
 // Description of a discovered test function or member function.
@@ -217,6 +233,13 @@ struct TestCaseInfo {
     bool          is_jitter      = false;
     bool          is_baseline    = false;
     std::uint64_t items_per_call = 1;
+    // complexity(n): the size argument expression, and the series label (display
+    // name with that argument replaced by its parameter name). Empty otherwise.
+    std::string complexity_n_expression;
+    std::string complexity_series;
+    // cache(...) attribute rendered as a gentest::BenchCache enumerator name
+    // ("Warm", "Cold" or "Both"); empty leaves the case at BenchCache::Default.
+    std::string bench_cache;
     // True when the discovered callable is declared as a function template.
     bool is_function_template = false;
     // True when the test function/method returns a non-void value.
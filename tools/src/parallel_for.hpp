@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -57,4 +58,70 @@ template <typename Func> void parallel_for(std::size_t task_count, std::size_t j
     }
 }
 
+// Job slots shared by nested parallel loops. A loop run against a budget
+// borrows one slot per helper thread and returns it once that helper finds no
+// more work, so slots freed by one loop are picked up by the others while they
+// are still running.
+class JobBudget {
+  public:
+    explicit JobBudget(std::size_t slots) : free_(slots) {}
+    JobBudget(const JobBudget &)            = delete;
+    JobBudget &operator=(const JobBudget &) = delete;
+
+    [[nodiscard]] bool try_acquire() noexcept {
+        std::size_t free = free_.load(std::memory_order_relaxed);
+        while (free != 0) {
+            if (free_.compare_exchange_weak(free, free - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void release() noexcept { free_.fetch_add(1, std::memory_order_release); }
+
+  private:
+    std::atomic<std::size_t> free_;
+};
+
+// Runs `func(i)` for every i < task_count on the calling thread, which the
+// caller has already accounted for, plus helpers that each hold a slot of
+// `budget`. Before every task the running threads start another helper when a
+// slot is free and unclaimed tasks remain.
+template <typename Func> void parallel_for(std::size_t task_count, JobBudget &budget, Func &&func) {
+    std::atomic<std::size_t> next{0};
+    std::mutex               threads_mtx;
+    std::vector<std::thread> threads;
+    const auto               work = [&](const auto &self, bool helper) -> void {
+        while (true) {
+            const std::size_t idx = next.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= task_count) {
+                break;
+            }
+            if (idx + 1 < task_count && budget.try_acquire()) {
+                const std::lock_guard<std::mutex> lock(threads_mtx);
+                threads.emplace_back([&self] { self(self, true); });
+            }
+            func(idx);
+        }
+        if (helper) {
+            budget.release();
+        }
+    };
+    work(work, false);
+    // A helper is only started by a thread that is still running, so once every
+    // listed thread has been joined no more can appear.
+    for (std::size_t i = 0;; ++i) {
+        std::thread thread;
+        {
+            const std::lock_guard<std::mutex> lock(threads_mtx);
+            if (i == threads.size()) {
+                break;
+            }
+            thread = std::move(threads[i]);
+        }
+        thread.join();
+    }
+}
+
 } // namespace gentest::codegen
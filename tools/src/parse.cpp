@@ -42,7 +42,8 @@ bool is_known_gentest_attribute_name(std::string_view name) {
            lowered == "items_per_call" || lowered == "ops_per_call" || lowered == "range" || lowered == "linspace" || lowered == "geom" ||
            lowered == "geomspace" || lowered == "geospace" || lowered == "logspace" || lowered == "parameters_pack" ||
            lowered == "fixtures" || lowered == "fast" || lowered == "slow" || lowered == "linux" || lowered == "windows" ||
-           lowered == "death" || lowered == "owner" || lowered == "fixture" || lowered == "suite";
+           lowered == "death" || lowered == "owner" || lowered == "fixture" || lowered == "suite" || lowered == "complexity" ||
+           lowered == "cache" || lowered == "virtual_time";
 }
 
 bool is_gentest_scoped_attribute_token(std::string_view token) {
@@ -0,0 +1,172 @@
+// Implementation of child-process launching with a per-child working directory
+
+#include "process_launch.hpp"
+
+#include <fmt/format.h>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ConvertUTF.h>
+#include <llvm/Support/Program.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__DragonFly__)
+#define GENTEST_CODEGEN_HAS_PIPE2 1
+#endif
+#endif
+
+namespace gentest::codegen {
+
+#if defined(_WIN32)
+
+int execute_in_directory(const std::string &program, std::span<const std::string> args, const std::filesystem::path &working_directory,
+                         std::string &error) {
+    std::vector<llvm::StringRef> arg_refs(args.begin(), args.end());
+    auto                         command_line = llvm::sys::flattenWindowsCommandLine(arg_refs);
+    if (!command_line) {
+        error = fmt::format("failed to build command line for '{}': {}", program, command_line.getError().message());
+        return -1;
+    }
+    std::wstring wide_program;
+    if (!llvm::ConvertUTF8toWide(program, wide_program)) {
+        error = fmt::format("invalid program path '{}'", program);
+        return -1;
+    }
+    const std::wstring wide_directory = working_directory.wstring();
+
+    STARTUPINFOW startup{};
+    startup.cb         = sizeof(startup);
+    startup.dwFlags    = STARTF_USESTDHANDLES;
+    startup.hStdInput  = ::GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = ::GetStdHandle(STD_OUTPUT_HANDLE);
+    startup.hStdError  = ::GetStdHandle(STD_ERROR_HANDLE);
+    PROCESS_INFORMATION process{};
+    if (!::CreateProcessW(wide_program.c_str(), command_line->data(), nullptr, nullptr, TRUE, 0, nullptr,
+                          wide_directory.empty() ? nullptr : wide_directory.c_str(), &startup, &process)) {
+        error = fmt::format("failed to start '{}': {}", program, std::system_category().message(static_cast<int>(::GetLastError())));
+        return -1;
+    }
+    ::CloseHandle(process.hThread);
+    ::WaitForSingleObject(process.hProcess, INFINITE);
+    DWORD      exit_code = 0;
+    const bool have_code = ::GetExitCodeProcess(process.hProcess, &exit_code) != 0;
+    ::CloseHandle(process.hProcess);
+    if (!have_code) {
+        error = fmt::format("failed to read the exit code of '{}'", program);
+        return -1;
+    }
+    return static_cast<int>(exit_code);
+}
+
+#else
+
+namespace {
+
+// Other threads launch children concurrently, so both ends must be
+// close-on-exec from the start: a sibling that inherited the write end would
+// hold the pipe open and delay the EOF this launch waits for. pipe2() sets the
+// flag atomically; where it is missing (macOS) fcntl() leaves a short window.
+int open_cloexec_pipe(int (&fds)[2]) {
+#if defined(GENTEST_CODEGEN_HAS_PIPE2)
+    return ::pipe2(fds, O_CLOEXEC);
+#else
+    if (::pipe(fds) != 0) {
+        return -1;
+    }
+    (void)::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    (void)::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+#endif
+}
+
+} // namespace
+
+int execute_in_directory(const std::string &program, std::span<const std::string> args, const std::filesystem::path &working_directory,
+                         std::string &error) {
+    // Everything the child touches is prepared before fork(): between fork and
+    // exec a multithreaded parent's child may only make async-signal-safe calls.
+    std::vector<char *> argv;
+    argv.reserve(args.size() + 1);
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    const std::string directory   = working_directory.string();
+    const bool        search_path = program.find('/') == std::string::npos;
+
+    // The child reports a failed chdir/exec as an errno on this pipe; a
+    // successful exec closes the write end and the parent reads EOF.
+    int status_pipe[2];
+    if (open_cloexec_pipe(status_pipe) != 0) {
+        error = fmt::format("failed to create pipe: {}", std::strerror(errno));
+        return -1;
+    }
+
+    const pid_t child = ::fork();
+    if (child < 0) {
+        error = fmt::format("failed to fork: {}", std::strerror(errno));
+        ::close(status_pipe[0]);
+        ::close(status_pipe[1]);
+        return -1;
+    }
+    if (child == 0) {
+        ::close(status_pipe[0]);
+        if (directory.empty() || ::chdir(directory.c_str()) == 0) {
+            if (search_path) {
+                ::execvp(program.c_str(), argv.data());
+            } else {
+                ::execve(program.c_str(), argv.data(), environ);
+            }
+        }
+        const int child_errno = errno;
+        (void)!::write(status_pipe[1], &child_errno, sizeof(child_errno));
+        ::_exit(127);
+    }
+
+    ::close(status_pipe[1]);
+    int     child_errno = 0;
+    ssize_t got         = 0;
+    do {
+        got = ::read(status_pipe[0], &child_errno, sizeof(child_errno));
+    } while (got < 0 && errno == EINTR);
+    ::close(status_pipe[0]);
+
+    int status = 0;
+    while (::waitpid(child, &status, 0) < 0) {
+        if (errno != EINTR) {
+            error = fmt::format("failed to wait for '{}': {}", program, std::strerror(errno));
+            return -1;
+        }
+    }
+    if (got == static_cast<ssize_t>(sizeof(child_errno))) {
+        error = fmt::format("failed to start '{}' in '{}': {}", program, directory, std::strerror(child_errno));
+        return -1;
+    }
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    if (WIFSIGNALED(status)) {
+        error = fmt::format("'{}' was terminated by signal {}", program, WTERMSIG(status));
+    }
+    return -2;
+}
+
+#endif
+
+} // namespace gentest::codegen
@@ -0,0 +1,20 @@
+// Child-process launching with a per-child working directory.
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace gentest::codegen {
+
+// Runs `program` with `args` (args[0] is the program name the child sees) and
+// waits for it. The child starts in `working_directory`; unlike a chdir around
+// llvm::sys::ExecuteAndWait, the codegen process keeps its own working
+// directory, so threads resolving relative paths concurrently are unaffected.
+//
+// Returns the exit code like ExecuteAndWait: -1 when the child could not be
+// started and -2 when it did not exit normally, with `error` describing why.
+[[nodiscard]] int execute_in_directory(const std::string &program, std::span<const std::string> args,
+                                       const std::filesystem::path &working_directory, std::string &error);
+
+} // namespace gentest::codegen
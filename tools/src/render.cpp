@@ -7,6 +7,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 
 namespace gentest::codegen::render {
@@ -930,11 +931,78 @@ std::string render_case_entries(const std::vector<TestCaseInfo> &cases, const st
                      test.returns_async ? std::string("&::kCaseAsyncInvoke_") + std::to_string(idx) : std::string("nullptr")),
             fmt::arg("is_async", test.returns_async ? "true" : "false"),
             fmt::arg("items_per_call", fmt::format("{}ULL", test.items_per_call)),
-            fmt::arg("owner", !test.owner.empty() ? "\"" + escape_string(test.owner) + "\"" : std::string("std::string_view{}")));
+            fmt::arg("owner", !test.owner.empty() ? "\"" + escape_string(test.owner) + "\"" : std::string("std::string_view{}")),
+            fmt::arg("complexity_n", !test.complexity_n_expression.empty()
+                                         ? fmt::format("static_cast<double>({})", test.complexity_n_expression)
+                                         : std::string("0.0")),
+            fmt::arg("complexity_series", !test.complexity_series.empty() ? "\"" + escape_string(test.complexity_series) + "\""
+                                                                          : std::string("std::string_view{}")),
+            fmt::arg("bench_cache", "gentest::BenchCache::" + (test.bench_cache.empty() ? std::string("Default") : test.bench_cache)));
     }
     return out;
 }
 
+namespace {
+std::string_view inventory_fixture_lifetime(FixtureLifetime lt) {
+    switch (lt) {
+    case FixtureLifetime::None: return "none";
+    case FixtureLifetime::MemberEphemeral: return "local";
+    case FixtureLifetime::MemberSuite: return "suite";
+    case FixtureLifetime::MemberGlobal: return "global";
+    }
+    return "none";
+}
+
+void append_json_string_array(std::string &out, const std::vector<std::string> &values) {
+    out.push_back('[');
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i != 0) {
+            out.push_back(',');
+        }
+        append_format(out, "\"{}\"", escape_string(values[i]));
+    }
+    out.push_back(']');
+}
+} // namespace
+
+bool registry_order_less(const TestCaseInfo &lhs, const TestCaseInfo &rhs) {
+    return std::tie(lhs.display_name, lhs.filename, lhs.line) < std::tie(rhs.display_name, rhs.filename, rhs.line);
+}
+
+std::string render_inventory_json(const std::vector<TestCaseInfo> &cases) {
+    // Same order as the runtime registry so the sidecar diffs cleanly against
+    // `--list-json` output.
+    std::vector<const TestCaseInfo *> sorted;
+    sorted.reserve(cases.size());
+    for (const auto &test : cases) {
+        sorted.push_back(&test);
+    }
+    std::ranges::sort(sorted, [](const TestCaseInfo *lhs, const TestCaseInfo *rhs) { return registry_order_less(*lhs, *rhs); });
+
+    std::string out;
+    out.reserve(cases.size() * 320 + 4);
+    out.append("[\n");
+    for (std::size_t idx = 0; idx < sorted.size(); ++idx) {
+        const auto &test             = *sorted[idx];
+        const auto  grouping_fixture = case_grouping_fixture(test);
+        const char *kind             = test.is_jitter ? "jitter" : (test.is_benchmark ? "bench" : "test");
+        append_format(out, R"(  {{"name":"{}","file":"{}","line":{},"kind":"{}","tags":)", escape_string(test.display_name),
+                      escape_string(test.filename), test.line, kind);
+        append_json_string_array(out, test.tags);
+        out.append(",\"requirements\":");
+        append_json_string_array(out, test.requirements);
+        append_format(out, R"(,"owner":"{}","skipped":{},"skipReason":"{}","fixture":"{}","fixtureLifetime":"{}","suite":"{}")",
+                      escape_string(test.owner), test.should_skip ? "true" : "false", escape_string(test.skip_reason),
+                      escape_string(grouping_fixture.first), inventory_fixture_lifetime(grouping_fixture.second),
+                      escape_string(test.suite_name));
+        append_format(out, R"(,"async":{},"baseline":{},"itemsPerCall":{}}}{})", test.returns_async ? "true" : "false",
+                      test.is_baseline ? "true" : "false", test.items_per_call, idx + 1 == sorted.size() ? "" : ",");
+        out.push_back('\n');
+    }
+    out.append("]\n");
+    return out;
+}
+
 std::string render_fixture_registrations(const std::vector<FixtureDeclInfo> &fixtures) {
     std::string out;
     for (const auto &fx : fixtures) {
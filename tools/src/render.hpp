@@ -39,6 +39,14 @@ std::string render_wrappers(const std::vector<TestCaseInfo> &cases, const Wrappe
 std::string render_case_entries(const std::vector<TestCaseInfo> &cases, const std::vector<std::string> &tag_names,
                                 const std::vector<std::string> &req_names, const std::string &tpl_case_entry);
 
+// Registry order (name, file, line). kCases and the inventory are emitted in
+// this order so the runtime can merge per-TU tables without re-sorting.
+bool registry_order_less(const TestCaseInfo &lhs, const TestCaseInfo &rhs);
+
+// Render the build-time case inventory: a JSON array in the `--list-json`
+// schema, one case object per line, sorted like the runtime registry.
+std::string render_inventory_json(const std::vector<TestCaseInfo> &cases);
+
 // Render fixture registration statements for suite/global fixtures.
 std::string render_fixture_registrations(const std::vector<FixtureDeclInfo> &fixtures);
 
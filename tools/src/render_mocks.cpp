@@ -344,10 +344,13 @@ std::string dispatch_block(const std::string &indent, const MockClassInfo &cls,
     const std::string method_constant_ref =
         fmt::format("static_cast<{0}>(&{1}::{2}{3})", type_parts.pointer_type, fq_type, method.method_name, tpl_usage);
     const std::string raw_method_ref = fmt::format("&{0}::{1}{2}", fq_type, method.method_name, tpl_usage);
+    // Record/replay key: overloads share a name, so the parameter list is part of it.
+    const std::string trace_key = fmt::format("{}{}({}){}", fq_method, tpl_usage, type_parts.parameter_types, type_parts.qualifiers);
     block.append("{0}auto token = ::gentest::detail::mocking::method_constant_identity<{1}>();\n", indent, method_constant_ref);
     block.append("{0}auto fallback_token = this->__gentest_state_.identify({1});\n", indent, raw_method_ref);
-    block.append("{0}{1}this->__gentest_state_.template dispatch_with_fallback<{2}>(token, fallback_token, \"{3}\"{4});\n", indent,
-                 returns_value ? "return " : "", type_parts.return_type, fq_method_escaped, dispatch_args);
+    block.append("{0}{1}this->__gentest_state_.template dispatch_with_fallback<{2}>(token, fallback_token, {3}, \"{4}\", \"{5}\"{6});\n",
+                 indent, returns_value ? "return " : "", type_parts.return_type, method_constant_ref, fq_method_escaped,
+                 escape_string(trace_key), dispatch_args);
     return block.str();
 }
 
@@ -765,6 +768,9 @@ std::string build_mock_access(const MockClassInfo &cls, bool module_mode = false
     body.append_raw("    }\n");
     body.append_raw("\n");
     body.append("    static void set_nice(mock<{0}> &instance, bool v) {{ instance.__gentest_state_.set_nice(v); }}\n", fq_type);
+    body.append("    static ::gentest::detail::mocking::InstanceState &state(mock<{0}> &instance) {{ "
+                "return instance.__gentest_state_; }}\n",
+                fq_type);
     body.append_raw("};\n\n");
     return body.str();
 }
@@ -21,7 +21,8 @@
 //   wrapper_stateful: {w}, {fixture}, {method}
 //   case_entry:       {name}, {wrapper}, {file}, {line}, {tags}, {reqs},
 //                     {skip_reason}, {should_skip}, {fixture}, {lifetime}, {suite},
-//                     {async_wrapper}, {is_async}, {items_per_call}, {owner}
+//                     {async_wrapper}, {is_async}, {items_per_call}, {owner},
+//                     {complexity_n}, {complexity_series}, {bench_cache}
 //   group_runner_*:   {gid}, {fixture}, {count}, {idxs}
 //   array_decl_*:     {name}; or {count}, {name}, {body}
 //   forward_decl_*:   {name}; or {scope}, {lines}
@@ -42,9 +43,9 @@ inline constexpr std::string_view registration_preamble_light = R"CPP(#include <
 
 #include "gentest/detail/registration_runtime.h"
 
-#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 3 || \
-    !defined(GENTEST_CASE_API_HAS_OWNER) || !GENTEST_CASE_API_HAS_OWNER
-#error "gentest_codegen output requires gentest headers with Case::owner; use matching gentest headers/runtime"
+#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 5 || \
+    !defined(GENTEST_CASE_API_HAS_BENCH_CACHE) || !GENTEST_CASE_API_HAS_BENCH_CACHE
+#error "gentest_codegen output requires gentest headers with Case::bench_cache; use matching gentest headers/runtime"
 #endif
 )CPP";
 ;
@@ -61,9 +62,9 @@ inline constexpr std::string_view registration_preamble_full = R"CPP(#include <a
 #include "gentest/async.h"
 #include "gentest/detail/generated_runtime.h"
 
-#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 3 || \
-    !defined(GENTEST_CASE_API_HAS_OWNER) || !GENTEST_CASE_API_HAS_OWNER
-#error "gentest_codegen output requires gentest headers with Case::owner; use matching gentest headers/runtime"
+#if !defined(GENTEST_CASE_API_VERSION) || GENTEST_CASE_API_VERSION < 5 || \
+    !defined(GENTEST_CASE_API_HAS_BENCH_CACHE) || !GENTEST_CASE_API_HAS_BENCH_CACHE
+#error "gentest_codegen output requires gentest headers with Case::bench_cache; use matching gentest headers/runtime"
 #endif
 )CPP";
 ;
@@ -305,9 +306,15 @@ constexpr std::array<gentest::Case, {{CASE_COUNT}}> kCases = {
 } // namespace gentest::generated::{{REGISTER_FN}}
 
 namespace gentest::generated::{{REGISTER_FN}} {
+#if defined(GENTEST_CASE_TABLE_SECTION)
+// kCases is emitted in registry order; the runtime merges it from the linker section.
+GENTEST_CASE_TABLE_ENTRY const gentest::detail::CaseTableRun {{REGISTER_FN}}_case_run{kCases.data(), kCases.data() + kCases.size()};
+#endif
 struct {{REGISTER_FN}}_registrar {
     {{REGISTER_FN}}_registrar() {
-{{FIXTURE_REGISTRATIONS}}        gentest::detail::register_cases(std::span{kCases});
+{{FIXTURE_REGISTRATIONS}}#if !defined(GENTEST_CASE_TABLE_SECTION)
+        gentest::detail::register_cases(std::span{kCases});
+#endif
     }
 };
 [[maybe_unused]] const {{REGISTER_FN}}_registrar {{REGISTER_FN}}_instance{};
@@ -460,7 +467,10 @@ inline constexpr std::string_view case_entry = R"FMT(    gentest::Case{{
         .async_fn = {async_wrapper},
         .is_async = {is_async},
         .items_per_call = {items_per_call},
-        .owner = {owner}
+        .owner = {owner},
+        .complexity_n = {complexity_n},
+        .complexity_series = {complexity_series},
+        .bench_cache = {bench_cache}
     }},
 
 )FMT";
@@ -0,0 +1,82 @@
+// Chrome trace-event output for gentest_codegen (--trace-out).
+#pragma once
+
+#include "log.hpp"
+
+#include <atomic>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace gentest::codegen {
+
+namespace trace_detail {
+inline std::atomic<bool>     enabled{false};
+inline std::atomic<unsigned> granularity_us{0};
+} // namespace trace_detail
+
+// Owns LLVM's time-trace profiler for one codegen run. Phases are recorded
+// with plain llvm::TimeTraceScope spans, which cost nothing while tracing is
+// off. The trace is written when the session ends, so every exit path of the
+// tool leaves one behind.
+class TraceSession {
+  public:
+    TraceSession(std::string output_path, unsigned granularity_us) : output_path_(std::move(output_path)) {
+        if (output_path_.empty()) {
+            return;
+        }
+        trace_detail::granularity_us = granularity_us;
+        trace_detail::enabled        = true;
+        llvm::timeTraceProfilerInitialize(granularity_us, "gentest_codegen");
+    }
+    TraceSession(const TraceSession &)            = delete;
+    TraceSession &operator=(const TraceSession &) = delete;
+
+    ~TraceSession() {
+        if (output_path_.empty()) {
+            return;
+        }
+        std::error_code      ec;
+        llvm::raw_fd_ostream out(output_path_, ec, llvm::sys::fs::OF_Text);
+        if (ec) {
+            log_err("gentest_codegen: warning: failed to write trace '{}': {}\n", output_path_, ec.message());
+        } else {
+            llvm::timeTraceProfilerWrite(out);
+        }
+        llvm::timeTraceProfilerCleanup();
+        trace_detail::enabled = false;
+    }
+
+  private:
+    std::string output_path_;
+};
+
+// Gives a worker thread its own profiler instance while the scope lives. Its
+// spans, including the frontend spans Clang records during an in-process
+// parse, end up in the session trace under the worker's thread id. A no-op
+// when tracing is off or the thread already has a profiler (the main thread).
+class ThreadTraceScope {
+  public:
+    ThreadTraceScope() {
+        if (trace_detail::enabled && llvm::getTimeTraceProfilerInstance() == nullptr) {
+            llvm::timeTraceProfilerInitialize(trace_detail::granularity_us, "gentest_codegen");
+            owns_profiler_ = true;
+        }
+    }
+    ThreadTraceScope(const ThreadTraceScope &)            = delete;
+    ThreadTraceScope &operator=(const ThreadTraceScope &) = delete;
+
+    ~ThreadTraceScope() {
+        if (owns_profiler_) {
+            llvm::timeTraceProfilerFinishThread();
+        }
+    }
+
+  private:
+    bool owns_profiler_ = false;
+};
+
+} // namespace gentest::codegen
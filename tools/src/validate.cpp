@@ -12,6 +12,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace gentest::codegen {
@@ -241,6 +242,21 @@ bool has_matching_angle_close(std::string_view text, std::size_t open_index) {
     }
     return false;
 }
+
+bool names_value_axis(const AttributeSummary &summary, std::string_view name) {
+    const auto matches = [&](const auto &specs, auto name_of) {
+        return std::ranges::any_of(specs, [&](const auto &spec) { return trim_copy(name_of(spec)) == name; });
+    };
+    const auto spec_name = [](const auto &spec) -> const std::string & { return spec.name; };
+    if (matches(summary.parameter_sets, [](const AttributeSummary::ParamSet &set) -> const std::string & { return set.param_name; }) ||
+        matches(summary.parameter_ranges, spec_name) || matches(summary.parameter_linspaces, spec_name) ||
+        matches(summary.parameter_geoms, spec_name) || matches(summary.parameter_logspaces, spec_name)) {
+        return true;
+    }
+    return std::ranges::any_of(summary.param_packs, [&](const AttributeSummary::ParamPack &pack) {
+        return std::ranges::any_of(pack.names, [&](const std::string &pack_name) { return trim_copy(pack_name) == name; });
+    });
+}
 } // namespace
 
 auto validate_attributes(const std::vector<ParsedAttribute> &parsed, const std::function<void(const std::string &)> &report)
@@ -252,6 +268,7 @@ auto validate_attributes(const std::vector<ParsedAttribute> &parsed, const std::
     bool                       saw_bench          = false;
     bool                       saw_jitter         = false;
     bool                       saw_items_per_call = false;
+    bool                       saw_cache          = false;
     std::set<std::string>      seen_flags;
     std::optional<std::string> seen_owner;
 
@@ -332,6 +349,44 @@ auto validate_attributes(const std::vector<ParsedAttribute> &parsed, const std::
                 continue;
             }
             summary.items_per_call = items_per_call;
+        } else if (lowered == "complexity") {
+            if (summary.complexity_param.has_value()) {
+                summary.had_error = true;
+                report("duplicate gentest attribute 'complexity'");
+                continue;
+            }
+            if (attr.arguments.size() != 1 || trim_copy(attr.arguments.front()).empty()) {
+                summary.had_error = true;
+                report("'complexity' requires exactly one parameter name argument");
+                continue;
+            }
+            summary.complexity_param = trim_copy(attr.arguments.front());
+        } else if (lowered == "cache") {
+            if (saw_cache) {
+                summary.had_error = true;
+                report("duplicate gentest attribute 'cache'");
+                continue;
+            }
+            saw_cache = true;
+            if (attr.arguments.empty() || attr.arguments.size() > 2) {
+                summary.had_error = true;
+                report("'cache' requires one or two arguments from: warm, cold");
+                continue;
+            }
+            for (const auto &arg : attr.arguments) {
+                const auto mode = trim_copy(arg);
+                if (mode != "warm" && mode != "cold") {
+                    summary.had_error = true;
+                    report(fmt::format("'cache' argument must be 'warm' or 'cold'; got '{}'", mode));
+                    continue;
+                }
+                bool &seen = mode == "warm" ? summary.cache_warm : summary.cache_cold;
+                if (seen) {
+                    summary.had_error = true;
+                    report(fmt::format("duplicate 'cache' argument '{}'", mode));
+                }
+                seen = true;
+            }
         } else if (lowered == "req" || lowered == "requires") {
             if (attr.arguments.empty()) {
                 summary.had_error = true;
@@ -679,6 +734,20 @@ auto validate_attributes(const std::vector<ParsedAttribute> &parsed, const std::
         summary.had_error = true;
         report("'items_per_call'/'ops_per_call' requires 'bench' or 'jitter' on the same declaration");
     }
+    if (saw_cache && !summary.is_benchmark) {
+        summary.had_error = true;
+        report("'cache' requires 'bench' on the same declaration");
+    }
+    if (summary.complexity_param.has_value()) {
+        if (!summary.is_benchmark) {
+            summary.had_error = true;
+            report("'complexity' requires 'bench' on the same declaration");
+        } else if (!names_value_axis(summary, *summary.complexity_param)) {
+            summary.had_error = true;
+            report(fmt::format("'complexity({})' must name a parameters, range, linspace, geom, or logspace axis",
+                               *summary.complexity_param));
+        }
+    }
 
     summary.is_case = saw_case;
 
@@ -74,6 +74,11 @@ struct AttributeSummary {
     };
     std::vector<ParamPack>     param_packs;
     std::optional<std::string> owner;
+    // Benchmarks: value axis named by complexity(n); its per-case value is the input size.
+    std::optional<std::string> complexity_param;
+    // Benchmarks: cache(warm|cold) states requested; both false defers to the CLI.
+    bool cache_warm = false;
+    bool cache_cold = false;
 };
 
 // Summary of class/struct-level attributes after validation.
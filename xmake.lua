@@ -51,9 +51,12 @@ target("gentest_runtime")
     gentest_apply_windows_llvm_toolchain()
     add_packages("fmt")
     add_files("src/async.cpp")
+    add_files("src/async_frame_pool.cpp")
+    add_files("src/async_io_poller.cpp")
     add_files("src/bench_stats.cpp")
     add_files("src/context_api.cpp")
     add_files("src/log_sink.cpp")
+    add_files("src/mock_trace.cpp")
     add_files("src/runtime_context.cpp")
     add_files("src/runner_async_executor.cpp")
     add_files("src/runner_async_scheduler.cpp")
@@ -62,7 +65,11 @@ target("gentest_runtime")
     add_files("src/runner_case_result.cpp")
     add_files("src/runner_case_invoker.cpp")
     add_files("src/runner_cli.cpp")
+    add_files("src/runner_death_fork.cpp")
     add_files("src/runner_fixture_runtime.cpp")
+    add_files("src/runner_measured_cache.cpp")
+    add_files("src/runner_measured_environment.cpp")
+    add_files("src/runner_measured_clock.cpp")
     add_files("src/runner_measured_executor.cpp")
     add_files("src/runner_measured_format.cpp")
     add_files("src/runner_measured_report.cpp")
@@ -71,6 +78,7 @@ target("gentest_runtime")
     add_files("src/runner_reporting.cpp")
     add_files("src/runner_reporting_allure.cpp")
     add_files("src/runner_selector.cpp")
+    add_files("src/runner_serve.cpp")
     add_files("src/runner_test_executor.cpp")
     add_files("src/runner_test_plan.cpp")
     add_includedirs(incdirs)